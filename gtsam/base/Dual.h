@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    Dual.h
+ * @brief   Dual numbers for forward-mode automatic differentiation
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+#include <cmath>
+#include <limits>
+
+namespace gtsam {
+
+namespace autodiff {
+
+  /**
+   * A dual number \f$ a + v \epsilon \f$ with \f$ \epsilon^2 = 0 \f$, carrying a value \c a and
+   * its derivatives \c v with respect to N variables.  Evaluating a function templated on the
+   * scalar type with Dual<N> arguments computes its value and its Jacobian in one pass (forward
+   * mode automatic differentiation), exact up to round-off.  The derivatives are a fixed-size
+   * Eigen vector, so no memory is allocated, and Dual<N> can be the scalar of fixed-size Eigen
+   * matrices.
+   *
+   * Constants convert implicitly from double, and variable k of N is created with Dual(value, k).
+   * Comparisons only look at the value.  See Traits and AutoDiffFactor1 for
+   * differentiating functions of geometry objects.
+   */
+  template<int N>
+  struct Dual {
+    typedef Eigen::Matrix<double, N, 1, Eigen::DontAlign> Derivatives;
+
+    double a;       ///< the value
+    Derivatives v;  ///< the derivatives with respect to the N variables
+
+    /** Zero */
+    Dual() : a(0.0), v(Derivatives::Zero()) {}
+
+    /** A constant */
+    Dual(double value) : a(value), v(Derivatives::Zero()) {}
+
+    /** Variable k of N, with the given value */
+    Dual(double value, int k) : a(value), v(Derivatives::Zero()) { v(k) = 1.0; }
+
+    /** Value and derivatives */
+    Dual(double value, const Derivatives& derivatives) : a(value), v(derivatives) {}
+
+    Dual& operator+=(const Dual& y) { a += y.a; v += y.v; return *this; }
+    Dual& operator-=(const Dual& y) { a -= y.a; v -= y.v; return *this; }
+    Dual& operator*=(const Dual& y) { v = y.a * v + a * y.v; a *= y.a; return *this; }
+    Dual& operator/=(const Dual& y) { const double inv = 1.0 / y.a; a *= inv; v = inv * (v - a * y.v); return *this; }
+    Dual& operator+=(double s) { a += s; return *this; }
+    Dual& operator-=(double s) { a -= s; return *this; }
+    Dual& operator*=(double s) { a *= s; v *= s; return *this; }
+    Dual& operator/=(double s) { const double inv = 1.0 / s; a *= inv; v *= inv; return *this; }
+  };
+
+  /// @name Arithmetic
+  /// @{
+
+  template<int N> inline Dual<N> operator+(const Dual<N>& x) { return x; }
+  template<int N> inline Dual<N> operator-(const Dual<N>& x) { return Dual<N>(-x.a, -x.v); }
+
+  template<int N> inline Dual<N> operator+(const Dual<N>& x, const Dual<N>& y) { return Dual<N>(x.a + y.a, x.v + y.v); }
+  template<int N> inline Dual<N> operator+(const Dual<N>& x, double s) { return Dual<N>(x.a + s, x.v); }
+  template<int N> inline Dual<N> operator+(double s, const Dual<N>& x) { return Dual<N>(s + x.a, x.v); }
+
+  template<int N> inline Dual<N> operator-(const Dual<N>& x, const Dual<N>& y) { return Dual<N>(x.a - y.a, x.v - y.v); }
+  template<int N> inline Dual<N> operator-(const Dual<N>& x, double s) { return Dual<N>(x.a - s, x.v); }
+  template<int N> inline Dual<N> operator-(double s, const Dual<N>& x) { return Dual<N>(s - x.a, -x.v); }
+
+  template<int N> inline Dual<N> operator*(const Dual<N>& x, const Dual<N>& y) { return Dual<N>(x.a * y.a, y.a * x.v + x.a * y.v); }
+  template<int N> inline Dual<N> operator*(const Dual<N>& x, double s) { return Dual<N>(x.a * s, s * x.v); }
+  template<int N> inline Dual<N> operator*(double s, const Dual<N>& x) { return Dual<N>(s * x.a, s * x.v); }
+
+  template<int N> inline Dual<N> operator/(const Dual<N>& x, const Dual<N>& y) {
+    const double inv = 1.0 / y.a, a = x.a * inv;
+    return Dual<N>(a, inv * (x.v - a * y.v));
+  }
+  template<int N> inline Dual<N> operator/(const Dual<N>& x, double s) { const double inv = 1.0 / s; return Dual<N>(x.a * inv, inv * x.v); }
+  template<int N> inline Dual<N> operator/(double s, const Dual<N>& x) {
+    const double inv = 1.0 / x.a, a = s * inv;
+    return Dual<N>(a, (-a * inv) * x.v);
+  }
+
+  /// @}
+  /// @name Comparisons, of the values only
+  /// @{
+
+#define GTSAM_DUAL_COMPARISON(OP) \
+  template<int N> inline bool operator OP(const Dual<N>& x, const Dual<N>& y) { return x.a OP y.a; } \
+  template<int N> inline bool operator OP(const Dual<N>& x, double s) { return x.a OP s; } \
+  template<int N> inline bool operator OP(double s, const Dual<N>& x) { return s OP x.a; }
+  GTSAM_DUAL_COMPARISON(<)
+  GTSAM_DUAL_COMPARISON(<=)
+  GTSAM_DUAL_COMPARISON(>)
+  GTSAM_DUAL_COMPARISON(>=)
+  GTSAM_DUAL_COMPARISON(==)
+  GTSAM_DUAL_COMPARISON(!=)
+#undef GTSAM_DUAL_COMPARISON
+
+  /// @}
+  /// @name Elementary functions, found by argument-dependent lookup
+  /// @{
+
+  template<int N> inline Dual<N> abs(const Dual<N>& x) { return x.a < 0.0 ? -x : x; }
+  template<int N> inline Dual<N> fabs(const Dual<N>& x) { return abs(x); }
+
+  template<int N> inline Dual<N> sqrt(const Dual<N>& x) {
+    const double r = std::sqrt(x.a);
+    return Dual<N>(r, (0.5 / r) * x.v);
+  }
+  template<int N> inline Dual<N> exp(const Dual<N>& x) {
+    const double e = std::exp(x.a);
+    return Dual<N>(e, e * x.v);
+  }
+  template<int N> inline Dual<N> log(const Dual<N>& x) { return Dual<N>(std::log(x.a), (1.0 / x.a) * x.v); }
+  template<int N> inline Dual<N> pow(const Dual<N>& x, double p) {
+    const double y = std::pow(x.a, p - 1.0);
+    return Dual<N>(y * x.a, (p * y) * x.v);
+  }
+
+  template<int N> inline Dual<N> sin(const Dual<N>& x) { return Dual<N>(std::sin(x.a), std::cos(x.a) * x.v); }
+  template<int N> inline Dual<N> cos(const Dual<N>& x) { return Dual<N>(std::cos(x.a), -std::sin(x.a) * x.v); }
+  template<int N> inline Dual<N> tan(const Dual<N>& x) {
+    const double t = std::tan(x.a);
+    return Dual<N>(t, (1.0 + t * t) * x.v);
+  }
+  template<int N> inline Dual<N> asin(const Dual<N>& x) { return Dual<N>(std::asin(x.a), (1.0 / std::sqrt(1.0 - x.a * x.a)) * x.v); }
+  template<int N> inline Dual<N> acos(const Dual<N>& x) { return Dual<N>(std::acos(x.a), (-1.0 / std::sqrt(1.0 - x.a * x.a)) * x.v); }
+  template<int N> inline Dual<N> atan(const Dual<N>& x) { return Dual<N>(std::atan(x.a), (1.0 / (1.0 + x.a * x.a)) * x.v); }
+  template<int N> inline Dual<N> atan2(const Dual<N>& y, const Dual<N>& x) {
+    const double inv = 1.0 / (x.a * x.a + y.a * y.a);
+    return Dual<N>(std::atan2(y.a, x.a), (x.a * inv) * y.v - (y.a * inv) * x.v);
+  }
+
+  /// @}
+
+} // namespace autodiff
+
+} // namespace gtsam
+
+namespace Eigen {
+
+  /** Lets Dual<N> be the scalar type of Eigen matrices */
+  template<int N>
+  struct NumTraits<gtsam::autodiff::Dual<N> > {
+    typedef gtsam::autodiff::Dual<N> Real;
+    typedef gtsam::autodiff::Dual<N> NonInteger;
+    typedef gtsam::autodiff::Dual<N> Nested;
+
+    enum {
+      IsComplex = 0,
+      IsInteger = 0,
+      IsSigned = 1,
+      RequireInitialization = 1,
+      ReadCost = 1,
+      AddCost = N + 1,
+      MulCost = 2 * N + 1
+    };
+
+    static inline Real epsilon() { return Real(std::numeric_limits<double>::epsilon()); }
+    static inline Real dummy_precision() { return Real(1e-12); }
+    static inline Real highest() { return Real(std::numeric_limits<double>::max()); }
+    static inline Real lowest() { return Real(-std::numeric_limits<double>::max()); }
+  };
+
+} // namespace Eigen
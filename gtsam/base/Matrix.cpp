@@ -20,11 +20,13 @@
 #include <gtsam/base/timing.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/FastList.h>
+#include <gtsam/base/FastVector.h>
 
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstring>
 #include <iomanip>
@@ -424,6 +426,76 @@ void householder(Matrix& A, size_t k) {
 //  gttoc(householder_zero_fill);
 }
 
+/* ************************************************************************* */
+void inplace_QR_staircase(Matrix& A, DenseIndex blockSize) {
+  gttic(inplace_QR_staircase);
+  const DenseIndex m = A.rows(), n = A.cols(), k = std::min(m, n);
+  if (k == 0)
+    return;
+
+  // Find the first nonzero column of every row, and sort the rows by it
+  gttic(profile);
+  FastVector<pair<DenseIndex, DenseIndex> > firstNonzero(m); // (column, row)
+  bool sorted = true;
+  for (DenseIndex i = 0; i < m; ++i) {
+    DenseIndex j = 0;
+    while (j < n && A(i, j) == 0.0)
+      ++j;
+    firstNonzero[i] = make_pair(j, i);
+    if (i > 0 && j < firstNonzero[i-1].first)
+      sorted = false;
+  }
+  if (!sorted) {
+    std::stable_sort(firstNonzero.begin(), firstNonzero.end());
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, DenseIndex> P(m);
+    for (DenseIndex i = 0; i < m; ++i)
+      P.indices()(i) = firstNonzero[i].second;
+    A = P.transpose() * A;
+  }
+
+  // The reflection of column j acts on rows j to rowEnd[j], the rows below
+  // being zero up to column j and remaining so
+  FastVector<DenseIndex> rowEnd(k);
+  DenseIndex i = 0;
+  for (DenseIndex j = 0; j < k; ++j) {
+    while (i < m && firstNonzero[i].first <= j)
+      ++i;
+    rowEnd[j] = std::max(i, j + 1);
+  }
+  gttoc(profile);
+
+  Vector hCoeffs(k), workspace(n);
+  for (DenseIndex p = 0; p < k; p += blockSize) {
+    const DenseIndex nb = std::min(blockSize, k - p), panelEnd = p + nb;
+
+    // Unblocked Householder within the panel, on the rows each column reaches
+    gttic(panel);
+    for (DenseIndex j = p; j < panelEnd; ++j) {
+      const DenseIndex rows = rowEnd[j] - j;
+      double beta;
+      A.col(j).segment(j, rows).makeHouseholderInPlace(hCoeffs(j), beta);
+      A(j, j) = beta;
+      if (j + 1 < panelEnd)
+        A.block(j, j + 1, rows, panelEnd - j - 1).applyHouseholderOnTheLeft(
+            A.col(j).segment(j + 1, rows - 1), hCoeffs(j), workspace.data());
+    }
+    gttoc(panel);
+
+    // Apply the panel's reflections to the trailing columns at once, as I - V T V'
+    if (panelEnd < n) {
+      gttic(trailing_update);
+      const DenseIndex rows = rowEnd[panelEnd - 1] - p;
+      Eigen::Block<Matrix> V = A.block(p, p, rows, nb);
+      Eigen::Block<Matrix> trailing = A.block(p, panelEnd, rows, n - panelEnd);
+      Eigen::internal::apply_block_householder_on_the_left(trailing, V,
+          hCoeffs.segment(p, nb).adjoint());
+      gttoc(trailing_update);
+    }
+  }
+
+  zeroBelowDiagonal(A);
+}
+
 /* ************************************************************************* */
 Vector backSubstituteLower(const Matrix& L, const Vector& b, bool unit) {
   // @return the solution x of L*x=b
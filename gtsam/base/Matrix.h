@@ -317,6 +317,19 @@ void inplace_QR(MATRIX& A) {
   zeroBelowDiagonal(A);
 }
 
+/**
+ * Blocked Householder QR for matrices whose rows start at different columns,
+ * such as the stacked rows of the Jacobian factors eliminated together.  The
+ * rows are sorted by their first nonzero column, after which each reflection
+ * only involves the rows that start at or before its column.  Reflections are
+ * accumulated over panels of blockSize columns and applied to the remaining
+ * columns at once, in the WY representation.  The result is R, up to the
+ * signs of its rows, with zeros below the diagonal.
+ * @param A is the input matrix, and is the output
+ * @param blockSize is the number of columns per panel
+ */
+GTSAM_EXPORT void inplace_QR_staircase(Matrix& A, DenseIndex blockSize = 32);
+
 /**
  * Imperative algorithm for in-place full elimination with
  * weights and constraint handling
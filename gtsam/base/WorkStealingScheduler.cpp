@@ -0,0 +1,214 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    WorkStealingScheduler.cpp
+ * @brief   Runs dynamically spawned tasks on worker threads that steal from each other
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/base/WorkStealingScheduler.h>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  void WorkStealingScheduler::Worker::spawn(size_t task)
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      // Every task is spawned once, so the deque never holds more than the capacity set by run()
+      assert(tail_ < tasks_.size());
+      tasks_[tail_++] = task;
+    }
+    // A worker that went to sleep before the task was added has counted itself as sleeping
+    // before it last looked at this deque
+    if(scheduler_.sleeping_ > 0)
+      scheduler_.wake(false);
+  }
+
+  /* ************************************************************************* */
+  bool WorkStealingScheduler::Worker::pop(size_t& task)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if(head_ == tail_)
+      return false;
+    task = tasks_[--tail_];
+    if(head_ == tail_)
+      head_ = tail_ = 0;
+    return true;
+  }
+
+  /* ************************************************************************* */
+  bool WorkStealingScheduler::Worker::steal(size_t& task)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if(head_ == tail_)
+      return false;
+    task = tasks_[head_++];
+    if(head_ == tail_)
+      head_ = tail_ = 0;
+    return true;
+  }
+
+  /* ************************************************************************* */
+  bool WorkStealingScheduler::Worker::empty()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    return head_ == tail_;
+  }
+
+  /* ************************************************************************* */
+  WorkStealingScheduler::WorkStealingScheduler(size_t nThreads) :
+    remaining_(0), aborted_(false), generation_(0), body_(0), running_(0), stopping_(false),
+    sleeping_(0)
+  {
+    if(nThreads == 0)
+      nThreads = std::max(1u, boost::thread::hardware_concurrency());
+    workers_.reserve(nThreads);
+    for(size_t id = 0; id < nThreads; ++id)
+      workers_.push_back(boost::shared_ptr<Worker>(new Worker(id, *this)));
+    for(size_t id = 1; id < nThreads; ++id)
+      threads_.create_thread(boost::bind(&WorkStealingScheduler::threadLoop, this, id));
+  }
+
+  /* ************************************************************************* */
+  WorkStealingScheduler::~WorkStealingScheduler()
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      stopping_ = true;
+    }
+    started_.notify_all();
+    threads_.join_all();
+  }
+
+  /* ************************************************************************* */
+  void WorkStealingScheduler::run(size_t nTasks, const FastVector<size_t>& initialTasks, Body& body)
+  {
+    if(nTasks == 0)
+      return;
+
+    // Deal the initial tasks out to the workers, whose deques can hold every task
+    BOOST_FOREACH(const boost::shared_ptr<Worker>& worker, workers_) {
+      if(worker->tasks_.size() < nTasks)
+        worker->tasks_.resize(nTasks);
+      worker->head_ = worker->tail_ = 0;
+    }
+    for(size_t i = 0; i < initialTasks.size(); ++i)
+      workers_[i % workers_.size()]->spawn(initialTasks[i]);
+
+    remaining_ = nTasks;
+    aborted_ = false;
+    exception_ = boost::exception_ptr();
+
+    if(workers_.size() == 1 || nTasks == 1) {
+      work(0, body);
+    } else {
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        body_ = &body;
+        running_ = workers_.size() - 1;
+        ++ generation_;
+      }
+      started_.notify_all();
+      work(0, body);
+      // The tasks are done, but the other workers may still be leaving the run
+      boost::mutex::scoped_lock lock(mutex_);
+      while(running_ > 0)
+        finished_.wait(lock);
+      body_ = 0;
+    }
+
+    if(exception_)
+      boost::rethrow_exception(exception_);
+  }
+
+  /* ************************************************************************* */
+  void WorkStealingScheduler::threadLoop(size_t id)
+  {
+    size_t generation = 0;
+    while(true) {
+      Body* body;
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        while(!stopping_ && generation_ == generation)
+          started_.wait(lock);
+        if(stopping_)
+          return;
+        generation = generation_;
+        body = body_;
+      }
+      work(id, *body);
+      boost::mutex::scoped_lock lock(mutex_);
+      if(--running_ == 0)
+        finished_.notify_one();
+    }
+  }
+
+  /* ************************************************************************* */
+  void WorkStealingScheduler::work(size_t id, Body& body)
+  {
+    Worker& worker = *workers_[id];
+    const size_t n = workers_.size();
+    size_t task;
+    while(!over()) {
+      bool found = worker.pop(task);
+      for(size_t k = 1; !found && k < n; ++k)
+        found = workers_[(id + k) % n]->steal(task);
+      if(!found) {
+        // Tasks are still running elsewhere and may spawn more.  Counting this worker as sleeping
+        // before looking at the deques again means that a task spawned after the look wakes it.
+        boost::mutex::scoped_lock lock(mutex_);
+        ++ sleeping_;
+        while(!over()) {
+          bool empty = true;
+          for(size_t k = 0; empty && k < n; ++k)
+            empty = workers_[k]->empty();
+          if(!empty)
+            break;
+          ready_.wait(lock);
+        }
+        -- sleeping_;
+        continue;
+      }
+      try {
+        body(task, worker);
+      } catch(...) {
+        boost::mutex::scoped_lock lock(exceptionMutex_);
+        if(!exception_)
+          exception_ = boost::current_exception();
+        aborted_ = true;
+      }
+      if(--remaining_ == 0 || aborted_)
+        wake(true);
+    }
+  }
+
+  /* ************************************************************************* */
+  void WorkStealingScheduler::wake(bool all)
+  {
+    // Locking makes the wake-up wait for a worker between looking for tasks and sleeping
+    boost::mutex::scoped_lock lock(mutex_);
+    if(all)
+      ready_.notify_all();
+    else
+      ready_.notify_one();
+  }
+
+}
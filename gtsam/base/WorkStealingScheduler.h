@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    WorkStealingScheduler.h
+ * @brief   Runs dynamically spawned tasks on worker threads that steal from each other
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/dllexport.h>
+
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * A work-stealing scheduler built on boost::thread, so that tree-shaped computations run in
+   * parallel also when GTSAM is built without TBB.  Tasks are numbers from 0 to nTasks-1, and the
+   * work is done by a Body, which may spawn the tasks enabled by the one it has just run, e.g.
+   * the children of a clique once the clique is solved.  Every worker keeps its own deque of
+   * tasks: it runs the task it spawned last, for locality, and when it runs out it steals the
+   * oldest task of another worker, which is usually the root of a large subtree.
+   *
+   * The deques are allocated for nTasks tasks up front and kept between runs, so nothing is
+   * allocated per task.  The calling thread is worker 0, and the other workers are threads started
+   * by the constructor and joined by the destructor, which sleep between runs.  Within a run, a
+   * worker that finds no task to run or steal sleeps until a task is spawned or the run ends.  An
+   * exception thrown by the Body stops all workers and is rethrown by run().  A scheduler runs one
+   * set of tasks at a time, so run() must not be called concurrently or from a Body.
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT WorkStealingScheduler {
+  public:
+
+    /** A worker thread and its deque of tasks */
+    class GTSAM_EXPORT Worker {
+    public:
+      /** Number of the worker, from 0 to nThreads()-1, e.g. to index per-thread storage */
+      size_t id() const { return id_; }
+
+      /** Add a task to the deque of this worker, to be run by it unless another one steals it */
+      void spawn(size_t task);
+
+    private:
+      size_t id_;
+      WorkStealingScheduler& scheduler_;
+      boost::mutex mutex_;
+      FastVector<size_t> tasks_; ///< deque, stolen from at head_ and run by the owner at tail_
+      size_t head_, tail_;
+
+      Worker(size_t id, WorkStealingScheduler& scheduler) :
+        id_(id), scheduler_(scheduler), head_(0), tail_(0) {}
+      bool pop(size_t& task);
+      bool empty();
+      bool steal(size_t& task);
+      friend class WorkStealingScheduler;
+    };
+
+    /** The work of the tasks */
+    class Body {
+    public:
+      virtual ~Body() {}
+
+      /** Run \c task on \c worker, spawning the tasks that it enables with worker.spawn().  Called
+       *  concurrently from all workers. */
+      virtual void operator()(size_t task, Worker& worker) = 0;
+    };
+
+    /** Create a scheduler with \c nThreads workers, by default one per hardware thread */
+    explicit WorkStealingScheduler(size_t nThreads = 0);
+
+    /** Stop and join the worker threads */
+    ~WorkStealingScheduler();
+
+    /** Number of workers, including the calling thread */
+    size_t nThreads() const { return workers_.size(); }
+
+    /**
+     * Run \c initialTasks and all the tasks that they spawn, returning once \c nTasks tasks have
+     * been run.  Every task must be spawned exactly once, and nTasks must be the total number.
+     */
+    void run(size_t nTasks, const FastVector<size_t>& initialTasks, Body& body);
+
+  private:
+    std::vector<boost::shared_ptr<Worker> > workers_;
+    boost::atomic<size_t> remaining_; ///< tasks not yet run
+    boost::atomic<bool> aborted_;     ///< set when a task throws
+    boost::mutex exceptionMutex_;
+    boost::exception_ptr exception_;  ///< the first exception thrown by a task
+
+    boost::thread_group threads_;     ///< workers 1 to nThreads()-1
+    boost::mutex mutex_;              ///< guards the members below and the sleep of workers
+    boost::condition_variable started_;  ///< signalled when a run starts or the scheduler stops
+    boost::condition_variable finished_; ///< signalled when the last worker thread leaves a run
+    boost::condition_variable ready_;    ///< signalled when a task is spawned or a run ends
+    size_t generation_;               ///< number of runs started
+    Body* body_;                      ///< the body of the current run
+    size_t running_;                  ///< worker threads that have not left the current run
+    bool stopping_;
+    boost::atomic<size_t> sleeping_;  ///< workers waiting for a task in the current run
+
+    /** The loop of the worker thread \c id, running every run until the scheduler stops */
+    void threadLoop(size_t id);
+
+    /** Run tasks on one worker until all are done */
+    void work(size_t id, Body& body);
+
+    /** Whether the current run is over, all tasks having run or one having thrown */
+    bool over() const { return remaining_ == 0 || aborted_; }
+
+    /** Wake the workers waiting for a task, all of them when the run is over */
+    void wake(bool all);
+
+    // Not copyable, the workers refer to the scheduler's state
+    WorkStealingScheduler(const WorkStealingScheduler&);
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&);
+  };
+
+}
@@ -0,0 +1,247 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    batchedNumericalDerivative.h
+ * @brief   Numerical derivatives with fixed-size results, evaluating all perturbations in one batch
+ * @date    October 19, 2026
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+#include <boost/array.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+namespace gtsam {
+
+  /*
+   * The functions in this file compute the same central differences as numericalDerivative11 and
+   * friends, but
+   *  - the sizes are known at compile time, from the static \c dimension of geometry types or the
+   *    size of fixed-size Eigen vectors, so the Jacobian is a fixed-size Eigen matrix;
+   *  - the function is any functor, called directly rather than through a boost::function;
+   *  - the 2n perturbed arguments are built first and then evaluated as one batch: by the
+   *    caller's own vectorized code (numericalDerivativeBatch), one after the other
+   *    (numericalDerivativeFixed11...), or in parallel when GTSAM is built with TBB
+   *    (numericalDerivativeParallel11...), which pays off for expensive functions.
+   *
+   * Since functors have no usable result type in C++03, the result type Y and the argument types
+   * are given explicitly, as for numericalDerivative11:
+   * \code
+   *   Eigen::Matrix<double, 2, 6> H = numericalDerivativeFixed21<Point2, Pose3, Point3>(project, pose, point);
+   * \endcode
+   */
+
+  namespace internal {
+
+    /**
+     * Compile-time dimension, retraction, and local coordinates of the arguments and results of
+     * numerically differentiated functions.  The default is for geometry types with a static
+     * dimension, retract and localCoordinates.
+     */
+    template<class T>
+    struct NumericalTraits {
+      enum { dimension = T::dimension };
+      typedef Eigen::Matrix<double, dimension, 1> TangentVector;
+      typedef Vector Increment; ///< retract takes a Vector, so the increment is allocated once
+      static T Retract(const T& x, const Increment& d) { return x.retract(d); }
+      static TangentVector Local(const T& origin, const T& y) { return origin.localCoordinates(y); }
+    };
+
+    /** Fixed-size Eigen vectors, which are their own local coordinates */
+    template<int N>
+    struct NumericalTraits<Eigen::Matrix<double, N, 1> > {
+      enum { dimension = N };
+      typedef Eigen::Matrix<double, N, 1> TangentVector;
+      typedef TangentVector Increment;
+      static TangentVector Retract(const TangentVector& x, const TangentVector& d) { return x + d; }
+      static TangentVector Local(const TangentVector& origin, const TangentVector& y) { return y - origin; }
+    };
+
+    /** Scalars */
+    template<>
+    struct NumericalTraits<double> {
+      enum { dimension = 1 };
+      typedef Eigen::Matrix<double, 1, 1> TangentVector;
+      typedef TangentVector Increment;
+      static double Retract(double x, const Increment& d) { return x + d(0); }
+      static TangentVector Local(double origin, double y) { return TangentVector::Constant(y - origin); }
+    };
+
+    /** Evaluates a pointwise function on a batch of arguments, one after the other */
+    template<class Y, class X, class FUNCTOR>
+    struct SerialBatch {
+      const FUNCTOR& h;
+      SerialBatch(const FUNCTOR& h) : h(h) {}
+      void operator()(const X* xs, Y* ys, size_t count) const {
+        for (size_t i = 0; i < count; ++i)
+          ys[i] = h(xs[i]);
+      }
+    };
+
+    /** Evaluates a pointwise function on a batch of arguments in parallel, when TBB is available */
+    template<class Y, class X, class FUNCTOR>
+    struct ParallelBatch {
+      const FUNCTOR& h;
+      ParallelBatch(const FUNCTOR& h) : h(h) {}
+
+#ifdef GTSAM_USE_TBB
+      struct Evaluate {
+        const FUNCTOR& h;
+        const X* xs;
+        Y* ys;
+        Evaluate(const FUNCTOR& h, const X* xs, Y* ys) : h(h), xs(xs), ys(ys) {}
+        void operator()(const tbb::blocked_range<size_t>& r) const {
+          for (size_t i = r.begin(); i != r.end(); ++i)
+            ys[i] = h(xs[i]);
+        }
+      };
+#endif
+
+      void operator()(const X* xs, Y* ys, size_t count) const {
+#ifdef GTSAM_USE_TBB
+        // One perturbation per task: this is meant for functions that are expensive to evaluate
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 1), Evaluate(h, xs, ys));
+#else
+        const SerialBatch<Y, X, FUNCTOR> serial(h);
+        serial(xs, ys, count);
+#endif
+      }
+    };
+
+    /** A binary function of its first argument, the second held fixed */
+    template<class Y, class X1, class X2, class FUNCTOR>
+    struct BindSecond {
+      const FUNCTOR& h;
+      const X2& x2;
+      BindSecond(const FUNCTOR& h, const X2& x2) : h(h), x2(x2) {}
+      Y operator()(const X1& x1) const { return h(x1, x2); }
+    };
+
+    /** A binary function of its second argument, the first held fixed */
+    template<class Y, class X1, class X2, class FUNCTOR>
+    struct BindFirst {
+      const FUNCTOR& h;
+      const X1& x1;
+      BindFirst(const FUNCTOR& h, const X1& x1) : h(h), x1(x1) {}
+      Y operator()(const X2& x2) const { return h(x1, x2); }
+    };
+
+  } // namespace internal
+
+  /**
+   * Compute the numerical derivative of a function evaluated on a batch of arguments at once.
+   * The function value at x and the 2n central-difference perturbations of x are evaluated in a
+   * single call
+   * \code
+   *   h(const X* xs, Y* ys, size_t count)
+   * \endcode
+   * which fills ys[i] with the value at xs[i], for i < count = 2n+1, and is free to share work
+   * between the arguments or vectorize across them.  xs[0] is x itself, and xs[2j+1] and
+   * xs[2j+2] are x retracted by plus and minus delta along coordinate j.
+   * @param h batched function, see above
+   * @param x n-dimensional value at which to evaluate h
+   * @param delta increment for numerical derivative
+   * Class Y is the output argument, class X the input argument: both are either geometry types
+   * with a static dimension, fixed-size Eigen vectors, or double.
+   * @return m*n Jacobian computed via central differencing, of fixed size
+   */
+  template<class Y, class X, class BATCH>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X>::dimension>
+  numericalDerivativeBatch(const BATCH& h, const X& x, double delta = 1e-5) {
+    typedef internal::NumericalTraits<X> TraitsX;
+    typedef internal::NumericalTraits<Y> TraitsY;
+    enum { M = TraitsY::dimension, N = TraitsX::dimension, COUNT = 2 * N + 1 };
+
+    boost::array<X, COUNT> xs;
+    boost::array<Y, COUNT> ys;
+    xs[0] = x;
+    typename TraitsX::Increment d = TraitsX::Increment::Zero(N);
+    for (int j = 0; j < N; ++j) {
+      d(j) = delta;  xs[2 * j + 1] = TraitsX::Retract(x, d);
+      d(j) = -delta; xs[2 * j + 2] = TraitsX::Retract(x, d);
+      d(j) = 0.0;
+    }
+
+    h(xs.data(), ys.data(), size_t(COUNT));
+
+    const double factor = 1.0 / (2.0 * delta);
+    Eigen::Matrix<double, M, N> H;
+    for (int j = 0; j < N; ++j)
+      H.col(j) = factor * (TraitsY::Local(ys[0], ys[2 * j + 1]) - TraitsY::Local(ys[0], ys[2 * j + 2]));
+    return H;
+  }
+
+  /**
+   * Compute numerical derivative in argument 1 of unary function, with fixed-size result
+   * @param h any functor or function pointer, called as h(x) and returning Y
+   * @param x n-dimensional value at which to evaluate h
+   * @param delta increment for numerical derivative
+   * @return m*n Jacobian computed via central differencing
+   */
+  template<class Y, class X, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X>::dimension>
+  numericalDerivativeFixed11(const FUNCTOR& h, const X& x, double delta = 1e-5) {
+    return numericalDerivativeBatch<Y, X>(internal::SerialBatch<Y, X, FUNCTOR>(h), x, delta);
+  }
+
+  /** Compute numerical derivative in argument 1 of binary function, with fixed-size result */
+  template<class Y, class X1, class X2, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X1>::dimension>
+  numericalDerivativeFixed21(const FUNCTOR& h, const X1& x1, const X2& x2, double delta = 1e-5) {
+    typedef internal::BindSecond<Y, X1, X2, FUNCTOR> Unary;
+    return numericalDerivativeFixed11<Y, X1>(Unary(h, x2), x1, delta);
+  }
+
+  /** Compute numerical derivative in argument 2 of binary function, with fixed-size result */
+  template<class Y, class X1, class X2, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X2>::dimension>
+  numericalDerivativeFixed22(const FUNCTOR& h, const X1& x1, const X2& x2, double delta = 1e-5) {
+    typedef internal::BindFirst<Y, X1, X2, FUNCTOR> Unary;
+    return numericalDerivativeFixed11<Y, X2>(Unary(h, x1), x2, delta);
+  }
+
+  /**
+   * Compute numerical derivative in argument 1 of unary function, evaluating the perturbations
+   * in parallel when GTSAM is built with TBB, and one after the other otherwise.  h is called
+   * concurrently, so it must be thread-safe.  Only worth it when h is expensive.
+   */
+  template<class Y, class X, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X>::dimension>
+  numericalDerivativeParallel11(const FUNCTOR& h, const X& x, double delta = 1e-5) {
+    return numericalDerivativeBatch<Y, X>(internal::ParallelBatch<Y, X, FUNCTOR>(h), x, delta);
+  }
+
+  /** Compute numerical derivative in argument 1 of binary function in parallel, see numericalDerivativeParallel11 */
+  template<class Y, class X1, class X2, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X1>::dimension>
+  numericalDerivativeParallel21(const FUNCTOR& h, const X1& x1, const X2& x2, double delta = 1e-5) {
+    typedef internal::BindSecond<Y, X1, X2, FUNCTOR> Unary;
+    return numericalDerivativeParallel11<Y, X1>(Unary(h, x2), x1, delta);
+  }
+
+  /** Compute numerical derivative in argument 2 of binary function in parallel, see numericalDerivativeParallel11 */
+  template<class Y, class X1, class X2, class FUNCTOR>
+  Eigen::Matrix<double, internal::NumericalTraits<Y>::dimension, internal::NumericalTraits<X2>::dimension>
+  numericalDerivativeParallel22(const FUNCTOR& h, const X1& x1, const X2& x2, double delta = 1e-5) {
+    typedef internal::BindFirst<Y, X1, X2, FUNCTOR> Unary;
+    return numericalDerivativeParallel11<Y, X2>(Unary(h, x1), x2, delta);
+  }
+
+} // namespace gtsam
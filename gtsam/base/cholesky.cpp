@@ -23,6 +23,11 @@
 #include <boost/format.hpp>
 #include <cmath>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -32,6 +37,10 @@ namespace gtsam {
   static const double underconstrainedPrior = 1e-5;
   static const int underconstrainedExponentDifference = 12;
 
+  // Frontal size from which choleskyPartial uses the tiled kernel, and its tile size
+  static const size_t choleskyTiledThreshold = 128;
+  static const DenseIndex choleskyTileSize = 64;
+
 /* ************************************************************************* */
 static inline int choleskyStep(Matrix& ATA, size_t k, size_t order) {
 
@@ -118,30 +127,54 @@ pair<size_t,bool> choleskyCareful(Matrix& ATA, int order) {
 }
 
 /* ************************************************************************* */
-bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
+namespace {
 
-  gttic(choleskyPartial);
+/* ************************************************************************* */
+// Partial Cholesky for N frontal dimensions, N known at compile time so that
+// the factorization of A and the solve for S are unrolled
+template<int N>
+bool choleskyPartialFixed(Matrix& ABC) {
+  const DenseIndex n = ABC.rows();
+
+  // Right-looking Cholesky of A, on the upper triangle.  Pivots are checked
+  // as in Eigen's LLT.
+  Eigen::Matrix<double, N, N> R = ABC.topLeftCorner(N, N);
+  for (int k = 0; k < N; ++k) {
+    const double alpha = R(k, k);
+    if (!(alpha > 0.0))
+      return false;
+    const double beta = sqrt(alpha);
+    R(k, k) = beta;
+    for (int j = k + 1; j < N; ++j)
+      R(k, j) /= beta;
+    for (int i = k + 1; i < N; ++i)
+      for (int j = i; j < N; ++j)
+        R(i, j) -= R(k, i) * R(k, j);
+  }
+  ABC.topLeftCorner(N, N).triangularView<Eigen::Upper>() = R;
 
-  const bool debug = ISDEBUG("choleskyPartial");
+  // S = inv(R') * B and L = C - S' * S
+  if (n > N) {
+    Eigen::Block<Matrix, N, Eigen::Dynamic> S(ABC, 0, N, N, n - N);
+    R.template triangularView<Eigen::Upper>().transpose().solveInPlace(S);
+    ABC.bottomRightCorner(n - N, n - N).selfadjointView<Eigen::Upper>().rankUpdate(S.transpose(), -1.0);
+  }
+  return true;
+}
 
-  assert(ABC.rows() == ABC.cols());
-  assert(ABC.rows() >= 0 && nFrontal <= size_t(ABC.rows()));
+/* ************************************************************************* */
+// Partial Cholesky with Eigen's LLT on A, a triangular solve for S, and a rank
+// update for L
+bool choleskyPartialGeneric(Matrix& ABC, size_t nFrontal) {
+
+  const bool debug = ISDEBUG("choleskyPartial");
 
   const size_t n = ABC.rows();
 
   // Compute Cholesky factorization of A, overwrites A.
   gttic(lld);
-  Eigen::ComputationInfo lltResult;
-  if(nFrontal > 0)
-  {
-    Eigen::LLT<Matrix, Eigen::Upper> llt = ABC.block(0, 0, nFrontal, nFrontal).selfadjointView<Eigen::Upper>().llt();
-    ABC.block(0, 0, nFrontal, nFrontal).triangularView<Eigen::Upper>() = llt.matrixU();
-    lltResult = llt.info();
-  }
-  else
-  {
-    lltResult = Eigen::Success;
-  }
+  Eigen::LLT<Matrix, Eigen::Upper> llt = ABC.block(0, 0, nFrontal, nFrontal).selfadjointView<Eigen::Upper>().llt();
+  ABC.block(0, 0, nFrontal, nFrontal).triangularView<Eigen::Upper>() = llt.matrixU();
   gttoc(lld);
 
   if(debug) cout << "R:\n" << Eigen::MatrixXd(ABC.topLeftCorner(nFrontal,nFrontal).triangularView<Eigen::Upper>()) << endl;
@@ -164,9 +197,112 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
   if(debug) cout << "L:\n" << Eigen::MatrixXd(ABC.bottomRightCorner(n-nFrontal,n-nFrontal).selfadjointView<Eigen::Upper>()) << endl;
   gttoc(compute_L);
 
+  return llt.info() == Eigen::Success;
+}
+
+/* ************************************************************************* */
+// One step of the tiled Cholesky: given the factored diagonal tile at k of
+// size kb, solve the tiles of the row panel to its right, then update the
+// tiles of the trailing upper triangle, column tile by column tile.
+struct _TiledPanelSolve {
+  Matrix& ABC;
+  const DenseIndex k, kb;
+  _TiledPanelSolve(Matrix& ABC, DenseIndex k, DenseIndex kb) : ABC(ABC), k(k), kb(kb) {}
+  void tile(DenseIndex t) const {
+    const DenseIndex c = k + kb + t * choleskyTileSize;
+    const DenseIndex cb = std::min(choleskyTileSize, DenseIndex(ABC.cols()) - c);
+    ABC.block(k, k, kb, kb).triangularView<Eigen::Upper>().transpose().solveInPlace(ABC.block(k, c, kb, cb));
+  }
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<DenseIndex>& r) const {
+    for (DenseIndex t = r.begin(); t != r.end(); ++t)
+      tile(t);
+  }
+#endif
+};
+
+struct _TiledTrailingUpdate {
+  Matrix& ABC;
+  const DenseIndex k, kb;
+  _TiledTrailingUpdate(Matrix& ABC, DenseIndex k, DenseIndex kb) : ABC(ABC), k(k), kb(kb) {}
+  void tile(DenseIndex t) const {
+    const DenseIndex next = k + kb, c = next + t * choleskyTileSize;
+    const DenseIndex cb = std::min(choleskyTileSize, DenseIndex(ABC.cols()) - c);
+    // Tiles above the diagonal with a product, the diagonal tile with a rank update
+    if (c > next)
+      ABC.block(next, c, c - next, cb).noalias() -=
+          ABC.block(k, next, kb, c - next).transpose() * ABC.block(k, c, kb, cb);
+    ABC.block(c, c, cb, cb).selfadjointView<Eigen::Upper>().rankUpdate(
+        ABC.block(k, c, kb, cb).transpose(), -1.0);
+  }
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<DenseIndex>& r) const {
+    for (DenseIndex t = r.begin(); t != r.end(); ++t)
+      tile(t);
+  }
+#endif
+};
+
+/* ************************************************************************* */
+// Tiled right-looking partial Cholesky for large frontal blocks, such as
+// root cliques, with the tiles of each step processed in parallel with TBB
+bool choleskyPartialTiled(Matrix& ABC, size_t nFrontal) {
+  const DenseIndex n = ABC.rows();
+  for (DenseIndex k = 0; k < DenseIndex(nFrontal); k += choleskyTileSize) {
+    const DenseIndex kb = std::min(choleskyTileSize, DenseIndex(nFrontal) - k);
+    Eigen::Block<Matrix> diagonal = ABC.block(k, k, kb, kb);
+    if (Eigen::internal::llt_inplace<double, Eigen::Upper>::blocked(diagonal) >= 0)
+      return false;
+
+    const DenseIndex tiles = (n - k - kb + choleskyTileSize - 1) / choleskyTileSize;
+    const _TiledPanelSolve panelSolve(ABC, k, kb);
+    const _TiledTrailingUpdate trailingUpdate(ABC, k, kb);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<DenseIndex>(0, tiles, 1), panelSolve);
+    tbb::parallel_for(tbb::blocked_range<DenseIndex>(0, tiles, 1), trailingUpdate);
+#else
+    for (DenseIndex t = 0; t < tiles; ++t)
+      panelSolve.tile(t);
+    for (DenseIndex t = 0; t < tiles; ++t)
+      trailingUpdate.tile(t);
+#endif
+  }
+  return true;
+}
+
+}
+
+/* ************************************************************************* */
+bool choleskyPartial(Matrix& ABC, size_t nFrontal) {
+
+  gttic(choleskyPartial);
+
+  assert(ABC.rows() == ABC.cols());
+  assert(ABC.rows() >= 0 && nFrontal <= size_t(ABC.rows()));
+
+  // Choose the kernel by the size of the frontal block: unrolled for the sizes
+  // of common variables such as poses, tiled for large root cliques
+  bool factored;
+  switch (nFrontal) {
+  case 0: factored = true; break;
+  case 1: factored = choleskyPartialFixed<1>(ABC); break;
+  case 2: factored = choleskyPartialFixed<2>(ABC); break;
+  case 3: factored = choleskyPartialFixed<3>(ABC); break;
+  case 4: factored = choleskyPartialFixed<4>(ABC); break;
+  case 5: factored = choleskyPartialFixed<5>(ABC); break;
+  case 6: factored = choleskyPartialFixed<6>(ABC); break;
+  default:
+    if (nFrontal >= choleskyTiledThreshold) {
+      gttic(tiled);
+      factored = choleskyPartialTiled(ABC, nFrontal);
+    } else {
+      factored = choleskyPartialGeneric(ABC, nFrontal);
+    }
+  }
+
   // Check last diagonal element - Eigen does not check it
   bool ok;
-  if(lltResult == Eigen::Success) {
+  if(factored) {
     if(nFrontal >= 2) {
       int exp2, exp1;
       (void)frexp(ABC(nFrontal-2, nFrontal-2), &exp2);
@@ -0,0 +1,94 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBatchedNumericalDerivative.cpp
+ * @date    October 19, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam/base/batchedNumericalDerivative.h>
+#include <gtsam/base/numericalDerivative.h>
+
+using namespace gtsam;
+
+typedef Eigen::Matrix<double, 2, 1> Vector2d;
+typedef Eigen::Matrix<double, 3, 1> Vector3d;
+
+/* ************************************************************************* */
+Vector3d h(const Vector2d& x) {
+  return Vector3d(sin(x(0)) * x(1), exp(x(1)), x(0) * x(0));
+}
+
+LieVector hLie(const LieVector& x) {
+  return LieVector((Vector) h(x));
+}
+
+/* ************************************************************************* */
+TEST(BatchedNumericalDerivative, Fixed11) {
+  const Vector2d x(0.3, -1.2);
+  const Eigen::Matrix<double, 3, 2> actual = numericalDerivativeFixed11<Vector3d, Vector2d>(h, x);
+  Matrix expected = (Matrix(3, 2) <<
+      cos(x(0)) * x(1), sin(x(0)),
+      0.0,              exp(x(1)),
+      2.0 * x(0),       0.0);
+  EXPECT(assert_equal(expected, Matrix(actual), 1e-8));
+  EXPECT(assert_equal(numericalDerivative11(hLie, LieVector((Vector) x)), Matrix(actual), 1e-12));
+}
+
+/* ************************************************************************* */
+// A vectorized batch: all perturbations are evaluated together, as one 2*5 matrix expression
+struct BatchedH {
+  mutable size_t calls;
+  BatchedH() : calls(0) {}
+  void operator()(const Vector2d* xs, Vector3d* ys, size_t count) const {
+    ++calls;
+    Eigen::Map<const Eigen::Matrix<double, 2, Eigen::Dynamic> > X(xs[0].data(), 2, count);
+    Eigen::Map<Eigen::Matrix<double, 3, Eigen::Dynamic> > Y(ys[0].data(), 3, count);
+    Y.row(0) = X.row(0).array().sin() * X.row(1).array();
+    Y.row(1) = X.row(1).array().exp();
+    Y.row(2) = X.row(0).array().square();
+  }
+};
+
+TEST(BatchedNumericalDerivative, Batch) {
+  const Vector2d x(0.3, -1.2);
+  const BatchedH batched;
+  const Eigen::Matrix<double, 3, 2> actual = numericalDerivativeBatch<Vector3d, Vector2d>(batched, x);
+  EXPECT_LONGS_EQUAL(1, batched.calls);
+  EXPECT(assert_equal(Matrix(numericalDerivativeFixed11<Vector3d, Vector2d>(h, x)), Matrix(actual), 1e-12));
+}
+
+/* ************************************************************************* */
+double f(const Vector2d& x, double y) {
+  return sin(x(0)) + cos(x(1)) * y;
+}
+
+TEST(BatchedNumericalDerivative, Scalar) {
+  const Vector2d x(0.3, -1.2);
+  const double y = 2.0;
+  const Eigen::Matrix<double, 1, 2> H1 = numericalDerivativeFixed21<double, Vector2d, double>(f, x, y);
+  const Eigen::Matrix<double, 1, 1> H2 = numericalDerivativeFixed22<double, Vector2d, double>(f, x, y);
+  EXPECT_DOUBLES_EQUAL(cos(x(0)), H1(0), 1e-8);
+  EXPECT_DOUBLES_EQUAL(-sin(x(1)) * y, H1(1), 1e-8);
+  EXPECT_DOUBLES_EQUAL(cos(x(1)), H2(0), 1e-8);
+
+  // Without TBB the parallel versions fall back to the serial ones
+  EXPECT(assert_equal(Matrix(H1),
+      Matrix(numericalDerivativeParallel21<double, Vector2d, double>(f, x, y)), 1e-12));
+  EXPECT(assert_equal(Matrix(H2),
+      Matrix(numericalDerivativeParallel22<double, Vector2d, double>(f, x, y)), 1e-12));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
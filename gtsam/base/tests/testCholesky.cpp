@@ -53,6 +53,34 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialKernels) {
+  // Frontal sizes taking the unrolled, generic, and tiled kernels, the last
+  // with a partial tile
+  const size_t sizes[] = { 1, 3, 6, 7, 20, 150 };
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    const size_t nFrontal = sizes[s], nSeparator = 10, n = nFrontal + nSeparator;
+    const Matrix M = Matrix::Random(n + 3, n);
+    const Matrix ABC = M.transpose() * M;
+
+    Matrix RSL(ABC);
+    EXPECT(choleskyPartial(RSL, nFrontal));
+
+    // The same decomposition as above, from the upper triangle
+    Matrix R2 = RSL.triangularView<Eigen::Upper>();
+    R2.bottomRightCorner(nSeparator, nSeparator) =
+        R2.bottomRightCorner(nSeparator, nSeparator).selfadjointView<Eigen::Upper>();
+    Matrix R1 = Matrix(RSL.triangularView<Eigen::Upper>()).transpose();
+    R1.bottomRightCorner(nSeparator, nSeparator).setIdentity();
+    EXPECT(assert_equal(ABC, Matrix(R1 * R2), 1e-8));
+
+    // A negative pivot is detected by every kernel
+    Matrix indefinite(ABC);
+    indefinite(nFrontal - 1, nFrontal - 1) = -1.0;
+    EXPECT(!choleskyPartial(indefinite, nFrontal));
+  }
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
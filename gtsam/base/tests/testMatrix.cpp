@@ -894,6 +894,46 @@ TEST( matrix, eigen_QR )
   EXPECT(assert_equal(expected, A, 1e-3));
 }
 
+/* ************************************************************************* */
+TEST( matrix, inplace_QR_staircase )
+{
+  // Stacked rows of factors on 2-dimensional variables, out of order, with a
+  // zero row, and a separator column no row starts at
+  Matrix A = (Matrix(10, 7) <<
+      0,  0,  3, -1,  0,  2,  1,
+      2, -1,  0,  0,  1,  0,  4,
+      0,  0,  0,  0,  0,  5, -2,
+      1,  3,  0,  0,  0,  0,  1,
+      0,  0,  0,  0,  0,  0,  0,
+      0,  0,  1,  4,  2,  0, -3,
+      0,  2,  1,  0,  0,  0,  2,
+      0,  0,  0,  0,  3,  1,  1,
+      0,  0,  2,  2,  0,  0,  5,
+      0,  0,  0,  0,  1, -1,  0);
+
+  Matrix expected = A;
+  inplace_QR(expected);
+
+  // Panels of 1, 2 and 3 columns, and one panel for all
+  for (DenseIndex blockSize = 1; blockSize <= 8; blockSize += (blockSize < 3 ? 1 : 5)) {
+    Matrix actual = A;
+    inplace_QR_staircase(actual, blockSize);
+    EXPECT(assert_equal(Matrix(actual.triangularView<Eigen::Upper>()), actual));
+    // R is unique up to the signs of its rows
+    EXPECT(assert_equal(Matrix(expected.transpose() * expected),
+        Matrix(actual.transpose() * actual), 1e-9));
+    EXPECT(assert_equal(Vector(expected.diagonal().cwiseAbs()),
+        Vector(actual.diagonal().cwiseAbs()), 1e-9));
+  }
+
+  // Already sorted, and wider than tall
+  Matrix B = A.topRows(4).rightCols(5);
+  expected = B;
+  inplace_QR(expected);
+  inplace_QR_staircase(B);
+  EXPECT(assert_equal(Matrix(expected.transpose() * expected), Matrix(B.transpose() * B), 1e-9));
+}
+
 /* ************************************************************************* */
 // unit test for qr factorization (and hence householder)
 // This behaves the same as QR in matlab: [Q,R] = qr(A), except for signs
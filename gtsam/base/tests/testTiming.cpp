@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTiming.cpp
+ * @brief   Unit tests for the per-thread timing trees
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/base/timing.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/foreach.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+static void work(size_t n) {
+  gttic_(timingTestWork);
+  for (size_t i = 0; i < n; ++i) {
+    gttic_(timingTestInner);
+  }
+}
+
+/* ************************************************************************* */
+TEST( timing, threads ) {
+  tictoc_reset_();
+  tictoc_setTraceCapacity_(2);
+
+  work(3);
+  std::vector<boost::shared_ptr<boost::thread> > threads;
+  for (size_t t = 0; t < 3; ++t)
+    threads.push_back(boost::shared_ptr<boost::thread>(new boost::thread(work, 3)));
+  BOOST_FOREACH(const boost::shared_ptr<boost::thread>& thread, threads)
+    thread->join();
+
+  // Sections of all four threads are merged by call path
+  stringstream json;
+  tictoc_printJson_(json);
+  EXPECT(json.str().find("\"label\": \"timingTestWork\", \"count\": 4,") != string::npos);
+  EXPECT(json.str().find("\"label\": \"timingTestInner\", \"count\": 12,") != string::npos);
+  EXPECT(json.str().find("\"threads\": 4") != string::npos);
+
+  // The last two sections of each thread
+  stringstream trace;
+  tictoc_printChromeTrace_(trace);
+  size_t events = 0;
+  for (size_t pos = trace.str().find("\"ph\": \"X\""); pos != string::npos;
+      pos = trace.str().find("\"ph\": \"X\"", pos + 1))
+    ++events;
+  LONGS_EQUAL(8, (long)events);
+
+  tictoc_setTraceCapacity_(0);
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+static void mismatched() {
+  gtsam::internal::profileTic(gtsam::internal::getTicTocID("timingTestA"), "timingTestA");
+  gtsam::internal::profileToc(gtsam::internal::getTicTocID("timingTestB"), "timingTestB");
+}
+
+TEST( timing, mismatch ) {
+  tictoc_reset_();
+  CHECK_EXCEPTION(mismatched(), std::invalid_argument);
+  tictoc_reset_();
+  CHECK_EXCEPTION(gtsam::internal::profileToc(0, "Total"), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
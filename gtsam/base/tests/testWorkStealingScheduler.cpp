@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testWorkStealingScheduler.cpp
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/base/WorkStealingScheduler.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Visits a complete binary tree of tasks, task t spawning 2t+1 and 2t+2, checking that every
+// task runs once and after its parent
+struct VisitTree : public WorkStealingScheduler::Body {
+  size_t n;
+  FastVector<int> done;
+  bool parentsFirst;
+  VisitTree(size_t n) : n(n), done(n, 0), parentsFirst(true) {}
+  void operator()(size_t task, WorkStealingScheduler::Worker& worker) {
+    if(task > 0 && done[(task - 1) / 2] != 1)
+      parentsFirst = false;
+    ++done[task];
+    for(size_t child = 2 * task + 1; child <= 2 * task + 2 && child < n; ++child)
+      worker.spawn(child);
+  }
+};
+
+TEST(WorkStealingScheduler, tree) {
+  for(size_t nThreads = 1; nThreads <= 4; ++nThreads) {
+    WorkStealingScheduler scheduler(nThreads);
+    LONGS_EQUAL(long(nThreads), long(scheduler.nThreads()));
+    // Several times, so later runs reuse the deques and worker threads
+    for(size_t run = 0; run < 20; ++run) {
+      VisitTree body(1000);
+      scheduler.run(body.n, FastVector<size_t>(1, 0), body);
+      EXPECT(body.parentsFirst);
+      long count = 0;
+      for(size_t t = 0; t < body.n; ++t)
+        count += body.done[t] == 1;
+      LONGS_EQUAL(1000, count);
+    }
+  }
+}
+
+/* ************************************************************************* */
+struct Throw : public WorkStealingScheduler::Body {
+  void operator()(size_t task, WorkStealingScheduler::Worker& worker) {
+    if(task == 5)
+      throw std::runtime_error("task 5");
+  }
+};
+
+TEST(WorkStealingScheduler, exception) {
+  WorkStealingScheduler scheduler(3);
+  FastVector<size_t> tasks;
+  for(size_t t = 0; t < 10; ++t)
+    tasks.push_back(t);
+  Throw body;
+  CHECK_EXCEPTION(scheduler.run(tasks.size(), tasks, body), std::runtime_error);
+
+  // The worker threads keep serving runs after one has thrown
+  VisitTree tree(100);
+  scheduler.run(tree.n, FastVector<size_t>(1, 0), tree);
+  long count = 0;
+  for(size_t t = 0; t < tree.n; ++t)
+    count += tree.done[t] == 1;
+  LONGS_EQUAL(100, count);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
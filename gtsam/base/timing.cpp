@@ -24,13 +24,241 @@
 #include <boost/foreach.hpp>
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/make_shared.hpp>
 
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define GTSAM_TIMING_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  include <x86intrin.h>
+#  define GTSAM_TIMING_RDTSC
+#endif
+
+#ifdef _MSC_VER
+#  define GTSAM_THREAD_LOCAL __declspec(thread)
+#else
+#  define GTSAM_THREAD_LOCAL __thread
+#endif
+
 namespace gtsam {
 namespace internal {
 
+namespace {
+
+  typedef boost::chrono::steady_clock Clock;
+
+  /* ************************************************************************* */
+  // Time stamp counter, or nanoseconds where there is none
+  inline boost::uint64_t ticks() {
+#ifdef GTSAM_TIMING_RDTSC
+    return __rdtsc();
+#else
+    return boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  // Reference point for converting ticks to seconds
+  const boost::uint64_t tick0 = ticks();
+  const Clock::time_point wall0 = Clock::now();
+  const boost::thread::id mainThread = boost::this_thread::get_id();
+
+  /* ************************************************************************* */
+  // Seconds per tick, measured against the steady clock since tick0
+  double secondsPerTick() {
+#ifdef GTSAM_TIMING_RDTSC
+    Clock::time_point wall = Clock::now();
+    while (wall - wall0 < boost::chrono::milliseconds(10))
+      wall = Clock::now();
+    const boost::uint64_t tick = ticks();
+    return boost::chrono::duration<double>(wall - wall0).count() / double(tick - tick0);
+#else
+    return 1e-9;
+#endif
+  }
+
+  /* ************************************************************************* */
+  /**
+   * Timing tree of one thread, written only by that thread.  Nodes are kept in
+   * a flat array and linked by index, so that a tic or toc does not allocate
+   * once the tree has its shape.  The last timed sections are optionally kept
+   * in a ring buffer of events.
+   */
+  struct ThreadTimingTree {
+    struct Node {
+      size_t id;
+      std::string label;
+      size_t parent, firstChild, lastChild, nextSibling; // 0 for none, the root has no parent
+      size_t count;
+      boost::uint64_t total, min, max, start;
+      Node(size_t id, const char* label, size_t parent) :
+          id(id), label(label), parent(parent), firstChild(0), lastChild(0), nextSibling(0),
+          count(0), total(0), min(0), max(0), start(0) {}
+    };
+    struct Event {
+      size_t node;
+      boost::uint64_t start, end;
+    };
+
+    size_t tid;                 ///< Number of the thread, in order of first use
+    bool isMain;                ///< Whether this is the thread that initialized gtsam
+    std::vector<Node> nodes;    ///< nodes[0] is the root
+    size_t current;             ///< The innermost open section
+    std::vector<Event> events;  ///< Ring buffer of timed sections
+    size_t nextEvent, nrEvents;
+
+    ThreadTimingTree(size_t tid, bool isMain) : tid(tid), isMain(isMain) { reset(); }
+
+    void reset() {
+      nodes.assign(1, Node(getTicTocID("Total"), "Total", 0));
+      current = 0;
+      nextEvent = 0;
+      nrEvents = 0;
+    }
+
+    void tic(size_t id, const char* label) {
+      size_t child = nodes[current].firstChild;
+      while (child && nodes[child].id != id)
+        child = nodes[child].nextSibling;
+      if (!child) {
+        child = nodes.size();
+        nodes.push_back(Node(id, label, current));
+        if (nodes[current].lastChild)
+          nodes[nodes[current].lastChild].nextSibling = child;
+        else
+          nodes[current].firstChild = child;
+        nodes[current].lastChild = child;
+      }
+      current = child;
+      nodes[child].start = ticks();
+    }
+
+    void toc(size_t id, const char* label, size_t traceCapacity) {
+      const boost::uint64_t end = ticks();
+      Node& node = nodes[current];
+      if (current == 0)
+        throw std::invalid_argument(
+            (boost::format(
+                "gtsam timing:  Mismatched tic/toc: extra gttoc(\"%s\"), already at the root")
+                % label).str());
+      if (id != node.id)
+        throw std::invalid_argument(
+            (boost::format(
+                "gtsam timing:  Mismatched tic/toc: gttoc(\"%s\") called when last tic was \"%s\".")
+                % label % node.label).str());
+      const boost::uint64_t elapsed = end - node.start;
+      node.total += elapsed;
+      if (node.count == 0 || elapsed < node.min) node.min = elapsed;
+      if (elapsed > node.max) node.max = elapsed;
+      ++node.count;
+      if (traceCapacity > 0) {
+        if (events.size() != traceCapacity) {
+          events.resize(traceCapacity);
+          nextEvent = 0;
+          nrEvents = 0;
+        }
+        Event& event = events[nextEvent];
+        event.node = current;
+        event.start = node.start;
+        event.end = end;
+        nextEvent = (nextEvent + 1) % traceCapacity;
+        if (nrEvents < traceCapacity) ++nrEvents;
+      }
+      current = node.parent;
+    }
+  };
+
+  /* ************************************************************************* */
+  // All thread timing trees, kept after their threads exit
+  struct TimingRegistry {
+    boost::mutex mutex;
+    std::vector<boost::shared_ptr<ThreadTimingTree> > trees;
+    size_t traceCapacity;
+    TimingRegistry() : traceCapacity(0) {}
+  };
+
+  TimingRegistry& registry() {
+    static TimingRegistry registry;
+    return registry;
+  }
+
+  GTSAM_THREAD_LOCAL ThreadTimingTree* threadTree = 0;
+
+  /* ************************************************************************* */
+  // The calling thread's timing tree, registered on first use
+  inline ThreadTimingTree& thisThreadTree() {
+    if (!threadTree) {
+      TimingRegistry& r = registry();
+      boost::mutex::scoped_lock lock(r.mutex);
+      r.trees.push_back(boost::make_shared<ThreadTimingTree>(r.trees.size(),
+          boost::this_thread::get_id() == mainThread));
+      threadTree = r.trees.back().get();
+    }
+    return *threadTree;
+  }
+
+  /* ************************************************************************* */
+  // A node of the timing trees of all threads merged by call path
+  struct MergedNode {
+    size_t id;
+    std::string label;
+    size_t count, threads;
+    double total, min, max;
+    std::vector<MergedNode> children;
+    MergedNode(size_t id, const std::string& label) :
+        id(id), label(label), count(0), threads(0), total(0), min(0), max(0) {}
+
+    void merge(const ThreadTimingTree& tree, size_t n, double scale) {
+      const ThreadTimingTree::Node& node = tree.nodes[n];
+      if (node.count > 0) {
+        min = (count == 0) ? node.min * scale : std::min(min, node.min * scale);
+        max = std::max(max, node.max * scale);
+        count += node.count;
+        total += node.total * scale;
+        ++threads;
+      }
+      for (size_t c = node.firstChild; c; c = tree.nodes[c].nextSibling) {
+        const ThreadTimingTree::Node& child = tree.nodes[c];
+        size_t k = 0;
+        while (k < children.size() && children[k].id != child.id) ++k;
+        if (k == children.size())
+          children.push_back(MergedNode(child.id, child.label));
+        children[k].merge(tree, c, scale);
+      }
+    }
+
+    double childTotal() const {
+      double sum = 0;
+      BOOST_FOREACH(const MergedNode& child, children)
+        sum += child.total;
+      return sum;
+    }
+
+    void printJson(std::ostream& os, const std::string& indent) const {
+      const double t = (count == 0) ? childTotal() : total;
+      os << indent << "{\"label\": \"" << label << "\", \"count\": " << count
+          << ", \"total\": " << t << ", \"self\": " << std::max(0.0, t - childTotal())
+          << ", \"min\": " << min << ", \"max\": " << max
+          << ", \"threads\": " << threads << ", \"children\": [";
+      for (size_t k = 0; k < children.size(); ++k) {
+        os << (k ? ",\n" : "\n");
+        children[k].printJson(os, indent + "  ");
+      }
+      if (!children.empty())
+        os << "\n" << indent;
+      os << "]}";
+    }
+  };
+
+} // namespace
+
 GTSAM_EXPORT boost::shared_ptr<TimingOutline> timingRoot(
     new TimingOutline("Total", getTicTocID("Total")));
 GTSAM_EXPORT boost::weak_ptr<TimingOutline> timingCurrent(timingRoot);
@@ -218,6 +446,8 @@ size_t getTicTocID(const char *descriptionC) {
   // Global (static) map from strings to ID numbers and current next ID number
   static size_t nextId = 0;
   static gtsam::FastMap<std::string, size_t> idMap;
+  static boost::mutex mutex;
+  boost::mutex::scoped_lock lock(mutex);
 
   // Retrieve or add this string
   gtsam::FastMap<std::string, size_t>::const_iterator it = idMap.find(
@@ -233,17 +463,27 @@ size_t getTicTocID(const char *descriptionC) {
 
 /* ************************************************************************* */
 void ticInternal(size_t id, const char *labelC) {
-  const std::string label(labelC);
-  if (ISDEBUG("timing-verbose"))
-    std::cout << "gttic_(" << id << ", " << label << ")" << std::endl;
-  boost::shared_ptr<TimingOutline> node = //
-      timingCurrent.lock()->child(id, label, timingCurrent);
-  timingCurrent = node;
-  node->ticInternal();
+  ThreadTimingTree& tree = thisThreadTree();
+  // The call-tree outline is not thread-safe, it only times the main thread
+  if (tree.isMain) {
+    const std::string label(labelC);
+    if (ISDEBUG("timing-verbose"))
+      std::cout << "gttic_(" << id << ", " << label << ")" << std::endl;
+    boost::shared_ptr<TimingOutline> node = //
+        timingCurrent.lock()->child(id, label, timingCurrent);
+    timingCurrent = node;
+    node->ticInternal();
+  }
+  tree.tic(id, labelC);
 }
 
 /* ************************************************************************* */
 void tocInternal(size_t id, const char *label) {
+  ThreadTimingTree& tree = thisThreadTree();
+  if (!tree.isMain) {
+    tree.toc(id, label, registry().traceCapacity);
+    return;
+  }
   if (ISDEBUG("timing-verbose"))
     std::cout << "gttoc(" << id << ", " << label << ")" << std::endl;
   boost::shared_ptr<TimingOutline> current(timingCurrent.lock());
@@ -263,6 +503,67 @@ void tocInternal(size_t id, const char *label) {
   }
   current->tocInternal();
   timingCurrent = current->parent_;
+  tree.toc(id, label, registry().traceCapacity);
+}
+
+/* ************************************************************************* */
+void profileTic(size_t id, const char *label) {
+  thisThreadTree().tic(id, label);
+}
+
+/* ************************************************************************* */
+void profileToc(size_t id, const char *label) {
+  thisThreadTree().toc(id, label, registry().traceCapacity);
+}
+
+/* ************************************************************************* */
+void printTimingJson(std::ostream& os) {
+  const double scale = secondsPerTick();
+  TimingRegistry& r = registry();
+  boost::mutex::scoped_lock lock(r.mutex);
+  MergedNode root(getTicTocID("Total"), "Total");
+  BOOST_FOREACH(const boost::shared_ptr<ThreadTimingTree>& tree, r.trees)
+    root.merge(*tree, 0, scale);
+  root.printJson(os, "");
+  os << std::endl;
+}
+
+/* ************************************************************************* */
+void printTimingChromeTrace(std::ostream& os) {
+  const double usecs = secondsPerTick() * 1e6;
+  TimingRegistry& r = registry();
+  boost::mutex::scoped_lock lock(r.mutex);
+  os << "{\"traceEvents\": [";
+  bool first = true;
+  BOOST_FOREACH(const boost::shared_ptr<ThreadTimingTree>& tree, r.trees) {
+    // Oldest event first
+    const size_t capacity = tree->events.size();
+    for (size_t k = 0; k < tree->nrEvents; ++k) {
+      const ThreadTimingTree::Event& event =
+          tree->events[(tree->nextEvent + capacity - tree->nrEvents + k) % capacity];
+      os << (first ? "\n" : ",\n") << "{\"name\": \"" << tree->nodes[event.node].label
+          << "\", \"cat\": \"gtsam\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << tree->tid
+          << ", \"ts\": " << double(boost::int64_t(event.start - tick0)) * usecs
+          << ", \"dur\": " << double(event.end - event.start) * usecs << "}";
+      first = false;
+    }
+  }
+  os << "\n]}" << std::endl;
+}
+
+/* ************************************************************************* */
+void setTimingTraceCapacity(size_t eventsPerThread) {
+  TimingRegistry& r = registry();
+  boost::mutex::scoped_lock lock(r.mutex);
+  r.traceCapacity = eventsPerThread;
+}
+
+/* ************************************************************************* */
+void resetThreadTimingTrees() {
+  TimingRegistry& r = registry();
+  boost::mutex::scoped_lock lock(r.mutex);
+  BOOST_FOREACH(const boost::shared_ptr<ThreadTimingTree>& tree, r.trees)
+    tree->reset();
 }
 
 } // namespace internal
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <string>
+#include <iosfwd>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
 #include <boost/version.hpp>
@@ -102,6 +103,21 @@
 //   have matching gttic/gttoc statments.  You may want to consider reorganizing your timing
 //   outline to match the scope of your code.
 
+// - Multithreaded code.  Every thread that calls gttic also records into its own timing
+//   tree, which only that thread writes to, so gttic can be used inside parallel
+//   linearization or Bayes tree traversals.  The call-tree printout above only shows the
+//   main thread.  The trees of all threads are merged when a report is requested, by
+//   tictoc_printJson_(stream) as a nested JSON object with counts and times, or by
+//   tictoc_printChromeTrace_(stream) as Chrome trace events (chrome://tracing), after
+//   calling tictoc_setTraceCapacity_(n) to keep the last n timed sections of each thread.
+//   Reports and tictoc_reset_ should be called while no other thread is timing.
+//
+// - Production builds.  The per-thread trees are time stamped with the processor cycle
+//   counter where available and cost little more than a function call, so they can stay
+//   enabled: configuring with GTSAM_ENABLE_PROFILER makes the non-underscore gttic/gttoc
+//   record into the per-thread trees only, without the CPU timers of the printout above,
+//   when ENABLE_TIMING is not defined.
+
 // Automatically use the new Boost timers if version is recent enough.
 #if BOOST_VERSION >= 104800
 #  ifndef GTSAM_DISABLE_NEW_TIMERS
@@ -199,6 +215,30 @@ namespace gtsam {
 
     GTSAM_EXTERN_EXPORT boost::shared_ptr<TimingOutline> timingRoot;
     GTSAM_EXTERN_EXPORT boost::weak_ptr<TimingOutline> timingCurrent;
+
+    /// Start and stop timing in the calling thread's timing tree only
+    GTSAM_EXPORT void profileTic(size_t id, const char *label);
+    GTSAM_EXPORT void profileToc(size_t id, const char *label);
+
+    /**
+     * Scoped timing in the per-thread timing trees only, used for gttic when
+     * GTSAM_ENABLE_PROFILER is defined and ENABLE_TIMING is not
+     */
+    class AutoProfile {
+    private:
+      size_t id_;
+      const char *label_;
+      bool isSet_;
+    public:
+      AutoProfile(size_t id, const char* label) : id_(id), label_(label), isSet_(true) { profileTic(id_, label_); }
+      void stop() { profileToc(id_, label_); isSet_ = false; }
+      ~AutoProfile() { if(isSet_) stop(); }
+    };
+
+    GTSAM_EXPORT void printTimingJson(std::ostream& os);
+    GTSAM_EXPORT void printTimingChromeTrace(std::ostream& os);
+    GTSAM_EXPORT void setTimingTraceCapacity(size_t eventsPerThread);
+    GTSAM_EXPORT void resetThreadTimingTrees();
   }
 
 // Tic and toc functions that are always active (whether or not ENABLE_TIMING is defined)
@@ -238,6 +278,18 @@ inline void tictoc_print_() {
 inline void tictoc_print2_() {
   ::gtsam::internal::timingRoot->print2(); }
 
+// print the merged timing trees of all threads as JSON
+inline void tictoc_printJson_(std::ostream& os) {
+  ::gtsam::internal::printTimingJson(os); }
+
+// print the last timed sections of all threads as Chrome trace events
+inline void tictoc_printChromeTrace_(std::ostream& os) {
+  ::gtsam::internal::printTimingChromeTrace(os); }
+
+// keep the last eventsPerThread timed sections of each thread for tictoc_printChromeTrace_
+inline void tictoc_setTraceCapacity_(size_t eventsPerThread) {
+  ::gtsam::internal::setTimingTraceCapacity(eventsPerThread); }
+
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
@@ -247,7 +299,21 @@ inline void tictoc_print2_() {
 // reset
 inline void tictoc_reset_() {
   ::gtsam::internal::timingRoot.reset(new ::gtsam::internal::TimingOutline("Total", ::gtsam::internal::getTicTocID("Total")));
-  ::gtsam::internal::timingCurrent = ::gtsam::internal::timingRoot; }
+  ::gtsam::internal::timingCurrent = ::gtsam::internal::timingRoot;
+  ::gtsam::internal::resetThreadTimingTrees(); }
+
+// tic and toc in the per-thread timing trees only
+#define gtprofile_(label) \
+  static const size_t label##_id_tic = ::gtsam::internal::getTicTocID(#label); \
+  ::gtsam::internal::AutoProfile label##_obj = ::gtsam::internal::AutoProfile(label##_id_tic, #label)
+
+#define longprofiletic_(label) \
+  static const size_t label##_id_tic = ::gtsam::internal::getTicTocID(#label); \
+  ::gtsam::internal::profileTic(label##_id_tic, #label)
+
+#define longprofiletoc_(label) \
+  static const size_t label##_id_toc = ::gtsam::internal::getTicTocID(#label); \
+  ::gtsam::internal::profileToc(label##_id_toc, #label)
 
 #ifdef ENABLE_TIMING
 #define gttic(label) gttic_(label)
@@ -257,6 +323,14 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration tictoc_finishedIteration_
 #define tictoc_print tictoc_print_
 #define tictoc_reset tictoc_reset_
+#elif defined(GTSAM_ENABLE_PROFILER)
+#define gttic(label) gtprofile_(label)
+#define gttoc(label) gttoc_(label)
+#define longtic(label) longprofiletic_(label)
+#define longtoc(label) longprofiletoc_(label)
+#define tictoc_finishedIteration() ((void)0)
+#define tictoc_print() ((void)0)
+#define tictoc_reset tictoc_reset_
 #else
 #define gttic(label) ((void)0)
 #define gttoc(label) ((void)0)
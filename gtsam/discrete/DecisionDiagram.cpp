@@ -0,0 +1,408 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DecisionDiagram.cpp
+ * @brief   Hash-consed algebraic decision diagrams living in a single arena
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DecisionDiagram.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  namespace {
+    const DecisionDiagram::NodeId EMPTY = DecisionDiagram::NodeId(-1);
+    const unsigned int COMBINE = 16; // offset of op codes for combine
+    const unsigned int CHOOSE = 32; // offset of op codes for choose, plus index
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::DecisionDiagram(size_t cacheSize) :
+      cacheHits_(0), cacheLookups_(0) {
+    size_t n = 1;
+    while (n < cacheSize)
+      n <<= 1;
+    CacheEntry empty = { 0, 0, 0, 0 };
+    cache_.assign(n, empty);
+    uniqueTable_.assign(1024, EMPTY);
+  }
+
+  /* ************************************************************************* */
+  void DecisionDiagram::clear() {
+    nodes_.clear();
+    children_.clear();
+    stack_.clear();
+    std::fill(uniqueTable_.begin(), uniqueTable_.end(), EMPTY);
+    BOOST_FOREACH(CacheEntry& entry, cache_)
+      entry.op = 0;
+    cacheHits_ = cacheLookups_ = 0;
+  }
+
+  /* ************************************************************************* */
+  size_t DecisionDiagram::HashNode(Key label, double value,
+      const NodeId* branches, size_t n) {
+    size_t seed = n;
+    if (n == 0) {
+      boost::hash_combine(seed, value);
+    } else {
+      boost::hash_combine(seed, label);
+      for (size_t i = 0; i < n; ++i)
+        boost::hash_combine(seed, branches[i]);
+    }
+    return seed;
+  }
+
+  /* ************************************************************************* */
+  void DecisionDiagram::rehash() {
+    uniqueTable_.assign(2 * uniqueTable_.size(), EMPTY);
+    const size_t mask = uniqueTable_.size() - 1;
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+      const Node& node = nodes_[id];
+      const NodeId* branches = node.nrChoices ? &children_[node.firstChild] : 0;
+      size_t h = HashNode(node.label, node.value, branches, node.nrChoices) & mask;
+      while (uniqueTable_[h] != EMPTY)
+        h = (h + 1) & mask;
+      uniqueTable_[h] = id;
+    }
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::findOrAdd(Key label, double value,
+      const NodeId* branches, size_t n) {
+
+    // keep the load factor of the unique table below 1/2
+    if (2 * (nodes_.size() + 1) > uniqueTable_.size())
+      rehash();
+
+    const size_t mask = uniqueTable_.size() - 1;
+    size_t h = HashNode(label, value, branches, n) & mask;
+    for (NodeId id = uniqueTable_[h]; id != EMPTY; id = uniqueTable_[h]) {
+      const Node& node = nodes_[id];
+      if (node.nrChoices == n) {
+        if (n == 0 ? node.value == value :
+            node.label == label
+                && std::equal(branches, branches + n, &children_[node.firstChild]))
+          return id;
+      }
+      h = (h + 1) & mask;
+    }
+
+    // not found, add a new node to the arena
+    Node node;
+    node.label = label;
+    node.value = value;
+    node.firstChild = children_.size();
+    node.nrChoices = n;
+    children_.insert(children_.end(), branches, branches + n);
+    const NodeId id = NodeId(nodes_.size());
+    nodes_.push_back(node);
+    uniqueTable_[h] = id;
+    return id;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::leaf(double value) {
+    if (value == 0.0)
+      value = 0.0; // -0.0 and 0.0 are the same leaf
+    return findOrAdd(0, value, 0, 0);
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::choiceFromStack(Key label,
+      size_t base) {
+    const size_t n = stack_.size() - base;
+    NodeId result = stack_[base];
+    // A choice between identical branches is redundant
+    for (size_t i = base + 1; i < stack_.size(); ++i) {
+      if (stack_[i] != stack_[base]) {
+        result = findOrAdd(label, 0.0, &stack_[base], n);
+        break;
+      }
+    }
+    stack_.resize(base);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::choice(Key label,
+      const std::vector<NodeId>& branches) {
+    if (branches.empty())
+      throw invalid_argument("DecisionDiagram::choice: no branches");
+    BOOST_FOREACH(NodeId branch, branches)
+      if (!isLeaf(branch) && !(this->label(branch) < label))
+        throw invalid_argument(
+            "DecisionDiagram::choice: branch labels must be lower than label");
+    const size_t base = stack_.size();
+    stack_.insert(stack_.end(), branches.begin(), branches.end());
+    return choiceFromStack(label, base);
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::CacheEntry& DecisionDiagram::cacheEntry(unsigned int op,
+      NodeId f, Key g) {
+    size_t seed = op;
+    boost::hash_combine(seed, f);
+    boost::hash_combine(seed, g);
+    return cache_[seed & (cache_.size() - 1)];
+  }
+
+  /* ************************************************************************* */
+  bool DecisionDiagram::cacheLookup(unsigned int op, NodeId f, Key g,
+      NodeId& result) {
+    ++cacheLookups_;
+    const CacheEntry& entry = cacheEntry(op, f, g);
+    if (entry.op == op && entry.f == f && entry.g == g) {
+      ++cacheHits_;
+      result = entry.result;
+      return true;
+    }
+    return false;
+  }
+
+  /* ************************************************************************* */
+  void DecisionDiagram::cacheInsert(unsigned int op, NodeId f, Key g,
+      NodeId result) {
+    CacheEntry& entry = cacheEntry(op, f, g);
+    entry.op = op;
+    entry.f = f;
+    entry.g = g;
+    entry.result = result;
+  }
+
+  /* ************************************************************************* */
+  double DecisionDiagram::Apply(double a, double b, Operation op) {
+    switch (op) {
+    case PRODUCT:
+      return a * b;
+    case SUM:
+      return a + b;
+    case MAX:
+      return std::max(a, b);
+    case DIVIDE:
+      return (a == 0 || b == 0) ? 0 : (a / b);
+    }
+    throw invalid_argument("DecisionDiagram: unknown operation");
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::apply(NodeId f, NodeId g,
+      Operation op) {
+
+    const bool fLeaf = isLeaf(f), gLeaf = isLeaf(g);
+    if (fLeaf && gLeaf)
+      return leaf(Apply(value(f), value(g), op));
+
+    // Terminal cases that do not need to recurse
+    switch (op) {
+    case PRODUCT:
+      if ((fLeaf && value(f) == 0.0) || (gLeaf && value(g) == 0.0))
+        return leaf(0.0);
+      if (fLeaf && value(f) == 1.0) return g;
+      if (gLeaf && value(g) == 1.0) return f;
+      break;
+    case SUM:
+      if (fLeaf && value(f) == 0.0) return g;
+      if (gLeaf && value(g) == 0.0) return f;
+      break;
+    case MAX:
+      if (f == g) return f;
+      break;
+    case DIVIDE:
+      if ((fLeaf && value(f) == 0.0) || (gLeaf && value(g) == 0.0))
+        return leaf(0.0);
+      break;
+    }
+
+    // Commutative operations only need one cache entry per unordered pair
+    if (op != DIVIDE && f > g)
+      std::swap(f, g);
+
+    NodeId result;
+    if (cacheLookup(op, f, g, result))
+      return result;
+
+    // Split on the highest label
+    const bool fSplit = !isLeaf(f) && (isLeaf(g) || !(label(f) < label(g)));
+    const bool gSplit = !isLeaf(g) && (isLeaf(f) || !(label(g) < label(f)));
+    const Key top = fSplit ? label(f) : label(g);
+    const size_t n = fSplit ? nrChoices(f) : nrChoices(g);
+    if (fSplit && gSplit && nrChoices(f) != nrChoices(g))
+      throw invalid_argument(
+          (boost::format("DecisionDiagram::apply: inconsistent cardinality for %d")
+              % top).str());
+
+    const size_t base = stack_.size();
+    for (size_t i = 0; i < n; ++i) {
+      const NodeId fi = fSplit ? branch(f, i) : f;
+      const NodeId gi = gSplit ? branch(g, i) : g;
+      const NodeId hi = apply(fi, gi, op);
+      stack_.push_back(hi);
+    }
+    result = choiceFromStack(top, base);
+
+    cacheInsert(op, f, g, result);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::combine(NodeId f, Key j,
+      size_t cardinality, Operation op) {
+
+    // If f does not depend on j, combine f with itself cardinality times
+    if (isLeaf(f) || label(f) < j) {
+      NodeId result = f;
+      for (size_t index = 1; index < cardinality; ++index)
+        result = apply(result, f, op);
+      return result;
+    }
+
+    NodeId result;
+    if (cacheLookup(COMBINE + op, f, j, result))
+      return result;
+
+    const size_t n = nrChoices(f);
+    if (label(f) == j) {
+      result = branch(f, 0);
+      for (size_t index = 1; index < n; ++index)
+        result = apply(result, branch(f, index), op);
+    } else {
+      const size_t base = stack_.size();
+      for (size_t i = 0; i < n; ++i) {
+        const NodeId hi = combine(branch(f, i), j, cardinality, op);
+        stack_.push_back(hi);
+      }
+      result = choiceFromStack(label(f), base);
+    }
+
+    cacheInsert(COMBINE + op, f, j, result);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::choose(NodeId f, Key j,
+      size_t index) {
+
+    if (isLeaf(f) || label(f) < j)
+      return f;
+    if (label(f) == j)
+      return branch(f, index);
+
+    NodeId result;
+    const unsigned int op = CHOOSE + (unsigned int) index;
+    if (cacheLookup(op, f, j, result))
+      return result;
+
+    const size_t base = stack_.size();
+    for (size_t i = 0; i < nrChoices(f); ++i) {
+      const NodeId hi = choose(branch(f, i), j, index);
+      stack_.push_back(hi);
+    }
+    result = choiceFromStack(label(f), base);
+
+    cacheInsert(op, f, j, result);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  double DecisionDiagram::operator()(NodeId f, const Assignment<Key>& x) const {
+    while (!isLeaf(f))
+      f = branch(f, x.at(label(f)));
+    return value(f);
+  }
+
+  /* ************************************************************************* */
+  size_t DecisionDiagram::nrNodes(NodeId f) const {
+    std::vector<bool> visited(nodes_.size(), false);
+    std::vector<NodeId> todo(1, f);
+    size_t count = 0;
+    while (!todo.empty()) {
+      const NodeId g = todo.back();
+      todo.pop_back();
+      if (visited[g])
+        continue;
+      visited[g] = true;
+      ++count;
+      for (size_t i = 0; i < nrChoices(g); ++i)
+        todo.push_back(branch(g, i));
+    }
+    return count;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::fromTreeNode(const ADT::Node& node,
+      boost::unordered_map<const void*, NodeId>& visited) {
+    typedef DecisionTree<Key, double>::Leaf Leaf;
+    typedef DecisionTree<Key, double>::Choice Choice;
+
+    boost::unordered_map<const void*, NodeId>::const_iterator it =
+        visited.find(node.id());
+    if (it != visited.end())
+      return it->second;
+
+    NodeId result;
+    if (node.isLeaf()) {
+      result = leaf(static_cast<const Leaf&>(node).constant());
+    } else {
+      const Choice& choice = static_cast<const Choice&>(node);
+      const size_t base = stack_.size();
+      BOOST_FOREACH(const ADT::NodePtr& branch, choice.branches()) {
+        const NodeId b = fromTreeNode(*branch, visited);
+        stack_.push_back(b);
+      }
+      result = choiceFromStack(choice.label(), base);
+    }
+    visited[node.id()] = result;
+    return result;
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::NodeId DecisionDiagram::fromTree(const ADT& tree) {
+    boost::unordered_map<const void*, NodeId> visited;
+    return fromTreeNode(*tree.root_, visited);
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::ADT::NodePtr DecisionDiagram::toTreeNode(NodeId f,
+      std::vector<ADT::NodePtr>& visited) const {
+    typedef DecisionTree<Key, double>::Leaf Leaf;
+    typedef DecisionTree<Key, double>::Choice Choice;
+
+    if (visited[f])
+      return visited[f];
+
+    if (isLeaf(f)) {
+      visited[f].reset(new Leaf(value(f)));
+    } else {
+      boost::shared_ptr<Choice> choice(new Choice(label(f), nrChoices(f)));
+      for (size_t i = 0; i < nrChoices(f); ++i)
+        choice->push_back(toTreeNode(branch(f, i), visited));
+      visited[f] = Choice::Unique(choice);
+    }
+    return visited[f];
+  }
+
+  /* ************************************************************************* */
+  DecisionDiagram::ADT DecisionDiagram::toTree(NodeId f) const {
+    std::vector<ADT::NodePtr> visited(nodes_.size());
+    return ADT(DecisionTree<Key, double>(toTreeNode(f, visited)));
+  }
+
+/* ************************************************************************* */
+} // namespace gtsam
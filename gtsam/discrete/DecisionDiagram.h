@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DecisionDiagram.h
+ * @brief   Hash-consed algebraic decision diagrams living in a single arena
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/discrete/AlgebraicDecisionTree.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/global_includes.h>
+
+#include <boost/unordered_map.hpp>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * An arena of canonical algebraic decision diagram (ADD) nodes, the backend
+   * counterpart of AlgebraicDecisionTree<Key>.
+   *
+   * All nodes created through one DecisionDiagram live in flat arrays and are
+   * referred to by integer NodeId. A unique table hash-conses the nodes, so two
+   * structurally identical sub-diagrams are always the same NodeId, and a
+   * Choice node whose branches are all identical is replaced by that branch.
+   * Binary operations and marginalization are memoized in a direct-mapped
+   * operation cache, so apply() costs time proportional to the number of
+   * distinct (f,g) node pairs rather than to the size of the unfolded trees.
+   *
+   * As in DecisionTree, the variable with the highest label is at the root.
+   * NodeIds are only meaningful for the DecisionDiagram that created them;
+   * memory is reclaimed all at once by clear() or when the arena is destroyed,
+   * so a typical use is one arena per factor graph or per elimination step.
+   */
+  class GTSAM_EXPORT DecisionDiagram {
+
+  public:
+
+    typedef AlgebraicDecisionTree<Key> ADT;
+    typedef unsigned int NodeId;
+
+    /// Binary operations supported by apply and combine
+    enum Operation {
+      PRODUCT = 1, ///< a * b
+      SUM,         ///< a + b
+      MAX,         ///< max(a, b)
+      DIVIDE       ///< a / b, with 0 when either a or b is 0 (Potentials::safe_div)
+    };
+
+  private:
+
+    /// A node is a leaf when nrChoices == 0, otherwise a Choice on label
+    struct Node {
+      Key label;
+      double value;
+      size_t firstChild; ///< index into children_
+      size_t nrChoices;
+    };
+
+    /// Entry in the direct-mapped operation cache
+    struct CacheEntry {
+      unsigned int op; ///< 0 marks an empty entry
+      NodeId f;
+      Key g;           ///< second NodeId for apply, label for combine
+      NodeId result;
+    };
+
+    std::vector<Node> nodes_;          ///< arena of nodes
+    std::vector<NodeId> children_;     ///< arena of branch lists
+    std::vector<NodeId> uniqueTable_;  ///< open-addressing hash table of NodeIds
+    std::vector<CacheEntry> cache_;    ///< operation cache, size is a power of 2
+    std::vector<NodeId> stack_;        ///< scratch space for branches under construction
+    size_t cacheHits_, cacheLookups_;
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /**
+     * Create an empty arena
+     * @param cacheSize number of operation cache entries, rounded up to a power of 2
+     */
+    DecisionDiagram(size_t cacheSize = 1 << 16);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Canonical leaf with the given value
+    NodeId leaf(double value);
+
+    /// Canonical constant 1, the identity for PRODUCT
+    NodeId one() { return leaf(1.0); }
+
+    /**
+     * Canonical Choice node on label with the given branches. All branch labels
+     * must be lower than label. Returns the branch itself if all are identical.
+     */
+    NodeId choice(Key label, const std::vector<NodeId>& branches);
+
+    /// Apply binary operation op to f and g
+    NodeId apply(NodeId f, NodeId g, Operation op);
+
+    /// Combine the branches on label with op, e.g. SUM to marginalize it out
+    NodeId combine(NodeId f, Key label, size_t cardinality, Operation op);
+
+    /// Restrict f to the sub-diagram where label == index
+    NodeId choose(NodeId f, Key label, size_t index);
+
+    /// Evaluate f at an assignment
+    double operator()(NodeId f, const Assignment<Key>& x) const;
+
+    /// Import a decision tree, identical subtrees become a single node
+    NodeId fromTree(const ADT& tree);
+
+    /// Export f as a decision tree, shared sub-diagrams become shared subtrees
+    ADT toTree(NodeId f) const;
+
+    /// @}
+    /// @name Inspection
+    /// @{
+
+    /// Whether f is a leaf
+    bool isLeaf(NodeId f) const { return nodes_[f].nrChoices == 0; }
+
+    /// Value of leaf f
+    double value(NodeId f) const { return nodes_[f].value; }
+
+    /// Label of Choice node f
+    Key label(NodeId f) const { return nodes_[f].label; }
+
+    /// Number of branches of f, 0 for leaves
+    size_t nrChoices(NodeId f) const { return nodes_[f].nrChoices; }
+
+    /// Branch i of Choice node f
+    NodeId branch(NodeId f, size_t i) const {
+      return children_[nodes_[f].firstChild + i]; }
+
+    /// Total number of nodes in the arena
+    size_t size() const { return nodes_.size(); }
+
+    /// Number of distinct nodes reachable from f
+    size_t nrNodes(NodeId f) const;
+
+    /// Fraction of operation cache lookups that were hits
+    double cacheHitRate() const {
+      return cacheLookups_ ? double(cacheHits_) / double(cacheLookups_) : 0.0; }
+
+    /// Release all nodes, invalidating every NodeId
+    void clear();
+
+    /// @}
+
+  private:
+
+    /// Hash of a would-be node, for the unique table
+    static size_t HashNode(Key label, double value, const NodeId* branches, size_t n);
+
+    /// Find or create the canonical node, branches are not yet in children_
+    NodeId findOrAdd(Key label, double value, const NodeId* branches, size_t n);
+
+    /// Canonical Choice node from the branches pushed on stack_ after base, pops them
+    NodeId choiceFromStack(Key label, size_t base);
+
+    /// Grow the unique table and rehash when it is half full
+    void rehash();
+
+    CacheEntry& cacheEntry(unsigned int op, NodeId f, Key g);
+    bool cacheLookup(unsigned int op, NodeId f, Key g, NodeId& result);
+    void cacheInsert(unsigned int op, NodeId f, Key g, NodeId result);
+
+    static double Apply(double a, double b, Operation op);
+
+    /// Recursive helpers for fromTree and toTree
+    NodeId fromTreeNode(const ADT::Node& node,
+        boost::unordered_map<const void*, NodeId>& visited);
+    ADT::NodePtr toTreeNode(NodeId f, std::vector<ADT::NodePtr>& visited) const;
+  };
+
+} // namespace gtsam
@@ -134,6 +134,8 @@ namespace gtsam {
 
     bool isLeaf() const { return true; }
 
+    size_t nrLeaves() const { return 1; }
+
   }; // Leaf
 
   /*********************************************************************************/
@@ -178,6 +180,13 @@ namespace gtsam {
 
     bool isLeaf() const { return false; }
 
+    size_t nrLeaves() const {
+      size_t n = 0;
+      BOOST_FOREACH(const NodePtr& branch, branches_)
+        n += branch->nrLeaves();
+      return n;
+    }
+
     /** Constructor, given choice label and mandatory expected branch count */
     Choice(const L& label, size_t count) :
       label_(label), allSame_(true) {
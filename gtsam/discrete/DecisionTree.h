@@ -87,6 +87,7 @@ namespace gtsam {
       virtual Ptr apply_g_op_fC(const Choice&, const Binary&) const = 0;
       virtual Ptr choose(const L& label, size_t index) const = 0;
       virtual bool isLeaf() const = 0;
+      virtual size_t nrLeaves() const = 0;
     };
     /** ------------------------ Node base class --------------------------- */
 
@@ -182,6 +183,11 @@ namespace gtsam {
       return DecisionTree(newRoot);
     }
 
+    /** number of leaves, counting shared subtrees once per path */
+    size_t nrLeaves() const {
+      return root_->nrLeaves();
+    }
+
     /** combine subtrees on key with binary operation "op" */
     DecisionTree combine(const L& label, size_t cardinality, const Binary& op) const;
 
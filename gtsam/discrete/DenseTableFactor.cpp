@@ -0,0 +1,446 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseTableFactor.cpp
+ * @brief   Discrete factor stored as a flat, dense table
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DenseTableFactor.h>
+#include <gtsam/discrete/DecisionTree-inl.h>
+
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  double DenseTableFactor::DensityThreshold = 0.5;
+  size_t DenseTableFactor::MinimumSize = 1024;
+  size_t DenseTableFactor::MaximumSize = size_t(1) << 24;
+
+  /* ************************************************************************* */
+  bool DenseTableFactor::PreferDense(const std::map<Key, size_t>& cardinalities,
+      size_t nrLeaves, size_t nrEntries) {
+    size_t size = 1;
+    typedef std::pair<const Key, size_t> KeyCardinality;
+    BOOST_FOREACH(const KeyCardinality& key, cardinalities) {
+      size *= key.second;
+      if (size > MaximumSize)
+        return false;
+    }
+    if (size < MinimumSize || nrEntries == 0)
+      return false;
+    return double(nrLeaves) >= DensityThreshold * double(nrEntries);
+  }
+
+  namespace {
+
+    /* *********************************************************************** */
+    // Advance the odometer over the first counter.size() dimensions, keeping the
+    // offsets of up to two operands with the given strides in sync.
+    inline void increment(std::vector<size_t>& counter,
+        const std::vector<size_t>& cardinalities, const std::vector<size_t>& s1,
+        size_t& o1, const std::vector<size_t>& s2, size_t& o2) {
+      for (size_t d = counter.size(); d-- > 0;) {
+        if (++counter[d] < cardinalities[d]) {
+          o1 += s1[d];
+          o2 += s2[d];
+          return;
+        }
+        counter[d] = 0;
+        o1 -= s1[d] * (cardinalities[d] - 1);
+        o2 -= s2[d] * (cardinalities[d] - 1);
+      }
+    }
+
+    /* *********************************************************************** */
+    // How an operand is accessed along the innermost run of a loop
+    enum RunMode { UNDECIDED, CONTIGUOUS, CONSTANT };
+
+    // Try to extend the innermost run of an operand by a dimension with the
+    // given stride, where length is the run length so far
+    inline bool extendRun(RunMode& mode, size_t stride, size_t length) {
+      if (stride == 0) {
+        if (mode == CONTIGUOUS) return false;
+        mode = CONSTANT;
+      } else {
+        if (mode == CONSTANT || stride != length) return false;
+        mode = CONTIGUOUS;
+      }
+      return true;
+    }
+  }
+
+  /* ************************************************************************* */
+  void DenseTableFactor::initialize(const DiscreteKeys& keys) {
+    const size_t n = keys.size();
+    keys_.resize(n);
+    cardinalities_.resize(n);
+    strides_.resize(n);
+    size_t size = 1;
+    for (size_t d = n; d-- > 0;) {
+      keys_[d] = keys[d].first;
+      cardinalities_[d] = keys[d].second;
+      strides_[d] = size;
+      size *= keys[d].second;
+    }
+    table_.resize(size);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::DenseTableFactor() {
+    initialize(DiscreteKeys());
+    table_(0) = 1.0;
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::DenseTableFactor(const DiscreteKeys& keys,
+      const std::vector<double>& table) {
+    DiscreteKeys sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    initialize(sorted);
+    if (table.size() != size_t(table_.size()))
+      throw invalid_argument(
+          (boost::format("DenseTableFactor: expected %d values but got %d instead")
+              % table_.size() % table.size()).str());
+
+    // Walk the source table, last given key fastest, and scatter into ours
+    const size_t n = keys.size();
+    std::vector<size_t> cards(n), strides(n), none(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+      cards[i] = keys[i].second;
+      strides[i] = strides_[std::lower_bound(keys_.begin(), keys_.end(),
+          keys[i].first) - keys_.begin()];
+    }
+    std::vector<size_t> counter(n, 0);
+    size_t offset = 0, unused = 0;
+    for (size_t i = 0; i < table.size(); ++i) {
+      table_(offset) = table[i];
+      increment(counter, cards, strides, offset, none, unused);
+    }
+  }
+
+  /* ************************************************************************* */
+  namespace {
+    // Fill all entries of the table that agree with the fixed dimensions with
+    // the leaves of the decision tree below node
+    void fillFromTree(const AlgebraicDecisionTree<Key>::Node& node,
+        const std::vector<Key>& keys, const std::vector<size_t>& cardinalities,
+        const std::vector<size_t>& strides, std::vector<bool>& fixed,
+        size_t base, Vector& table) {
+      typedef DecisionTree<Key, double>::Leaf Leaf;
+      typedef DecisionTree<Key, double>::Choice Choice;
+
+      if (node.isLeaf()) {
+        const double value = static_cast<const Leaf&>(node).constant();
+        // odometer over the free dimensions only
+        std::vector<size_t> freeCards, freeStrides, none;
+        for (size_t d = 0; d < keys.size(); ++d)
+          if (!fixed[d]) {
+            freeCards.push_back(cardinalities[d]);
+            freeStrides.push_back(strides[d]);
+          }
+        none.assign(freeCards.size(), 0);
+        size_t count = 1;
+        BOOST_FOREACH(size_t c, freeCards)
+          count *= c;
+        std::vector<size_t> counter(freeCards.size(), 0);
+        size_t offset = base, unused = 0;
+        for (size_t i = 0; i < count; ++i) {
+          table(offset) = value;
+          increment(counter, freeCards, freeStrides, offset, none, unused);
+        }
+      } else {
+        const Choice& choice = static_cast<const Choice&>(node);
+        const size_t d = std::lower_bound(keys.begin(), keys.end(),
+            choice.label()) - keys.begin();
+        if (d == keys.size() || keys[d] != choice.label())
+          throw invalid_argument("DenseTableFactor: tree splits on an unknown key");
+        fixed[d] = true;
+        for (size_t v = 0; v < choice.nrChoices(); ++v)
+          fillFromTree(*choice.branches()[v], keys, cardinalities, strides,
+              fixed, base + v * strides[d], table);
+        fixed[d] = false;
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::DenseTableFactor(const DecisionTreeFactor& f) {
+    DiscreteKeys keys;
+    BOOST_FOREACH(Key j, f.keys())
+      keys.push_back(DiscreteKey(j, f.cardinality(j)));
+    std::sort(keys.begin(), keys.end());
+    initialize(keys);
+    std::vector<bool> fixed(keys_.size(), false);
+    fillFromTree(*f.root_, keys_, cardinalities_, strides_, fixed, 0, table_);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::FromFactor(
+      const DiscreteFactor& f) {
+    if (const DenseTableFactor* dense = dynamic_cast<const DenseTableFactor*>(&f))
+      return boost::make_shared<DenseTableFactor>(*dense);
+    return boost::make_shared<DenseTableFactor>(f.toDecisionTreeFactor());
+  }
+
+  /* ************************************************************************* */
+  bool DenseTableFactor::equals(const DiscreteFactor& other, double tol) const {
+    const DenseTableFactor* f = dynamic_cast<const DenseTableFactor*>(&other);
+    if (!f)
+      return false;
+    return keys_ == f->keys_ && cardinalities_ == f->cardinalities_
+        && equal_with_abs_tol(table_, f->table_, tol);
+  }
+
+  /* ************************************************************************* */
+  void DenseTableFactor::print(const string& s,
+      const KeyFormatter& formatter) const {
+    cout << s << "  Cardinalities: ";
+    for (size_t d = 0; d < keys_.size(); ++d)
+      cout << formatter(keys_[d]) << "=" << cardinalities_[d] << " ";
+    cout << endl;
+    gtsam::print(table_, "  Table: ");
+  }
+
+  /* ************************************************************************* */
+  size_t DenseTableFactor::cardinality(Key j) const {
+    const size_t d = std::lower_bound(keys_.begin(), keys_.end(), j) - keys_.begin();
+    if (d == keys_.size() || keys_[d] != j)
+      throw out_of_range("DenseTableFactor::cardinality: key not in factor");
+    return cardinalities_[d];
+  }
+
+  /* ************************************************************************* */
+  DiscreteKeys DenseTableFactor::discreteKeys() const {
+    DiscreteKeys keys;
+    for (size_t d = 0; d < keys_.size(); ++d)
+      keys.push_back(DiscreteKey(keys_[d], cardinalities_[d]));
+    return keys;
+  }
+
+  /* ************************************************************************* */
+  double DenseTableFactor::operator()(const Values& values) const {
+    size_t offset = 0;
+    for (size_t d = 0; d < keys_.size(); ++d)
+      offset += values.at(keys_[d]) * strides_[d];
+    return table_(offset);
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DenseTableFactor::toDecisionTreeFactor() const {
+    // A tree can't be created from an empty list of keys, a constant is one leaf
+    if (keys_.empty())
+      return DecisionTreeFactor(DiscreteKeys(),
+          DecisionTreeFactor::ADT(DecisionTreeFactor::ADT::Super(table_(0))));
+    return DecisionTreeFactor(discreteKeys(),
+        std::vector<double>(table_.data(), table_.data() + table_.size()));
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DenseTableFactor::operator*(
+      const DecisionTreeFactor& f) const {
+    return toDecisionTreeFactor() * f;
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor DenseTableFactor::operator*(const DenseTableFactor& f) const {
+    return apply(f, PRODUCT);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor DenseTableFactor::operator/(const DenseTableFactor& f) const {
+    return apply(f, DIVIDE);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor DenseTableFactor::apply(const DenseTableFactor& g,
+      BinaryOp op) const {
+    const DenseTableFactor& f = *this;
+
+    // Keys of the result are the sorted union of the keys of f and g
+    DiscreteKeys keys;
+    size_t i = 0, j = 0;
+    while (i < f.keys_.size() || j < g.keys_.size()) {
+      if (j == g.keys_.size() || (i < f.keys_.size() && f.keys_[i] < g.keys_[j])) {
+        keys.push_back(DiscreteKey(f.keys_[i], f.cardinalities_[i]));
+        ++i;
+      } else if (i == f.keys_.size() || g.keys_[j] < f.keys_[i]) {
+        keys.push_back(DiscreteKey(g.keys_[j], g.cardinalities_[j]));
+        ++j;
+      } else {
+        if (f.cardinalities_[i] != g.cardinalities_[j])
+          throw invalid_argument("DenseTableFactor: inconsistent cardinalities");
+        keys.push_back(DiscreteKey(f.keys_[i], f.cardinalities_[i]));
+        ++i;
+        ++j;
+      }
+    }
+    DenseTableFactor h;
+    h.initialize(keys);
+
+    // Strides of f and g along the dimensions of h, 0 if absent
+    const size_t n = keys.size();
+    std::vector<size_t> sf(n, 0), sg(n, 0);
+    for (size_t d = 0, a = 0, b = 0; d < n; ++d) {
+      if (a < f.keys_.size() && f.keys_[a] == h.keys_[d]) sf[d] = f.strides_[a++];
+      if (b < g.keys_.size() && g.keys_[b] == h.keys_[d]) sg[d] = g.strides_[b++];
+    }
+
+    // Find the longest run of trailing dimensions along which both operands are
+    // either contiguous or constant, so the inner loop is a vector operation
+    RunMode modeF = UNDECIDED, modeG = UNDECIDED;
+    size_t length = 1, outer = n;
+    while (outer > 0) {
+      RunMode mf = modeF, mg = modeG;
+      if (!extendRun(mf, sf[outer - 1], length) || !extendRun(mg, sg[outer - 1], length))
+        break;
+      modeF = mf;
+      modeG = mg;
+      length *= h.cardinalities_[--outer];
+    }
+
+    const Vector& F = f.table_;
+    const Vector& G = g.table_;
+    Vector& H = h.table_;
+    std::vector<size_t> counter(outer, 0);
+    size_t of = 0, og = 0;
+    for (size_t oh = 0; oh < size_t(H.size()); oh += length) {
+      if (op == PRODUCT) {
+        if (modeF == CONTIGUOUS && modeG == CONTIGUOUS)
+          H.segment(oh, length) = F.segment(of, length).cwiseProduct(G.segment(og, length));
+        else if (modeF == CONTIGUOUS)
+          H.segment(oh, length) = F.segment(of, length) * G(og);
+        else if (modeG == CONTIGUOUS)
+          H.segment(oh, length) = G.segment(og, length) * F(of);
+        else
+          H(oh) = F(of) * G(og);
+      } else {
+        const size_t incF = (modeF == CONTIGUOUS), incG = (modeG == CONTIGUOUS);
+        for (size_t k = 0; k < length; ++k) {
+          const double a = F(of + k * incF), b = G(og + k * incG);
+          H(oh + k) = (a == 0 || b == 0) ? 0 : (a / b);
+        }
+      }
+      increment(counter, h.cardinalities_, sf, of, sg, og);
+    }
+    return h;
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::reduce(
+      const std::vector<bool>& eliminate, ReduceOp op) const {
+
+    // The result keeps the keys that are not eliminated
+    DiscreteKeys keys;
+    for (size_t d = 0; d < keys_.size(); ++d)
+      if (!eliminate[d])
+        keys.push_back(DiscreteKey(keys_[d], cardinalities_[d]));
+    shared_ptr result = boost::make_shared<DenseTableFactor>();
+    result->initialize(keys);
+    Vector& R = result->table_;
+    if (op == SUM)
+      R.setZero();
+    else
+      R.setConstant(-std::numeric_limits<double>::infinity());
+
+    // Strides of the result along our dimensions, 0 for eliminated keys
+    const size_t n = keys_.size();
+    std::vector<size_t> sr(n, 0), none(n, 0);
+    for (size_t d = 0, k = 0; d < n; ++d)
+      if (!eliminate[d]) sr[d] = result->strides_[k++];
+
+    // Longest run of trailing dimensions that are all kept or all eliminated
+    RunMode mode = UNDECIDED;
+    size_t length = 1, outer = n;
+    while (outer > 0) {
+      RunMode m = mode;
+      if (!extendRun(m, sr[outer - 1], length))
+        break;
+      mode = m;
+      length *= cardinalities_[--outer];
+    }
+
+    std::vector<size_t> counter(outer, 0);
+    size_t offset = 0, unused = 0;
+    for (size_t i = 0; i < size_t(table_.size()); i += length) {
+      if (mode == CONTIGUOUS) {
+        if (op == SUM)
+          R.segment(offset, length) += table_.segment(i, length);
+        else
+          R.segment(offset, length) = R.segment(offset, length).cwiseMax(
+              table_.segment(i, length));
+      } else {
+        if (op == SUM)
+          R(offset) += table_.segment(i, length).sum();
+        else
+          R(offset) = std::max(R(offset), table_.segment(i, length).maxCoeff());
+      }
+      increment(counter, cardinalities_, sr, offset, none, unused);
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  std::vector<bool> DenseTableFactor::flags(const Ordering& frontalKeys) const {
+    std::vector<bool> eliminate(keys_.size(), false);
+    BOOST_FOREACH(Key j, frontalKeys) {
+      const size_t d = std::lower_bound(keys_.begin(), keys_.end(), j) - keys_.begin();
+      if (d == keys_.size() || keys_[d] != j)
+        throw invalid_argument("DenseTableFactor: frontal key not in factor");
+      eliminate[d] = true;
+    }
+    return eliminate;
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::sum(size_t nrFrontals) const {
+    if (nrFrontals > size()) throw invalid_argument(
+        (boost::format(
+            "DenseTableFactor::sum: invalid number of frontal keys %d, nr.keys=%d")
+            % nrFrontals % size()).str());
+    std::vector<bool> eliminate(keys_.size(), false);
+    std::fill(eliminate.begin(), eliminate.begin() + nrFrontals, true);
+    return reduce(eliminate, SUM);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::sum(const Ordering& keys) const {
+    return reduce(flags(keys), SUM);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::max(size_t nrFrontals) const {
+    if (nrFrontals > size()) throw invalid_argument(
+        (boost::format(
+            "DenseTableFactor::max: invalid number of frontal keys %d, nr.keys=%d")
+            % nrFrontals % size()).str());
+    std::vector<bool> eliminate(keys_.size(), false);
+    std::fill(eliminate.begin(), eliminate.begin() + nrFrontals, true);
+    return reduce(eliminate, MAX);
+  }
+
+  /* ************************************************************************* */
+  DenseTableFactor::shared_ptr DenseTableFactor::max(const Ordering& keys) const {
+    return reduce(flags(keys), MAX);
+  }
+
+/* ************************************************************************* */
+} // namespace gtsam
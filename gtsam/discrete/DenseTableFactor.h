@@ -0,0 +1,174 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseTableFactor.h
+ * @brief   Discrete factor stored as a flat, dense table
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/discrete/DiscreteFactor.h>
+#include <gtsam/discrete/DecisionTreeFactor.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/Vector.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+  /**
+   * A discrete factor that stores its values in a flat table, an alternative
+   * to DecisionTreeFactor for low-cardinality, densely connected problems
+   * where few subtrees can be pruned.
+   *
+   * Keys are kept in increasing order and the first key is the most
+   * significant, so the table has the same layout as the vector constructor
+   * of DecisionTreeFactor. Products, marginalization and maximization walk the
+   * table with strides; the innermost run of contiguous entries is handled
+   * by Eigen expressions, which are vectorized.
+   *
+   * The factor interoperates with DecisionTreeFactor through the DiscreteFactor
+   * interface, so both can live in one DiscreteFactorGraph. EliminateDiscrete
+   * switches to this representation when the product is large and dense, see
+   * PreferDense.
+   */
+  class GTSAM_EXPORT DenseTableFactor: public DiscreteFactor {
+
+  public:
+
+    // typedefs needed to play nice with gtsam
+    typedef DenseTableFactor This;
+    typedef DiscreteFactor Base; ///< Typedef to base class
+    typedef boost::shared_ptr<DenseTableFactor> shared_ptr;
+
+    /// @name Dense elimination thresholds
+    /// @{
+
+    /// Minimum fraction of distinct leaves in the input trees (default: 0.5)
+    static double DensityThreshold;
+
+    /// Minimum number of entries in the product table (default: 1024)
+    static size_t MinimumSize;
+
+    /// Maximum number of entries in the product table (default: 2^24)
+    static size_t MaximumSize;
+
+    /**
+     * Whether a product of factors over the given keys is better computed in a
+     * dense table: its size is within [MinimumSize, MaximumSize] and the inputs
+     * either are DenseTableFactors or have at least DensityThreshold leaves per
+     * table entry
+     * @param cardinalities keys and cardinalities of the product
+     * @param nrLeaves total number of leaves of the input factors
+     * @param nrEntries total number of table entries of the input factors
+     */
+    static bool PreferDense(const std::map<Key, size_t>& cardinalities,
+        size_t nrLeaves, size_t nrEntries);
+
+    /// @}
+
+  protected:
+
+    std::vector<size_t> cardinalities_; ///< cardinality of each key
+    std::vector<size_t> strides_;       ///< stride of each key in table_
+    Vector table_;                      ///< values, first key most significant
+
+    /// Compute strides from cardinalities, and allocate the table
+    void initialize(const DiscreteKeys& keys);
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor: the constant 1 */
+    DenseTableFactor();
+
+    /** Construct from keys and a table with the layout of DecisionTreeFactor */
+    DenseTableFactor(const DiscreteKeys& keys, const std::vector<double>& table);
+
+    /** Construct from a DecisionTreeFactor (or DiscreteConditional) */
+    explicit DenseTableFactor(const DecisionTreeFactor& f);
+
+    /** Convert any DiscreteFactor, copying DenseTableFactors directly */
+    static shared_ptr FromFactor(const DiscreteFactor& f);
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /// equality
+    bool equals(const DiscreteFactor& other, double tol = 1e-9) const;
+
+    // print
+    virtual void print(const std::string& s = "DenseTableFactor:\n",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Look up the value of an assignment
+    virtual double operator()(const Values& values) const;
+
+    /// Multiply in a DecisionTreeFactor and return the result as DecisionTreeFactor
+    virtual DecisionTreeFactor operator*(const DecisionTreeFactor& f) const;
+
+    /// Convert into a DecisionTreeFactor
+    virtual DecisionTreeFactor toDecisionTreeFactor() const;
+
+    /// multiply two dense factors
+    DenseTableFactor operator*(const DenseTableFactor& f) const;
+
+    /// divide by factor f, with 0 when either value is 0 (as Potentials::safe_div)
+    DenseTableFactor operator/(const DenseTableFactor& f) const;
+
+    /// Sum out the first nrFrontals keys
+    shared_ptr sum(size_t nrFrontals) const;
+
+    /// Sum out the given keys
+    shared_ptr sum(const Ordering& keys) const;
+
+    /// Maximize over the first nrFrontals keys
+    shared_ptr max(size_t nrFrontals) const;
+
+    /// Maximize over the given keys
+    shared_ptr max(const Ordering& keys) const;
+
+    /// Cardinality of key j
+    size_t cardinality(Key j) const;
+
+    /// Keys and cardinalities
+    DiscreteKeys discreteKeys() const;
+
+    /// The flat table
+    const Vector& table() const { return table_; }
+
+    /// @}
+
+  protected:
+
+    enum BinaryOp { PRODUCT, DIVIDE };
+    enum ReduceOp { SUM, MAX };
+
+    /// Binary operation on the union of keys
+    DenseTableFactor apply(const DenseTableFactor& f, BinaryOp op) const;
+
+    /// Sum or maximize over the keys flagged in eliminate
+    shared_ptr reduce(const std::vector<bool>& eliminate, ReduceOp op) const;
+
+    /// Flags for the keys in the given ordering
+    std::vector<bool> flags(const Ordering& keys) const;
+  };
+
+} // namespace gtsam
@@ -22,6 +22,7 @@
 #include <gtsam/inference/BayesTreeCliqueBase-inst.h>
 #include <gtsam/discrete/DiscreteBayesTree.h>
 #include <gtsam/discrete/DiscreteBayesNet.h>
+#include <gtsam/base/ConcurrentMap.h>
 
 namespace gtsam {
 
@@ -36,6 +37,47 @@ namespace gtsam {
     return Base::equals(other, tol);
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Values of the frontal and separator keys of a clique, passed to children
+    struct OptimizeData {
+      DiscreteFactor::Values values;
+    };
+
+    // Pre-order visitor that solves a clique given the solution of its parent.
+    // Children only need their separator values, so each clique copies those
+    // instead of the whole solution so far.
+    struct OptimizeClique {
+      ConcurrentMap<Key, size_t> collectedResult;
+
+      OptimizeData operator()(const DiscreteBayesTreeClique::shared_ptr& clique,
+          OptimizeData& parentData) {
+        const DiscreteConditional& conditional = *clique->conditional();
+        OptimizeData myData;
+        BOOST_FOREACH(Key parent, conditional.parents())
+          myData.values[parent] = parentData.values.at(parent);
+        conditional.solveInPlace(myData.values);
+        BOOST_FOREACH(Key j, conditional.frontals())
+          collectedResult.insert(std::make_pair(j, myData.values[j]));
+        return myData;
+      }
+    };
+  }
+
+  /* ************************************************************************* */
+  DiscreteFactor::sharedValues DiscreteBayesTree::optimize() const {
+    gttic(DiscreteBayesTree_optimize);
+    OptimizeData rootData;
+    OptimizeClique preVisitor;
+    treeTraversal::no_op postVisitor;
+    TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+    treeTraversal::DepthFirstForestParallel(*this, rootData, preVisitor, postVisitor);
+
+    DiscreteFactor::sharedValues result(new DiscreteFactor::Values());
+    result->insert(preVisitor.collectedResult.begin(), preVisitor.collectedResult.end());
+    return result;
+  }
+
 } // \namespace gtsam
 
 
@@ -61,6 +61,15 @@ namespace gtsam {
 
     /** Check equality */
     bool equals(const This& other, double tol = 1e-9) const;
+
+    /**
+     * Solve each clique top-down, taking the most probable values of its frontal
+     * variables given the values of its separator.  Sibling subtrees are solved in
+     * parallel when TBB is enabled.  This is the MPE if the tree was eliminated with
+     * EliminateForMPE, but not in general on the sum-product conditionals of the
+     * default elimination.
+     */
+    DiscreteFactor::sharedValues optimize() const;
   };
 
 }
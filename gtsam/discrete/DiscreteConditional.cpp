@@ -58,6 +58,14 @@ DiscreteConditional::DiscreteConditional(const DecisionTreeFactor& joint,
   }
 }
 
+/* ******************************************************************************** */
+DiscreteConditional::DiscreteConditional(size_t nrFrontals,
+    const DecisionTreeFactor& conditional, const Ordering& orderedKeys) :
+    BaseFactor(conditional), BaseConditional(nrFrontals) {
+  keys_.clear();
+  keys_.insert(keys_.end(), orderedKeys.begin(), orderedKeys.end());
+}
+
 /* ******************************************************************************** */
 DiscreteConditional::DiscreteConditional(const Signature& signature) :
         BaseFactor(signature.discreteKeysParentsFirst(), signature.cpt()), BaseConditional(
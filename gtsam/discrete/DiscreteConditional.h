@@ -62,6 +62,13 @@ public:
   DiscreteConditional(const DecisionTreeFactor& joint,
       const DecisionTreeFactor& marginal, const boost::optional<Ordering>& orderedKeys = boost::none);
 
+  /**
+   * construct from a table P(F|S) that is already normalized, with keys
+   * ordered frontals first; unlike the constructors above, no division is done
+   */
+  DiscreteConditional(size_t nrFrontals, const DecisionTreeFactor& conditional,
+      const Ordering& orderedKeys);
+
   /**
    * Combine several conditional into a single one.
    * The conditionals must be given in increasing order, meaning that the parents
@@ -30,6 +30,12 @@ namespace gtsam {
     const Ordering& order) :
   Base(factorGraph, structure, order) {}
 
+  /* ************************************************************************* */
+  DiscreteEliminationTree::DiscreteEliminationTree(
+    const DiscreteFactorGraph& factorGraph, const CompressedVariableIndex& structure,
+    const Ordering& order) :
+  Base(factorGraph, structure, order) {}
+
   /* ************************************************************************* */
   DiscreteEliminationTree::DiscreteEliminationTree(
     const DiscreteFactorGraph& factorGraph, const Ordering& order) :
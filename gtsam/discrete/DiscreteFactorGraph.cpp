@@ -22,6 +22,8 @@
 #include <gtsam/discrete/DiscreteBayesTree.h>
 #include <gtsam/discrete/DiscreteEliminationTree.h>
 #include <gtsam/discrete/DiscreteJunctionTree.h>
+#include <gtsam/discrete/DecisionDiagram.h>
+#include <gtsam/discrete/DenseTableFactor.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
 #include <boost/make_shared.hpp>
@@ -54,6 +56,35 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Multiply all factors into one diagram, collecting their cardinalities
+    DecisionDiagram::NodeId productInDiagram(const DiscreteFactorGraph& factors,
+        DecisionDiagram& diagram, std::map<Key, size_t>& cardinalities) {
+      DecisionDiagram::NodeId product = diagram.one();
+      BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors) {
+        if (!factor) continue;
+        DecisionTreeFactor f = factor->toDecisionTreeFactor();
+        BOOST_FOREACH(Key j, f.keys())
+          cardinalities[j] = f.cardinality(j);
+        product = diagram.apply(product, diagram.fromTree(f),
+            DecisionDiagram::PRODUCT);
+      }
+      return product;
+    }
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DiscreteFactorGraph::productDiagram() const {
+    DecisionDiagram diagram;
+    std::map<Key, size_t> cardinalities;
+    DecisionDiagram::NodeId product = productInDiagram(*this, diagram, cardinalities);
+    DiscreteKeys keys;
+    BOOST_FOREACH(const DiscreteKey& key, cardinalities)
+      keys.push_back(key);
+    return DecisionTreeFactor(keys, diagram.toTree(product));
+  }
+
   /* ************************************************************************* */
   double DiscreteFactorGraph::operator()(
       const DiscreteFactor::Values &values) const {
@@ -100,10 +131,43 @@ namespace gtsam {
     return BaseEliminateable::eliminateSequential()->optimize();
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Whether the product of the factors is large and dense enough to be
+    // computed in a DenseTableFactor, see DenseTableFactor::PreferDense
+    bool preferDense(const DiscreteFactorGraph& factors) {
+      std::map<Key, size_t> cardinalities;
+      size_t nrLeaves = 0, nrEntries = 0;
+      BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors) {
+        if (!factor) continue;
+        size_t size = 1;
+        if (const DenseTableFactor* dense =
+            dynamic_cast<const DenseTableFactor*>(factor.get())) {
+          BOOST_FOREACH(Key j, dense->keys())
+            size *= (cardinalities[j] = dense->cardinality(j));
+          nrLeaves += size;
+        } else if (const DecisionTreeFactor* tree =
+            dynamic_cast<const DecisionTreeFactor*>(factor.get())) {
+          BOOST_FOREACH(Key j, tree->keys())
+            size *= (cardinalities[j] = tree->cardinality(j));
+          nrLeaves += tree->nrLeaves();
+        } else {
+          return false; // other factor types stay on the tree path
+        }
+        nrEntries += size;
+      }
+      return DenseTableFactor::PreferDense(cardinalities, nrLeaves, nrEntries);
+    }
+  }
+
   /* ************************************************************************* */
   std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
   EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
 
+    // Large products of dense tables are cheaper as flat tables
+    if (preferDense(factors))
+      return EliminateDiscreteDense(factors, frontalKeys);
+
     // PRODUCT: multiply all factors
     gttic(product);
     DecisionTreeFactor product;
@@ -129,6 +193,113 @@ namespace gtsam {
     return std::make_pair(cond, sum);
   }
 
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateForMPE(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
+
+    // PRODUCT: multiply all factors
+    gttic(product);
+    DecisionTreeFactor product;
+    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors)
+      product = (*factor) * product;
+    gttoc(product);
+
+    // max out frontals, this is the factor on the separator
+    gttic(max);
+    DecisionTreeFactor::shared_ptr max = product.combine(frontalKeys, DecisionTreeFactor::ADT::Ring::max);
+    gttoc(max);
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(), frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), max->keys().begin(), max->keys().end());
+
+    // now divide product/max to get conditional
+    gttic(divide);
+    DiscreteConditional::shared_ptr cond(new DiscreteConditional(product, *max, orderedKeys));
+    gttoc(divide);
+
+    return std::make_pair(cond, max);
+  }
+
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateDiscreteDiagram(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
+
+    // One arena for this elimination step
+    DecisionDiagram diagram;
+
+    // PRODUCT: multiply all factors
+    gttic(product);
+    std::map<Key, size_t> cardinalities;
+    DecisionDiagram::NodeId product = productInDiagram(factors, diagram, cardinalities);
+    gttoc(product);
+
+    // sum out frontals, this is the factor on the separator
+    gttic(sum);
+    DecisionDiagram::NodeId sum = product;
+    BOOST_FOREACH(Key j, frontalKeys)
+      sum = diagram.combine(sum, j, cardinalities.at(j), DecisionDiagram::SUM);
+    gttoc(sum);
+
+    // Separator keys are all keys that are not frontal
+    DiscreteKeys separatorKeys;
+    BOOST_FOREACH(const DiscreteKey& key, cardinalities)
+      if (std::find(frontalKeys.begin(), frontalKeys.end(), key.first) == frontalKeys.end())
+        separatorKeys.push_back(key);
+    DecisionTreeFactor::shared_ptr sumFactor =
+        boost::make_shared<DecisionTreeFactor>(separatorKeys, diagram.toTree(sum));
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(), frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), sumFactor->keys().begin(), sumFactor->keys().end());
+
+    // now divide product/sum to get conditional
+    gttic(divide);
+    DiscreteKeys allKeys;
+    BOOST_FOREACH(const DiscreteKey& key, cardinalities)
+      allKeys.push_back(key);
+    DecisionDiagram::NodeId conditional = diagram.apply(product, sum, DecisionDiagram::DIVIDE);
+    DiscreteConditional::shared_ptr cond = boost::make_shared<DiscreteConditional>(
+        frontalKeys.size(), DecisionTreeFactor(allKeys, diagram.toTree(conditional)),
+        orderedKeys);
+    gttoc(divide);
+
+    return std::make_pair(cond, sumFactor);
+  }
+
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateDiscreteDense(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
+
+    // PRODUCT: multiply all factors
+    gttic(product);
+    DenseTableFactor product;
+    BOOST_FOREACH(const DiscreteFactor::shared_ptr& factor, factors)
+      if (factor) product = product * (*DenseTableFactor::FromFactor(*factor));
+    gttoc(product);
+
+    // sum out frontals, this is the factor on the separator
+    gttic(sum);
+    DenseTableFactor::shared_ptr sum = product.sum(frontalKeys);
+    gttoc(sum);
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(), frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), sum->keys().begin(), sum->keys().end());
+
+    // now divide product/sum to get conditional
+    gttic(divide);
+    DiscreteConditional::shared_ptr cond = boost::make_shared<DiscreteConditional>(
+        frontalKeys.size(), (product / *sum).toDecisionTreeFactor(), orderedKeys);
+    gttoc(divide);
+
+    return std::make_pair(cond,
+        boost::make_shared<DecisionTreeFactor>(sum->toDecisionTreeFactor()));
+  }
+
 /* ************************************************************************* */
 } // namespace
 
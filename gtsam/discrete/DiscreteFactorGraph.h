@@ -41,6 +41,33 @@ class DiscreteJunctionTree;
 GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
 EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& keys);
 
+/**
+ * Elimination function for DiscreteFactorGraph that multiplies, sums out and
+ * divides in a hash-consed DecisionDiagram, so identical sub-tables are stored
+ * once and repeated sub-products are memoized. Produces the same conditional
+ * and separator factor as EliminateDiscrete, as canonically reduced trees.
+ * Pass it to eliminateSequential/eliminateMultifrontal as the function argument.
+ */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateDiscreteDiagram(const DiscreteFactorGraph& factors, const Ordering& keys);
+
+/**
+ * Elimination function for DiscreteFactorGraph that multiplies, sums out and
+ * divides in a flat DenseTableFactor. EliminateDiscrete calls it automatically
+ * when DenseTableFactor::PreferDense holds for the factors being eliminated.
+ */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateDiscreteDense(const DiscreteFactorGraph& factors, const Ordering& keys);
+
+/**
+ * Max-product elimination function for DiscreteFactorGraph: the separator
+ * factor is the maximum instead of the sum over the frontal variables, and the
+ * conditional is the product divided by it.  Solving the resulting Bayes net
+ * or Bayes tree top-down, with optimize(), gives the MPE.
+ */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateForMPE(const DiscreteFactorGraph& factors, const Ordering& keys);
+
 /* ************************************************************************* */
 template<> struct EliminationTraits<DiscreteFactorGraph>
 {
@@ -125,6 +152,10 @@ public:
   /** return product of all factors as a single factor */
   DecisionTreeFactor product() const;
 
+  /** return product of all factors as a single factor, computed in one
+   *  DecisionDiagram arena so that shared sub-tables are not duplicated */
+  DecisionTreeFactor productDiagram() const;
+
   /** Evaluates the factor graph given values, returns the joint probability of the factor graph given specific instantiation of values*/
   double operator()(const DiscreteFactor::Values & values) const;
 
@@ -0,0 +1,223 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DiscreteSampler.cpp
+ * @brief   Draw many samples at once from a DiscreteBayesNet or DiscreteBayesTree
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DiscreteSampler.h>
+#include <gtsam/discrete/DiscreteBayesNet.h>
+#include <gtsam/discrete/DiscreteBayesTree.h>
+
+#include <boost/foreach.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  void DiscreteSampler::add(const DiscreteConditional& conditional) {
+    Table table;
+
+    // Frontal keys get new columns, first frontal is most significant
+    table.nrValues = 1;
+    BOOST_FOREACH(Key j, conditional.frontals()) {
+      if (columns_.count(j))
+        throw invalid_argument("DiscreteSampler: key appears as frontal twice");
+      table.frontals.push_back(keys_.size());
+      table.frontalCardinalities.push_back(conditional.cardinality(j));
+      table.nrValues *= conditional.cardinality(j);
+      columns_[j] = keys_.size();
+      keys_.push_back(j);
+    }
+
+    // Parents must be sampled before, first parent is most significant
+    size_t nrRows = 1;
+    std::vector<size_t> parentCardinalities;
+    BOOST_FOREACH(Key j, conditional.parents()) {
+      std::map<Key, size_t>::const_iterator column = columns_.find(j);
+      if (column == columns_.end())
+        throw invalid_argument(
+            "DiscreteSampler: conditionals must be given parents first");
+      table.parents.push_back(column->second);
+      parentCardinalities.push_back(conditional.cardinality(j));
+      nrRows *= conditional.cardinality(j);
+    }
+    table.parentStrides.resize(table.parents.size());
+    for (size_t k = table.parents.size(), stride = 1; k-- > 0;) {
+      table.parentStrides[k] = stride;
+      stride *= parentCardinalities[k];
+    }
+
+    // Tabulate P(F|S) row by row and accumulate into a normalized cdf
+    table.cdf.resize(nrRows * table.nrValues);
+    DiscreteFactor::Values values;
+    for (size_t row = 0; row < nrRows; ++row) {
+      for (size_t k = 0; k < table.parents.size(); ++k)
+        values[keys_[table.parents[k]]] =
+            (row / table.parentStrides[k]) % parentCardinalities[k];
+      double* cdf = &table.cdf[row * table.nrValues];
+      double sum = 0;
+      for (size_t v = 0; v < table.nrValues; ++v) {
+        for (size_t k = table.frontals.size(), rest = v; k-- > 0;) {
+          values[keys_[table.frontals[k]]] = rest % table.frontalCardinalities[k];
+          rest /= table.frontalCardinalities[k];
+        }
+        sum += conditional(values);
+        cdf[v] = sum;
+      }
+      // Impossible parent values get a uniform row, so sampling stays defined
+      for (size_t v = 0; v < table.nrValues; ++v)
+        cdf[v] = (sum > 0) ? cdf[v] / sum : double(v + 1) / table.nrValues;
+      cdf[table.nrValues - 1] = 1.0;
+    }
+    tables_.push_back(table);
+  }
+
+  /* ************************************************************************* */
+  DiscreteSampler::DiscreteSampler(const DiscreteBayesNet& bayesNet) {
+    // Bayes nets from elimination are stored children first, but hand-built
+    // ones often are not, so defer conditionals until their parents are known
+    std::vector<DiscreteConditional::shared_ptr> pending;
+    BOOST_REVERSE_FOREACH(const DiscreteConditional::shared_ptr& conditional, bayesNet)
+      if (conditional) pending.push_back(conditional);
+    while (!pending.empty()) {
+      std::vector<DiscreteConditional::shared_ptr> deferred;
+      BOOST_FOREACH(const DiscreteConditional::shared_ptr& conditional, pending) {
+        bool ready = true;
+        BOOST_FOREACH(Key j, conditional->parents())
+          if (!columns_.count(j)) ready = false;
+        if (ready)
+          add(*conditional);
+        else
+          deferred.push_back(conditional);
+      }
+      if (deferred.size() == pending.size())
+        throw invalid_argument("DiscreteSampler: Bayes net has a missing parent or a cycle");
+      pending.swap(deferred);
+    }
+  }
+
+  /* ************************************************************************* */
+  DiscreteSampler::DiscreteSampler(const DiscreteBayesTree& bayesTree) {
+    // Pre-order traversal visits every clique after its parent
+    std::vector<DiscreteBayesTree::sharedClique> stack(
+        bayesTree.roots().rbegin(), bayesTree.roots().rend());
+    while (!stack.empty()) {
+      DiscreteBayesTree::sharedClique clique = stack.back();
+      stack.pop_back();
+      add(*clique->conditional());
+      stack.insert(stack.end(), clique->children.rbegin(), clique->children.rend());
+    }
+  }
+
+  namespace {
+    /* ************************************************************************* */
+    // Look up the sampled frontal values of samples [begin,end) in their rows
+    template<class TABLE>
+    void lookupSamples(const TABLE& table, const std::vector<size_t>& rows,
+        const std::vector<double>& uniform,
+        std::vector<std::vector<size_t> >& columns, size_t begin, size_t end) {
+      const size_t nrValues = table.nrValues;
+      for (size_t i = begin; i < end; ++i) {
+        const double* cdf = &table.cdf[rows[i] * nrValues];
+        size_t rest = std::upper_bound(cdf, cdf + nrValues, uniform[i]) - cdf;
+        if (rest == nrValues) rest = nrValues - 1;
+        for (size_t k = table.frontals.size(); k-- > 0;) {
+          columns[table.frontals[k]][i] = rest % table.frontalCardinalities[k];
+          rest /= table.frontalCardinalities[k];
+        }
+      }
+    }
+
+#ifdef GTSAM_USE_TBB
+    /* ************************************************************************* */
+    template<class TABLE>
+    struct _LookupSamples {
+      const TABLE& table;
+      const std::vector<size_t>& rows;
+      const std::vector<double>& uniform;
+      std::vector<std::vector<size_t> >& columns;
+
+      _LookupSamples(const TABLE& table, const std::vector<size_t>& rows,
+          const std::vector<double>& uniform,
+          std::vector<std::vector<size_t> >& columns) :
+          table(table), rows(rows), uniform(uniform), columns(columns) {
+      }
+
+      void operator()(const tbb::blocked_range<size_t>& r) const {
+        lookupSamples(table, rows, uniform, columns, r.begin(), r.end());
+      }
+    };
+#endif
+  }
+
+  /* ************************************************************************* */
+  DiscreteSampler::Samples DiscreteSampler::sample(size_t N,
+      boost::mt19937& rng) const {
+    gttic(DiscreteSampler_sample);
+    std::vector<std::vector<size_t> > columns(keys_.size(), std::vector<size_t>(N));
+    std::vector<size_t> rows(N);
+    std::vector<double> uniform(N);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<> > die(rng,
+        boost::uniform_real<>(0, 1));
+
+    BOOST_FOREACH(const Table& table, tables_) {
+      // Row of every sample, from the columns of the parents
+      std::fill(rows.begin(), rows.end(), 0);
+      for (size_t k = 0; k < table.parents.size(); ++k) {
+        const std::vector<size_t>& parent = columns[table.parents[k]];
+        const size_t stride = table.parentStrides[k];
+        for (size_t i = 0; i < N; ++i)
+          rows[i] += parent[i] * stride;
+      }
+
+      // Draw serially for reproducibility, then invert the cdf
+      for (size_t i = 0; i < N; ++i)
+        uniform[i] = die();
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, N, 1024),
+          _LookupSamples<Table>(table, rows, uniform, columns));
+#else
+      lookupSamples(table, rows, uniform, columns, 0, N);
+#endif
+    }
+
+    Samples samples;
+    for (size_t c = 0; c < keys_.size(); ++c)
+      samples[keys_[c]].swap(columns[c]);
+    return samples;
+  }
+
+  /* ************************************************************************* */
+  DiscreteFactor::Values DiscreteSampler::SampleAt(const Samples& samples,
+      size_t i) {
+    DiscreteFactor::Values values;
+    typedef std::pair<const Key, std::vector<size_t> > KeySamples;
+    BOOST_FOREACH(const KeySamples& key, samples)
+      values[key.first] = key.second.at(i);
+    return values;
+  }
+
+/* ************************************************************************* */
+} // namespace gtsam
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DiscreteSampler.h
+ * @brief   Draw many samples at once from a DiscreteBayesNet or DiscreteBayesTree
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/discrete/DiscreteConditional.h>
+
+#include <boost/random/mersenne_twister.hpp>
+
+#include <map>
+#include <vector>
+
+namespace gtsam {
+
+  // Forward declarations
+  class DiscreteBayesNet;
+  class DiscreteBayesTree;
+
+  /**
+   * Ancestral sampler that draws N joint assignments in one top-down pass.
+   *
+   * On construction every conditional P(F|S) is tabulated as a cumulative
+   * distribution over the joint frontal values F, one row per assignment of
+   * the parents S. Sampling then visits the conditionals parents first, and
+   * for each one computes the row index of all N samples from the columns of
+   * the parents, and finds the sampled frontal values by binary search in that
+   * row. Samples are stored per key, so all work is on contiguous arrays rather
+   * than on one DiscreteFactor::Values per sample. Unlike
+   * DiscreteBayesNet::sample, conditionals with several frontal keys are
+   * supported, so Bayes trees can be sampled directly.
+   */
+  class GTSAM_EXPORT DiscreteSampler {
+
+  public:
+
+    /// N values for every key, indexed by sample
+    typedef std::map<Key, std::vector<size_t> > Samples;
+
+  protected:
+
+    /// Cumulative table of one conditional
+    struct Table {
+      std::vector<size_t> frontals;             ///< columns of the frontal keys
+      std::vector<size_t> frontalCardinalities; ///< cardinalities of the frontal keys
+      std::vector<size_t> parents;              ///< columns of the parent keys
+      std::vector<size_t> parentStrides;        ///< row stride of each parent
+      size_t nrValues;                          ///< nr. of joint frontal values
+      std::vector<double> cdf;                  ///< one cumulative row per parent value
+    };
+
+    std::vector<Table> tables_;      ///< tables, parents before children
+    std::vector<Key> keys_;          ///< key of each column
+    std::map<Key, size_t> columns_;  ///< column of each key
+
+    /// Tabulate a conditional whose parents have all been added before
+    void add(const DiscreteConditional& conditional);
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Tabulate the conditionals of a Bayes net, as returned by eliminateSequential */
+    explicit DiscreteSampler(const DiscreteBayesNet& bayesNet);
+
+    /** Tabulate the clique conditionals of a Bayes tree, as returned by eliminateMultifrontal */
+    explicit DiscreteSampler(const DiscreteBayesTree& bayesTree);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Number of keys that are sampled
+    size_t size() const { return keys_.size(); }
+
+    /**
+     * Draw N joint samples. Uniform variates are drawn from rng in a fixed order,
+     * so results are reproducible regardless of the number of threads.
+     */
+    Samples sample(size_t N, boost::mt19937& rng) const;
+
+    /// Extract sample i as an assignment
+    static DiscreteFactor::Values SampleAt(const Samples& samples, size_t i);
+
+    /// @}
+  };
+
+} // namespace gtsam
@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * @file    testDecisionDiagram.cpp
+ * @brief   Unit tests for the hash-consed DecisionDiagram arena
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DecisionDiagram.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+#include <gtsam/discrete/DiscreteConditional.h>
+#include <gtsam/discrete/DiscreteBayesNet.h>
+#include <gtsam/discrete/Signature.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+typedef AlgebraicDecisionTree<Key> ADT;
+
+/* ************************************************************************* */
+// Check that two functions agree on every assignment of keys
+template<class F, class G>
+bool sameValues(const F& f, const G& g, const DiscreteKeys& keys, double tol = 1e-9) {
+  BOOST_FOREACH(const Assignment<Key>& x, cartesianProduct(keys))
+    if (fabs(f(x) - g(x)) > tol) return false;
+  return true;
+}
+
+// Same as Potentials::safe_div
+double safeDiv(const double& a, const double& b) {
+  return (a == 0 || b == 0) ? 0 : (a / b);
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, leavesAreUnique ) {
+  DecisionDiagram dd;
+  DecisionDiagram::NodeId a = dd.leaf(0.5), b = dd.leaf(0.5);
+  EXPECT(a == b);
+  EXPECT(dd.leaf(0.0) == dd.leaf(-0.0));
+  EXPECT(dd.leaf(0.25) != a);
+  LONGS_EQUAL(3, dd.size());
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, reduction ) {
+  DecisionDiagram dd;
+  DecisionDiagram::NodeId x = dd.leaf(1), y = dd.leaf(2);
+
+  // choice between identical branches is the branch itself
+  vector<DecisionDiagram::NodeId> same(3, x);
+  EXPECT(dd.choice(0, same) == x);
+
+  // identical choices are hash-consed
+  vector<DecisionDiagram::NodeId> branches;
+  branches.push_back(x);
+  branches.push_back(y);
+  DecisionDiagram::NodeId c1 = dd.choice(0, branches);
+  DecisionDiagram::NodeId c2 = dd.choice(0, branches);
+  EXPECT(c1 == c2);
+
+  // and a choice on a higher label over identical sub-diagrams collapses,
+  // which DecisionTree does not do for Choice branches
+  vector<DecisionDiagram::NodeId> top(2, c1);
+  EXPECT(dd.choice(1, top) == c1);
+  LONGS_EQUAL(3, dd.nrNodes(c1));
+
+  // labels must decrease towards the leaves
+  CHECK_EXCEPTION(dd.choice(0, top), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, treeRoundTrip ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2);
+  DiscreteKeys keys = A & B & C;
+  // Table does not depend on B, a tree still stores it three times
+  ADT f(keys, "1 2 1 2 1 2   3 4 3 4 3 4");
+
+  DecisionDiagram dd;
+  DecisionDiagram::NodeId n = dd.fromTree(f);
+  EXPECT(sameValues(f, dd.toTree(n), keys));
+  for (size_t a = 0; a < 2; ++a)
+    for (size_t b = 0; b < 3; ++b)
+      for (size_t c = 0; c < 2; ++c) {
+        Assignment<Key> x;
+        x[0] = a; x[1] = b; x[2] = c;
+        EXPECT_DOUBLES_EQUAL(f(x), dd(n, x), 1e-9);
+      }
+
+  // C, A, and four leaves, with no node on B
+  LONGS_EQUAL(7, dd.nrNodes(n));
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, apply ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2);
+  ADT f(A & B, "1 2 3  4 5 6");
+  ADT g(B & C, "0.5 1  2 0  1 3");
+
+  DecisionDiagram dd;
+  DecisionDiagram::NodeId nf = dd.fromTree(f), ng = dd.fromTree(g);
+  DiscreteKeys keys = A & B & C;
+
+  EXPECT(sameValues(f * g, dd.toTree(dd.apply(nf, ng, DecisionDiagram::PRODUCT)), keys));
+  EXPECT(sameValues(f + g, dd.toTree(dd.apply(nf, ng, DecisionDiagram::SUM)), keys));
+  EXPECT(sameValues(f.apply(g, &ADT::Ring::max),
+      dd.toTree(dd.apply(nf, ng, DecisionDiagram::MAX)), keys));
+  EXPECT(sameValues(f.apply(g, &safeDiv),
+      dd.toTree(dd.apply(nf, ng, DecisionDiagram::DIVIDE)), keys));
+
+  // Second application is answered by the operation cache
+  DecisionDiagram::NodeId h1 = dd.apply(nf, ng, DecisionDiagram::PRODUCT);
+  DecisionDiagram::NodeId h2 = dd.apply(ng, nf, DecisionDiagram::PRODUCT);
+  EXPECT(h1 == h2);
+  EXPECT(dd.cacheHitRate() > 0);
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, combineAndChoose ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2);
+  DiscreteKeys keys = A & B & C;
+  ADT f(keys, "1 2 3 4 5 6   7 8 9 10 11 12");
+
+  DecisionDiagram dd;
+  DecisionDiagram::NodeId n = dd.fromTree(f);
+  EXPECT(sameValues(f.sum(B), dd.toTree(dd.combine(n, 1, 3, DecisionDiagram::SUM)), keys));
+  EXPECT(sameValues(f.sum(A), dd.toTree(dd.combine(n, 0, 2, DecisionDiagram::SUM)), keys));
+  EXPECT(sameValues(f.combine(C, &ADT::Ring::max),
+      dd.toTree(dd.combine(n, 2, 2, DecisionDiagram::MAX)), keys));
+  EXPECT(sameValues(f.choose(1, 2), dd.toTree(dd.choose(n, 1, 2)), keys));
+
+  dd.clear();
+  LONGS_EQUAL(0, dd.size());
+}
+
+/* ************************************************************************* */
+TEST( DecisionDiagram, productAndEliminate ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2), D(3, 2);
+  DiscreteFactorGraph graph;
+  graph.add(A & B, "1 2 3  4 5 6");
+  graph.add(B & C, "0.5 1  2 0  1 3");
+  graph.add(C & D, "1 1  0.2 0.8");
+  graph.add(A, "0.3 0.7");
+  DiscreteKeys keys = A & B & C & D;
+
+  EXPECT(sameValues(graph.product(), graph.productDiagram(), keys));
+
+  Ordering frontals;
+  frontals.push_back(0);
+  frontals.push_back(1);
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>
+      expected = EliminateDiscrete(graph, frontals),
+      actual = EliminateDiscreteDiagram(graph, frontals);
+  EXPECT(expected.first->keys() == actual.first->keys());
+  LONGS_EQUAL(expected.first->nrFrontals(), actual.first->nrFrontals());
+  EXPECT(sameValues(*expected.first, *actual.first, keys));
+  EXPECT(expected.second->keys() == actual.second->keys());
+  EXPECT(sameValues(*expected.second, *actual.second, keys));
+
+  // Same MPE through a full elimination
+  Ordering ordering;
+  for (Key j = 0; j < 4; ++j)
+    ordering.push_back(j);
+  DiscreteFactor::sharedValues mpe1 =
+      graph.eliminateSequential(ordering, EliminateDiscrete)->optimize();
+  DiscreteFactor::sharedValues mpe2 =
+      graph.eliminateSequential(ordering, EliminateDiscreteDiagram)->optimize();
+  EXPECT(*mpe1 == *mpe2);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,176 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * @file    testDenseTableFactor.cpp
+ * @brief   Unit tests for DenseTableFactor
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DenseTableFactor.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+#include <gtsam/discrete/DiscreteConditional.h>
+#include <gtsam/discrete/DiscreteBayesNet.h>
+#include <gtsam/discrete/Signature.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Check that two factors agree on every assignment of keys
+template<class F, class G>
+bool sameValues(const F& f, const G& g, const DiscreteKeys& keys, double tol = 1e-9) {
+  BOOST_FOREACH(const Assignment<Key>& x, cartesianProduct(keys))
+    if (fabs(f(x) - g(x)) > tol) return false;
+  return true;
+}
+
+/* ************************************************************************* */
+TEST( DenseTableFactor, constructors ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2);
+
+  // Keys given out of order are sorted, values follow them
+  vector<double> table;
+  for (size_t i = 0; i < 12; ++i)
+    table.push_back(i + 1);
+  DenseTableFactor f(C & A & B, table);
+  DecisionTreeFactor expected(C & A & B, "1 2 3 4 5 6 7 8 9 10 11 12");
+  EXPECT(sameValues(expected, f, A & B & C));
+  EXPECT(f.keys()[0] == 0 && f.keys()[2] == 2);
+  LONGS_EQUAL(3, f.cardinality(1));
+
+  // From and back to a decision tree
+  DenseTableFactor g(expected);
+  EXPECT(assert_equal(f, g));
+  EXPECT(sameValues(expected, g.toDecisionTreeFactor(), A & B & C));
+
+  // A tree that does not split on all of its keys
+  DecisionTreeFactor pruned(A & B & C, "1 1 1 1 1 1  2 3 2 3 2 3");
+  EXPECT(sameValues(pruned, DenseTableFactor(pruned), A & B & C));
+
+  CHECK_EXCEPTION(DenseTableFactor(A & B, table), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( DenseTableFactor, product ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2), D(3, 2);
+  DecisionTreeFactor f1(A & C, "1 2 3 4");
+  DecisionTreeFactor f2(B & C & D, "1 2 3 4  0.5 1 2 0  1 3 0 2");
+  DecisionTreeFactor f3(B, "0.2 0.3 0.5");
+  DiscreteKeys keys = A & B & C & D;
+
+  DenseTableFactor d1(f1), d2(f2), d3(f3);
+  EXPECT(sameValues(f1 * f2, d1 * d2, keys));
+  EXPECT(sameValues(f2 * f1, d2 * d1, keys));
+  EXPECT(sameValues(f1 * f3, d1 * d3, keys));
+  EXPECT(sameValues(f2 * f3, d2 * d3, keys));
+  EXPECT(sameValues(f2 * f2, d2 * d2, keys));
+
+  // Mixed with a tree through the DiscreteFactor interface
+  const DiscreteFactor& base = d1;
+  EXPECT(sameValues(f1 * f2, base * f2, keys));
+
+  // Division by the marginal, 0 where either side is 0
+  DecisionTreeFactor sum = *f2.sum(1);
+  EXPECT(sameValues(f2 / sum, d2 / DenseTableFactor(sum), keys));
+}
+
+/* ************************************************************************* */
+TEST( DenseTableFactor, sumAndMax ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2), D(3, 2);
+  DiscreteKeys keys = A & B & C & D;
+  vector<double> table;
+  for (size_t i = 0; i < 24; ++i)
+    table.push_back((i * 7) % 11 + 1);
+  DecisionTreeFactor f(keys, table);
+  DenseTableFactor d(keys, table);
+
+  EXPECT(sameValues(*f.sum(2), *d.sum(2), keys));
+  EXPECT(sameValues(*f.max(1), *d.max(1), keys));
+  EXPECT(sameValues(*f.sum(4), *d.sum(4), keys));
+
+  Ordering inner, outer;
+  inner.push_back(3);
+  inner.push_back(1);
+  outer.push_back(0);
+  outer.push_back(2);
+  EXPECT(sameValues(*f.sum(inner), *d.sum(inner), keys));
+  EXPECT(sameValues(*f.sum(outer), *d.sum(outer), keys));
+  typedef AlgebraicDecisionTree<Key> ADT;
+  EXPECT(sameValues(ADT(f).combine(D, &ADT::Ring::max).combine(B, &ADT::Ring::max),
+      *d.max(inner), keys));
+  EXPECT(sameValues(ADT(f).combine(A, &ADT::Ring::max).combine(C, &ADT::Ring::max),
+      *d.max(outer), keys));
+
+  Ordering unknown;
+  unknown.push_back(7);
+  CHECK_EXCEPTION(d.sum(unknown), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( DenseTableFactor, eliminate ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2), D(3, 2);
+  DiscreteFactorGraph graph;
+  graph.add(A & B, "1 2 3  4 5 6");
+  graph.add(B & C, "0.5 1  2 0  1 3");
+  graph.add(C & D, "1 1  0.2 0.8");
+  graph.push_back(boost::make_shared<DenseTableFactor>(
+      DecisionTreeFactor(A & D, "0.3 0.7 0.6 0.4")));
+  DiscreteKeys keys = A & B & C & D;
+
+  Ordering frontals;
+  frontals.push_back(1);
+  frontals.push_back(0);
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>
+      expected = EliminateDiscrete(graph, frontals),
+      actual = EliminateDiscreteDense(graph, frontals);
+  EXPECT(expected.first->keys() == actual.first->keys());
+  LONGS_EQUAL(expected.first->nrFrontals(), actual.first->nrFrontals());
+  EXPECT(sameValues(*expected.first, *actual.first, keys));
+  EXPECT(sameValues(*expected.second, *actual.second, keys));
+
+  // EliminateDiscrete takes the dense path once the product is big enough
+  Ordering ordering;
+  for (Key j = 0; j < 4; ++j)
+    ordering.push_back(j);
+  DiscreteFactor::sharedValues mpe1 = graph.eliminateSequential(ordering)->optimize();
+  size_t minimumSize = DenseTableFactor::MinimumSize;
+  DenseTableFactor::MinimumSize = 1;
+  DiscreteFactor::sharedValues mpe2 = graph.eliminateSequential(ordering)->optimize();
+  DenseTableFactor::MinimumSize = minimumSize;
+  EXPECT(*mpe1 == *mpe2);
+}
+
+/* ************************************************************************* */
+TEST( DenseTableFactor, preferDense ) {
+  std::map<Key, size_t> cardinalities;
+  for (Key j = 0; j < 12; ++j)
+    cardinalities[j] = 2;
+  EXPECT(DenseTableFactor::PreferDense(cardinalities, 900, 1000));
+  EXPECT(!DenseTableFactor::PreferDense(cardinalities, 100, 1000));
+
+  // too small
+  cardinalities.erase(11);
+  cardinalities.erase(10);
+  cardinalities.erase(9);
+  EXPECT(!DenseTableFactor::PreferDense(cardinalities, 1000, 1000));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -233,6 +233,26 @@ TEST( DiscreteFactorGraph, testMPE_Darwiche09book_p244)
   //  bayesTree->print("Bayes Tree");
   EXPECT_LONGS_EQUAL(2,bayesTree->size());
 
+  // Solving the sum-product conditionals above top-down does not give the MPE in general.  With
+  // max-product elimination, the Bayes net and the Bayes tree both give it, found here by
+  // enumeration, which differs from the above in the value of 2.
+  DecisionTreeFactor product = graph.product();
+  DiscreteFactor::Values trueMPE;
+  double maxP = 0;
+  BOOST_FOREACH(const DiscreteFactor::Values& values, cartesianProduct(A & C & S & T1 & T2)) {
+    if (product(values) > maxP) {
+      maxP = product(values);
+      trueMPE = values;
+    }
+  }
+  DiscreteFactor::Values expectedMPE2;
+  insert(expectedMPE2)(4, 0)(2, 1)(3, 1)(0, 1)(1, 1);
+  EXPECT(assert_equal(expectedMPE2, trueMPE));
+  EXPECT(assert_equal(expectedMPE2, *graph.eliminateSequential(ordering, EliminateForMPE)->optimize()));
+  DiscreteBayesTree::shared_ptr maxTree = graph.eliminateMultifrontal(ordering, EliminateForMPE);
+  EXPECT_LONGS_EQUAL(2,maxTree->size());
+  EXPECT(assert_equal(expectedMPE2, *maxTree->optimize()));
+
 #ifdef OLD
 // Create the elimination tree manually
 VariableIndexOrdered structure(graph);
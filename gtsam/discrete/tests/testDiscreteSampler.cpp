@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * @file    testDiscreteSampler.cpp
+ * @brief   Unit tests for batch sampling of discrete Bayes nets and trees
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/discrete/DiscreteSampler.h>
+#include <gtsam/discrete/DiscreteBayesNet.h>
+#include <gtsam/discrete/DiscreteBayesTree.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+#include <gtsam/discrete/Signature.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t N = 100000;
+
+/* ************************************************************************* */
+// Frequency of each assignment of keys among the samples
+static map<DiscreteFactor::Values, double> frequencies(
+    const DiscreteSampler::Samples& samples, const DiscreteKeys& keys) {
+  map<DiscreteFactor::Values, double> result;
+  BOOST_FOREACH(const DiscreteFactor::Values& x, cartesianProduct(keys))
+    result[x] = 0;
+  const size_t n = samples.begin()->second.size();
+  for (size_t i = 0; i < n; ++i) {
+    DiscreteFactor::Values x;
+    BOOST_FOREACH(const DiscreteKey& key, keys)
+      x[key.first] = samples.at(key.first)[i];
+    result[x] += 1.0 / n;
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+TEST( DiscreteSampler, bayesNet ) {
+  // Hand-built net.  Conditionals built from a Signature list their parents first and take the
+  // first key as frontal, so the net that is sampled is eliminated from its factors.
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2);
+  DiscreteBayesNet bayesNet;
+  bayesNet.add(A % "3/7");
+  bayesNet.add(B | A = "1/2/1 6/1/1");
+  bayesNet.add((C | A, B) = "9/1 1/1 1/9 5/5 2/8 1/3");
+  Ordering ordering;
+  ordering += Key(2), Key(1), Key(0);
+  DiscreteBayesNet::shared_ptr chordal = DiscreteFactorGraph(bayesNet).eliminateSequential(ordering);
+
+  DiscreteSampler sampler(*chordal);
+  LONGS_EQUAL(3, sampler.size());
+  boost::mt19937 rng(42);
+  DiscreteSampler::Samples samples = sampler.sample(N, rng);
+  LONGS_EQUAL(N, samples.at(2).size());
+
+  // Empirical joint matches the Bayes net
+  typedef pair<const DiscreteFactor::Values, double> Frequency;
+  BOOST_FOREACH(const Frequency& f, frequencies(samples, A & B & C))
+    EXPECT_DOUBLES_EQUAL(bayesNet.evaluate(f.first), f.second, 0.01);
+
+  // Same seed, same samples
+  boost::mt19937 rng2(42);
+  DiscreteSampler::Samples samples2 = sampler.sample(N, rng2);
+  EXPECT(samples == samples2);
+
+  // Extracting one sample
+  DiscreteFactor::Values x = DiscreteSampler::SampleAt(samples, 7);
+  LONGS_EQUAL(3, x.size());
+  LONGS_EQUAL(samples.at(1)[7], x[1]);
+}
+
+/* ************************************************************************* */
+TEST( DiscreteSampler, bayesTree ) {
+  DiscreteKey A(0, 2), B(1, 3), C(2, 2), D(3, 2);
+  DiscreteFactorGraph graph;
+  graph.add(A & B, "1 2 3  4 5 6");
+  graph.add(B & C, "0.5 1  2 0  1 3");
+  graph.add(C & D, "1 1  0.2 0.8");
+  DiscreteKeys keys = A & B & C & D;
+
+  // Cliques have several frontal keys, which DiscreteBayesNet::sample can't do
+  Ordering ordering;
+  ordering += Key(0), Key(3), Key(1), Key(2);
+  DiscreteBayesTree::shared_ptr bayesTree = graph.eliminateMultifrontal(ordering);
+  DiscreteSampler sampler(*bayesTree);
+  LONGS_EQUAL(4, sampler.size());
+
+  boost::mt19937 rng(7);
+  DiscreteSampler::Samples samples = sampler.sample(N, rng);
+  DecisionTreeFactor product = graph.product();
+  double Z = (*product.sum(4))(DiscreteFactor::Values());
+  typedef pair<const DiscreteFactor::Values, double> Frequency;
+  BOOST_FOREACH(const Frequency& f, frequencies(samples, keys))
+    EXPECT_DOUBLES_EQUAL(product(f.first) / Z, f.second, 0.01);
+
+  // Zero-probability assignments are never drawn
+  for (size_t i = 0; i < N; ++i)
+    EXPECT(!(samples.at(1)[i] == 1 && samples.at(2)[i] == 1));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,313 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AutoDiff.h
+ * @brief   Geometry types templated on the scalar, for automatic differentiation with Dual
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Dual.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/PinholeCamera.h>
+
+namespace gtsam {
+
+/**
+ * Counterparts of the geometry types templated on the scalar type T, which is double or Dual<N>.
+ * They have the operations needed to write measurement functions, so that one templated function
+ * gives both the error and, evaluated on Dual numbers, its Jacobians; see AutoDiffFactor1.
+ *
+ * Traits<VALUE> lifts a value of a GTSAM type to its counterpart with Dual scalars, such that the
+ * derivatives are those with respect to the local coordinates of VALUE::retract: a value x
+ * becomes x.retract(d) at d = 0, to first order in d, which is all the derivatives depend on.
+ */
+namespace autodiff {
+
+  /** Lifts a GTSAM type to its counterpart, specialized for each supported type */
+  template<class VALUE>
+  struct Traits;
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::Point2 */
+  template<typename T>
+  class Point2 {
+  public:
+    typedef Eigen::Matrix<T, 2, 1> Vector2;
+
+    Point2() : v_(Vector2::Zero()) {}
+    Point2(const T& x, const T& y) { v_ << x, y; }
+    explicit Point2(const Vector2& v) : v_(v) {}
+    explicit Point2(const gtsam::Point2& p) { v_ << T(p.x()), T(p.y()); }
+
+    const T& x() const { return v_(0); }
+    const T& y() const { return v_(1); }
+    const Vector2& vector() const { return v_; }
+
+    Point2 operator+(const Point2& q) const { return Point2(Vector2(v_ + q.v_)); }
+    Point2 operator-(const Point2& q) const { return Point2(Vector2(v_ - q.v_)); }
+    Point2 operator-() const { return Point2(Vector2(-v_)); }
+    Point2 operator*(const T& s) const { return Point2(Vector2(v_ * s)); }
+    T norm() const { using std::sqrt; return sqrt(v_.squaredNorm()); }
+
+  private:
+    Vector2 v_;
+  };
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::Point3 */
+  template<typename T>
+  class Point3 {
+  public:
+    typedef Eigen::Matrix<T, 3, 1> Vector3;
+
+    Point3() : v_(Vector3::Zero()) {}
+    Point3(const T& x, const T& y, const T& z) { v_ << x, y, z; }
+    explicit Point3(const Vector3& v) : v_(v) {}
+    explicit Point3(const gtsam::Point3& p) { v_ << T(p.x()), T(p.y()), T(p.z()); }
+
+    const T& x() const { return v_(0); }
+    const T& y() const { return v_(1); }
+    const T& z() const { return v_(2); }
+    const Vector3& vector() const { return v_; }
+
+    Point3 operator+(const Point3& q) const { return Point3(Vector3(v_ + q.v_)); }
+    Point3 operator-(const Point3& q) const { return Point3(Vector3(v_ - q.v_)); }
+    Point3 operator-() const { return Point3(Vector3(-v_)); }
+    Point3 operator*(const T& s) const { return Point3(Vector3(v_ * s)); }
+    T dot(const Point3& q) const { return v_.dot(q.v_); }
+    Point3 cross(const Point3& q) const { return Point3(Vector3(v_.cross(q.v_))); }
+    T norm() const { using std::sqrt; return sqrt(v_.squaredNorm()); }
+
+  private:
+    Vector3 v_;
+  };
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::Rot3, as a rotation matrix */
+  template<typename T>
+  class Rot3 {
+  public:
+    typedef Eigen::Matrix<T, 3, 3> Matrix3;
+
+    Rot3() : R_(Matrix3::Identity()) {}
+    explicit Rot3(const Matrix3& R) : R_(R) {}
+    explicit Rot3(const gtsam::Rot3& R) : R_(R.matrix().template cast<T>()) {}
+
+    const Matrix3& matrix() const { return R_; }
+    Matrix3 transpose() const { return R_.transpose(); }
+
+    Rot3 compose(const Rot3& R2) const { return Rot3(Matrix3(R_ * R2.R_)); }
+    Rot3 operator*(const Rot3& R2) const { return compose(R2); }
+    Rot3 inverse() const { return Rot3(transpose()); }
+    Rot3 between(const Rot3& R2) const { return Rot3(Matrix3(R_.transpose() * R2.R_)); }
+
+    Point3<T> rotate(const Point3<T>& p) const { return Point3<T>(typename Point3<T>::Vector3(R_ * p.vector())); }
+    Point3<T> operator*(const Point3<T>& p) const { return rotate(p); }
+    Point3<T> unrotate(const Point3<T>& p) const { return Point3<T>(typename Point3<T>::Vector3(R_.transpose() * p.vector())); }
+
+  private:
+    Matrix3 R_;
+  };
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::Pose3 */
+  template<typename T>
+  class Pose3 {
+  public:
+    Pose3() {}
+    Pose3(const Rot3<T>& R, const Point3<T>& t) : R_(R), t_(t) {}
+    explicit Pose3(const gtsam::Pose3& pose) : R_(pose.rotation()), t_(pose.translation()) {}
+
+    const Rot3<T>& rotation() const { return R_; }
+    const Point3<T>& translation() const { return t_; }
+
+    Pose3 compose(const Pose3& p2) const { return Pose3(R_ * p2.R_, t_ + R_ * p2.t_); }
+    Pose3 operator*(const Pose3& p2) const { return compose(p2); }
+    Pose3 inverse() const { const Rot3<T> Rt = R_.inverse(); return Pose3(Rt, -(Rt * t_)); }
+    Pose3 between(const Pose3& p2) const { return inverse() * p2; }
+
+    /** Transform a point from the pose's coordinates to world coordinates */
+    Point3<T> transform_from(const Point3<T>& p) const { return R_ * p + t_; }
+
+    /** Transform a point from world coordinates to the pose's coordinates */
+    Point3<T> transform_to(const Point3<T>& p) const { return R_.unrotate(p - t_); }
+
+  private:
+    Rot3<T> R_;
+    Point3<T> t_;
+  };
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::Cal3_S2 */
+  template<typename T>
+  class Cal3_S2 {
+  public:
+    Cal3_S2() : fx_(1.0), fy_(1.0), s_(0.0), u0_(0.0), v0_(0.0) {}
+    Cal3_S2(const T& fx, const T& fy, const T& s, const T& u0, const T& v0) :
+      fx_(fx), fy_(fy), s_(s), u0_(u0), v0_(v0) {}
+    explicit Cal3_S2(const gtsam::Cal3_S2& K) :
+      fx_(K.fx()), fy_(K.fy()), s_(K.skew()), u0_(K.px()), v0_(K.py()) {}
+
+    const T& fx() const { return fx_; }
+    const T& fy() const { return fy_; }
+    const T& skew() const { return s_; }
+    const T& px() const { return u0_; }
+    const T& py() const { return v0_; }
+
+    /** Convert intrinsic coordinates to image coordinates */
+    Point2<T> uncalibrate(const Point2<T>& p) const {
+      return Point2<T>(fx_ * p.x() + s_ * p.y() + u0_, fy_ * p.y() + v0_);
+    }
+
+    /** Convert image coordinates to intrinsic coordinates */
+    Point2<T> calibrate(const Point2<T>& p) const {
+      const T y = (p.y() - v0_) / fy_;
+      return Point2<T>((p.x() - u0_ - s_ * y) / fx_, y);
+    }
+
+  private:
+    T fx_, fy_, s_, u0_, v0_;
+  };
+
+  /* ************************************************************************* */
+  /** Counterpart of gtsam::PinholeCamera<gtsam::Cal3_S2> */
+  template<typename T>
+  class PinholeCamera {
+  public:
+    PinholeCamera() {}
+    PinholeCamera(const Pose3<T>& pose, const Cal3_S2<T>& K) : pose_(pose), K_(K) {}
+    explicit PinholeCamera(const gtsam::PinholeCamera<gtsam::Cal3_S2>& camera) :
+      pose_(camera.pose()), K_(camera.calibration()) {}
+
+    const Pose3<T>& pose() const { return pose_; }
+    const Cal3_S2<T>& calibration() const { return K_; }
+
+    /** Project a point in camera coordinates to the normalized image plane */
+    static Point2<T> project_to_camera(const Point3<T>& pc) {
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+      if (pc.z() <= 0.0)
+        throw CheiralityException();
+#endif
+      const T d = 1.0 / pc.z();
+      return Point2<T>(pc.x() * d, pc.y() * d);
+    }
+
+    /** Project a point in world coordinates to the image */
+    Point2<T> project(const Point3<T>& pw) const {
+      return K_.uncalibrate(project_to_camera(pose_.transform_to(pw)));
+    }
+
+  private:
+    Pose3<T> pose_;
+    Cal3_S2<T> K_;
+  };
+
+  /* ************************************************************************* */
+  // Traits, lifting a value around the local coordinates of its retract
+
+  template<>
+  struct Traits<gtsam::Point2> {
+    enum { dimension = 2 };
+    template<typename T> struct Type { typedef Point2<T> type; };
+    template<int N>
+    static Point2<Dual<N> > Lift(const gtsam::Point2& p, int offset) {
+      return Point2<Dual<N> >(Dual<N>(p.x(), offset), Dual<N>(p.y(), offset + 1));
+    }
+  };
+
+  template<>
+  struct Traits<gtsam::Point3> {
+    enum { dimension = 3 };
+    template<typename T> struct Type { typedef Point3<T> type; };
+    template<int N>
+    static Point3<Dual<N> > Lift(const gtsam::Point3& p, int offset) {
+      return Point3<Dual<N> >(Dual<N>(p.x(), offset), Dual<N>(p.y(), offset + 1),
+          Dual<N>(p.z(), offset + 2));
+    }
+  };
+
+  template<>
+  struct Traits<gtsam::Rot3> {
+    enum { dimension = 3 };
+    template<typename T> struct Type { typedef Rot3<T> type; };
+    /** R * (I + skew(d)), the first order of both the Cayley and the exponential retract */
+    template<int N>
+    static Rot3<Dual<N> > Lift(const gtsam::Rot3& R, int offset) {
+      const Matrix3 M = R.matrix();
+      Eigen::Matrix<Dual<N>, 3, 3> result;
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          // Column j of R * skew(d) is R * (d x e_j)
+          typename Dual<N>::Derivatives derivatives = Dual<N>::Derivatives::Zero();
+          const int k = (j + 1) % 3, l = (j + 2) % 3;
+          derivatives(offset + l) = M(i, k);
+          derivatives(offset + k) = -M(i, l);
+          result(i, j) = Dual<N>(M(i, j), derivatives);
+        }
+      }
+      return Rot3<Dual<N> >(result);
+    }
+  };
+
+  template<>
+  struct Traits<gtsam::Pose3> {
+    enum { dimension = 6 };
+    template<typename T> struct Type { typedef Pose3<T> type; };
+    /** (R * (I + skew(w)), t + R * v) for d = (w, v), the first order of Pose3::retract */
+    template<int N>
+    static Pose3<Dual<N> > Lift(const gtsam::Pose3& pose, int offset) {
+      const Matrix3 R = pose.rotation().matrix();
+      const gtsam::Point3& t = pose.translation();
+      const double t0[3] = { t.x(), t.y(), t.z() };
+      typename Point3<Dual<N> >::Vector3 translation;
+      for (int i = 0; i < 3; ++i) {
+        typename Dual<N>::Derivatives derivatives = Dual<N>::Derivatives::Zero();
+        derivatives.template segment<3>(offset + 3) = R.row(i).transpose();
+        translation(i) = Dual<N>(t0[i], derivatives);
+      }
+      return Pose3<Dual<N> >(Traits<gtsam::Rot3>::Lift<N>(pose.rotation(), offset),
+          Point3<Dual<N> >(translation));
+    }
+  };
+
+  template<>
+  struct Traits<gtsam::Cal3_S2> {
+    enum { dimension = 5 };
+    template<typename T> struct Type { typedef Cal3_S2<T> type; };
+    template<int N>
+    static Cal3_S2<Dual<N> > Lift(const gtsam::Cal3_S2& K, int offset) {
+      return Cal3_S2<Dual<N> >(Dual<N>(K.fx(), offset), Dual<N>(K.fy(), offset + 1),
+          Dual<N>(K.skew(), offset + 2), Dual<N>(K.px(), offset + 3), Dual<N>(K.py(), offset + 4));
+    }
+  };
+
+  template<>
+  struct Traits<gtsam::PinholeCamera<gtsam::Cal3_S2> > {
+    enum { dimension = 11 };
+    template<typename T> struct Type { typedef PinholeCamera<T> type; };
+    /** The pose in the first 6 coordinates and the calibration in the last 5, as in retract */
+    template<int N>
+    static PinholeCamera<Dual<N> > Lift(const gtsam::PinholeCamera<gtsam::Cal3_S2>& camera, int offset) {
+      return PinholeCamera<Dual<N> >(Traits<gtsam::Pose3>::Lift<N>(camera.pose(), offset),
+          Traits<gtsam::Cal3_S2>::Lift<N>(camera.calibration(), offset + 6));
+    }
+  };
+
+} // namespace autodiff
+
+} // namespace gtsam
@@ -0,0 +1,210 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BatchTriangulator.cpp
+ * @brief Triangulate many feature tracks at once with fixed-size linear algebra
+ * @date October 19, 2026
+ */
+
+#include <gtsam/geometry/BatchTriangulator.h>
+
+#include <cmath>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+namespace gtsam {
+
+namespace {
+
+/* ************************************************************************* */
+// Fold the row r into the upper-triangular R with Givens rotations, so that
+// R'R accumulates the normal equations without ever forming them.
+inline void addRowGivens(Matrix4& R, Eigen::RowVector4d r) {
+  for (int j = 0; j < 4; ++j) {
+    if (r(j) == 0.0)
+      continue;
+    const double a = R(j, j), b = r(j);
+    const double rho = std::sqrt(a * a + b * b);
+    const double c = a / rho, s = b / rho;
+    R(j, j) = rho;
+    r(j) = 0.0;
+    for (int k = j + 1; k < 4; ++k) {
+      const double Rjk = R(j, k), rk = r(k);
+      R(j, k) = c * Rjk + s * rk;
+      r(k) = c * rk - s * Rjk;
+    }
+  }
+}
+
+#ifdef GTSAM_USE_TBB
+/* ************************************************************************* */
+struct _TriangulateTracks {
+  const BatchTriangulator& triangulator;
+  const std::vector<TriangulationTrack>& tracks;
+  std::vector<Point3>& points;
+  std::vector<BatchTriangulator::Status>& status;
+  _TriangulateTracks(const BatchTriangulator& triangulator,
+      const std::vector<TriangulationTrack>& tracks, std::vector<Point3>& points,
+      std::vector<BatchTriangulator::Status>& status) :
+      triangulator(triangulator), tracks(tracks), points(points), status(status) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& r) const {
+    for (size_t i = r.begin(); i != r.end(); ++i)
+      status[i] = triangulator.triangulate(tracks[i], points[i]);
+  }
+};
+#endif
+
+}
+
+/* ************************************************************************* */
+BatchTriangulator::Status BatchTriangulator::triangulateDLT(
+    const TriangulationTrack& track, Vector3& X) const {
+
+  const size_t m = track.size();
+  assert(track.cameraIndices.size() == m);
+  if (m < 2)
+    return UNDERCONSTRAINED;
+
+  // Accumulate the 2m*4 DLT system (Hartley and Zisserman, 2nd Ed., page 312)
+  // into a 4*4 triangular factor with the same singular values
+  Matrix4 R = Matrix4::Zero();
+  for (size_t i = 0; i < m; ++i) {
+    const ProjectionMatrix& P = projections_[track.cameraIndices[i]];
+    const Point2& p = track.measurements[i];
+    addRowGivens(R, p.x() * P.row(2) - P.row(0));
+    addRowGivens(R, p.y() * P.row(2) - P.row(1));
+  }
+
+  Eigen::JacobiSVD<Matrix4> svd(R, Eigen::ComputeFullV);
+  const Vector4& s = svd.singularValues();
+  int rank = 0;
+  for (int j = 0; j < 4; ++j)
+    if (s(j) > params_.rankTolerance)
+      ++rank;
+  if (rank < 3)
+    return UNDERCONSTRAINED;
+
+  // Create 3D point from the right singular vector of the smallest singular value
+  const Vector4 v = svd.matrixV().col(3);
+  if (std::abs(v(3)) < std::numeric_limits<double>::epsilon())
+    return UNDERCONSTRAINED; // point at infinity
+  X = v.head<3>() / v(3);
+  return VALID;
+}
+
+/* ************************************************************************* */
+double BatchTriangulator::error(const TriangulationTrack& track,
+    const Vector3& X) const {
+  double total = 0.0;
+  for (size_t i = 0; i < track.size(); ++i) {
+    const ProjectionMatrix& P = projections_[track.cameraIndices[i]];
+    const Vector3 x = P.leftCols<3>() * X + P.col(3);
+    const double du = x(0) / x(2) - track.measurements[i].x();
+    const double dv = x(1) / x(2) - track.measurements[i].y();
+    total += du * du + dv * dv;
+  }
+  return total;
+}
+
+/* ************************************************************************* */
+double BatchTriangulator::error(const TriangulationTrack& track,
+    const Point3& point) const {
+  return error(track, point.vector());
+}
+
+/* ************************************************************************* */
+double BatchTriangulator::refine(const TriangulationTrack& track,
+    Vector3& X) const {
+
+  double currentError = error(track, X);
+  for (size_t iteration = 0; iteration < params_.maxIterations; ++iteration) {
+    if (currentError < params_.absoluteErrorTol)
+      break;
+
+    // Accumulate 3*3 normal equations of the reprojection error
+    Matrix3 H = Matrix3::Zero();
+    Vector3 g = Vector3::Zero();
+    for (size_t i = 0; i < track.size(); ++i) {
+      const ProjectionMatrix& P = projections_[track.cameraIndices[i]];
+      const Vector3 x = P.leftCols<3>() * X + P.col(3);
+      const double invZ = 1.0 / x(2);
+      const double u = x(0) * invZ, v = x(1) * invZ;
+      Eigen::Matrix<double, 2, 3> J;
+      J.row(0) = (P.block<1, 3>(0, 0) - u * P.block<1, 3>(2, 0)) * invZ;
+      J.row(1) = (P.block<1, 3>(1, 0) - v * P.block<1, 3>(2, 0)) * invZ;
+      const Vector2 e(u - track.measurements[i].x(),
+          v - track.measurements[i].y());
+      H.noalias() += J.transpose() * J;
+      g.noalias() += J.transpose() * e;
+    }
+
+    const Vector3 candidate = X - H.ldlt().solve(g);
+    const double newError = error(track, candidate);
+    if (!(newError < currentError))
+      break; // Gauss-Newton step did not decrease the error, keep current point
+    const double decrease = currentError - newError;
+    X = candidate;
+    const bool converged = decrease <= params_.relativeErrorTol * currentError;
+    currentError = newError;
+    if (converged)
+      break;
+  }
+  return currentError;
+}
+
+/* ************************************************************************* */
+BatchTriangulator::Status BatchTriangulator::triangulate(
+    const TriangulationTrack& track, Point3& point) const {
+
+  Vector3 X;
+  const Status status = triangulateDLT(track, X);
+  if (status != VALID)
+    return status;
+
+  if (params_.maxIterations > 0)
+    refine(track, X);
+
+  // verify that the triangulated point lies in front of all cameras: the last
+  // row of K is [0 0 1], so the third projected coordinate is the depth
+  if (params_.checkCheirality) {
+    for (size_t i = 0; i < track.size(); ++i) {
+      const ProjectionMatrix& P = projections_[track.cameraIndices[i]];
+      if (P.block<1, 3>(2, 0).dot(X) + P(2, 3) <= 0)
+        return BEHIND_CAMERA;
+    }
+  }
+
+  point = Point3(X);
+  return VALID;
+}
+
+/* ************************************************************************* */
+void BatchTriangulator::triangulate(const std::vector<TriangulationTrack>& tracks,
+    std::vector<Point3>& points, std::vector<Status>& status) const {
+
+  points.resize(tracks.size());
+  status.resize(tracks.size());
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, tracks.size()),
+      _TriangulateTracks(*this, tracks, points, status));
+#else
+  for (size_t i = 0; i < tracks.size(); ++i)
+    status[i] = triangulate(tracks[i], points[i]);
+#endif
+}
+
+} // \namespace gtsam
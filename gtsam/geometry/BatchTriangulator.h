@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BatchTriangulator.h
+ * @brief Triangulate many feature tracks at once with fixed-size linear algebra
+ * @date October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/geometry/Point3.h>
+
+#include <boost/foreach.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/// A feature track: the cameras observing one landmark and the measurement in each
+struct GTSAM_EXPORT TriangulationTrack {
+  std::vector<size_t> cameraIndices; ///< indices into the cameras of the BatchTriangulator
+  std::vector<Point2> measurements;  ///< 2D measurement in the corresponding camera
+
+  /// Number of observations in the track
+  size_t size() const { return measurements.size(); }
+
+  /// Add an observation of the landmark in camera i
+  void add(size_t i, const Point2& z) {
+    cameraIndices.push_back(i);
+    measurements.push_back(z);
+  }
+};
+
+/// Parameters for BatchTriangulator
+struct GTSAM_EXPORT BatchTriangulationParams {
+  double rankTolerance;     ///< Threshold on singular values of the DLT system (default: 1e-9)
+  size_t maxIterations;     ///< Gauss-Newton refinement iterations, 0 disables refinement (default: 0)
+  double relativeErrorTol;  ///< Stop refining when the relative decrease in error is below this (default: 1e-5)
+  double absoluteErrorTol;  ///< Stop refining when the reprojection error is below this (default: 1e-9)
+  bool checkCheirality;     ///< Reject points behind one of the cameras (default: true)
+
+  BatchTriangulationParams() :
+      rankTolerance(1e-9), maxIterations(0), relativeErrorTol(1e-5),
+      absoluteErrorTol(1e-9), checkCheirality(true) {
+  }
+};
+
+/**
+ * Triangulates thousands of tracks observed by a common set of cameras.
+ *
+ * Unlike triangulatePoint3, which builds a dynamic DLT matrix and, when refining,
+ * a NonlinearFactorGraph and a LevenbergMarquardtOptimizer per landmark, this
+ * class precomputes one 3*4 projection matrix K*[R'|-R't] per camera and works
+ * with fixed-size matrices only: the DLT rows are folded into a 4*4 triangular
+ * factor by Givens rotations (same singular values as the stacked system, no
+ * heap allocation), and refinement is a small hand-rolled Gauss-Newton on the
+ * 3D point. Tracks are processed in parallel when GTSAM is compiled with TBB.
+ *
+ * Failures are reported per track through Status instead of exceptions, so one
+ * degenerate track does not abort the batch.
+ *
+ * Both the DLT and the refinement use the linear projection model K*[R'|-R't];
+ * for calibrations with distortion (Cal3DS2, Cal3Bundler) this is the same
+ * approximation triangulateDLT makes.
+ */
+class GTSAM_EXPORT BatchTriangulator {
+
+public:
+
+  typedef Eigen::Matrix<double, 3, 4> ProjectionMatrix;
+
+  /// Outcome of triangulating a single track
+  enum Status {
+    VALID,            ///< point triangulated successfully
+    UNDERCONSTRAINED, ///< fewer than two observations, rank < 3, or point at infinity
+    BEHIND_CAMERA     ///< point lies behind one or more of the cameras
+  };
+
+protected:
+
+  typedef std::vector<ProjectionMatrix, Eigen::aligned_allocator<ProjectionMatrix> > Projections;
+
+  Projections projections_; ///< one projection matrix per camera
+  BatchTriangulationParams params_;
+
+  /// Projection matrix K*[R'|-R't] for a pose and calibration matrix
+  static ProjectionMatrix Projection(const Pose3& pose, const Matrix3& K) {
+    return K * pose.inverse().matrix().topRows<3>();
+  }
+
+public:
+
+  /// Construct from poses that share a single calibration
+  template<class CALIBRATION>
+  BatchTriangulator(const std::vector<Pose3>& poses, const CALIBRATION& K,
+      const BatchTriangulationParams& params = BatchTriangulationParams()) :
+      params_(params) {
+    const Matrix3 Kmat = K.K();
+    projections_.reserve(poses.size());
+    BOOST_FOREACH(const Pose3& pose, poses)
+      projections_.push_back(Projection(pose, Kmat));
+  }
+
+  /// Construct from pinhole cameras, each with its own calibration
+  template<class CALIBRATION>
+  BatchTriangulator(const std::vector<PinholeCamera<CALIBRATION> >& cameras,
+      const BatchTriangulationParams& params = BatchTriangulationParams()) :
+      params_(params) {
+    projections_.reserve(cameras.size());
+    BOOST_FOREACH(const PinholeCamera<CALIBRATION>& camera, cameras)
+      projections_.push_back(
+          Projection(camera.pose(), Matrix3(camera.calibration().K())));
+  }
+
+  /// Number of cameras
+  size_t nrCameras() const { return projections_.size(); }
+
+  /// Projection matrix of camera i
+  const ProjectionMatrix& projection(size_t i) const { return projections_[i]; }
+
+  /// Parameters
+  const BatchTriangulationParams& params() const { return params_; }
+
+  /**
+   * Triangulate a single track. Does not throw on degenerate tracks.
+   * @param track cameras and measurements of the landmark
+   * @param point output, only meaningful when VALID is returned
+   */
+  Status triangulate(const TriangulationTrack& track, Point3& point) const;
+
+  /**
+   * Triangulate all tracks, in parallel when TBB is available.
+   * @param tracks the feature tracks
+   * @param points output, resized to tracks.size()
+   * @param status output, resized to tracks.size()
+   */
+  void triangulate(const std::vector<TriangulationTrack>& tracks,
+      std::vector<Point3>& points, std::vector<Status>& status) const;
+
+  /// Sum of squared reprojection errors of a point in a track
+  double error(const TriangulationTrack& track, const Point3& point) const;
+
+protected:
+
+  /// Linear (DLT) triangulation with a fixed-size 4*4 triangular factor
+  Status triangulateDLT(const TriangulationTrack& track, Vector3& X) const;
+
+  /// Gauss-Newton refinement of X, returns the final squared reprojection error
+  double refine(const TriangulationTrack& track, Vector3& X) const;
+
+  /// Squared reprojection error of X in a track
+  double error(const TriangulationTrack& track, const Vector3& X) const;
+};
+
+} // \namespace gtsam
+
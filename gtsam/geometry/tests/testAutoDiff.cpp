@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testAutoDiff.cpp
+ * @brief   Unit tests for Dual numbers and the autodiff geometry types
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/geometry/AutoDiff.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const Rot3 R = Rot3::ypr(0.3, -0.2, 1.1);
+static const Pose3 pose(R, Point3(0.5, -1.0, -2.0));
+static const Point3 point(1.0, 2.0, 4.0);
+static const Cal3_S2 K(500.0, 480.0, 0.1, 320.0, 240.0);
+
+/* ************************************************************************* */
+// Split a result on Dual numbers into value and Jacobian
+template<int M, int N>
+static Matrix jacobian(const Eigen::Matrix<autodiff::Dual<N>, M, 1>& e) {
+  Matrix H(M, N);
+  for (int i = 0; i < M; ++i)
+    H.row(i) = e(i).v.transpose();
+  return H;
+}
+
+template<int M, int N>
+static Vector value(const Eigen::Matrix<autodiff::Dual<N>, M, 1>& e) {
+  Vector v(M);
+  for (int i = 0; i < M; ++i)
+    v(i) = e(i).a;
+  return v;
+}
+
+/* ************************************************************************* */
+TEST(Dual, chainRule) {
+  typedef autodiff::Dual<2> D;
+  const D x(0.7, 0), y(-1.3, 1);
+  const D f = sin(x * y) + sqrt(x) / y - atan2(y, x) * exp(x) + pow(x, 3.0) - 2.0 * log(x);
+
+  const double a = 0.7, b = -1.3;
+  EXPECT_DOUBLES_EQUAL(std::sin(a * b) + std::sqrt(a) / b - std::atan2(b, a) * std::exp(a)
+      + a * a * a - 2.0 * std::log(a), f.a, 1e-12);
+  const double dfdx = std::cos(a * b) * b + 0.5 / std::sqrt(a) / b
+      + b / (a * a + b * b) * std::exp(a) - std::atan2(b, a) * std::exp(a) + 3.0 * a * a - 2.0 / a;
+  const double dfdy = std::cos(a * b) * a - std::sqrt(a) / (b * b)
+      - a / (a * a + b * b) * std::exp(a);
+  EXPECT_DOUBLES_EQUAL(dfdx, f.v(0), 1e-12);
+  EXPECT_DOUBLES_EQUAL(dfdy, f.v(1), 1e-12);
+}
+
+/* ************************************************************************* */
+TEST(AutoDiff, rotate) {
+  typedef autodiff::Dual<6> D;
+  const autodiff::Rot3<D> Rd = autodiff::Traits<Rot3>::Lift<6>(R, 0);
+  const autodiff::Point3<D> pd = autodiff::Traits<Point3>::Lift<6>(point, 3);
+
+  Matrix H1, H2;
+  const Point3 expected = R.rotate(point, H1, H2);
+  const Eigen::Matrix<D, 3, 1> actual = Rd.rotate(pd).vector();
+  EXPECT(assert_equal(expected.vector(), value(actual), 1e-9));
+  EXPECT(assert_equal(H1, Matrix(jacobian(actual).leftCols(3)), 1e-9));
+  EXPECT(assert_equal(H2, Matrix(jacobian(actual).rightCols(3)), 1e-9));
+
+  const Point3 expectedUnrotated = R.unrotate(point, H1, H2);
+  const Eigen::Matrix<D, 3, 1> unrotated = Rd.unrotate(pd).vector();
+  EXPECT(assert_equal(expectedUnrotated.vector(), value(unrotated), 1e-9));
+  EXPECT(assert_equal(H1, Matrix(jacobian(unrotated).leftCols(3)), 1e-9));
+  EXPECT(assert_equal(H2, Matrix(jacobian(unrotated).rightCols(3)), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(AutoDiff, transform) {
+  typedef autodiff::Dual<9> D;
+  const autodiff::Pose3<D> poseD = autodiff::Traits<Pose3>::Lift<9>(pose, 0);
+  const autodiff::Point3<D> pointD = autodiff::Traits<Point3>::Lift<9>(point, 6);
+
+  Matrix H1, H2;
+  const Point3 expected = pose.transform_to(point, H1, H2);
+  const Eigen::Matrix<D, 3, 1> actual = poseD.transform_to(pointD).vector();
+  EXPECT(assert_equal(expected.vector(), value(actual), 1e-9));
+  EXPECT(assert_equal(H1, Matrix(jacobian(actual).leftCols(6)), 1e-9));
+  EXPECT(assert_equal(H2, Matrix(jacobian(actual).rightCols(3)), 1e-9));
+
+  const Point3 expectedFrom = pose.transform_from(point, H1, H2);
+  const Eigen::Matrix<D, 3, 1> from = poseD.transform_from(pointD).vector();
+  EXPECT(assert_equal(expectedFrom.vector(), value(from), 1e-9));
+  EXPECT(assert_equal(H1, Matrix(jacobian(from).leftCols(6)), 1e-9));
+  EXPECT(assert_equal(H2, Matrix(jacobian(from).rightCols(3)), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(AutoDiff, compose) {
+  // The translation of a composition, differentiated with respect to both poses
+  typedef autodiff::Dual<12> D;
+  const Pose3 pose2(Rot3::ypr(-0.4, 0.1, 0.2), Point3(1.0, 0.3, 0.2));
+  const autodiff::Pose3<D> p1 = autodiff::Traits<Pose3>::Lift<12>(pose, 0);
+  const autodiff::Pose3<D> p2 = autodiff::Traits<Pose3>::Lift<12>(pose2, 6);
+
+  Matrix H1, H2;
+  const Pose3 expected = pose.between(pose2, H1, H2);
+  const Eigen::Matrix<D, 3, 1> actual = p1.between(p2).translation().vector();
+  EXPECT(assert_equal(expected.translation().vector(), value(actual), 1e-9));
+
+  // The translation rows of between's Jacobians are expressed in the frame of the result
+  const Matrix3 Rb = expected.rotation().matrix();
+  EXPECT(assert_equal(Matrix(Rb * H1.bottomRows(3)), Matrix(jacobian(actual).leftCols(6)), 1e-9));
+  EXPECT(assert_equal(Matrix(Rb * H2.bottomRows(3)), Matrix(jacobian(actual).rightCols(6)), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(AutoDiff, project) {
+  typedef autodiff::Dual<14> D;
+  const PinholeCamera<Cal3_S2> camera(pose.compose(Pose3(Rot3(), Point3(0, 0, -10))), K);
+  const autodiff::PinholeCamera<D> cameraD =
+    autodiff::Traits<PinholeCamera<Cal3_S2> >::Lift<14>(camera, 0);
+  const autodiff::Point3<D> pointD = autodiff::Traits<Point3>::Lift<14>(point, 11);
+
+  Matrix Dpose, Dpoint, Dcal;
+  const Point2 expected = camera.project(point, Dpose, Dpoint, Dcal);
+  const Eigen::Matrix<D, 2, 1> actual = cameraD.project(pointD).vector();
+  EXPECT(assert_equal(expected.vector(), value(actual), 1e-9));
+  const Matrix H = jacobian(actual);
+  EXPECT(assert_equal(Dpose, Matrix(H.leftCols(6)), 1e-9));
+  EXPECT(assert_equal(Dcal, Matrix(H.middleCols(6, 5)), 1e-9));
+  EXPECT(assert_equal(Dpoint, Matrix(H.rightCols(3)), 1e-9));
+
+  // Evaluated on doubles, the same function gives the value only
+  const autodiff::Point2<double> projected =
+    autodiff::PinholeCamera<double>(camera).project(autodiff::Point3<double>(point));
+  EXPECT(assert_equal(expected.vector(), Vector(projected.vector()), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
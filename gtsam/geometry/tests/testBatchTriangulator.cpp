@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testBatchTriangulator.cpp
+ * @brief Unit tests for BatchTriangulator
+ */
+
+#include <gtsam/geometry/BatchTriangulator.h>
+#include <gtsam/geometry/triangulation.h>
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/std/vector.hpp>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+
+static const Cal3_S2 K(1500, 1200, 0, 640, 480);
+
+// Looking along X-axis, 1 meter above ground plane (x-y)
+static const Rot3 upright = Rot3::ypr(-M_PI / 2, 0., -M_PI / 2);
+static const Pose3 pose1 = Pose3(upright, Point3(0, 0, 1));
+static const Pose3 pose2 = pose1 * Pose3(Rot3(), Point3(1, 0, 0));
+static const Pose3 pose3 = pose1
+    * Pose3(Rot3::ypr(0.1, 0.2, 0.1), Point3(0.1, -2, -.1));
+
+static const Point3 landmark(5, 0.5, 1.2);
+
+// Pinhole projection without the cheirality check done by SimpleCamera::project
+static Point2 projectIgnoringCheirality(const Pose3& pose, const Point3& point) {
+  const Point3 q = pose.transform_to(point);
+  return K.uncalibrate(Point2(q.x() / q.z(), q.y() / q.z()));
+}
+
+/* ************************************************************************* */
+TEST( BatchTriangulator, twoPoses ) {
+  vector<Pose3> poses;
+  poses += pose1, pose2;
+  BatchTriangulator triangulator(poses, K);
+  LONGS_EQUAL(2, triangulator.nrCameras());
+
+  TriangulationTrack track;
+  track.add(0, SimpleCamera(pose1, K).project(landmark));
+  track.add(1, SimpleCamera(pose2, K).project(landmark));
+
+  Point3 actual;
+  EXPECT(BatchTriangulator::VALID == triangulator.triangulate(track, actual));
+  EXPECT(assert_equal(landmark, actual, 1e-7));
+  EXPECT_DOUBLES_EQUAL(0.0, triangulator.error(track, actual), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( BatchTriangulator, agreesWithTriangulatePoint3 ) {
+  vector<Pose3> poses;
+  poses += pose1, pose2, pose3;
+  boost::shared_ptr<Cal3_S2> sharedCal = boost::make_shared<Cal3_S2>(K);
+
+  vector<Point2> measurements;
+  TriangulationTrack track;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    measurements += SimpleCamera(poses[i], K).project(landmark);
+    track.add(i, measurements.back());
+  }
+  measurements[0] += Point2(0.1, 0.5);
+  measurements[1] += Point2(-0.2, 0.3);
+  measurements[2] += Point2(0.1, -0.1);
+  track.measurements = measurements;
+
+  // Linear triangulation only
+  Point3 expectedDLT = triangulatePoint3(poses, sharedCal, measurements);
+  Point3 actualDLT;
+  BatchTriangulator dlt(poses, K);
+  EXPECT(BatchTriangulator::VALID == dlt.triangulate(track, actualDLT));
+  EXPECT(assert_equal(expectedDLT, actualDLT, 1e-6));
+
+  // With nonlinear refinement
+  Point3 expected = triangulatePoint3(poses, sharedCal, measurements, 1e-9, true);
+  BatchTriangulationParams params;
+  params.maxIterations = 20;
+  BatchTriangulator refined(poses, K, params);
+  Point3 actual;
+  EXPECT(BatchTriangulator::VALID == refined.triangulate(track, actual));
+  EXPECT(assert_equal(expected, actual, 1e-4));
+  EXPECT(refined.error(track, actual) <= refined.error(track, actualDLT));
+}
+
+/* ************************************************************************* */
+TEST( BatchTriangulator, cameras ) {
+  Cal3Bundler bundlerCal(1500, 0, 0, 640, 480);
+  vector<PinholeCamera<Cal3Bundler> > cameras;
+  cameras += PinholeCamera<Cal3Bundler>(pose1, bundlerCal);
+  cameras += PinholeCamera<Cal3Bundler>(pose2, bundlerCal);
+
+  TriangulationTrack track;
+  track.add(0, cameras[0].project(landmark));
+  track.add(1, cameras[1].project(landmark));
+
+  BatchTriangulator triangulator(cameras);
+  Point3 actual;
+  EXPECT(BatchTriangulator::VALID == triangulator.triangulate(track, actual));
+  EXPECT(assert_equal(landmark, actual, 1e-7));
+}
+
+/* ************************************************************************* */
+TEST( BatchTriangulator, batch ) {
+  vector<Pose3> poses;
+  poses += pose1, pose2, pose3;
+  BatchTriangulationParams params;
+  params.maxIterations = 10;
+  BatchTriangulator triangulator(poses, K, params);
+
+  vector<Point3> landmarks;
+  landmarks += landmark, Point3(6, -0.5, 1.0), Point3(4, 1.0, 0.5);
+
+  vector<TriangulationTrack> tracks(landmarks.size() + 2);
+  for (size_t j = 0; j < landmarks.size(); ++j)
+    for (size_t i = 0; i < poses.size(); ++i)
+      tracks[j].add(i, SimpleCamera(poses[i], K).project(landmarks[j]));
+
+  // A single observation is underconstrained
+  tracks[3].add(0, SimpleCamera(pose1, K).project(landmark));
+
+  // Observations consistent with a point behind the cameras
+  const Point3 behind(-5, 0.5, 1.2);
+  tracks[4].add(0, projectIgnoringCheirality(pose1, behind));
+  tracks[4].add(1, projectIgnoringCheirality(pose2, behind));
+
+  vector<Point3> points;
+  vector<BatchTriangulator::Status> status;
+  triangulator.triangulate(tracks, points, status);
+  LONGS_EQUAL(5, points.size());
+  LONGS_EQUAL(5, status.size());
+  for (size_t j = 0; j < landmarks.size(); ++j) {
+    EXPECT(BatchTriangulator::VALID == status[j]);
+    EXPECT(assert_equal(landmarks[j], points[j], 1e-7));
+  }
+  EXPECT(BatchTriangulator::UNDERCONSTRAINED == status[3]);
+  EXPECT(BatchTriangulator::BEHIND_CAMERA == status[4]);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -19,6 +19,7 @@
 #include <gtsam/base/lieProxies.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/batchedNumericalDerivative.h>
 
 #include <boost/assign/std/vector.hpp> // for operator +=
 using namespace boost::assign;
@@ -357,6 +358,18 @@ TEST( Pose3, transform_to_with_derivatives)
   EXPECT(assert_equal(expH2, actH2, 1e-8));
 }
 
+/* ************************************************************************* */
+TEST( Pose3, transform_to_batched_derivatives)
+{
+  Matrix actH1, actH2;
+  T.transform_to(P,actH1,actH2);
+  Eigen::Matrix<double,3,6> expH1 = numericalDerivativeFixed21<Point3,Pose3,Point3>(transform_to_, T,P);
+  Eigen::Matrix<double,3,3> expH2 = numericalDerivativeFixed22<Point3,Pose3,Point3>(transform_to_, T,P);
+  EXPECT(assert_equal(Matrix(expH1), actH1, 1e-8));
+  EXPECT(assert_equal(Matrix(expH2), actH2, 1e-8));
+  EXPECT(assert_equal(numericalDerivative21(transform_to_, T,P), Matrix(expH1), 1e-12));
+}
+
 /* ************************************************************************* */
 TEST( Pose3, transform_from_with_derivatives)
 {
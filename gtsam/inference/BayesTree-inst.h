@@ -84,7 +84,7 @@ namespace gtsam {
     std::string parent = out.str();
     parent += "[label=\"";
 
-    BOOST_FOREACH(Key index, clique->conditional_->frontals()) {
+    BOOST_FOREACH(Key index, clique->conditional()->frontals()) {
       if(!first) parent += ","; first = false;
       parent += indexFormatter(index);
     }
@@ -95,7 +95,7 @@ namespace gtsam {
     }
 
     first = true;
-    BOOST_FOREACH(Key sep, clique->conditional_->parents()) {
+    BOOST_FOREACH(Key sep, clique->conditional()->parents()) {
       if(!first) parent += ","; first = false;
       parent += indexFormatter(sep);
     }
@@ -136,7 +136,7 @@ namespace gtsam {
   namespace {
     template<class FACTOR, class CLIQUE>
     int _pushClique(FactorGraph<FACTOR>& fg, const boost::shared_ptr<CLIQUE>& clique) {
-      fg.push_back(clique->conditional_);
+      fg.push_back(clique->conditional());
       return 0;
     }
 
@@ -145,7 +145,7 @@ namespace gtsam {
       _pushCliqueFunctor(FactorGraph<FACTOR>& graph_) : graph(graph_) {}
       FactorGraph<FACTOR>& graph;
       int operator()(const boost::shared_ptr<CLIQUE>& clique, int dummy) {
-        graph.push_back(clique->conditional_);
+        graph.push_back(clique->conditional());
         return 0;
       }
     };
@@ -392,6 +392,20 @@ namespace gtsam {
     return p_BC1C2.marginalMultifrontalBayesNet(Ordering(cref_list_of<2,Key>(j1)(j2)), boost::none, function);
   }
 
+  /* ************************************************************************* */
+  template<class CLIQUE>
+  FastVector<typename BayesTree<CLIQUE>::sharedClique>
+    BayesTree<CLIQUE>::denseNodes(const KeyIndexer& indexer) const
+  {
+    FastVector<sharedClique> result(indexer.size());
+    for(size_t j = 0; j < indexer.size(); ++j) {
+      typename Nodes::const_iterator node = nodes_.find(indexer.key(j));
+      if(node != nodes_.end())
+        result[j] = node->second;
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   template<class CLIQUE>
   void BayesTree<CLIQUE>::clear() {
@@ -452,7 +466,7 @@ namespace gtsam {
       orphans.insert(orphans.begin(), clique->children.begin(), clique->children.end());
       clique->children.clear();
 
-      bn.push_back(clique->conditional_);
+      bn.push_back(clique->conditional());
 
     }
   }
@@ -25,6 +25,7 @@
 #include <gtsam/base/FastList.h>
 #include <gtsam/base/ConcurrentMap.h>
 #include <gtsam/base/FastVector.h>
+#include <gtsam/inference/KeyIndexer.h>
 
 namespace gtsam {
 
@@ -143,6 +144,10 @@ namespace gtsam {
     /** Access node by variable */
     const sharedNode operator[](Key j) const { return nodes_.at(j); }
 
+    /** The clique containing each variable of \c indexer, by dense index, for the dense key mode
+     *  (see KeyIndexer).  Entries for variables not in the tree are null. */
+    FastVector<sharedClique> denseNodes(const KeyIndexer& indexer) const;
+
     /** return root cliques */
     const Roots& roots() const { return roots_;  }
 
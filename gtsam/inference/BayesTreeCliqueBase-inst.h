@@ -35,8 +35,8 @@ namespace gtsam {
   bool BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::equals(
     const DERIVED& other, double tol) const
   {
-    return (!conditional_ && !other.conditional())
-      || conditional_->equals(*other.conditional(), tol);
+    return (!conditional() && !other.conditional())
+      || conditional()->equals(*other.conditional(), tol);
   }
 
   /* ************************************************************************* */
@@ -76,7 +76,7 @@ namespace gtsam {
   void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::print(
     const std::string& s, const KeyFormatter& keyFormatter) const
   {
-    conditional_->print(s, keyFormatter);
+    conditional()->print(s, keyFormatter);
   }
 
   /* ************************************************************************* */
@@ -122,7 +122,7 @@ namespace gtsam {
       gttoc(BayesTreeCliqueBase_shortcut);
       FactorGraphType p_Cp_B(parent->shortcut(B, function)); // P(Sp||B)
       gttic(BayesTreeCliqueBase_shortcut);
-      p_Cp_B += parent->conditional_; // P(Fp|Sp)
+      p_Cp_B += parent->conditional(); // P(Fp|Sp)
 
       // Determine the variables we want to keepSet, S union B
       FastVector<Key> keep = shortcut_indices(B, p_Cp_B);
@@ -168,7 +168,7 @@ namespace gtsam {
         gttic(BayesTreeCliqueBase_separatorMarginal);
         gttic(BayesTreeCliqueBase_separatorMarginal_cachemiss);
         // now add the parent conditional
-        p_Cp += parent->conditional_; // P(Fp|Sp)
+        p_Cp += parent->conditional(); // P(Fp|Sp)
 
         // The variables we want to keepSet are exactly the ones in S
         FastVector<Key> indicesS(this->conditional()->beginParents(), this->conditional()->endParents());
@@ -192,7 +192,7 @@ namespace gtsam {
     // initialize with separator marginal P(S)
     FactorGraphType p_C = this->separatorMarginal(function);
     // add the conditional P(F|S)
-    p_C += boost::shared_ptr<FactorType>(this->conditional_);
+    p_C += boost::shared_ptr<FactorType>(this->conditional());
     return p_C;
   }
 
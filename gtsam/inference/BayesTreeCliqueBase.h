@@ -101,7 +101,13 @@ namespace gtsam {
     /// @{
 
     /** Access the conditional */
-    const sharedConditional& conditional() const { return conditional_; }
+    const sharedConditional& conditional() const {
+      static_cast<const DerivedType*>(this)->ensureResident(); return conditional_; }
+
+    /** Called before the conditional is accessed.  Cliques that may release
+     * their conditional from memory, such as ISAM2Clique, hide this to load it
+     * back. */
+    void ensureResident() const {}
 
     /** is this the root of a Bayes tree ? */
     inline bool isRoot() const { return parent_.expired(); }
@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex-inl.h
+ * @brief   Construction of a CompressedVariableIndex from a factor graph
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/base/timing.h>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+namespace gtsam {
+
+namespace internal {
+  /* ************************************************************************* */
+  // Writes the (key, factor index) entries of each factor at the factor's offset
+  template<class FG>
+  struct GatherVariableIndexEntries
+  {
+    const FG& factorGraph;
+    const FastVector<size_t>& offsets;
+    FastVector<CompressedVariableIndex::Entry>& entries;
+
+    GatherVariableIndexEntries(const FG& _factorGraph, const FastVector<size_t>& _offsets,
+      FastVector<CompressedVariableIndex::Entry>& _entries) :
+      factorGraph(_factorGraph), offsets(_offsets), entries(_entries) {}
+
+    void operator()(size_t i) const {
+      if(factorGraph[i]) {
+        size_t entry = offsets[i];
+        for(typename FG::FactorType::const_iterator key = factorGraph[i]->begin();
+          key != factorGraph[i]->end(); ++key)
+          entries[entry++] = CompressedVariableIndex::Entry(*key, i);
+      }
+    }
+
+#ifdef GTSAM_USE_TBB
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for(size_t i = r.begin(); i != r.end(); ++i)
+        (*this)(i);
+    }
+#endif
+  };
+}
+
+/* ************************************************************************* */
+template<class FG>
+CompressedVariableIndex::CompressedVariableIndex(const FG& factorGraph) :
+  nFactors_(factorGraph.size())
+{
+  gttic(CompressedVariableIndex_Constructor);
+
+  // Offset of each factor's entries, so the factors can be gathered independently
+  FastVector<size_t> offsets(nFactors_ + 1);
+  offsets[0] = 0;
+  for(size_t i = 0; i < nFactors_; ++i)
+    offsets[i + 1] = offsets[i] + (factorGraph[i] ? factorGraph[i]->size() : 0);
+
+  FastVector<Entry> entries(offsets.back());
+  internal::GatherVariableIndexEntries<FG> gather(factorGraph, offsets, entries);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nFactors_), gather);
+#else
+  for(size_t i = 0; i < nFactors_; ++i)
+    gather(i);
+#endif
+
+  compress(entries);
+}
+
+}
@@ -0,0 +1,94 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex.cpp
+ * @brief   Immutable variable index in compressed sparse column form
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void CompressedVariableIndex::compress(FastVector<Entry>& entries) {
+  gttic(CompressedVariableIndex_compress);
+
+  // Sorting by key and then factor index groups the entries of each variable, in increasing
+  // factor order, which is all the compressed form needs
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_sort(entries.begin(), entries.end());
+#else
+  sort(entries.begin(), entries.end());
+#endif
+
+  keys_.clear();
+  starts_.clear();
+  factors_.resize(entries.size());
+  for(size_t e = 0; e < entries.size(); ++e) {
+    if(e == 0 || entries[e].first != entries[e - 1].first) {
+      keys_.push_back(entries[e].first);
+      starts_.push_back(e);
+    }
+    factors_[e] = entries[e].second;
+  }
+  starts_.push_back(entries.size());
+}
+
+/* ************************************************************************* */
+size_t CompressedVariableIndex::find(Key variable) const {
+  const FastVector<Key>::const_iterator it = lower_bound(keys_.begin(), keys_.end(), variable);
+  if(it == keys_.end() || *it != variable)
+    return keys_.size();
+  return size_t(it - keys_.begin());
+}
+
+/* ************************************************************************* */
+size_t CompressedVariableIndex::index(Key variable) const {
+  const size_t j = find(variable);
+  if(j == keys_.size())
+    throw invalid_argument("Requested non-existent variable from CompressedVariableIndex");
+  return j;
+}
+
+/* ************************************************************************* */
+bool CompressedVariableIndex::equals(const CompressedVariableIndex& other, double tol) const {
+  return nFactors_ == other.nFactors_ && keys_ == other.keys_ && starts_ == other.starts_
+    && factors_ == other.factors_;
+}
+
+/* ************************************************************************* */
+void CompressedVariableIndex::print(const string& str, const KeyFormatter& keyFormatter) const {
+  cout << str;
+  cout << "nEntries = " << nEntries() << ", nFactors = " << nFactors() << "\n";
+  for(size_t j = 0; j < keys_.size(); ++j) {
+    cout << "var " << keyFormatter(keys_[j]) << ":";
+    BOOST_FOREACH(const size_t factor, factors(j))
+      cout << " " << factor;
+    cout << "\n";
+  }
+  cout.flush();
+}
+
+}
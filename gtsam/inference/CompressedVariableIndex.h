@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex.h
+ * @brief   Immutable variable index in compressed sparse column form
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/inference/Key.h>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <string>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * An immutable alternative to VariableIndex for batch problems.  Like VariableIndex it stores,
+ * for every variable, the increasing indices of the factors that involve it, but in three flat
+ * arrays instead of a map of lists: the sorted keys, and the factor indices of all variables
+ * concatenated in key order with the start of each variable's entries.  The position of a key in
+ * the sorted keys is a dense index from 0 to size()-1, which is also its position in
+ * Ordering::Natural.
+ *
+ * It is built from a factor graph in a single pass over the factors, in parallel when GTSAM is
+ * compiled with TBB, and cannot be augmented afterwards; use VariableIndex for incremental
+ * problems.  Ordering::COLAMD, EliminationTree and SubgraphBuilder accept it directly, and
+ * batch elimination uses it when no VariableIndex is given.
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT CompressedVariableIndex {
+public:
+
+  typedef FastVector<size_t>::const_iterator Factor_const_iterator;
+  typedef boost::iterator_range<Factor_const_iterator> Factors; ///< Increasing factor indices of a variable
+  typedef std::pair<Key, size_t> Entry; ///< A variable and a factor that involves it
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Default constructor, creates an empty index */
+  CompressedVariableIndex() : nFactors_(0) { starts_.push_back(0); }
+
+  /** Build the index of a factor graph.  Null factors keep their index but have no entries. */
+  template<class FG>
+  explicit CompressedVariableIndex(const FG& factorGraph);
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /** The number of variables */
+  size_t size() const { return keys_.size(); }
+
+  /** The number of factors in the original factor graph */
+  size_t nFactors() const { return nFactors_; }
+
+  /** The number of nonzero blocks, i.e. the number of variable-factor entries */
+  size_t nEntries() const { return factors_.size(); }
+
+  /** The sorted keys of all variables */
+  const FastVector<Key>& keys() const { return keys_; }
+
+  /** The key of the variable with dense index j */
+  Key key(size_t j) const { return keys_[j]; }
+
+  /** The dense index of a variable, or size() if no factor involves it */
+  size_t find(Key variable) const;
+
+  /** The dense index of a variable, throws std::invalid_argument if no factor involves it */
+  size_t index(Key variable) const;
+
+  /** The factors involving a variable, throws std::invalid_argument if there are none */
+  Factors operator[](Key variable) const { return factors(index(variable)); }
+
+  /** The factors involving the variable with dense index j */
+  Factors factors(size_t j) const {
+    return Factors(factors_.begin() + starts_[j], factors_.begin() + starts_[j + 1]); }
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /** Test for equality (for unit tests and debug assertions). */
+  bool equals(const CompressedVariableIndex& other, double tol = 0.0) const;
+
+  /** Print the variable index (for unit tests and debugging). */
+  void print(const std::string& str = "CompressedVariableIndex: ",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @}
+  /// @name Advanced Interface
+  /// @{
+
+  /** Offsets of the entries of each variable into factorIndices(), of size size()+1 */
+  const FastVector<size_t>& starts() const { return starts_; }
+
+  /** The factor indices of all variables, in the order of keys() */
+  const FastVector<size_t>& factorIndices() const { return factors_; }
+
+  /// @}
+
+private:
+  FastVector<Key> keys_;
+  FastVector<size_t> starts_;
+  FastVector<size_t> factors_;
+  size_t nFactors_;
+
+  /** Sort the entries gathered from the factors and compress them into the index */
+  void compress(FastVector<Entry>& entries);
+};
+
+}
+
+#include <gtsam/inference/CompressedVariableIndex-inl.h>
@@ -20,7 +20,9 @@
 
 #include <gtsam/inference/EliminateableFactorGraph.h>
 #include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
 #include <boost/tuple/tuple.hpp>
+#include <boost/make_shared.hpp>
 
 namespace gtsam {
 
@@ -30,31 +32,34 @@ namespace gtsam {
     EliminateableFactorGraph<FACTORGRAPH>::eliminateSequential(
     OptionalOrdering ordering, const Eliminate& function, OptionalVariableIndex variableIndex) const
   {
-    if(ordering && variableIndex) {
+    if(variableIndex && !ordering) {
+      // If no Ordering provided, compute one from the given VariableIndex and call this function
+      // again.
+      return eliminateSequential(Ordering::COLAMD(*variableIndex), function, variableIndex);
+    }
+    else {
       gttic(eliminateSequential);
+      // Build the elimination tree.  If no VariableIndex is provided, the column structure is
+      // computed as a CompressedVariableIndex, which is faster to build for a batch problem, and
+      // also used to compute an Ordering with COLAMD if none is provided.
+      boost::shared_ptr<EliminationTreeType> etree;
+      if(variableIndex) {
+        etree = boost::make_shared<EliminationTreeType>(asDerived(), *variableIndex, *ordering);
+      } else {
+        const CompressedVariableIndex compressedIndex(asDerived());
+        etree = boost::make_shared<EliminationTreeType>(asDerived(), compressedIndex,
+          ordering ? *ordering : Ordering::COLAMD(compressedIndex));
+      }
       // Do elimination
-      EliminationTreeType etree(asDerived(), *variableIndex, *ordering);
       boost::shared_ptr<BayesNetType> bayesNet;
       boost::shared_ptr<FactorGraphType> factorGraph;
-      boost::tie(bayesNet,factorGraph) = etree.eliminate(function);
+      boost::tie(bayesNet,factorGraph) = etree->eliminate(function);
       // If any factors are remaining, the ordering was incomplete
       if(!factorGraph->empty())
         throw InconsistentEliminationRequested();
       // Return the Bayes net
       return bayesNet;
     }
-    else if(!variableIndex) {
-      // If no VariableIndex provided, compute one and call this function again IMPORTANT: we check
-      // for no variable index first so that it's always computed if we need to call COLAMD because
-      // no Ordering is provided.
-      return eliminateSequential(ordering, function, VariableIndex(asDerived()));
-    }
-    else /*if(!ordering)*/ {
-      // If no Ordering provided, compute one and call this function again.  We are guaranteed to
-      // have a VariableIndex already here because we computed one if needed in the previous 'else'
-      // block.
-      return eliminateSequential(Ordering::COLAMD(*variableIndex), function);
-    }
   }
 
   /* ************************************************************************* */
@@ -63,11 +68,26 @@ namespace gtsam {
     EliminateableFactorGraph<FACTORGRAPH>::eliminateMultifrontal(
     OptionalOrdering ordering, const Eliminate& function, OptionalVariableIndex variableIndex) const
   {
-    if(ordering && variableIndex) {
+    if(variableIndex && !ordering) {
+      // If no Ordering provided, compute one from the given VariableIndex and call this function
+      // again.
+      return eliminateMultifrontal(Ordering::COLAMD(*variableIndex), function, variableIndex);
+    }
+    else {
       gttic(eliminateMultifrontal);
-      // Do elimination with given ordering
-      EliminationTreeType etree(asDerived(), *variableIndex, *ordering);
-      JunctionTreeType junctionTree(etree);
+      // Build the elimination tree.  If no VariableIndex is provided, the column structure is
+      // computed as a CompressedVariableIndex, which is faster to build for a batch problem, and
+      // also used to compute an Ordering with COLAMD if none is provided.
+      boost::shared_ptr<EliminationTreeType> etree;
+      if(variableIndex) {
+        etree = boost::make_shared<EliminationTreeType>(asDerived(), *variableIndex, *ordering);
+      } else {
+        const CompressedVariableIndex compressedIndex(asDerived());
+        etree = boost::make_shared<EliminationTreeType>(asDerived(), compressedIndex,
+          ordering ? *ordering : Ordering::COLAMD(compressedIndex));
+      }
+      // Do elimination
+      JunctionTreeType junctionTree(*etree);
       boost::shared_ptr<BayesTreeType> bayesTree;
       boost::shared_ptr<FactorGraphType> factorGraph;
       boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function);
@@ -77,18 +97,6 @@ namespace gtsam {
       // Return the Bayes tree
       return bayesTree;
     }
-    else if(!variableIndex) {
-      // If no VariableIndex provided, compute one and call this function again IMPORTANT: we check
-      // for no variable index first so that it's always computed if we need to call COLAMD because
-      // no Ordering is provided.
-      return eliminateMultifrontal(ordering, function, VariableIndex(asDerived()));
-    }
-    else /*if(!ordering)*/ {
-      // If no Ordering provided, compute one and call this function again.  We are guaranteed to
-      // have a VariableIndex already here because we computed one if needed in the previous 'else'
-      // block.
-      return eliminateMultifrontal(Ordering::COLAMD(*variableIndex), function);
-    }
   }
 
   /* ************************************************************************* */
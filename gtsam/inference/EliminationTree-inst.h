@@ -26,6 +26,7 @@
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/inference/EliminationTree.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/inference-inst.h>
 
@@ -81,7 +82,24 @@ namespace gtsam {
     const VariableIndex& structure, const Ordering& order)
   {
     gttic(EliminationTree_Contructor);
+    build(graph, structure, order);
+  }
 
+  /* ************************************************************************* */
+  template<class BAYESNET, class GRAPH>
+  EliminationTree<BAYESNET,GRAPH>::EliminationTree(const FactorGraphType& graph,
+    const CompressedVariableIndex& structure, const Ordering& order)
+  {
+    gttic(EliminationTree_Contructor);
+    build(graph, structure, order);
+  }
+
+  /* ************************************************************************* */
+  template<class BAYESNET, class GRAPH>
+  template<class STRUCTURE>
+  void EliminationTree<BAYESNET,GRAPH>::build(const FactorGraphType& graph,
+    const STRUCTURE& structure, const Ordering& order)
+  {
     // Number of factors and variables - NOTE in the case of partial elimination, n here may
     // be fewer variables than are actually present in the graph.
     const size_t m = graph.size();
@@ -100,12 +118,11 @@ namespace gtsam {
       for (size_t j = 0; j < n; j++)
       {
         // Retrieve the factors involving this variable and create the current node
-        const VariableIndex::Factors& factors = structure[order[j]];
         nodes[j] = boost::make_shared<Node>();
         nodes[j]->key = order[j];
 
         // for row i \in Struct[A*j] do
-        BOOST_FOREACH(const size_t i, factors) {
+        BOOST_FOREACH(const size_t i, structure[order[j]]) {
           // If we already hit a variable in this factor, make the subtree containing the previous
           // variable in this factor a child of the current node.  This means that the variables
           // eliminated earlier in the factor depend on the later variables in the factor.  If we
@@ -162,7 +179,7 @@ namespace gtsam {
   {
     gttic(ET_Create2);
     // Build variable index first
-    const VariableIndex variableIndex(factorGraph);
+    const CompressedVariableIndex variableIndex(factorGraph);
     This temp(factorGraph, variableIndex, order);
     this->swap(temp); // Swap in the tree, and temp will be deleted
   }
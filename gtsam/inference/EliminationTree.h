@@ -28,6 +28,7 @@ class EliminationTreeTester; // for unit tests, see testEliminationTree
 namespace gtsam {
 
   class VariableIndex;
+  class CompressedVariableIndex;
   class Ordering;
 
   /**
@@ -100,8 +101,17 @@ namespace gtsam {
     EliminationTree(const FactorGraphType& factorGraph,
       const VariableIndex& structure, const Ordering& order);
 
+    /**
+    * Build the elimination tree of a factor graph using pre-computed column structure in the
+    * compressed form of a batch problem.
+    * @param factorGraph The factor graph for which to build the elimination tree
+    * @param structure The set of factors involving each variable
+    */
+    EliminationTree(const FactorGraphType& factorGraph,
+      const CompressedVariableIndex& structure, const Ordering& order);
+
     /** Build the elimination tree of a factor graph.  Note that this has to compute the column
-    * structure as a VariableIndex, so if you already have this precomputed, use the other
+    * structure as a CompressedVariableIndex, so if you already have this precomputed, use the other
     * constructor instead.
     * @param factorGraph The factor graph for which to build the elimination tree
     */
@@ -161,6 +171,11 @@ namespace gtsam {
     EliminationTree() {}
 
   private:
+    /// Build the tree from \c structure, which gives the increasing indices of the factors involving
+    /// a key with structure[key], i.e. a VariableIndex or CompressedVariableIndex
+    template<class STRUCTURE>
+    void build(const FactorGraphType& graph, const STRUCTURE& structure, const Ordering& order);
+
     /// Allow access to constructor and add methods for testing purposes
     friend class ::EliminationTreeTester;
   };
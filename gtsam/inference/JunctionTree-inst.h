@@ -22,9 +22,15 @@
 
 #include <gtsam/inference/JunctionTree.h>
 #include <gtsam/inference/ClusterTree-inst.h>
+#include <gtsam/inference/SupernodalStructure.h>
 #include <gtsam/symbolic/SymbolicConditional.h>
 #include <gtsam/symbolic/SymbolicFactor-inst.h>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 namespace gtsam {
   
   namespace {
@@ -116,6 +122,34 @@ namespace gtsam {
       }
       myData.myJTNode->problemSize_ = combinedProblemSize;
     }
+
+    /* ************************************************************************* */
+    // Makes the cluster of each supernode, with its frontal keys and factors
+    template<class BAYESTREE, class GRAPH>
+    struct SupernodeClusters
+    {
+      typedef typename JunctionTree<BAYESTREE,GRAPH>::sharedNode sharedNode;
+      const GRAPH& factorGraph;
+      const SupernodalStructure& structure;
+      FastVector<sharedNode>& clusters;
+      SupernodeClusters(const GRAPH& factorGraph, const SupernodalStructure& structure,
+        FastVector<sharedNode>& clusters) : factorGraph(factorGraph), structure(structure), clusters(clusters) {}
+      void operator()(size_t s) const {
+        sharedNode cluster = boost::make_shared<typename JunctionTree<BAYESTREE,GRAPH>::Node>();
+        cluster->keys.assign(structure.frontalsBegin(s), structure.frontalsEnd(s));
+        cluster->factors.reserve(structure.factorsEnd(s) - structure.factorsBegin(s));
+        for(FastVector<size_t>::const_iterator i = structure.factorsBegin(s); i != structure.factorsEnd(s); ++i)
+          if(factorGraph[*i])
+            cluster->factors.push_back(factorGraph[*i]);
+        clusters[s] = cluster;
+      }
+#ifdef GTSAM_USE_TBB
+      void operator()(const tbb::blocked_range<size_t>& r) const {
+        for(size_t s = r.begin(); s != r.end(); ++s)
+          (*this)(s);
+      }
+#endif
+    };
   }
 
   /* ************************************************************************* */
@@ -145,4 +179,38 @@ namespace gtsam {
     Base::remainingFactors_ = eliminationTree.remainingFactors();
   }
 
+  /* ************************************************************************* */
+  template<class BAYESTREE, class GRAPH>
+  JunctionTree<BAYESTREE,GRAPH>::JunctionTree(const GRAPH& factorGraph, const SupernodalStructure& structure)
+  {
+    gttic(JunctionTree_FromSupernodalStructure);
+    // Allocating the clusters is most of the work here, so each supernode gets its cluster in
+    // parallel.  Supernodes are numbered in post-order, so linking them to their parents afterwards
+    // gives every cluster its children in order.
+    FastVector<typename Base::sharedNode> clusters(structure.nrSupernodes());
+    SupernodeClusters<BAYESTREE,GRAPH> makeCluster(factorGraph, structure, clusters);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size()), makeCluster);
+#else
+    for(size_t s = 0; s < clusters.size(); ++s)
+      makeCluster(s);
+#endif
+
+    for(size_t s = 0; s < clusters.size(); ++s) {
+      if(structure.superParent(s) == SupernodalStructure::None)
+        Base::roots_.push_back(clusters[s]);
+      else
+        clusters[structure.superParent(s)]->children.push_back(clusters[s]);
+    }
+
+    // Size of the dense elimination of each cluster, as used to decide on parallel elimination
+    for(size_t s = 0; s < clusters.size(); ++s)
+      clusters[s]->problemSize_ = int((clusters[s]->keys.size() + structure.separatorSize(s))
+        * (clusters[s]->factors.size() + clusters[s]->children.size()));
+
+    BOOST_FOREACH(size_t i, structure.remainingFactors())
+      if(factorGraph[i])
+        Base::remainingFactors_.push_back(factorGraph[i]);
+  }
+
 } //namespace gtsam
@@ -26,6 +26,7 @@ namespace gtsam {
 
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
+  class SupernodalStructure;
 
   /**
    * A JunctionTree is a ClusterTree, i.e., a set of variable clusters with factors, arranged
@@ -70,6 +71,10 @@ namespace gtsam {
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
     JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
 
+    /** Build the junction tree with the cliques of a SupernodalStructure of \c factorGraph, without
+     *  an elimination tree or symbolic elimination. */
+    JunctionTree(const GRAPH& factorGraph, const SupernodalStructure& structure);
+
     /// @}
 
   private:
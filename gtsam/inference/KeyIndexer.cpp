@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyIndexer.cpp
+ * @brief   Assigns contiguous integer indices to the keys of a problem
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/inference/KeyIndexer.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  const size_t KeyIndexer::None = numeric_limits<size_t>::max();
+
+  /* ************************************************************************* */
+  KeyIndexer::KeyIndexer(const FastVector<Key>& keys) : keys_(keys), sorted_(true)
+  {
+    initialize();
+  }
+
+  /* ************************************************************************* */
+  KeyIndexer::KeyIndexer(const CompressedVariableIndex& variableIndex) :
+    keys_(variableIndex.keys()), sorted_(true) {}
+
+  /* ************************************************************************* */
+  void KeyIndexer::initialize()
+  {
+    // Keys in increasing order are searched directly, otherwise a sorted copy is kept
+    sorted_ = true;
+    for(size_t j = 1; j < keys_.size() && sorted_; ++j)
+      sorted_ = keys_[j - 1] < keys_[j];
+    lookup_.clear();
+    if(!sorted_) {
+      lookup_.reserve(keys_.size());
+      for(size_t j = 0; j < keys_.size(); ++j)
+        lookup_.push_back(make_pair(keys_[j], j));
+      sort(lookup_.begin(), lookup_.end());
+      for(size_t j = 1; j < lookup_.size(); ++j)
+        if(lookup_[j - 1].first == lookup_[j].first)
+          throw invalid_argument("KeyIndexer: a key was given more than once");
+    }
+  }
+
+  /* ************************************************************************* */
+  size_t KeyIndexer::find(Key key) const
+  {
+    if(sorted_) {
+      const FastVector<Key>::const_iterator it = lower_bound(keys_.begin(), keys_.end(), key);
+      return (it == keys_.end() || *it != key) ? None : size_t(it - keys_.begin());
+    } else {
+      const FastVector<pair<Key, size_t> >::const_iterator it =
+        lower_bound(lookup_.begin(), lookup_.end(), make_pair(key, size_t(0)));
+      return (it == lookup_.end() || it->first != key) ? None : it->second;
+    }
+  }
+
+  /* ************************************************************************* */
+  size_t KeyIndexer::index(Key key) const
+  {
+    const size_t j = find(key);
+    if(j == None)
+      throw invalid_argument("Requested non-existent key from KeyIndexer");
+    return j;
+  }
+
+  /* ************************************************************************* */
+  void KeyIndexer::print(const string& str, const KeyFormatter& keyFormatter) const
+  {
+    cout << str << size() << " keys\n";
+    for(size_t j = 0; j < keys_.size(); ++j)
+      cout << "  " << j << ": " << keyFormatter(keys_[j]) << "\n";
+    cout.flush();
+  }
+
+  /* ************************************************************************* */
+  bool KeyIndexer::equals(const KeyIndexer& other, double tol) const
+  {
+    return keys_ == other.keys_;
+  }
+
+}
@@ -0,0 +1,174 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyIndexer.h
+ * @brief   Assigns contiguous integer indices to the keys of a problem
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/inference/FactorGraph.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace gtsam {
+
+  // Forward declarations
+  class CompressedVariableIndex;
+
+  /**
+   * Assigns the contiguous indices 0 to size()-1 to a set of keys, for the opt-in dense key mode
+   * of inference.  Keys are usually Symbol-encoded 64-bit values, so containers indexed by Key
+   * are hash or tree maps and every access in an inner loop hashes or walks a tree.  A KeyIndexer
+   * is created once per problem, the keys of every factor are translated to indices once with
+   * indexFactors(), and from then on containers are flat vectors indexed by those integers, e.g.
+   * DenseVectorValues and BayesTree::denseNodes().
+   *
+   * Looking up a key is a binary search, so it belongs outside of inner loops.
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT KeyIndexer {
+  public:
+    typedef boost::shared_ptr<KeyIndexer> shared_ptr;
+
+    static const size_t None; ///< Index returned by find() for a key that is not indexed
+
+    /**
+     * The dense indices of the keys of each factor of a factor graph, in compressed form: the
+     * indices of the keys of factor i are at begin(i) to end(i), in the order of the factor's keys.
+     * Null factors have no indices.
+     */
+    class GTSAM_EXPORT FactorIndices {
+    public:
+      FactorIndices() { starts_.push_back(0); }
+
+      /** Number of factors */
+      size_t size() const { return starts_.size() - 1; }
+
+      /** Indices of the keys of factor i */
+      const size_t* begin(size_t i) const { return data() + starts_[i]; }
+      const size_t* end(size_t i) const { return data() + starts_[i + 1]; }
+
+    private:
+      FastVector<size_t> starts_;
+      FastVector<size_t> indices_;
+      const size_t* data() const { return indices_.empty() ? 0 : &indices_[0]; }
+      friend class KeyIndexer;
+    };
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor, creates an empty indexer */
+    KeyIndexer() : sorted_(true) {}
+
+    /** Index the keys of a factor graph in increasing key order, as in Ordering::Natural */
+    template<class FACTOR>
+    explicit KeyIndexer(const FactorGraph<FACTOR>& graph);
+
+    /** Index the given keys in the given order, e.g. an Ordering so that indices are elimination
+     *  positions.  Throws std::invalid_argument if a key appears more than once. */
+    explicit KeyIndexer(const FastVector<Key>& keys);
+
+    /** Index the variables of a CompressedVariableIndex, using its dense indices */
+    explicit KeyIndexer(const CompressedVariableIndex& variableIndex);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** Number of indexed keys */
+    size_t size() const { return keys_.size(); }
+
+    /** Key with index j */
+    Key key(size_t j) const { return keys_[j]; }
+
+    /** All keys, in index order */
+    const FastVector<Key>& keys() const { return keys_; }
+
+    /** Index of a key, or None if it is not indexed */
+    size_t find(Key key) const;
+
+    /** Index of a key, throws std::invalid_argument if it is not indexed */
+    size_t index(Key key) const;
+
+    /** Whether a key is indexed */
+    bool exists(Key key) const { return find(key) != None; }
+
+    /** Translate the keys of every factor of a graph to indices, throws std::invalid_argument if
+     *  a factor involves a key that is not indexed */
+    template<class FACTOR>
+    FactorIndices indexFactors(const FactorGraph<FACTOR>& graph) const;
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /** Print the keys and their indices */
+    void print(const std::string& str = "KeyIndexer: ",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+    /** Test for equality */
+    bool equals(const KeyIndexer& other, double tol = 0.0) const;
+
+    /// @}
+
+  private:
+    FastVector<Key> keys_; ///< Key of each index
+    FastVector<std::pair<Key, size_t> > lookup_; ///< Keys and indices sorted by key, if keys_ is not sorted
+    bool sorted_; ///< Whether keys_ is sorted, so it is searched directly
+
+    /** Set up lookups of the keys in keys_ */
+    void initialize();
+  };
+
+  /* ************************************************************************* */
+  template<class FACTOR>
+  KeyIndexer::KeyIndexer(const FactorGraph<FACTOR>& graph) : sorted_(true)
+  {
+    BOOST_FOREACH(const typename FactorGraph<FACTOR>::sharedFactor& factor, graph)
+      if(factor)
+        keys_.insert(keys_.end(), factor->begin(), factor->end());
+    std::sort(keys_.begin(), keys_.end());
+    keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+    initialize();
+  }
+
+  /* ************************************************************************* */
+  template<class FACTOR>
+  KeyIndexer::FactorIndices KeyIndexer::indexFactors(const FactorGraph<FACTOR>& graph) const
+  {
+    FactorIndices result;
+    result.starts_.resize(graph.size() + 1);
+    for(size_t i = 0; i < graph.size(); ++i) {
+      result.starts_[i + 1] = result.starts_[i] + (graph[i] ? graph[i]->size() : 0);
+    }
+    result.indices_.resize(result.starts_.back());
+    for(size_t i = 0; i < graph.size(); ++i) {
+      if(graph[i]) {
+        size_t p = result.starts_[i];
+        BOOST_FOREACH(Key key, *graph[i])
+          result.indices_[p++] = index(key);
+      }
+    }
+    return result;
+  }
+
+}
@@ -17,6 +17,7 @@
 
 #include <vector>
 #include <limits>
+#include <algorithm>
 
 #include <boost/format.hpp>
 
@@ -36,6 +37,141 @@ namespace gtsam {
     return inverted;
   }
 
+  namespace {
+    /* ************************************************************************* */
+    // Calls CCOLAMD on the nVars compressed columns in A and p of a matrix with nFactors rows, and
+    // returns the ordering of the variables whose keys are in \c keys in column order.  A must
+    // have the length recommended by ccolamd_recommended.
+    template<class KEYS>
+    Ordering ccolamdOrdering(size_t nFactors, size_t nVars, vector<int>& A, vector<int>& p,
+      vector<int>& cmember, const KEYS& keys)
+    {
+      //double* knobs = NULL; /* colamd arg 6: parameters (uses defaults if NULL) */
+      double knobs[CCOLAMD_KNOBS];
+      ccolamd_set_defaults(knobs);
+      knobs[CCOLAMD_DENSE_ROW]=-1;
+      knobs[CCOLAMD_DENSE_COL]=-1;
+
+      int stats[CCOLAMD_STATS]; /* colamd arg 7: colamd output statistics and error codes */
+
+      // call colamd, result will be in p
+      /* returns (1) if successful, (0) otherwise*/
+      if(nVars > 0) {
+        gttic(ccolamd);
+        int rv = ccolamd((int)nFactors, (int)nVars, (int)A.size(), &A[0], &p[0], knobs, stats, &cmember[0]);
+        if(rv != 1)
+          throw runtime_error((boost::format("ccolamd failed with return value %1%")%rv).str());
+      }
+
+      //  ccolamd_report(stats);
+
+      gttic(Fill_Ordering);
+      // Convert elimination ordering in p to an ordering
+      Ordering result;
+      result.resize(nVars);
+      for(size_t j = 0; j < nVars; ++j)
+        result[j] = keys[p[j]];
+      gttoc(Fill_Ordering);
+
+      return result;
+    }
+
+    /* ************************************************************************* */
+    // Renumbers the constraint groups in cmember to 0, 1, ... keeping their order, as CCOLAMD
+    // does not order correctly when a group is skipped, e.g. when no variable is in group 0.
+    void compactGroups(vector<int>& cmember)
+    {
+      vector<int> groups(cmember);
+      sort(groups.begin(), groups.end());
+      groups.erase(unique(groups.begin(), groups.end()), groups.end());
+      BOOST_FOREACH(int& c, cmember)
+        c = int(lower_bound(groups.begin(), groups.end(), c) - groups.begin());
+    }
+
+    /* ************************************************************************* */
+    // The CCOLAMD column of every variable of a VariableIndex, which COLAMDConstrained passes in
+    // key order
+    class VariableIndexColumns {
+      FastMap<Key, size_t> columns_;
+    public:
+      explicit VariableIndexColumns(const VariableIndex& variableIndex) {
+        size_t j = 0;
+        BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
+          columns_.insert(columns_.end(), make_pair(key_factors.first, j++));
+      }
+      size_t operator()(Key key) const { return columns_.at(key); }
+    };
+
+    // The CCOLAMD column of every variable of a CompressedVariableIndex, which is its index
+    class CompressedVariableIndexColumns {
+      const CompressedVariableIndex& variableIndex_;
+    public:
+      explicit CompressedVariableIndexColumns(const CompressedVariableIndex& variableIndex) :
+        variableIndex_(variableIndex) {}
+      size_t operator()(Key key) const { return variableIndex_.index(key); }
+    };
+
+    /* ************************************************************************* */
+    // Groups of the n variables that put those in constrainLast last, in that order if
+    // forceOrder, given the CCOLAMD column of every key
+    template<class COLUMNS>
+    vector<int> constrainedLastGroups(size_t n, const COLUMNS& column,
+      const vector<Key>& constrainLast, bool forceOrder)
+    {
+      vector<int> cmember(n, 0);
+
+      // If at least some variables are not constrained to be last, constrain the
+      // ones that should be constrained.
+      int group = (constrainLast.size() != n ? 1 : 0);
+      BOOST_FOREACH(Key key, constrainLast) {
+        cmember[column(key)] = group;
+        if(forceOrder)
+          ++ group;
+      }
+      return cmember;
+    }
+
+    /* ************************************************************************* */
+    // Groups of the n variables that put those in constrainFirst first, in that order if
+    // forceOrder, given the CCOLAMD column of every key
+    template<class COLUMNS>
+    vector<int> constrainedFirstGroups(size_t n, const COLUMNS& column,
+      const vector<Key>& constrainFirst, bool forceOrder)
+    {
+      const int none = -1;
+      vector<int> cmember(n, none);
+
+      // Constrain the variables that should be first, and put all others in one group after them
+      int group = 0;
+      BOOST_FOREACH(Key key, constrainFirst) {
+        cmember[column(key)] = group;
+        if(forceOrder)
+          ++ group;
+      }
+
+      if(!forceOrder && !constrainFirst.empty())
+        ++ group;
+      BOOST_FOREACH(int& c, cmember)
+        if(c == none)
+          c = group;
+      return cmember;
+    }
+
+    /* ************************************************************************* */
+    // Groups of the n variables given by key, variables not in groups being in group 0, given the
+    // CCOLAMD column of every key
+    template<class COLUMNS>
+    vector<int> keyGroups(size_t n, const COLUMNS& column, const FastMap<Key, int>& groups)
+    {
+      vector<int> cmember(n, 0);
+      typedef FastMap<Key, int>::value_type key_group;
+      BOOST_FOREACH(const key_group& p, groups)
+        cmember[column(p.first)] = p.second;
+      compactGroups(cmember);
+      return cmember;
+    }
+  }
+
   /* ************************************************************************* */
   Ordering Ordering::COLAMD(const VariableIndex& variableIndex)
   {
@@ -44,6 +180,14 @@ namespace gtsam {
     return Ordering::COLAMDConstrained(variableIndex, dummy_groups);
   }
 
+  /* ************************************************************************* */
+  Ordering Ordering::COLAMD(const CompressedVariableIndex& variableIndex)
+  {
+    // Call constrained version with all groups set to zero
+    vector<int> dummy_groups(variableIndex.size(), 0);
+    return Ordering::COLAMDConstrained(variableIndex, dummy_groups);
+  }
+
   /* ************************************************************************* */
   Ordering Ordering::COLAMDConstrained(
     const VariableIndex& variableIndex, std::vector<int>& cmember)
@@ -78,37 +222,28 @@ namespace gtsam {
     }
 
     assert((size_t)count == variableIndex.nEntries());
-
-    //double* knobs = NULL; /* colamd arg 6: parameters (uses defaults if NULL) */
-    double knobs[CCOLAMD_KNOBS];
-    ccolamd_set_defaults(knobs);
-    knobs[CCOLAMD_DENSE_ROW]=-1;
-    knobs[CCOLAMD_DENSE_COL]=-1;
-
-    int stats[CCOLAMD_STATS]; /* colamd arg 7: colamd output statistics and error codes */
-
     gttoc(Prepare);
 
-    // call colamd, result will be in p
-    /* returns (1) if successful, (0) otherwise*/
-    if(nVars > 0) {
-      gttic(ccolamd);
-      int rv = ccolamd((int)nFactors, (int)nVars, (int)Alen, &A[0], &p[0], knobs, stats, &cmember[0]);
-      if(rv != 1)
-        throw runtime_error((boost::format("ccolamd failed with return value %1%")%rv).str());
-    }
+    return ccolamdOrdering(nFactors, nVars, A, p, cmember, keys);
+  }
 
-    //  ccolamd_report(stats);
+  /* ************************************************************************* */
+  Ordering Ordering::COLAMDConstrained(
+    const CompressedVariableIndex& variableIndex, std::vector<int>& cmember)
+  {
+    gttic(Ordering_COLAMDConstrained);
 
-    gttic(Fill_Ordering);
-    // Convert elimination ordering in p to an ordering
-    Ordering result;
-    result.resize(nVars);
-    for(size_t j = 0; j < nVars; ++j)
-      result[j] = keys[p[j]];
-    gttoc(Fill_Ordering);
+    // The index is already in the compressed column format colamd wants, only the integer type
+    // differs, and its columns are in key order
+    gttic(Prepare);
+    size_t nEntries = variableIndex.nEntries(), nFactors = variableIndex.nFactors(), nVars = variableIndex.size();
+    size_t Alen = ccolamd_recommended((int)nEntries, (int)nFactors, (int)nVars);
+    vector<int> A(Alen);
+    vector<int> p(variableIndex.starts().begin(), variableIndex.starts().end());
+    copy(variableIndex.factorIndices().begin(), variableIndex.factorIndices().end(), A.begin());
+    gttoc(Prepare);
 
-    return result;
+    return ccolamdOrdering(nFactors, nVars, A, p, cmember, variableIndex.keys());
   }
 
   /* ************************************************************************* */
@@ -116,25 +251,8 @@ namespace gtsam {
     const VariableIndex& variableIndex, const std::vector<Key>& constrainLast, bool forceOrder)
   {
     gttic(Ordering_COLAMDConstrainedLast);
-
-    size_t n = variableIndex.size();
-    std::vector<int> cmember(n, 0);
-
-    // Build a mapping to look up sorted Key indices by Key
-    FastMap<Key, size_t> keyIndices;
-    size_t j = 0;
-    BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-      keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
-
-    // If at least some variables are not constrained to be last, constrain the
-    // ones that should be constrained.
-    int group = (constrainLast.size() != n ? 1 : 0);
-    BOOST_FOREACH(Key key, constrainLast) {
-      cmember[keyIndices.at(key)] = group;
-      if(forceOrder)
-        ++ group;
-    }
-
+    vector<int> cmember = constrainedLastGroups(variableIndex.size(),
+      VariableIndexColumns(variableIndex), constrainLast, forceOrder);
     return Ordering::COLAMDConstrained(variableIndex, cmember);
   }
 
@@ -143,56 +261,46 @@ namespace gtsam {
     const VariableIndex& variableIndex, const std::vector<Key>& constrainFirst, bool forceOrder)
   {
     gttic(Ordering_COLAMDConstrainedFirst);
+    vector<int> cmember = constrainedFirstGroups(variableIndex.size(),
+      VariableIndexColumns(variableIndex), constrainFirst, forceOrder);
+    return Ordering::COLAMDConstrained(variableIndex, cmember);
+  }
 
-    const int none = -1;
-    size_t n = variableIndex.size();
-    std::vector<int> cmember(n, none);
-
-    // Build a mapping to look up sorted Key indices by Key
-    FastMap<Key, size_t> keyIndices;
-    size_t j = 0;
-    BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-      keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
-
-    // If at least some variables are not constrained to be last, constrain the
-    // ones that should be constrained.
-    int group = 0;
-    BOOST_FOREACH(Key key, constrainFirst) {
-      cmember[keyIndices.at(key)] = group;
-      if(forceOrder)
-        ++ group;
-    }
+  /* ************************************************************************* */
+  Ordering Ordering::COLAMDConstrained(const VariableIndex& variableIndex,
+    const FastMap<Key, int>& groups)
+  {
+    gttic(Ordering_COLAMDConstrained);
+    vector<int> cmember = keyGroups(variableIndex.size(), VariableIndexColumns(variableIndex), groups);
+    return Ordering::COLAMDConstrained(variableIndex, cmember);
+  }
 
-    if(!forceOrder && !constrainFirst.empty())
-      ++ group;
-    BOOST_FOREACH(int& c, cmember)
-      if(c == none)
-        c = group;
+  /* ************************************************************************* */
+  Ordering Ordering::COLAMDConstrainedLast(
+    const CompressedVariableIndex& variableIndex, const std::vector<Key>& constrainLast, bool forceOrder)
+  {
+    gttic(Ordering_COLAMDConstrainedLast);
+    vector<int> cmember = constrainedLastGroups(variableIndex.size(),
+      CompressedVariableIndexColumns(variableIndex), constrainLast, forceOrder);
+    return Ordering::COLAMDConstrained(variableIndex, cmember);
+  }
 
+  /* ************************************************************************* */
+  Ordering Ordering::COLAMDConstrainedFirst(
+    const CompressedVariableIndex& variableIndex, const std::vector<Key>& constrainFirst, bool forceOrder)
+  {
+    gttic(Ordering_COLAMDConstrainedFirst);
+    vector<int> cmember = constrainedFirstGroups(variableIndex.size(),
+      CompressedVariableIndexColumns(variableIndex), constrainFirst, forceOrder);
     return Ordering::COLAMDConstrained(variableIndex, cmember);
   }
 
   /* ************************************************************************* */
-  Ordering Ordering::COLAMDConstrained(const VariableIndex& variableIndex,
+  Ordering Ordering::COLAMDConstrained(const CompressedVariableIndex& variableIndex,
     const FastMap<Key, int>& groups)
   {
     gttic(Ordering_COLAMDConstrained);
-    size_t n = variableIndex.size();
-    std::vector<int> cmember(n, 0);
-
-    // Build a mapping to look up sorted Key indices by Key
-    FastMap<Key, size_t> keyIndices;
-    size_t j = 0;
-    BOOST_FOREACH(const VariableIndex::value_type key_factors, variableIndex)
-      keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
-
-    // Assign groups
-    typedef FastMap<Key, int>::value_type key_group;
-    BOOST_FOREACH(const key_group& p, groups) {
-      // FIXME: check that no groups are skipped
-      cmember[keyIndices.at(p.first)] = p.second;
-    }
-
+    vector<int> cmember = keyGroups(variableIndex.size(), CompressedVariableIndexColumns(variableIndex), groups);
     return Ordering::COLAMDConstrained(variableIndex, cmember);
   }
 
@@ -24,6 +24,7 @@
 #include <gtsam/base/FastSet.h>
 #include <gtsam/inference/Key.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
 #include <gtsam/inference/FactorGraph.h>
 
 namespace gtsam {
@@ -59,18 +60,22 @@ namespace gtsam {
     /// @name Fill-reducing Orderings @{
 
     /// Compute a fill-reducing ordering using COLAMD from a factor graph (see details for note on
-    /// performance). This internally builds a VariableIndex so if you already have a VariableIndex,
-    /// it is faster to use COLAMD(const VariableIndex&)
+    /// performance). This internally builds a CompressedVariableIndex so if you already have a
+    /// variable index, it is faster to use COLAMD(const VariableIndex&)
     template<class FACTOR>
     static Ordering COLAMD(const FactorGraph<FACTOR>& graph) {
-      return COLAMD(VariableIndex(graph)); }
+      return COLAMD(CompressedVariableIndex(graph)); }
 
     /// Compute a fill-reducing ordering using COLAMD from a VariableIndex.
     static GTSAM_EXPORT Ordering COLAMD(const VariableIndex& variableIndex);
 
+    /// Compute a fill-reducing ordering using COLAMD from a CompressedVariableIndex, whose
+    /// compressed columns are passed to COLAMD without conversion.
+    static GTSAM_EXPORT Ordering COLAMD(const CompressedVariableIndex& variableIndex);
+
     /// Compute a fill-reducing ordering using constrained COLAMD from a factor graph (see details
-    /// for note on performance).  This internally builds a VariableIndex so if you already have a
-    /// VariableIndex, it is faster to use COLAMD(const VariableIndex&).  This function constrains
+    /// for note on performance).  This internally builds a CompressedVariableIndex so if you already
+    /// have a variable index, it is faster to use COLAMD(const VariableIndex&).  This function constrains
     /// the variables in \c constrainLast to the end of the ordering, and orders all other variables
     /// before in a fill-reducing ordering.  If \c forceOrder is true, the variables in \c
     /// constrainLast will be ordered in the same order specified in the vector<Key> \c
@@ -79,7 +84,7 @@ namespace gtsam {
     template<class FACTOR>
     static Ordering COLAMDConstrainedLast(const FactorGraph<FACTOR>& graph,
       const std::vector<Key>& constrainLast, bool forceOrder = false) {
-        return COLAMDConstrainedLast(VariableIndex(graph), constrainLast, forceOrder); }
+        return COLAMDConstrainedLast(CompressedVariableIndex(graph), constrainLast, forceOrder); }
 
     /// Compute a fill-reducing ordering using constrained COLAMD from a VariableIndex.  This
     /// function constrains the variables in \c constrainLast to the end of the ordering, and orders
@@ -90,9 +95,14 @@ namespace gtsam {
     static GTSAM_EXPORT Ordering COLAMDConstrainedLast(const VariableIndex& variableIndex,
       const std::vector<Key>& constrainLast, bool forceOrder = false);
 
+    /// Same as COLAMDConstrainedLast(const VariableIndex&, const std::vector<Key>&, bool), from a
+    /// CompressedVariableIndex.
+    static GTSAM_EXPORT Ordering COLAMDConstrainedLast(const CompressedVariableIndex& variableIndex,
+      const std::vector<Key>& constrainLast, bool forceOrder = false);
+
     /// Compute a fill-reducing ordering using constrained COLAMD from a factor graph (see details
-    /// for note on performance).  This internally builds a VariableIndex so if you already have a
-    /// VariableIndex, it is faster to use COLAMD(const VariableIndex&).  This function constrains
+    /// for note on performance).  This internally builds a CompressedVariableIndex so if you already
+    /// have a variable index, it is faster to use COLAMD(const VariableIndex&).  This function constrains
     /// the variables in \c constrainLast to the end of the ordering, and orders all other variables
     /// before in a fill-reducing ordering.  If \c forceOrder is true, the variables in \c
     /// constrainLast will be ordered in the same order specified in the vector<Key> \c
@@ -101,7 +111,7 @@ namespace gtsam {
     template<class FACTOR>
     static Ordering COLAMDConstrainedFirst(const FactorGraph<FACTOR>& graph,
       const std::vector<Key>& constrainFirst, bool forceOrder = false) {
-        return COLAMDConstrainedFirst(VariableIndex(graph), constrainFirst, forceOrder); }
+        return COLAMDConstrainedFirst(CompressedVariableIndex(graph), constrainFirst, forceOrder); }
 
     /// Compute a fill-reducing ordering using constrained COLAMD from a VariableIndex.  This
     /// function constrains the variables in \c constrainFirst to the front of the ordering, and
@@ -113,30 +123,40 @@ namespace gtsam {
     static GTSAM_EXPORT Ordering COLAMDConstrainedFirst(const VariableIndex& variableIndex,
       const std::vector<Key>& constrainFirst, bool forceOrder = false);
 
+    /// Same as COLAMDConstrainedFirst(const VariableIndex&, const std::vector<Key>&, bool), from a
+    /// CompressedVariableIndex.
+    static GTSAM_EXPORT Ordering COLAMDConstrainedFirst(const CompressedVariableIndex& variableIndex,
+      const std::vector<Key>& constrainFirst, bool forceOrder = false);
+
     /// Compute a fill-reducing ordering using constrained COLAMD from a factor graph (see details
-    /// for note on performance).  This internally builds a VariableIndex so if you already have a
-    /// VariableIndex, it is faster to use COLAMD(const VariableIndex&).  In this function, a group
+    /// for note on performance).  This internally builds a CompressedVariableIndex so if you already
+    /// have a variable index, it is faster to use COLAMD(const VariableIndex&).  In this function, a group
     /// for each variable should be specified in \c groups, and each group of variables will appear
     /// in the ordering in group index order.  \c groups should be a map from Key to group index.
-    /// The group indices used should be consecutive starting at 0, but may appear in \c groups in
-    /// arbitrary order.  Any variables not present in \c groups will be assigned to group 0.  This
-    /// function simply fills the \c cmember argument to CCOLAMD with the supplied indices, see the
-    /// CCOLAMD documentation for more information.
+    /// The group indices may appear in \c groups in arbitrary order, and need not be consecutive.
+    /// Any variables not present in \c groups will be assigned to group 0.  This function fills the
+    /// \c cmember argument to CCOLAMD with the supplied indices, renumbered to be consecutive from
+    /// 0, see the CCOLAMD documentation for more information.
     template<class FACTOR>
     static Ordering COLAMDConstrained(const FactorGraph<FACTOR>& graph,
       const FastMap<Key, int>& groups) {
-        return COLAMDConstrained(VariableIndex(graph), groups); }
+        return COLAMDConstrained(CompressedVariableIndex(graph), groups); }
 
     /// Compute a fill-reducing ordering using constrained COLAMD from a VariableIndex.  In this
     /// function, a group for each variable should be specified in \c groups, and each group of
     /// variables will appear in the ordering in group index order.  \c groups should be a map from
-    /// Key to group index. The group indices used should be consecutive starting at 0, but may
-    /// appear in \c groups in arbitrary order.  Any variables not present in \c groups will be
-    /// assigned to group 0.  This function simply fills the \c cmember argument to CCOLAMD with the
-    /// supplied indices, see the CCOLAMD documentation for more information.
+    /// Key to group index.  The group indices may appear in \c groups in arbitrary order, and need
+    /// not be consecutive.  Any variables not present in \c groups will be assigned to group 0.
+    /// This function fills the \c cmember argument to CCOLAMD with the supplied indices,
+    /// renumbered to be consecutive from 0, see the CCOLAMD documentation for more information.
     static GTSAM_EXPORT Ordering COLAMDConstrained(const VariableIndex& variableIndex,
       const FastMap<Key, int>& groups);
 
+    /// Same as COLAMDConstrained(const VariableIndex&, const FastMap<Key, int>&), from a
+    /// CompressedVariableIndex.
+    static GTSAM_EXPORT Ordering COLAMDConstrained(const CompressedVariableIndex& variableIndex,
+      const FastMap<Key, int>& groups);
+
     /// Return a natural Ordering. Typically used by iterative solvers
     template <class FACTOR>
     static Ordering Natural(const FactorGraph<FACTOR> &fg) {
@@ -161,6 +181,10 @@ namespace gtsam {
     static GTSAM_EXPORT Ordering COLAMDConstrained(
       const VariableIndex& variableIndex, std::vector<int>& cmember);
 
+    /// Internal COLAMD function
+    static GTSAM_EXPORT Ordering COLAMDConstrained(
+      const CompressedVariableIndex& variableIndex, std::vector<int>& cmember);
+
     /** Serialization function */
     friend class boost::serialization::access;
     template<class ARCHIVE>
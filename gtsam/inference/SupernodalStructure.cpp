@@ -0,0 +1,294 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalStructure.cpp
+ * @brief   Elimination tree, column counts and relaxed supernodes of an ordered factor graph
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/inference/SupernodalStructure.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  const size_t SupernodalStructure::None = numeric_limits<size_t>::max();
+
+  namespace {
+    // The algorithms below follow CSparse (Davis, "Direct Methods for Sparse Linear Systems"), on
+    // the matrix A'A where A has a row per factor and a column per ordered variable.  -1 marks none.
+    typedef ptrdiff_t Index;
+
+    /* ************************************************************************* */
+    // Depth-first post-order of the elimination forest.  Children are visited in increasing order.
+    void postorder(const FastVector<Index>& parents, FastVector<Index>& post) {
+      const Index n = (Index)parents.size();
+      FastVector<Index> head(n, -1), next(n), stack(n);
+      for(Index j = n - 1; j >= 0; --j) {
+        if(parents[j] != -1) {
+          next[j] = head[parents[j]];
+          head[parents[j]] = j;
+        }
+      }
+      Index k = 0;
+      for(Index j = 0; j < n; ++j) {
+        if(parents[j] != -1)
+          continue;
+        Index top = 0;
+        stack[0] = j;
+        while(top >= 0) {
+          const Index p = stack[top], child = head[p];
+          if(child == -1) {
+            --top;
+            post[k++] = p;
+          } else {
+            head[p] = next[child];
+            stack[++top] = child;
+          }
+        }
+      }
+    }
+
+    /* ************************************************************************* */
+    // Whether j is a leaf of the row subtree of i, and if so the least common ancestor q of j and
+    // the previous leaf of that subtree (cs_leaf)
+    Index leaf(Index i, Index j, const FastVector<Index>& first, FastVector<Index>& maxfirst,
+        FastVector<Index>& prevleaf, FastVector<Index>& ancestor, int& jleaf) {
+      jleaf = 0;
+      if(i <= j || first[j] <= maxfirst[i])
+        return -1;
+      maxfirst[i] = first[j];
+      const Index jprev = prevleaf[i];
+      prevleaf[i] = j;
+      jleaf = (jprev == -1) ? 1 : 2;
+      if(jleaf == 1)
+        return i;
+      Index q = jprev;
+      while(q != ancestor[q])
+        q = ancestor[q];
+      for(Index s = jprev, sparent; s != q; s = sparent) {
+        sparent = ancestor[s];
+        ancestor[s] = q;
+      }
+      return q;
+    }
+
+    /* ************************************************************************* */
+    // Dense lower trapezoid of a clique with ns frontal and nsep separator variables
+    double entries(double ns, double nsep) {
+      return ns * (ns + 1.0) / 2.0 + ns * nsep;
+    }
+  }
+
+  /* ************************************************************************* */
+  SupernodalStructure::SupernodalStructure(const VariableIndex& structure, const Ordering& order,
+      const SupernodeParams& params) : nrExplicitZeros_(0.0)
+  {
+    gttic(SupernodalStructure_Constructor);
+    const Index n = (Index)order.size(), m = (Index)structure.nFactors();
+
+    // Factor rows in compressed form, filled from the variable index so no key is looked up: the
+    // positions of the ordered variables of factor i are rowPositions[rowStarts[i]..rowStarts[i+1]),
+    // in increasing order.
+    gttic(rows);
+    FastVector<const VariableIndex::Factors*> columns(n);
+    FastVector<Index> rowStarts(m + 1, 0);
+    try {
+      for(Index j = 0; j < n; ++j) {
+        columns[j] = &structure[order[j]];
+        BOOST_FOREACH(size_t i, *columns[j])
+          ++ rowStarts[i + 1];
+      }
+    } catch(std::invalid_argument&) {
+      throw std::invalid_argument("SupernodalStructure: given ordering contains variables that are not involved in the factor graph");
+    }
+    partial_sum(rowStarts.begin(), rowStarts.end(), rowStarts.begin());
+    FastVector<Index> rowPositions(rowStarts.back());
+    {
+      FastVector<Index> fill(rowStarts.begin(), rowStarts.end() - 1);
+      for(Index j = 0; j < n; ++j)
+        BOOST_FOREACH(size_t i, *columns[j])
+          rowPositions[fill[i]++] = j;
+    }
+    gttoc(rows);
+
+    // Elimination tree of A'A (cs_etree), a variable's first factor in each row linking it to the
+    // root of the subtree of the previous variable of that row
+    gttic(etree);
+    FastVector<Index> parents(n), ancestor(n), prev(m, -1);
+    for(Index k = 0; k < n; ++k) {
+      parents[k] = -1;
+      ancestor[k] = -1;
+      BOOST_FOREACH(size_t i, *columns[k]) {
+        for(Index r = prev[i], rnext; r != -1 && r < k; r = rnext) {
+          rnext = ancestor[r];
+          ancestor[r] = k;
+          if(rnext == -1)
+            parents[r] = k;
+        }
+        prev[i] = k;
+      }
+    }
+    gttoc(etree);
+
+    gttic(postorder);
+    FastVector<Index> post(n), ipost(n);
+    postorder(parents, post);
+    for(Index k = 0; k < n; ++k)
+      ipost[post[k]] = k;
+    gttoc(postorder);
+
+    // Column counts (cs_counts for A'A): each factor row is handled at the first of its variables
+    // in post-order, and the skeleton of the row subtrees is counted with least common ancestors.
+    gttic(column_counts);
+    FastVector<Index> counts(n), first(n, -1), maxfirst(n, -1), prevleaf(n, -1);
+    for(Index k = 0; k < n; ++k) {
+      Index j = post[k];
+      counts[j] = (first[j] == -1) ? 1 : 0;
+      for(; j != -1 && first[j] == -1; j = parents[j])
+        first[j] = k;
+    }
+    FastVector<Index> head(n, -1), next(m, -1);
+    for(Index i = 0; i < m; ++i) {
+      if(rowStarts[i] == rowStarts[i + 1])
+        continue;
+      Index k = n;
+      for(Index p = rowStarts[i]; p < rowStarts[i + 1]; ++p)
+        k = min(k, ipost[rowPositions[p]]);
+      next[i] = head[k];
+      head[k] = i;
+    }
+    for(Index j = 0; j < n; ++j)
+      ancestor[j] = j;
+    for(Index k = 0; k < n; ++k) {
+      const Index j = post[k];
+      if(parents[j] != -1)
+        -- counts[parents[j]];
+      for(Index row = head[k]; row != -1; row = next[row]) {
+        for(Index p = rowStarts[row]; p < rowStarts[row + 1]; ++p) {
+          int jleaf;
+          const Index q = leaf(rowPositions[p], j, first, maxfirst, prevleaf, ancestor, jleaf);
+          if(jleaf >= 1)
+            ++ counts[j];
+          if(jleaf == 2)
+            -- counts[q];
+        }
+      }
+      if(parents[j] != -1)
+        ancestor[j] = parents[j];
+    }
+    for(Index j = 0; j < n; ++j)
+      if(parents[j] != -1)
+        counts[parents[j]] += counts[j];
+    gttoc(column_counts);
+
+    // Relaxed amalgamation in post-order: each child supernode is merged into the supernode of
+    // its elimination tree parent if SupernodeParams accepts the explicit zeros this adds.  The
+    // separator of a supernode is that of its last variable, whose parent is in the parent supernode.
+    gttic(amalgamate);
+    FastVector<Index> mergedInto(n, -1), nrFrontals(n, 1);
+    FastVector<double> zeros(n, 0.0);
+    FastVector<Index> sibling(n, -1);
+    head.assign(n, -1);
+    for(Index j = n - 1; j >= 0; --j) {
+      if(parents[j] != -1) {
+        sibling[j] = head[parents[j]];
+        head[parents[j]] = j;
+      }
+    }
+    for(Index k = 0; k < n; ++k) {
+      const Index j = post[k];
+      const double separator = double(counts[j] - 1);
+      for(Index c = head[j]; c != -1; c = sibling[c]) {
+        const double childSeparator = double(counts[c] - 1);
+        const size_t size = size_t(nrFrontals[c] + nrFrontals[j]);
+        const double total = entries(double(size), separator);
+        const double added = total - entries(double(nrFrontals[c]), childSeparator)
+            - entries(double(nrFrontals[j]), separator);
+        const double fraction = (zeros[c] + zeros[j] + added) / total;
+        if(added <= 0.0 || size <= params.alwaysMergeSize
+            || (size <= params.smallSize && fraction < params.smallZeros)
+            || (size <= params.mediumSize && fraction < params.mediumZeros)
+            || fraction < params.largeZeros) {
+          mergedInto[c] = j;
+          nrFrontals[j] += nrFrontals[c];
+          zeros[j] += zeros[c] + added;
+        }
+      }
+    }
+
+    // Number supernodes in post-order of their last variables, and find the supernode of every
+    // variable, parents before children
+    FastVector<Index> supernode(n);
+    Index nrSupernodes = 0;
+    for(Index k = 0; k < n; ++k)
+      if(mergedInto[post[k]] == -1)
+        supernode[post[k]] = nrSupernodes++;
+    for(Index k = n - 1; k >= 0; --k)
+      if(mergedInto[post[k]] != -1)
+        supernode[post[k]] = supernode[mergedInto[post[k]]];
+    gttoc(amalgamate);
+
+    // Gather results
+    gttic(gather);
+    parents_.resize(n);
+    columnCounts_.resize(n);
+    superParents_.resize(nrSupernodes);
+    separatorSizes_.resize(nrSupernodes);
+    frontalStarts_.assign(nrSupernodes + 1, 0);
+    for(Index j = 0; j < n; ++j) {
+      parents_[j] = parents[j] == -1 ? None : size_t(parents[j]);
+      columnCounts_[j] = size_t(counts[j]);
+      ++ frontalStarts_[supernode[j] + 1];
+      if(mergedInto[j] == -1) {
+        superParents_[supernode[j]] = parents[j] == -1 ? None : size_t(supernode[parents[j]]);
+        separatorSizes_[supernode[j]] = size_t(counts[j] - 1);
+        nrExplicitZeros_ += zeros[j];
+      }
+    }
+    partial_sum(frontalStarts_.begin(), frontalStarts_.end(), frontalStarts_.begin());
+    frontals_.resize(n);
+    {
+      FastVector<size_t> fill(frontalStarts_.begin(), frontalStarts_.end() - 1);
+      for(Index j = 0; j < n; ++j)
+        frontals_[fill[supernode[j]]++] = order[j];
+    }
+
+    // Each factor goes to the supernode of its first eliminated variable
+    factorStarts_.assign(nrSupernodes + 1, 0);
+    for(Index i = 0; i < m; ++i) {
+      if(rowStarts[i] != rowStarts[i + 1])
+        ++ factorStarts_[supernode[rowPositions[rowStarts[i]]] + 1];
+      else
+        remainingFactors_.push_back(size_t(i));
+    }
+    partial_sum(factorStarts_.begin(), factorStarts_.end(), factorStarts_.begin());
+    factors_.resize(factorStarts_.back());
+    {
+      FastVector<size_t> fill(factorStarts_.begin(), factorStarts_.end() - 1);
+      for(Index i = 0; i < m; ++i)
+        if(rowStarts[i] != rowStarts[i + 1])
+          factors_[fill[supernode[rowPositions[rowStarts[i]]]]++] = size_t(i);
+    }
+    gttoc(gather);
+  }
+
+}
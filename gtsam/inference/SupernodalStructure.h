@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalStructure.h
+ * @brief   Elimination tree, column counts and relaxed supernodes of an ordered factor graph
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/inference/Key.h>
+
+namespace gtsam {
+
+  // Forward declarations
+  class VariableIndex;
+  class Ordering;
+
+  /**
+   * Parameters of supernode amalgamation in SupernodalStructure.  A child supernode is merged into
+   * its parent whenever that adds no explicit zeros to the dense clique.  Otherwise it is merged if
+   * the merged clique has at most \c alwaysMergeSize frontal variables, or if the fraction of
+   * explicit zeros in the merged clique is below the limit for its size: \c smallZeros up to
+   * \c smallSize frontal variables, \c mediumZeros up to \c mediumSize, and \c largeZeros beyond.
+   * Larger cliques make for fewer, larger dense factorizations, which BLAS runs more efficiently.
+   * The defaults are those of CHOLMOD.
+   */
+  struct GTSAM_EXPORT SupernodeParams {
+    size_t alwaysMergeSize; ///< Merged cliques with up to this many frontal variables are always accepted (default: 4)
+    size_t smallSize; ///< Largest clique, in frontal variables, that smallZeros applies to (default: 16)
+    size_t mediumSize; ///< Largest clique, in frontal variables, that mediumZeros applies to (default: 48)
+    double smallZeros; ///< Largest fraction of explicit zeros in a small merged clique (default: 0.8)
+    double mediumZeros; ///< Largest fraction of explicit zeros in a medium merged clique (default: 0.1)
+    double largeZeros; ///< Largest fraction of explicit zeros in a large merged clique (default: 0.05)
+
+    SupernodeParams(size_t _alwaysMergeSize = 4, size_t _smallSize = 16, size_t _mediumSize = 48,
+      double _smallZeros = 0.8, double _mediumZeros = 0.1, double _largeZeros = 0.05) :
+      alwaysMergeSize(_alwaysMergeSize), smallSize(_smallSize), mediumSize(_mediumSize),
+      smallZeros(_smallZeros), mediumZeros(_mediumZeros), largeZeros(_largeZeros) {}
+
+    /** Merge only where no explicit zeros are added, i.e. exact supernodes */
+    static SupernodeParams Exact() { return SupernodeParams(0, 0, 0, 0.0, 0.0, 0.0); }
+  };
+
+  /**
+   * The symbolic analysis of eliminating a factor graph in a given ordering, computed on flat
+   * integer arrays without symbolic factors: the elimination tree (Liu's algorithm with path
+   * compression), the number of variables in every conditional (Gilbert, Ng and Peyton's column
+   * counts), and the cliques obtained by amalgamating the elimination tree into relaxed supernodes
+   * (see SupernodeParams).  Variables are identified by their position in the ordering, and
+   * supernodes are numbered in a post-order, children before parents.
+   *
+   * A JunctionTree can be built from this structure directly instead of from an EliminationTree,
+   * see e.g. GaussianJunctionTree(const GaussianFactorGraph&, const SupernodalStructure&).
+   * Variables not in the ordering (partial elimination) are left out of the analysis.
+   */
+  class GTSAM_EXPORT SupernodalStructure {
+  public:
+    static const size_t None; ///< Parent of a root
+
+    /** Analyze eliminating the factors indexed by \c structure in the order \c order */
+    SupernodalStructure(const VariableIndex& structure, const Ordering& order,
+      const SupernodeParams& params = SupernodeParams());
+
+    /** Number of variables eliminated */
+    size_t nrVariables() const { return parents_.size(); }
+
+    /** Elimination tree parent of the variable at position j of the ordering, or None */
+    size_t parent(size_t j) const { return parents_[j]; }
+
+    /** Number of variables in the conditional of the variable at position j, itself included */
+    size_t columnCount(size_t j) const { return columnCounts_[j]; }
+
+    /** Number of supernodes, i.e. cliques */
+    size_t nrSupernodes() const { return superParents_.size(); }
+
+    /** Parent supernode of supernode s, or None */
+    size_t superParent(size_t s) const { return superParents_[s]; }
+
+    /** Frontal keys of supernode s, in elimination order */
+    FastVector<Key>::const_iterator frontalsBegin(size_t s) const { return frontals_.begin() + frontalStarts_[s]; }
+    FastVector<Key>::const_iterator frontalsEnd(size_t s) const { return frontals_.begin() + frontalStarts_[s + 1]; }
+
+    /** Number of separator variables of supernode s */
+    size_t separatorSize(size_t s) const { return separatorSizes_[s]; }
+
+    /** Indices of the factors assigned to supernode s, those whose first eliminated variable it contains */
+    FastVector<size_t>::const_iterator factorsBegin(size_t s) const { return factors_.begin() + factorStarts_[s]; }
+    FastVector<size_t>::const_iterator factorsEnd(size_t s) const { return factors_.begin() + factorStarts_[s + 1]; }
+
+    /** Indices of the factors that involve no eliminated variable */
+    const FastVector<size_t>& remainingFactors() const { return remainingFactors_; }
+
+    /** Number of explicit zeros the amalgamation added to the dense cliques */
+    double nrExplicitZeros() const { return nrExplicitZeros_; }
+
+  private:
+    FastVector<size_t> parents_;
+    FastVector<size_t> columnCounts_;
+    FastVector<size_t> superParents_;
+    FastVector<Key> frontals_;
+    FastVector<size_t> frontalStarts_;
+    FastVector<size_t> separatorSizes_;
+    FastVector<size_t> factors_;
+    FastVector<size_t> factorStarts_;
+    FastVector<size_t> remainingFactors_;
+    double nrExplicitZeros_;
+  };
+
+}
@@ -77,6 +77,23 @@ TEST(Ordering, grouped_constrained_ordering) {
   EXPECT(assert_equal(expConstrained, actConstrained));
 }
 
+/* ************************************************************************* */
+TEST(Ordering, grouped_constrained_ordering_skipped_groups) {
+  SymbolicFactorGraph sfg;
+  sfg.push_factor(0,1);
+  sfg.push_factor(1,2);
+
+  // No variable is in group 0
+  FastMap<size_t, int> constraints;
+  constraints[0] = 1;
+  constraints[1] = 1;
+  constraints[2] = 3;
+
+  Ordering actConstrained = Ordering::COLAMDConstrained(sfg, constraints);
+  LONGS_EQUAL(3, (long)actConstrained.size());
+  LONGS_EQUAL(2, (long)actConstrained.back());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
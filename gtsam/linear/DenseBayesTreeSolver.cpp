@@ -0,0 +1,226 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseBayesTreeSolver.cpp
+ * @brief   Parallel back-substitution and gradient of a GaussianBayesTree in the dense key mode
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/DenseBayesTreeSolver.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  struct DenseBayesTreeSolver::BackSubstitute : public WorkStealingScheduler::Body {
+    DenseBayesTreeSolver& solver;
+    double* x;
+    const size_t* offsets;
+    BackSubstitute(DenseBayesTreeSolver& solver, DenseVectorValues& x) :
+      solver(solver), x(x.vector().data()), offsets(&x.offsets()[0]) {}
+    void operator()(size_t clique, WorkStealingScheduler::Worker& worker) {
+      solver.conditionals_[clique]->solve(x, offsets, &solver.keyIndices_[solver.keyStarts_[clique]],
+        solver.work_[worker.id()].data());
+      // The children can be solved now that their separator is
+      for(size_t k = solver.childStarts_[clique]; k < solver.childStarts_[clique + 1]; ++k)
+        worker.spawn(solver.children_[k]);
+    }
+  };
+
+  /* ************************************************************************* */
+  struct DenseBayesTreeSolver::AccumulateGradient : public WorkStealingScheduler::Body {
+    DenseBayesTreeSolver& solver;
+    DenseVectorValues& g;
+    const size_t* offsets;
+    AccumulateGradient(DenseBayesTreeSolver& solver, DenseVectorValues& g) :
+      solver(solver), g(g), offsets(&g.offsets()[0]) {}
+    void operator()(size_t chunk, WorkStealingScheduler::Worker& worker) {
+      Vector& d = chunk == 0 ? g.vector() : solver.partials_[chunk - 1];
+      d.setZero();
+      for(size_t i = solver.chunkStarts_[chunk]; i < solver.chunkStarts_[chunk + 1]; ++i)
+        solver.conditionals_[i]->gradientAtZero(d.data(), offsets, &solver.keyIndices_[solver.keyStarts_[i]]);
+    }
+  };
+
+  /* ************************************************************************* */
+  namespace {
+    // The conditionals of all cliques in pre-order, with the pre-order index of their parents
+    void flatten(const GaussianBayesTree& bayesTree,
+      FastVector<GaussianConditional::shared_ptr>& conditionals, FastVector<size_t>& parents)
+    {
+      typedef pair<GaussianBayesTree::sharedClique, size_t> Entry;
+      FastVector<Entry> stack;
+      for(size_t r = bayesTree.roots().size(); r > 0; --r)
+        stack.push_back(Entry(bayesTree.roots()[r - 1], KeyIndexer::None));
+      while(!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        const size_t i = conditionals.size();
+        conditionals.push_back(entry.first->conditional());
+        parents.push_back(entry.second);
+        for(size_t c = entry.first->children.size(); c > 0; --c)
+          stack.push_back(Entry(entry.first->children[c - 1], i));
+      }
+    }
+
+    // The frontal keys of the conditionals in order
+    FastVector<Key> frontalKeys(const FastVector<GaussianConditional::shared_ptr>& conditionals)
+    {
+      FastVector<Key> keys;
+      BOOST_FOREACH(const GaussianConditional::shared_ptr& conditional, conditionals)
+        keys.insert(keys.end(), conditional->beginFrontals(), conditional->endFrontals());
+      return keys;
+    }
+  }
+
+  /* ************************************************************************* */
+  DenseBayesTreeSolver::DenseBayesTreeSolver(const GaussianBayesTree& bayesTree, size_t nThreads) :
+    scheduler_(nThreads)
+  {
+    FastVector<size_t> parents;
+    flatten(bayesTree, conditionals_, parents);
+    indexer_ = boost::make_shared<KeyIndexer>(frontalKeys(conditionals_));
+    initialize(parents);
+  }
+
+  /* ************************************************************************* */
+  DenseBayesTreeSolver::DenseBayesTreeSolver(const GaussianBayesTree& bayesTree,
+    const sharedIndexer& indexer, size_t nThreads) :
+    indexer_(indexer), scheduler_(nThreads)
+  {
+    FastVector<size_t> parents;
+    flatten(bayesTree, conditionals_, parents);
+    initialize(parents);
+  }
+
+  /* ************************************************************************* */
+  void DenseBayesTreeSolver::initialize(const FastVector<size_t>& parents)
+  {
+    const size_t n = conditionals_.size();
+
+    // Children of every clique, in compressed form
+    childStarts_.assign(n + 1, 0);
+    for(size_t i = 0; i < n; ++i) {
+      if(parents[i] == KeyIndexer::None)
+        roots_.push_back(i);
+      else
+        ++childStarts_[parents[i] + 1];
+    }
+    for(size_t i = 0; i < n; ++i)
+      childStarts_[i + 1] += childStarts_[i];
+    children_.resize(n - roots_.size());
+    FastVector<size_t> next(childStarts_.begin(), childStarts_.end() - 1);
+    for(size_t i = 0; i < n; ++i)
+      if(parents[i] != KeyIndexer::None)
+        children_[next[parents[i]]++] = i;
+
+    // Indices of the keys of every clique, and the largest one for the scratch space
+    keyStarts_.assign(1, 0);
+    size_t maxRows = 0;
+    BOOST_FOREACH(const GaussianConditional::shared_ptr& conditional, conditionals_) {
+      BOOST_FOREACH(Key key, *conditional)
+        keyIndices_.push_back(indexer_->index(key));
+      keyStarts_.push_back(keyIndices_.size());
+      maxRows = std::max(maxRows, conditional->rows());
+    }
+    work_.assign(nThreads(), Vector(maxRows));
+
+    // Gradient chunks of equal cost, the size of the conditionals
+    FastVector<size_t> cost(n + 1, 0);
+    for(size_t i = 0; i < n; ++i)
+      cost[i + 1] = cost[i] + conditionals_[i]->rows() * conditionals_[i]->cols();
+    const size_t nChunks = std::max<size_t>(1, std::min(nThreads(), n));
+    chunkStarts_.assign(1, 0);
+    for(size_t c = 1; c < nChunks; ++c) {
+      const size_t target = cost[n] * c / nChunks;
+      chunkStarts_.push_back(lower_bound(cost.begin() + chunkStarts_.back(), cost.end(), target) - cost.begin());
+    }
+    chunkStarts_.push_back(n);
+    for(size_t c = 0; c < nChunks; ++c)
+      chunkTasks_.push_back(c);
+  }
+
+  /* ************************************************************************* */
+  void DenseBayesTreeSolver::checkLayout(const DenseVectorValues& x) const
+  {
+    if(x.size() != indexer_->size() ||
+      (x.size() > 0 && &x.indexer() != indexer_.get() && !x.indexer().equals(*indexer_)))
+      throw invalid_argument("DenseBayesTreeSolver: the DenseVectorValues must be laid out by the solver's indexer");
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseBayesTreeSolver::zero() const
+  {
+    FastVector<size_t> dims(indexer_->size(), 0);
+    size_t found = 0;
+    for(size_t i = 0; i < conditionals_.size(); ++i) {
+      const GaussianConditional& conditional = *conditionals_[i];
+      for(size_t k = 0; k < conditional.nrFrontals(); ++k, ++found)
+        dims[keyIndices_[keyStarts_[i] + k]] = conditional.getDim(conditional.begin() + k);
+    }
+    if(found != indexer_->size())
+      throw invalid_argument("DenseBayesTreeSolver::zero: the indexer has variables that are not in the Bayes tree");
+    return DenseVectorValues(indexer_, dims);
+  }
+
+  /* ************************************************************************* */
+  void DenseBayesTreeSolver::optimize(DenseVectorValues& x)
+  {
+    gttic(DenseBayesTreeSolver_optimize);
+    checkLayout(x);
+    BackSubstitute backSubstitute(*this, x);
+    scheduler_.run(conditionals_.size(), roots_, backSubstitute);
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseBayesTreeSolver::optimize()
+  {
+    DenseVectorValues x = zero();
+    optimize(x);
+    return x;
+  }
+
+  /* ************************************************************************* */
+  void DenseBayesTreeSolver::gradientAtZero(DenseVectorValues& g)
+  {
+    gttic(DenseBayesTreeSolver_gradientAtZero);
+    checkLayout(g);
+    if(conditionals_.empty()) {
+      g.setZero();
+      return;
+    }
+
+    // Every chunk but the first accumulates into its own vector
+    partials_.resize(chunkTasks_.size() - 1);
+    BOOST_FOREACH(Vector& partial, partials_)
+      if(partial.size() != g.vector().size())
+        partial.resize(g.vector().size());
+
+    AccumulateGradient accumulateGradient(*this, g);
+    scheduler_.run(chunkTasks_.size(), chunkTasks_, accumulateGradient);
+
+    // Summed in a fixed order, so that the result does not depend on the scheduling
+    BOOST_FOREACH(const Vector& partial, partials_)
+      g.vector() += partial;
+  }
+
+}
@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseBayesTreeSolver.h
+ * @brief   Parallel back-substitution and gradient of a GaussianBayesTree in the dense key mode
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/DenseVectorValues.h>
+#include <gtsam/base/WorkStealingScheduler.h>
+
+namespace gtsam {
+
+  /**
+   * Back-substitution and gradient of a GaussianBayesTree in the dense key mode, in parallel.
+   * GaussianBayesTree::optimize() solves every clique into a new VectorValues and merges them by
+   * key.  This class instead flattens the tree once, translating the keys of every conditional
+   * to DenseVectorValues indices, and then solves all cliques directly into one preallocated
+   * DenseVectorValues, each at the precomputed offsets of its variables.  The cliques are run by
+   * a WorkStealingScheduler, a clique becoming ready when its parent is solved, so the solve is
+   * parallel with or without TBB, and allocates nothing.
+   *
+   * gradientAtZero() splits the cliques into one contiguous range of equal cost per thread, and
+   * every thread accumulates \f$ -R^T d \f$ into its own dense vector.  The vectors are then
+   * summed in a fixed order, so the result does not depend on the scheduling.
+   *
+   * The solver refers to the conditionals of the tree, and solves with their current values, but
+   * has to be recreated when the structure of the tree changes.  optimize() and gradientAtZero()
+   * use the worker threads and scratch space of the solver, so they are not const, and one solver
+   * must not be used from several threads at once.
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT DenseBayesTreeSolver {
+  public:
+    typedef DenseVectorValues::sharedIndexer sharedIndexer;
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Flatten \c bayesTree, laying out its variables with a new KeyIndexer in which the frontal
+     *  variables of every clique are contiguous, so that cliques are solved in place.  The solve
+     *  uses \c nThreads threads, by default one per hardware thread. */
+    explicit DenseBayesTreeSolver(const GaussianBayesTree& bayesTree, size_t nThreads = 0);
+
+    /** Flatten \c bayesTree for DenseVectorValues laid out by an existing KeyIndexer, which must
+     *  index every variable of the tree, and may index others. */
+    DenseBayesTreeSolver(const GaussianBayesTree& bayesTree, const sharedIndexer& indexer,
+      size_t nThreads = 0);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** The indexer by which solutions and gradients are laid out */
+    const sharedIndexer& indexer() const { return indexer_; }
+
+    /** Number of cliques */
+    size_t nrCliques() const { return conditionals_.size(); }
+
+    /** Number of threads */
+    size_t nThreads() const { return scheduler_.nThreads(); }
+
+    /** A zero vector for the variables of the tree, laid out by indexer().  Throws
+     *  std::invalid_argument if the indexer has variables that are not in the tree. */
+    DenseVectorValues zero() const;
+
+    /** Solve for the variables of the tree by back-substitution, writing them into \c x, which
+     *  must be laid out by indexer().  Other variables of \c x are not touched. */
+    void optimize(DenseVectorValues& x);
+
+    /** The solution as a new DenseVectorValues, see optimize(DenseVectorValues&) */
+    DenseVectorValues optimize();
+
+    /** Write the gradient at zero, \f$ -R^T d \f$, into \c g, which must be laid out by indexer().
+     *  Other variables of \c g are set to zero. */
+    void gradientAtZero(DenseVectorValues& g);
+
+    /// @}
+
+  private:
+    struct BackSubstitute;
+    struct AccumulateGradient;
+
+    sharedIndexer indexer_;
+    FastVector<GaussianConditional::shared_ptr> conditionals_; ///< the cliques, in pre-order
+    FastVector<size_t> roots_;       ///< the root cliques
+    FastVector<size_t> childStarts_; ///< children of clique i at children_[childStarts_[i]]...
+    FastVector<size_t> children_;
+    FastVector<size_t> keyStarts_;   ///< indices of the keys of clique i at keyIndices_[keyStarts_[i]]...
+    FastVector<size_t> keyIndices_;
+    FastVector<size_t> chunkStarts_; ///< cliques of gradient chunk c from chunkStarts_[c]
+    FastVector<size_t> chunkTasks_;  ///< 0 to number of chunks - 1, the initial gradient tasks
+
+    WorkStealingScheduler scheduler_;
+    FastVector<Vector> work_;     ///< scratch space of each thread, for cliques not solved in place
+    FastVector<Vector> partials_; ///< gradient accumulated by each chunk but the first
+
+    /** Set up the children, key indices, scratch space and gradient chunks of the flattened
+     *  cliques, given the pre-order index of the parent of every clique */
+    void initialize(const FastVector<size_t>& parents);
+
+    /** Check the layout of a DenseVectorValues */
+    void checkLayout(const DenseVectorValues& x) const;
+
+    // Not copyable, the scheduler is not
+    DenseBayesTreeSolver(const DenseBayesTreeSolver&);
+    DenseBayesTreeSolver& operator=(const DenseBayesTreeSolver&);
+  };
+
+}
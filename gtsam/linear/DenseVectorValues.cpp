@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseVectorValues.cpp
+ * @brief   Vector-valued variables in one flat vector, laid out by a KeyIndexer
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/DenseVectorValues.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  DenseVectorValues::DenseVectorValues(const sharedIndexer& indexer, const FastVector<size_t>& dims) :
+    indexer_(indexer), offsets_(indexer->size() + 1)
+  {
+    if(dims.size() != indexer->size())
+      throw invalid_argument("DenseVectorValues: requires a dimension for every indexed key");
+    offsets_[0] = 0;
+    for(size_t j = 0; j < dims.size(); ++j)
+      offsets_[j + 1] = offsets_[j] + dims[j];
+    values_ = Vector::Zero(offsets_.back());
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues::DenseVectorValues(const sharedIndexer& indexer, const VectorValues& x) :
+    indexer_(indexer), offsets_(indexer->size() + 1)
+  {
+    // Look up every key once, then copy the values into place
+    FastVector<const Vector*> vectors(indexer->size());
+    offsets_[0] = 0;
+    for(size_t j = 0; j < indexer->size(); ++j) {
+      VectorValues::const_iterator item = x.find(indexer->key(j));
+      if(item == x.end())
+        throw invalid_argument("DenseVectorValues: the VectorValues has no value for an indexed key");
+      vectors[j] = &item->second;
+      offsets_[j + 1] = offsets_[j] + item->second.size();
+    }
+    values_.resize(offsets_.back());
+    for(size_t j = 0; j < vectors.size(); ++j)
+      (*this)[j] = *vectors[j];
+  }
+
+  /* ************************************************************************* */
+  DenseVectorValues DenseVectorValues::Zero(const DenseVectorValues& other)
+  {
+    DenseVectorValues result;
+    result.indexer_ = other.indexer_;
+    result.offsets_ = other.offsets_;
+    result.values_ = Vector::Zero(other.values_.size());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  VectorValues DenseVectorValues::toVectorValues() const
+  {
+    VectorValues result;
+    for(size_t j = 0; j < size(); ++j)
+      result.insert(indexer_->key(j), (*this)[j]);
+    return result;
+  }
+
+  /* ************************************************************************* */
+  void DenseVectorValues::print(const string& str, const KeyFormatter& keyFormatter) const
+  {
+    cout << str << ": " << size() << " elements\n";
+    for(size_t j = 0; j < size(); ++j)
+      cout << "  " << keyFormatter(indexer_->key(j)) << ": " << (*this)[j].transpose() << "\n";
+    cout.flush();
+  }
+
+  /* ************************************************************************* */
+  bool DenseVectorValues::equals(const DenseVectorValues& other, double tol) const
+  {
+    if(size() != other.size() || offsets_ != other.offsets_)
+      return false;
+    for(size_t j = 0; j < size(); ++j)
+      if(indexer_->key(j) != other.indexer_->key(j))
+        return false;
+    return equal_with_abs_tol(values_, other.values_, tol);
+  }
+
+}
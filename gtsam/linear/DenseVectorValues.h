@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseVectorValues.h
+ * @brief   Vector-valued variables in one flat vector, laid out by a KeyIndexer
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Vector.h>
+#include <gtsam/base/FastVector.h>
+#include <gtsam/inference/KeyIndexer.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+  // Forward declarations
+  class VectorValues;
+
+  /**
+   * The dense key mode counterpart of VectorValues: the variables are segments of one flat
+   * vector, variable j of a KeyIndexer being the dim(j) entries from offset(j).  Accessing a
+   * variable by index is array indexing, and the raw memory can be passed to the dense
+   * GaussianFactor operations, e.g. GaussianFactorGraph::multiplyHessianAdd(double, const
+   * DenseVectorValues&, DenseVectorValues&, const KeyIndexer::FactorIndices&).
+   *
+   * The KeyIndexer is shared with the DenseVectorValues, so one indexer can lay out all the
+   * vectors of a problem.
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT DenseVectorValues {
+  public:
+    typedef boost::shared_ptr<const KeyIndexer> sharedIndexer;
+    typedef Eigen::VectorBlock<Vector> Segment;
+    typedef const Eigen::VectorBlock<const Vector> ConstSegment;
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor, creates an empty DenseVectorValues */
+    DenseVectorValues() { offsets_.push_back(0); }
+
+    /** Zero vectors of dimensions \c dims, given for every index of \c indexer */
+    DenseVectorValues(const sharedIndexer& indexer, const FastVector<size_t>& dims);
+
+    /** Copy the values of \c x, which must have a value for every key of \c indexer */
+    DenseVectorValues(const sharedIndexer& indexer, const VectorValues& x);
+
+    /** Zero vectors with the same layout as \c other */
+    static DenseVectorValues Zero(const DenseVectorValues& other);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** Number of variables */
+    size_t size() const { return offsets_.size() - 1; }
+
+    /** Total dimension */
+    size_t dim() const { return offsets_.back(); }
+
+    /** Dimension of the variable with index j */
+    size_t dim(size_t j) const { return offsets_[j + 1] - offsets_[j]; }
+
+    /** Offset of the variable with index j in vector() */
+    size_t offset(size_t j) const { return offsets_[j]; }
+
+    /** Offsets of all variables, of size size()+1 */
+    const FastVector<size_t>& offsets() const { return offsets_; }
+
+    /** The indexer laying out the variables */
+    const KeyIndexer& indexer() const { return *indexer_; }
+
+    /** The variable with index j */
+    Segment operator[](size_t j) { return values_.segment(offsets_[j], dim(j)); }
+    ConstSegment operator[](size_t j) const { return values_.segment(offsets_[j], dim(j)); }
+
+    /** The variable with key \c key, looked up in the indexer */
+    Segment at(Key key) { return (*this)[indexer_->index(key)]; }
+    ConstSegment at(Key key) const { return (*this)[indexer_->index(key)]; }
+
+    /** All variables as one vector */
+    const Vector& vector() const { return values_; }
+    Vector& vector() { return values_; }
+
+    /** Set all values to zero */
+    void setZero() { values_.setZero(); }
+
+    /** Convert to a VectorValues */
+    VectorValues toVectorValues() const;
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /** Print the variables by key */
+    void print(const std::string& str = "DenseVectorValues: ",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+    /** Test for equality of layout and values */
+    bool equals(const DenseVectorValues& other, double tol = 1e-9) const;
+
+    /// @}
+
+  private:
+    sharedIndexer indexer_;
+    FastVector<size_t> offsets_;
+    Vector values_;
+  };
+
+}
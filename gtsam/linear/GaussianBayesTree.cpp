@@ -25,6 +25,13 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/VectorValues.h>
 
+#include <boost/foreach.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 namespace gtsam {
 
   // Instantiate base class
@@ -43,6 +50,87 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  namespace
+  {
+    /* ************************************************************************* */
+    // The conditionals of all cliques, in pre-order
+    std::vector<GaussianConditional::shared_ptr> conditionals(const GaussianBayesTree& bayesTree)
+    {
+      std::vector<GaussianConditional::shared_ptr> result;
+      std::vector<GaussianBayesTree::sharedClique> stack(bayesTree.roots().rbegin(), bayesTree.roots().rend());
+      while(!stack.empty()) {
+        const GaussianBayesTree::sharedClique clique = stack.back();
+        stack.pop_back();
+        result.push_back(clique->conditional());
+        stack.insert(stack.end(), clique->children.rbegin(), clique->children.rend());
+      }
+      return result;
+    }
+
+#ifdef GTSAM_USE_TBB
+    /* ************************************************************************* */
+    struct _SquaredProductNorms
+    {
+      const std::vector<GaussianConditional::shared_ptr>& conditionals;
+      const VectorValues& x;
+      std::vector<double>& squaredNorms;
+      _SquaredProductNorms(const std::vector<GaussianConditional::shared_ptr>& conditionals,
+        const VectorValues& x, std::vector<double>& squaredNorms) :
+        conditionals(conditionals), x(x), squaredNorms(squaredNorms) {}
+      void operator()(const tbb::blocked_range<size_t>& r) const {
+        for(size_t i = r.begin(); i != r.end(); ++i)
+          squaredNorms[i] = ((*conditionals[i]) * x).squaredNorm();
+      }
+    };
+#endif
+
+    /* ************************************************************************* */
+    // Gradient at zero, with the contribution of each clique added in place, in a
+    // fixed order, into one vector allocated up front
+    VectorValues gradientAtZero(const std::vector<GaussianConditional::shared_ptr>& conditionals)
+    {
+      VectorValues g;
+      BOOST_FOREACH(const GaussianConditional::shared_ptr& conditional, conditionals) {
+        for(GaussianConditional::const_iterator frontal = conditional->beginFrontals(); frontal != conditional->endFrontals(); ++frontal)
+          g.insert(*frontal, Vector::Zero(conditional->getDim(frontal)));
+      }
+      BOOST_FOREACH(const GaussianConditional::shared_ptr& conditional, conditionals) {
+        // Gradient is really -A'*b / sigma^2, without whitening for the conditionals of elimination
+        const SharedDiagonal& model = conditional->get_model();
+        if(!model || dynamic_cast<const noiseModel::Unit*>(model.get())) {
+          for(GaussianConditional::const_iterator it = conditional->begin(); it != conditional->end(); ++it)
+            g.at(*it).noalias() -= conditional->getA(it).transpose() * conditional->getb();
+        } else {
+          Vector b_sigma = conditional->getb();
+          model->whitenInPlace(b_sigma);
+          model->whitenInPlace(b_sigma);
+          for(GaussianConditional::const_iterator it = conditional->begin(); it != conditional->end(); ++it)
+            g.at(*it).noalias() -= conditional->getA(it).transpose() * b_sigma;
+        }
+      }
+      return g;
+    }
+
+    /* ************************************************************************* */
+    // Squared norm of R x, with the product of each clique computed in parallel
+    double squaredProductNorm(const std::vector<GaussianConditional::shared_ptr>& conditionals, const VectorValues& x)
+    {
+      std::vector<double> squaredNorms(conditionals.size());
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, conditionals.size()),
+        _SquaredProductNorms(conditionals, x, squaredNorms));
+#else
+      for(size_t i = 0; i < conditionals.size(); ++i)
+        squaredNorms[i] = ((*conditionals[i]) * x).squaredNorm();
+#endif
+      double sum = 0.0;
+      BOOST_FOREACH(double squaredNorm, squaredNorms)
+        sum += squaredNorm;
+      return sum;
+    }
+  }
+
   /* ************************************************************************* */
   bool GaussianBayesTree::equals(const This& other, double tol) const
   {
@@ -59,7 +147,23 @@ namespace gtsam {
   VectorValues GaussianBayesTree::optimizeGradientSearch() const
   {
     gttic(GaussianBayesTree_optimizeGradientSearch);
-    return GaussianFactorGraph(*this).optimizeGradientSearch();
+    const std::vector<GaussianConditional::shared_ptr> conds = conditionals(*this);
+
+    gttic(Compute_Gradient);
+    VectorValues grad = gtsam::gradientAtZero(conds);
+    const double gradientSqNorm = grad.dot(grad);
+    gttoc(Compute_Gradient);
+
+    gttic(Compute_Rg);
+    const double RgSqNorm = squaredProductNorm(conds, grad);
+    gttoc(Compute_Rg);
+
+    gttic(Compute_point);
+    // Minimizing step size along the gradient
+    grad *= -gradientSqNorm / RgSqNorm;
+    gttoc(Compute_point);
+
+    return grad;
   }
 
   /* ************************************************************************* */
@@ -69,7 +173,8 @@ namespace gtsam {
 
   /* ************************************************************************* */
   VectorValues GaussianBayesTree::gradientAtZero() const {
-    return GaussianFactorGraph(*this).gradientAtZero();
+    gttic(GaussianBayesTree_gradientAtZero);
+    return gtsam::gradientAtZero(conditionals(*this));
   }
 
   /* ************************************************************************* */
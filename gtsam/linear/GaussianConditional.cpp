@@ -144,6 +144,42 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  void GaussianConditional::solve(double* x, const size_t* offsets, const size_t* indices,
+    double* work) const
+  {
+    typedef Eigen::Map<Vector> DMap;
+    typedef Eigen::Map<const Vector> ConstDMap;
+
+    // Solve in place if the frontal variables follow each other in x
+    bool contiguous = true;
+    for(size_t k = 0; k + 1 < nrFrontals(); ++k)
+      contiguous = contiguous && offsets[indices[k] + 1] == offsets[indices[k + 1]];
+    assert(contiguous || work);
+    DMap soln(contiguous ? x + offsets[indices[0]] : work, rows());
+
+    // Update right-hand-side
+    soln = getb();
+    for(size_t k = nrFrontals(); k < size(); ++k)
+      soln.noalias() -= Ab_(k) * ConstDMap(x + offsets[indices[k]], Ab_(k).cols());
+
+    // Solve matrix
+    get_R().triangularView<Eigen::Upper>().solveInPlace(soln);
+
+    // Check for indeterminant solution
+    if(soln.hasNaN()) throw IndeterminantLinearSystemException(keys().front());
+
+    // Scatter the solution if it was not solved in place
+    if(!contiguous) {
+      DenseIndex vectorPosition = 0;
+      for(size_t k = 0; k < nrFrontals(); ++k) {
+        const DenseIndex dim = Ab_(k).cols();
+        DMap(x + offsets[indices[k]], dim) = soln.segment(vectorPosition, dim);
+        vectorPosition += dim;
+      }
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianConditional::solveOtherRHS(
     const VectorValues& parents, const VectorValues& rhs) const
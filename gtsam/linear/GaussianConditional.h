@@ -120,6 +120,16 @@ namespace gtsam {
     */
     VectorValues solve(const VectorValues& parents) const;
 
+    /**
+     * Dense key mode counterpart of solve(const VectorValues&): reads the parents from and
+     * writes the frontal variables to the flat vector \c x, variable k of this conditional being
+     * at x + offsets[indices[k]] (see GaussianFactor::multiplyHessianAdd(double, const double*,
+     * double*, const size_t*, const size_t*)).  If the frontal variables are contiguous in \c x
+     * they are solved for in place, otherwise \c work must hold rows() doubles.  Nothing is
+     * allocated.
+     */
+    void solve(double* x, const size_t* offsets, const size_t* indices, double* work = 0) const;
+
     VectorValues solveOtherRHS(const VectorValues& parents, const VectorValues& rhs) const;
 
     /** Performs transpose backsubstition in place on values */
@@ -0,0 +1,51 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    GaussianFactor.cpp
+ * @brief   Default dense key mode operations of GaussianFactor
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+
+namespace gtsam {
+
+  namespace {
+    typedef Eigen::Map<Vector> DMap;
+    typedef Eigen::Map<const Vector> ConstDMap;
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactor::multiplyHessianAdd(double alpha, const double* x, double* y,
+    const size_t* offsets, const size_t* indices) const
+  {
+    VectorValues xValues, yValues;
+    for(size_t k = 0; k < size(); ++k) {
+      const size_t dim = offsets[indices[k] + 1] - offsets[indices[k]];
+      xValues.insert(keys_[k], ConstDMap(x + offsets[indices[k]], dim));
+      yValues.insert(keys_[k], Vector::Zero(dim));
+    }
+    multiplyHessianAdd(alpha, xValues, yValues);
+    for(size_t k = 0; k < size(); ++k)
+      DMap(y + offsets[indices[k]], offsets[indices[k] + 1] - offsets[indices[k]]) += yValues.at(keys_[k]);
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactor::gradientAtZero(double* d, const size_t* offsets, const size_t* indices) const
+  {
+    const VectorValues g = gradientAtZero();
+    for(size_t k = 0; k < size(); ++k)
+      DMap(d + offsets[indices[k]], offsets[indices[k] + 1] - offsets[indices[k]]) += g.at(keys_[k]);
+  }
+
+}
@@ -133,6 +133,16 @@ namespace gtsam {
     /// A'*b for Jacobian, eta for Hessian (raw memory version)
     virtual void gradientAtZero(double* d) const = 0;
 
+    /// y += alpha * A'*A*x, in dense key mode (see KeyIndexer): the variable of the k'th key of
+    /// this factor is at offsets[indices[k]] in x and y, up to offsets[indices[k]+1].  The default
+    /// implementation goes through VectorValues, JacobianFactor and HessianFactor work in place.
+    virtual void multiplyHessianAdd(double alpha, const double* x, double* y,
+      const size_t* offsets, const size_t* indices) const;
+
+    /// d += gradient at zero, i.e. -A'*b for Jacobian, -eta for Hessian, in dense key mode (see
+    /// multiplyHessianAdd(double, const double*, double*, const size_t*, const size_t*))
+    virtual void gradientAtZero(double* d, const size_t* offsets, const size_t* indices) const;
+
   private:
     /** Serialization function */
     friend class boost::serialization::access;
@@ -30,6 +30,9 @@
 #include <gtsam/base/timing.h>
 #include <gtsam/base/cholesky.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 using namespace gtsam;
 
@@ -89,6 +92,25 @@ namespace gtsam {
       return dims_accumulated;
     }
 
+  /* ************************************************************************* */
+  DenseVectorValues GaussianFactorGraph::zeroDenseVectorValues(
+      const DenseVectorValues::sharedIndexer& indexer) const {
+    const size_t none = numeric_limits<size_t>::max();
+    vector<size_t> dims(indexer->size(), none);
+    BOOST_FOREACH(const sharedFactor& factor, *this) {
+      if (factor) {
+        for (GaussianFactor::const_iterator pos = factor->begin(); pos != factor->end(); ++pos) {
+          const size_t j = indexer->find(*pos);
+          if (j != KeyIndexer::None)
+            dims[j] = factor->getDim(pos);
+        }
+      }
+    }
+    if (find(dims.begin(), dims.end(), none) != dims.end())
+      throw invalid_argument("GaussianFactorGraph::zeroDenseVectorValues: an indexed key is not in the graph");
+    return DenseVectorValues(indexer, FastVector<size_t>(dims.begin(), dims.end()));
+  }
+
   /* ************************************************************************* */
   GaussianFactorGraph::shared_ptr GaussianFactorGraph::cloneToPtr() const {
     gtsam::GaussianFactorGraph::shared_ptr result(new GaussianFactorGraph());
@@ -364,6 +386,25 @@ namespace gtsam {
 
   }
 
+  /* ************************************************************************* */
+  void GaussianFactorGraph::multiplyHessianAdd(double alpha, const DenseVectorValues& x,
+      DenseVectorValues& y, const KeyIndexer::FactorIndices& factorIndices) const {
+    const size_t* offsets = &x.offsets()[0];
+    for (size_t i = 0; i < size(); ++i)
+      if ((*this)[i])
+        (*this)[i]->multiplyHessianAdd(alpha, x.vector().data(), y.vector().data(), offsets,
+            factorIndices.begin(i));
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::gradientAtZero(DenseVectorValues& g,
+      const KeyIndexer::FactorIndices& factorIndices) const {
+    const size_t* offsets = &g.offsets()[0];
+    for (size_t i = 0; i < size(); ++i)
+      if ((*this)[i])
+        (*this)[i]->gradientAtZero(g.vector().data(), offsets, factorIndices.begin(i));
+  }
+
   /* ************************************************************************* */
   void GaussianFactorGraph::multiplyInPlace(const VectorValues& x, Errors& e) const {
     multiplyInPlace(x, e.begin());
@@ -27,6 +27,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/linear/Errors.h> // Included here instead of fw-declared so we can use Errors::iterator
+#include <gtsam/linear/DenseVectorValues.h>
 
 namespace gtsam {
 
@@ -143,6 +144,10 @@ namespace gtsam {
 
     std::vector<size_t> getkeydim() const;
 
+    /** Zero vectors for the variables of \c indexer, in dense key mode (see KeyIndexer), with their
+     *  dimensions in this graph.  Throws std::invalid_argument if a variable is not in the graph. */
+    DenseVectorValues zeroDenseVectorValues(const DenseVectorValues::sharedIndexer& indexer) const;
+
     /** unnormalized error */
     double error(const VectorValues& x) const {
       double total_error = 0.;
@@ -314,6 +319,15 @@ namespace gtsam {
     void multiplyHessianAdd(double alpha, const double* x,
         double* y) const;
 
+    /** y += alpha*A'A*x in dense key mode, where \c factorIndices is KeyIndexer::indexFactors(*this)
+     *  for the indexer of x and y */
+    void multiplyHessianAdd(double alpha, const DenseVectorValues& x, DenseVectorValues& y,
+        const KeyIndexer::FactorIndices& factorIndices) const;
+
+    /** g += the gradient at zero in dense key mode, where \c factorIndices is
+     *  KeyIndexer::indexFactors(*this) for the indexer of g */
+    void gradientAtZero(DenseVectorValues& g, const KeyIndexer::FactorIndices& factorIndices) const;
+
     ///** In-place version e <- A*x that overwrites e. */
     void multiplyInPlace(const VectorValues& x, Errors& e) const;
 
@@ -31,4 +31,9 @@ namespace gtsam {
     const GaussianEliminationTree& eliminationTree) :
   Base(eliminationTree) {}
 
+  /* ************************************************************************* */
+  GaussianJunctionTree::GaussianJunctionTree(
+    const GaussianFactorGraph& factorGraph, const SupernodalStructure& structure) :
+  Base(factorGraph, structure) {}
+
 }
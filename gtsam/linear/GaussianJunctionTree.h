@@ -61,6 +61,10 @@ namespace gtsam {
     * @return The elimination tree
     */
     GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+
+    /** Build the junction tree with the (relaxed) supernodes of a SupernodalStructure, made from
+     *  the VariableIndex of \c factorGraph */
+    GaussianJunctionTree(const GaussianFactorGraph& factorGraph, const SupernodalStructure& structure);
   };
 
 }
@@ -102,6 +102,78 @@ Scatter::Scatter(const GaussianFactorGraph& gfg,
   }
 }
 
+/* ************************************************************************* */
+namespace {
+  // Whether Scatter gives slots to the keys of a factor, see the zero-row Jacobian hack above
+  bool hasSlots(const GaussianFactor::shared_ptr& factor) {
+    const JacobianFactor* asJacobian = dynamic_cast<const JacobianFactor*>(factor.get());
+    return factor && (!asJacobian || asJacobian->cols() > 1);
+  }
+}
+
+/* ************************************************************************* */
+AssemblyPlan::AssemblyPlan(const GaussianFactorGraph& gfg,
+    boost::optional<const Ordering&> ordering) {
+  gttic(AssemblyPlan_Constructor);
+  // The slots are those of the Scatter, looked up once here rather than in every updateATA
+  const Scatter scatter(gfg, ordering);
+  keys.resize(scatter.size());
+  dims.resize(scatter.size() + 1);
+  BOOST_FOREACH(const Scatter::value_type& key_slotentry, scatter) {
+    keys[key_slotentry.second.slot] = key_slotentry.first;
+    dims[key_slotentry.second.slot] = key_slotentry.second.dimension;
+  }
+  dims.back() = 1;
+
+  slots.resize(gfg.size());
+  for(size_t i = 0; i < gfg.size(); ++i) {
+    if(hasSlots(gfg[i])) {
+      slots[i].reserve(gfg[i]->size());
+      BOOST_FOREACH(Key j, *gfg[i])
+        slots[i].push_back(scatter.at(j).slot);
+    }
+  }
+}
+
+/* ************************************************************************* */
+bool AssemblyPlan::matches(const GaussianFactorGraph& gfg,
+    boost::optional<const Ordering&> ordering) const {
+  if(gfg.size() != slots.size())
+    return false;
+  if(ordering) {
+    if(ordering->size() > keys.size())
+      return false;
+    for(size_t slot = 0; slot < ordering->size(); ++slot)
+      if((*ordering)[slot] != keys[slot])
+        return false;
+  }
+  // Keys first, which tell most changed cliques apart without any virtual calls
+  for(size_t i = 0; i < gfg.size(); ++i) {
+    const FastVector<DenseIndex>& factorSlots = slots[i];
+    const GaussianFactor* factor = gfg[i].get();
+    if(factorSlots.empty()) {
+      // Only null factors, factors without keys and the zero-row Jacobians have no slots
+      if(factor && factor->size() > 0 && hasSlots(gfg[i]))
+        return false;
+      continue;
+    }
+    if(!factor || factor->size() != factorSlots.size())
+      return false;
+    for(size_t j = 0; j < factorSlots.size(); ++j)
+      if(factor->keys()[j] != keys[factorSlots[j]])
+        return false;
+  }
+  // A factor with the keys and dimensions of the plan has columns, so it is not a zero-row
+  // Jacobian without slots
+  for(size_t i = 0; i < gfg.size(); ++i) {
+    const FastVector<DenseIndex>& factorSlots = slots[i];
+    for(size_t j = 0; j < factorSlots.size(); ++j)
+      if(gfg[i]->getDim(gfg[i]->begin() + j) != dims[factorSlots[j]])
+        return false;
+  }
+  return true;
+}
+
 /* ************************************************************************* */
 HessianFactor::HessianFactor() :
                           info_(cref_list_of<1>(1))
@@ -309,6 +381,30 @@ HessianFactor::HessianFactor(const GaussianFactorGraph& factors,
   gttoc(update);
 }
 
+/* ************************************************************************* */
+HessianFactor::HessianFactor(const GaussianFactorGraph& factors, const AssemblyPlan& plan) :
+  GaussianFactor(plan.keys), info_(plan.dims)
+{
+  gttic(HessianFactor_PlanConstructor);
+  if(factors.size() != plan.slots.size())
+    throw invalid_argument("HessianFactor: the assembly plan was made for a different factor graph");
+  info_.full().triangularView().setZero();
+
+  // Form A' * A, the blocks of factor i going to the slots plan.slots[i]
+  gttic(update);
+  for(size_t i = 0; i < factors.size(); ++i) {
+    if(const GaussianFactor* factor = factors[i].get()) {
+      if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor))
+        updateATA(*hessian, plan.slots[i]);
+      else if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor))
+        updateATA(*jacobian, plan.slots[i]);
+      else
+        throw invalid_argument("GaussianFactor is neither Hessian nor Jacobian");
+    }
+  }
+  gttoc(update);
+}
+
 /* ************************************************************************* */
 void HessianFactor::print(const std::string& s, const KeyFormatter& formatter) const {
   cout << s << "\n";
@@ -415,7 +511,6 @@ double HessianFactor::error(const VectorValues& c) const {
 /* ************************************************************************* */
 void HessianFactor::updateATA(const HessianFactor& update, const Scatter& scatter)
 {
-  gttic(updateATA);
   // This function updates 'combined' with the information in 'update'. 'scatter' maps variables in
   // the update factor to slots in the combined factor.
 
@@ -429,6 +524,15 @@ void HessianFactor::updateATA(const HessianFactor& update, const Scatter& scatte
   }
   gttoc(slots);
 
+  updateATA(update, slots);
+}
+
+/* ************************************************************************* */
+void HessianFactor::updateATA(const HessianFactor& update, const FastVector<DenseIndex>& slots)
+{
+  gttic(updateATA);
+  assert(slots.size() == update.size());
+
   // Apply updates to the upper triangle
   gttic(update);
   size_t nrInfoBlocks = this->info_.nBlocks();
@@ -449,8 +553,6 @@ void HessianFactor::updateATA(const JacobianFactor& update, const Scatter& scatt
   // 'scatter' maps variables in the update factor to slots in the combined
   // factor.
 
-  gttic(updateATA);
-
   if(update.rows() > 0)
   {
     // First build an array of slots
@@ -463,6 +565,20 @@ void HessianFactor::updateATA(const JacobianFactor& update, const Scatter& scatt
     }
     gttoc(slots);
 
+    updateATA(update, slots);
+  }
+}
+
+/* ************************************************************************* */
+void HessianFactor::updateATA(const JacobianFactor& update, const FastVector<DenseIndex>& slots) {
+
+  gttic(updateATA);
+
+  if(update.rows() > 0)
+  {
+    if(slots.size() != update.size())
+      throw invalid_argument("HessianFactor::updateATA: one slot is needed for every block of the JacobianFactor");
+
     gttic(whiten);
     // Whiten the factor if it has a noise model
     boost::optional<JacobianFactor> _whitenedFactor;
@@ -590,6 +706,38 @@ void HessianFactor::multiplyHessianAdd(double alpha, const double* x,
 }
 
 
+/* ************************************************************************* */
+void HessianFactor::multiplyHessianAdd(double alpha, const double* x,
+    double* yvalues, const size_t* offsets, const size_t* indices) const {
+
+  // Use eigen magic to access raw memory
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> DVector;
+  typedef Eigen::Map<DVector> DMap;
+  typedef Eigen::Map<const DVector> ConstDMap;
+
+  // Same as with key offsets above, but the blocks of this factor are found with the dense
+  // indices of its keys
+  vector<Vector> y;
+  y.reserve(size());
+  for (const_iterator it = begin(); it != end(); it++)
+    y.push_back(zero(getDim(it)));
+
+  for (DenseIndex j = 0; j < (DenseIndex) size(); ++j) {
+    const ConstDMap xj(x + offsets[indices[j]], info_(j, j).cols());
+    DenseIndex i = 0;
+    for (; i < j; ++i)
+      y[i] += info_(i, j).knownOffDiagonal() * xj;
+    // blocks on the diagonal are only half
+    y[i] += info_(j, j).selfadjointView() * xj;
+    // for below diagonal, we take transpose block from upper triangular part
+    for (i = j + 1; i < (DenseIndex) size(); ++i)
+      y[i] += info_(i, j).knownOffDiagonal() * xj;
+  }
+
+  for (DenseIndex i = 0; i < (DenseIndex) size(); ++i)
+    DMap(yvalues + offsets[indices[i]], y[i].size()) += alpha * y[i];
+}
+
 /* ************************************************************************* */
 VectorValues HessianFactor::gradientAtZero() const {
   VectorValues g;
@@ -616,6 +764,17 @@ void HessianFactor::gradientAtZero(double* d) const {
     }
 }
 
+/* ************************************************************************* */
+void HessianFactor::gradientAtZero(double* d, const size_t* offsets,
+    const size_t* indices) const {
+  typedef Eigen::Map<Vector> DMap;
+  const size_t n = size();
+  for (size_t pos = 0; pos < n; ++pos) {
+    const Vector eta = info_(pos, n).knownOffDiagonal();
+    DMap(d + offsets[indices[pos]], eta.size()) -= eta;
+  }
+}
+
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
 EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys)
@@ -648,6 +807,38 @@ EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys)
   return make_pair(conditional, jointFactor);
 }
 
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+EliminateCholeskyWithPlan(const GaussianFactorGraph& factors, const Ordering& keys, const AssemblyPlan& plan)
+{
+  gttic(EliminateCholesky);
+
+  // Build joint factor
+  HessianFactor::shared_ptr jointFactor;
+  try {
+    jointFactor = boost::make_shared<HessianFactor>(factors, plan);
+  } catch(std::invalid_argument&) {
+    throw InvalidDenseElimination(
+        "EliminateCholesky was called with a request to eliminate variables that are not\n"
+        "involved in the provided factors.");
+  }
+
+  // Do dense elimination
+  GaussianConditional::shared_ptr conditional;
+  try {
+    size_t numberOfKeysToEliminate = keys.size();
+    VerticalBlockMatrix Ab = jointFactor->info_.choleskyPartial(numberOfKeysToEliminate);
+    conditional = boost::make_shared<GaussianConditional>(jointFactor->keys(), numberOfKeysToEliminate, Ab);
+    // Erase the eliminated keys in the remaining factor
+    jointFactor->keys_.erase(jointFactor->begin(), jointFactor->begin() + numberOfKeysToEliminate);
+  } catch(CholeskyFailed&) {
+    throw IndeterminantLinearSystemException(keys.front());
+  }
+
+  // Return result
+  return make_pair(conditional, jointFactor);
+}
+
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
 EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys)
@@ -664,4 +855,42 @@ EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys
     return EliminateCholesky(factors, keys);
 }
 
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
+AssemblyPlanCache::operator()(const GaussianFactorGraph& factors, const Ordering& keys) const
+{
+  gttic(AssemblyPlanCache_eliminate);
+
+  // Constrained noise models need QR, as in EliminatePreferCholesky
+  if (hasConstraints(factors))
+    return EliminateQR(factors, keys);
+  if (keys.empty())
+    return EliminateCholesky(factors, keys);
+
+  // Reuse the plan of this clique unless its factors changed structure. Each clique is
+  // eliminated by one thread, so only this thread touches the entry of keys.front().
+  sharedPlan plan;
+  ConcurrentMap<Key, sharedPlan>::const_iterator kept = plans_.find(keys.front());
+  if (kept != plans_.end() && kept->second->matches(factors, keys)) {
+    plan = kept->second;
+  } else {
+    try {
+      plan = boost::make_shared<AssemblyPlan>(factors, keys);
+    } catch(std::invalid_argument&) {
+      throw InvalidDenseElimination(
+          "AssemblyPlanCache was called with a request to eliminate variables that are not\n"
+          "involved in the provided factors.");
+    }
+    plans_[keys.front()] = plan;
+  }
+
+  return EliminateCholeskyWithPlan(factors, keys, *plan);
+}
+
+/* ************************************************************************* */
+AssemblyPlanCache::sharedPlan AssemblyPlanCache::plan(Key j) const {
+  ConcurrentMap<Key, sharedPlan>::const_iterator kept = plans_.find(j);
+  return kept == plans_.end() ? sharedPlan() : kept->second;
+}
+
 } // gtsam
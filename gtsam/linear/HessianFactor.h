@@ -21,6 +21,7 @@
 #include <gtsam/base/SymmetricBlockMatrix.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/FastMap.h>
+#include <gtsam/base/ConcurrentMap.h>
 #include <gtsam/linear/GaussianFactor.h>
 
 #include <boost/make_shared.hpp>
@@ -34,6 +35,7 @@ namespace gtsam {
   class GaussianConditional;
   class GaussianBayesNet;
   class GaussianFactorGraph;
+  class AssemblyPlan;
 
   GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
     EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
@@ -41,6 +43,9 @@ namespace gtsam {
   GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
     EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+  GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+    EliminateCholeskyWithPlan(const GaussianFactorGraph& factors, const Ordering& keys, const AssemblyPlan& plan);
+
   /**
    * One SlotEntry stores the slot index for a variable, as well its dimension.
    */
@@ -65,6 +70,63 @@ namespace gtsam {
         boost::optional<const Ordering&> ordering = boost::none);
   };
 
+  /**
+   * AssemblyPlan is a Scatter resolved ahead of time: the keys and dimensions of the joint
+   * HessianFactor in slot order, and for every factor in the graph the joint slot of each of its
+   * blocks.  Building a HessianFactor from a plan adds blocks by slot index without any key
+   * lookups, and one plan serves every graph with the same structure, e.g. the same clique
+   * eliminated again in the next nonlinear iteration.
+   */
+  class GTSAM_EXPORT AssemblyPlan {
+  public:
+    FastVector<Key> keys; ///< Keys of the joint factor in slot order
+    FastVector<DenseIndex> dims; ///< Dimensions in slot order, followed by 1 for the information vector
+    FastVector<FastVector<DenseIndex> > slots; ///< Joint slot of every block of every factor, empty for factors that add nothing
+
+    AssemblyPlan() {}
+
+    /** Plan the assembly of gfg, with the slots of the variables in ordering first as with Scatter */
+    AssemblyPlan(const GaussianFactorGraph& gfg,
+        boost::optional<const Ordering&> ordering = boost::none);
+
+    /** Whether gfg has the structure this plan was made for, i.e. the same number of factors with
+     *  the same keys and dimensions, and (if given) ordering is the leading slots of the plan. */
+    bool matches(const GaussianFactorGraph& gfg,
+        boost::optional<const Ordering&> ordering = boost::none) const;
+  };
+
+  /**
+   * An elimination function that behaves like EliminatePreferCholesky but keeps the AssemblyPlan
+   * of every clique it eliminates, keyed on the first frontal variable, and reuses it for as long
+   * as the clique's structure stays the same.  Pass it by reference, e.g. with boost::cref, so the
+   * plans outlive one elimination.  The plans of different cliques can be made concurrently, but
+   * one AssemblyPlanCache must not be used by two eliminations at once.
+   */
+  class GTSAM_EXPORT AssemblyPlanCache {
+  public:
+    typedef boost::shared_ptr<const AssemblyPlan> sharedPlan;
+
+    /** Eliminate with EliminatePreferCholesky semantics, making or reusing the clique's plan */
+    std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
+      operator()(const GaussianFactorGraph& factors, const Ordering& keys) const;
+
+    /** The plan kept for the clique whose first frontal variable is j, or null */
+    sharedPlan plan(Key j) const;
+
+    /** Number of plans kept */
+    size_t size() const { return plans_.size(); }
+
+    /** Forget the plan kept for the clique whose first frontal variable is j, if any.  Not to be
+     *  called during an elimination with this cache. */
+    void erase(Key j) { plans_.unsafe_erase(j); }
+
+    /** Forget all plans */
+    void clear() { plans_.clear(); }
+
+  private:
+    mutable ConcurrentMap<Key, sharedPlan> plans_;
+  };
+
   /**
    * @brief A Gaussian factor using the canonical parameters (information form)
    *
@@ -208,6 +270,10 @@ namespace gtsam {
     explicit HessianFactor(const GaussianFactorGraph& factors,
       boost::optional<const Scatter&> scatter = boost::none);
 
+    /** Combine a set of factors into a single dense HessianFactor, adding blocks at the slots of
+     *  a plan made for the structure of \c factors */
+    HessianFactor(const GaussianFactorGraph& factors, const AssemblyPlan& plan);
+
     /** Destructor */
     virtual ~HessianFactor() {}
 
@@ -377,6 +443,14 @@ namespace gtsam {
      */
     void updateATA(const HessianFactor& update, const Scatter& scatter);
 
+    /** Update the factor by adding the information from the JacobianFactor, given the slot in
+     * this HessianFactor of each of its blocks (used internally during elimination). */
+    void updateATA(const JacobianFactor& update, const FastVector<DenseIndex>& slots);
+
+    /** Update the factor by adding the information from the HessianFactor, given the slot in
+     * this HessianFactor of each of its blocks (used internally during elimination). */
+    void updateATA(const HessianFactor& update, const FastVector<DenseIndex>& slots);
+
     /** y += alpha * A'*A*x */
     void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y) const;
 
@@ -384,11 +458,18 @@ namespace gtsam {
 
     void multiplyHessianAdd(double alpha, const double* x, double* y) const {};
 
+    /** y += alpha * A'*A*x in dense key mode, see GaussianFactor */
+    void multiplyHessianAdd(double alpha, const double* x, double* y,
+      const size_t* offsets, const size_t* indices) const;
+
     /// eta for Hessian
     VectorValues gradientAtZero() const;
 
     virtual void gradientAtZero(double* d) const;
 
+    /** d -= eta in dense key mode, see GaussianFactor */
+    void gradientAtZero(double* d, const size_t* offsets, const size_t* indices) const;
+
     /**
     *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
     *   left-multiplied with their transpose to form the Hessian using the conversion constructor
@@ -408,6 +489,10 @@ namespace gtsam {
     friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
       EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+    /** EliminateCholesky, assembling the joint factor from a plan made for \c factors and \c keys */
+    friend GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+      EliminateCholeskyWithPlan(const GaussianFactorGraph& factors, const Ordering& keys, const AssemblyPlan& plan);
+
     /**
     *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
     *   left-multiplied with their transpose to form the Hessian using the conversion constructor
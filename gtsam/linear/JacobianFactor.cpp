@@ -578,6 +578,57 @@ void JacobianFactor::gradientAtZero(double* d) const {
   //throw std::runtime_error("gradientAtZero not implemented for Jacobian factor");
 }
 
+/* ************************************************************************* */
+void JacobianFactor::multiplyHessianAdd(double alpha, const double* x, double* y,
+    const size_t* offsets, const size_t* indices) const {
+
+  // Use eigen magic to access raw memory
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> DVector;
+  typedef Eigen::Map<DVector> DMap;
+  typedef Eigen::Map<const DVector> ConstDMap;
+
+  if (empty())
+    return;
+  Vector Ax = zero(Ab_.rows());
+
+  // Just iterate over all A matrices and multiply in correct config part
+  for (size_t pos = 0; pos < size(); ++pos)
+    Ax += Ab_(pos) * ConstDMap(x + offsets[indices[pos]], Ab_(pos).cols());
+
+  // Deal with noise properly, need to Double* whiten as we are dividing by variance
+  if (model_) {
+    model_->whitenInPlace(Ax);
+    model_->whitenInPlace(Ax);
+  }
+
+  // multiply with alpha
+  Ax *= alpha;
+
+  // Again iterate over all A matrices and insert Ai^e into y
+  for (size_t pos = 0; pos < size(); ++pos)
+    DMap(y + offsets[indices[pos]], Ab_(pos).cols()) += Ab_(pos).transpose() * Ax;
+}
+
+/* ************************************************************************* */
+void JacobianFactor::gradientAtZero(double* d, const size_t* offsets,
+    const size_t* indices) const {
+  typedef Eigen::Map<Vector> DMap;
+  // Without whitening, e.g. for the conditionals of a Bayes tree, nothing is allocated
+  if (!model_ || dynamic_cast<const noiseModel::Unit*>(model_.get())) {
+    for (size_t pos = 0; pos < size(); ++pos)
+      DMap(d + offsets[indices[pos]], Ab_(pos).cols()).noalias() -= Ab_(pos).transpose() * getb();
+    return;
+  }
+  // Gradient is really -A'*b / sigma^2
+  Vector b_sigma = getb();
+  if (model_) {
+    model_->whitenInPlace(b_sigma);
+    model_->whitenInPlace(b_sigma);
+  }
+  for (size_t pos = 0; pos < size(); ++pos)
+    DMap(d + offsets[indices[pos]], Ab_(pos).cols()) -= Ab_(pos).transpose() * b_sigma;
+}
+
 /* ************************************************************************* */
 pair<Matrix, Vector> JacobianFactor::jacobian() const {
   pair<Matrix, Vector> result = jacobianUnweighted();
@@ -662,7 +713,7 @@ std::pair<boost::shared_ptr<GaussianConditional>,
   if (jointFactor->model_)
     jointFactor->model_ = jointFactor->model_->QR(jointFactor->Ab_.matrix());
   else
-    inplace_QR(jointFactor->Ab_.matrix());
+    inplace_QR_staircase(jointFactor->Ab_.matrix());
 
   // Zero below the diagonal
   jointFactor->Ab_.matrix().triangularView<Eigen::StrictlyLower>().setZero();
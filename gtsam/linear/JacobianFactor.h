@@ -283,12 +283,19 @@ namespace gtsam {
 
     void multiplyHessianAdd(double alpha, const double* x, double* y) const {};
 
+    /** y += alpha * A'*A*x in dense key mode, see GaussianFactor */
+    void multiplyHessianAdd(double alpha, const double* x, double* y,
+      const size_t* offsets, const size_t* indices) const;
+
     /// A'*b for Jacobian
     VectorValues gradientAtZero() const;
 
     /* ************************************************************************* */
     virtual void gradientAtZero(double* d) const;
 
+    /** d -= A'*b in dense key mode, see GaussianFactor */
+    void gradientAtZero(double* d, const size_t* offsets, const size_t* indices) const;
+
     /** Return a whitened version of the factor, i.e. with unit diagonal noise model. */
     JacobianFactor whiten() const;
 
@@ -0,0 +1,362 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KalmanFilterBatch-inl.h
+ * @brief   Many independent linear Kalman filters of the same dimension, advanced together
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/KalmanFilterBatch.h>
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  // Work matrices of a block of filters, entry (r,c) of filter l at [(r * COLS + c) * Lanes + l]
+  template<int N>
+  struct KalmanFilterBatch<N>::Predict {
+    enum { ROWS = 2 * N, COLS = 2 * N + 1 };
+    KalmanFilterBatch& batch;
+    const MatrixN A0, A1;     // Whitened -F and whitening matrix of Q
+    const Matrix* controls;
+    Predict(KalmanFilterBatch& batch, const MatrixN& A0, const MatrixN& A1, const Matrix* controls) :
+      batch(batch), A0(A0), A1(A1), controls(controls) {}
+
+    void block(size_t b) const {
+      const size_t first = b * Lanes, count = std::min(size_t(Lanes), batch.size_ - first);
+      double W[ROWS * COLS * Lanes];
+      // [R 0 d] above [-F I b], whitened
+      batch.template gather<COLS>(first, count, W, 2 * N);
+      for(int i = 0; i < N; ++i) {
+        double* row = W + (N + i) * COLS * Lanes;
+        for(int c = 0; c < N; ++c)
+          for(int l = 0; l < Lanes; ++l) {
+            row[c * Lanes + l] = A0(i, c);
+            row[(N + c) * Lanes + l] = A1(i, c);
+          }
+        double* rhs = row + 2 * N * Lanes;
+        for(int l = 0; l < Lanes; ++l)
+          rhs[l] = 0.0;
+        if(controls)
+          for(int k = 0; k < N; ++k)
+            for(size_t l = 0; l < count; ++l)
+              rhs[l] += A1(i, k) * (*controls)(k, first + l);
+      }
+      // Eliminate x_t and triangularize what remains on x_{t+1}
+      triangularize<ROWS, COLS>(W, 2 * N, N);
+      batch.template scatter<COLS>(first, count, W, N);
+    }
+
+#ifdef GTSAM_USE_TBB
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for(size_t b = r.begin(); b != r.end(); ++b)
+        block(b);
+    }
+#endif
+  };
+
+  /* ************************************************************************* */
+  template<int N>
+  template<int M>
+  struct KalmanFilterBatch<N>::Update {
+    enum { ROWS = N + M, COLS = N + 1 };
+    KalmanFilterBatch& batch;
+    const Eigen::Matrix<double, M, N> A;     // Whitened H
+    const Eigen::Matrix<double, M, M> S;     // Whitening matrix of R
+    const Matrix& Z;
+    Update(KalmanFilterBatch& batch, const Eigen::Matrix<double, M, N>& A, const Eigen::Matrix<double, M, M>& S,
+        const Matrix& Z) : batch(batch), A(A), S(S), Z(Z) {}
+
+    void block(size_t b) const {
+      const size_t first = b * Lanes, count = std::min(size_t(Lanes), batch.size_ - first);
+      double W[ROWS * COLS * Lanes];
+      // [R d] above [H z], whitened
+      batch.template gather<COLS>(first, count, W, N);
+      for(int i = 0; i < M; ++i) {
+        double* row = W + (N + i) * COLS * Lanes;
+        for(int c = 0; c < N; ++c)
+          for(int l = 0; l < Lanes; ++l)
+            row[c * Lanes + l] = A(i, c);
+        double* rhs = row + N * Lanes;
+        for(int l = 0; l < Lanes; ++l)
+          rhs[l] = 0.0;
+        for(int k = 0; k < M; ++k)
+          for(size_t l = 0; l < count; ++l)
+            rhs[l] += S(i, k) * Z(k, first + l);
+      }
+      triangularize<ROWS, COLS>(W, N, N);
+      batch.template scatter<COLS>(first, count, W, 0);
+    }
+
+#ifdef GTSAM_USE_TBB
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for(size_t b = r.begin(); b != r.end(); ++b)
+        block(b);
+    }
+#endif
+  };
+
+  /* ************************************************************************* */
+  template<int N>
+  KalmanFilterBatch<N>::KalmanFilterBatch(size_t count) :
+    size_(count), step_(0), R_(TriangleSize * count, 0.0), d_(N * count, 0.0) {}
+
+  /* ************************************************************************* */
+  template<int N>
+  Matrix KalmanFilterBatch<N>::whitening(const SharedGaussian& model, size_t dim) {
+    if(!model || model->dim() != dim)
+      throw std::invalid_argument("KalmanFilterBatch: noise model of the wrong dimension");
+    if(model->isConstrained())
+      throw std::invalid_argument("KalmanFilterBatch: constrained noise models are not supported");
+    return model->Whiten(eye(dim));
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  template<int COLS>
+  void KalmanFilterBatch<N>::gather(size_t first, size_t count, double* W, int rhsColumn) const {
+    // Unused lanes hold the unit density, and are not copied back
+    for(int i = 0; i < N; ++i)
+      for(int c = 0; c < COLS; ++c) {
+        double* w = W + (i * COLS + c) * Lanes;
+        const double* source = 0;
+        double padding = 0.0;
+        if(c >= i && c < N) {
+          source = &R_[tri(i, c) * size_ + first];
+          padding = (c == i) ? 1.0 : 0.0;
+        } else if(c == rhsColumn) {
+          source = &d_[i * size_ + first];
+        }
+        size_t l = 0;
+        if(source)
+          for(; l < count; ++l)
+            w[l] = source[l];
+        for(; l < size_t(Lanes); ++l)
+          w[l] = source ? padding : 0.0;
+      }
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  template<int COLS>
+  void KalmanFilterBatch<N>::scatter(size_t first, size_t count, const double* W, int row) {
+    for(int i = 0; i < N; ++i) {
+      for(int j = i; j < N; ++j) {
+        const double* w = W + ((row + i) * COLS + row + j) * Lanes;
+        double* target = &R_[tri(i, j) * size_ + first];
+        for(size_t l = 0; l < count; ++l)
+          target[l] = w[l];
+      }
+      const double* w = W + ((row + i) * COLS + COLS - 1) * Lanes;
+      double* target = &d_[i * size_ + first];
+      for(size_t l = 0; l < count; ++l)
+        target[l] = w[l];
+    }
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  template<int ROWS, int COLS>
+  void KalmanFilterBatch<N>::triangularize(double* W, int columns, int dense) {
+    double sigma[Lanes], beta[Lanes], scale[Lanes], s[Lanes];
+    for(int j = 0; j < columns; ++j) {
+      const int below = std::max(j + 1, dense);
+
+      // Householder vector [1; x / v0] of column j, which leaves |x| on the
+      // diagonal, as in Golub & Van Loan, Algorithm 5.1.1
+      for(int l = 0; l < Lanes; ++l)
+        sigma[l] = 0.0;
+      for(int r = below; r < ROWS; ++r) {
+        const double* x = W + (r * COLS + j) * Lanes;
+        for(int l = 0; l < Lanes; ++l)
+          sigma[l] += x[l] * x[l];
+      }
+      double* diagonal = W + (j * COLS + j) * Lanes;
+      for(int l = 0; l < Lanes; ++l) {
+        const double x0 = diagonal[l];
+        const double mu = std::sqrt(x0 * x0 + sigma[l]);
+        const double v0 = (x0 <= 0.0) ? x0 - mu : -sigma[l] / (x0 + mu);
+        const bool reflect = sigma[l] > 0.0;
+        beta[l] = reflect ? 2.0 * v0 * v0 / (sigma[l] + v0 * v0) : 0.0;
+        scale[l] = reflect ? 1.0 / v0 : 0.0;
+        diagonal[l] = reflect ? mu : x0;
+      }
+      for(int r = below; r < ROWS; ++r) {
+        double* x = W + (r * COLS + j) * Lanes;
+        for(int l = 0; l < Lanes; ++l)
+          x[l] *= scale[l];
+      }
+
+      // Apply the reflection to the columns on the right
+      for(int c = j + 1; c < COLS; ++c) {
+        double* top = W + (j * COLS + c) * Lanes;
+        for(int l = 0; l < Lanes; ++l)
+          s[l] = top[l];
+        for(int r = below; r < ROWS; ++r) {
+          const double* v = W + (r * COLS + j) * Lanes;
+          const double* w = W + (r * COLS + c) * Lanes;
+          for(int l = 0; l < Lanes; ++l)
+            s[l] += v[l] * w[l];
+        }
+        for(int l = 0; l < Lanes; ++l) {
+          s[l] *= beta[l];
+          top[l] -= s[l];
+        }
+        for(int r = below; r < ROWS; ++r) {
+          const double* v = W + (r * COLS + j) * Lanes;
+          double* w = W + (r * COLS + c) * Lanes;
+          for(int l = 0; l < Lanes; ++l)
+            w[l] -= s[l] * v[l];
+        }
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  void KalmanFilterBatch<N>::init(const VectorN& x0, const SharedGaussian& P0) {
+    for(size_t i = 0; i < size_; ++i)
+      init(i, x0, P0);
+    step_ = 0;
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  void KalmanFilterBatch<N>::init(size_t i, const VectorN& x0, const SharedGaussian& P0) {
+    // |x - x0|^2_P0, with an upper-triangular whitening matrix
+    const MatrixN R = whitening(P0, N);
+    const VectorN d = R * x0;
+    for(int r = 0; r < N; ++r) {
+      for(int c = r; c < N; ++c)
+        R_[tri(r, c) * size_ + i] = R(r, c);
+      d_[r * size_ + i] = d(r);
+    }
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  void KalmanFilterBatch<N>::setState(size_t i, const KalmanFilter::State& p) {
+    if(p->rows() != N || p->nrParents() != 0 || p->getDim(p->begin()) != N)
+      throw std::invalid_argument("KalmanFilterBatch: density of the wrong dimension");
+    Matrix R = p->get_R();
+    Vector d = p->get_d();
+    if(p->get_model()) {
+      R = p->get_model()->Whiten(R);
+      d = p->get_model()->whiten(d);
+    }
+    for(int r = 0; r < N; ++r) {
+      for(int c = r; c < N; ++c)
+        R_[tri(r, c) * size_ + i] = R(r, c);
+      d_[r * size_ + i] = d(r);
+    }
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  void KalmanFilterBatch<N>::predict(const MatrixN& F, const SharedGaussian& Q) {
+    const MatrixN S = whitening(Q, N);
+    const Predict kernel(*this, -S * F, S, 0);
+    const size_t blocks = (size_ + Lanes - 1) / Lanes;
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks), kernel);
+#else
+    for(size_t b = 0; b < blocks; ++b)
+      kernel.block(b);
+#endif
+    ++ step_;
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  void KalmanFilterBatch<N>::predict(const MatrixN& F, const Matrix& controls, const SharedGaussian& Q) {
+    if(controls.rows() != N || size_t(controls.cols()) != size_)
+      throw std::invalid_argument("KalmanFilterBatch: controls should have a column per filter");
+    const MatrixN S = whitening(Q, N);
+    const Predict kernel(*this, -S * F, S, &controls);
+    const size_t blocks = (size_ + Lanes - 1) / Lanes;
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks), kernel);
+#else
+    for(size_t b = 0; b < blocks; ++b)
+      kernel.block(b);
+#endif
+    ++ step_;
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  template<int M>
+  void KalmanFilterBatch<N>::update(const Eigen::Matrix<double, M, N>& H, const Matrix& Z, const SharedGaussian& R) {
+    if(Z.rows() != M || size_t(Z.cols()) != size_)
+      throw std::invalid_argument("KalmanFilterBatch: measurements should have a column per filter");
+    const Eigen::Matrix<double, M, M> S = whitening(R, M);
+    const Update<M> kernel(*this, S * H, S, Z);
+    const size_t blocks = (size_ + Lanes - 1) / Lanes;
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks), kernel);
+#else
+    for(size_t b = 0; b < blocks; ++b)
+      kernel.block(b);
+#endif
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  typename KalmanFilterBatch<N>::MatrixN KalmanFilterBatch<N>::R(size_t i) const {
+    MatrixN R = MatrixN::Zero();
+    for(int r = 0; r < N; ++r)
+      for(int c = r; c < N; ++c)
+        R(r, c) = R_[tri(r, c) * size_ + i];
+    return R;
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  typename KalmanFilterBatch<N>::VectorN KalmanFilterBatch<N>::d(size_t i) const {
+    VectorN d;
+    for(int r = 0; r < N; ++r)
+      d(r) = d_[r * size_ + i];
+    return d;
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  typename KalmanFilterBatch<N>::VectorN KalmanFilterBatch<N>::mean(size_t i) const {
+    return R(i).template triangularView<Eigen::Upper>().solve(d(i));
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  typename KalmanFilterBatch<N>::MatrixN KalmanFilterBatch<N>::covariance(size_t i) const {
+    const MatrixN Rinv = R(i).template triangularView<Eigen::Upper>().solve(MatrixN::Identity());
+    return Rinv * Rinv.transpose();
+  }
+
+  /* ************************************************************************* */
+  template<int N>
+  KalmanFilter::State KalmanFilterBatch<N>::state(size_t i) const {
+    return boost::make_shared<GaussianDensity>(step_, Vector(d(i)), Matrix(R(i)));
+  }
+
+} // namespace gtsam
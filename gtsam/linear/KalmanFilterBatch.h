@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KalmanFilterBatch.h
+ * @brief   Many independent linear Kalman filters of the same dimension, advanced together
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A batch of independent linear Kalman filters with N-dimensional states that
+ * share their motion and measurement models, such as the tracks of a
+ * multi-target tracker, advanced together by one call to predict() or update().
+ *
+ * Like KalmanFilter, each filter is a square-root information filter holding
+ * the density \f$ |R x - d|^2 \f$ with upper-triangular R, and predict() and
+ * update() compute the same QR factorizations as KalmanFilter with the QR
+ * factorization.  They do so directly on the stacked matrices of the density
+ * and the new factor, without factor graphs, skipping the entries known to be
+ * zero, and allocate no memory.
+ *
+ * The states are stored as structure-of-arrays, entry by entry of R and d for
+ * all filters, and the Householder reflections are applied to blocks of Lanes
+ * filters with the filter index innermost, so that the compiler vectorizes
+ * across filters.  With TBB, blocks of filters are processed in parallel.
+ */
+template<int N>
+class KalmanFilterBatch {
+
+public:
+
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+
+  /// Number of filters processed together by the kernels
+  enum { Lanes = 16 };
+
+private:
+
+  /// Number of entries in the upper triangle of R
+  enum { TriangleSize = N * (N + 1) / 2 };
+
+  size_t size_;             ///< Number of filters
+  Key step_;                ///< Step index k, incremented at each predict
+  std::vector<double> R_;   ///< Entry e of the upper triangle of R of filter f at [e * size_ + f], by rows
+  std::vector<double> d_;   ///< Entry i of d of filter f at [i * size_ + f]
+
+  /// Index of R(i,j), j >= i, in the packed upper triangle
+  static size_t tri(int i, int j) { return i * N - i * (i - 1) / 2 + (j - i); }
+
+  /// Whitening matrix of a noise model, which may not be constrained
+  static Matrix whitening(const SharedGaussian& model, size_t dim);
+
+  /// Copy the densities of a block of filters into the first N rows of a work matrix
+  template<int COLS>
+  void gather(size_t first, size_t count, double* W, int rhsColumn) const;
+
+  /// Copy the densities of a block of filters back from rows \c row to \c row + N of a work matrix
+  template<int COLS>
+  void scatter(size_t first, size_t count, const double* W, int row);
+
+  /**
+   * Triangularize the first \c columns columns of a block of work matrices,
+   * with the Householder reflection of column j acting on row j and on rows
+   * max(j+1, dense) and below, the rows above dense being upper-triangular.
+   */
+  template<int ROWS, int COLS>
+  static void triangularize(double* W, int columns, int dense);
+
+  template<int M> struct Update;
+  struct Predict;
+
+public:
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Create a batch of count filters, to be initialized with init() */
+  explicit KalmanFilterBatch(size_t count);
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /** Number of filters */
+  size_t size() const { return size_; }
+
+  /** Step index k, starts at 0, incremented at each predict, as KalmanFilter::step */
+  Key step() const { return step_; }
+
+  /** Set all filters to the prior density at time 0, with mean x0 and covariance P0 */
+  void init(const VectorN& x0, const SharedGaussian& P0);
+
+  /** Set filter i to the prior density with mean x0 and covariance P0 */
+  void init(size_t i, const VectorN& x0, const SharedGaussian& P0);
+
+  /** Set filter i to a density, e.g., one of a KalmanFilter */
+  void setState(size_t i, const KalmanFilter::State& p);
+
+  /**
+   * Predict all filters with the motion model x_{t+1} = F x_t + w, where w is
+   * zero-mean Gaussian noise with covariance Q, as KalmanFilter::predict with
+   * a zero control input.
+   */
+  void predict(const MatrixN& F, const SharedGaussian& Q);
+
+  /**
+   * Predict all filters with the motion model x_{t+1} = F x_t + b_f + w, where
+   * b_f is column f of controls, e.g., B u_f for filter f, as KalmanFilter::predict.
+   */
+  void predict(const MatrixN& F, const Matrix& controls, const SharedGaussian& Q);
+
+  /**
+   * Update all filters with the measurements z_f = H x_f + v, where z_f is
+   * column f of Z and v is zero-mean Gaussian noise with covariance R, as
+   * KalmanFilter::update.
+   */
+  template<int M>
+  void update(const Eigen::Matrix<double, M, N>& H, const Matrix& Z, const SharedGaussian& R);
+
+  /** The square-root information matrix R of filter i */
+  MatrixN R(size_t i) const;
+
+  /** The vector d of filter i */
+  VectorN d(size_t i) const;
+
+  /** Mean \f$ \mu = R^{-1} d \f$ of filter i */
+  VectorN mean(size_t i) const;
+
+  /** Covariance \f$ \Sigma = (R^T R)^{-1} \f$ of filter i */
+  MatrixN covariance(size_t i) const;
+
+  /** The density of filter i, as KalmanFilter states */
+  KalmanFilter::State state(size_t i) const;
+
+  /// @}
+};
+
+} // namespace gtsam
+
+#include <gtsam/linear/KalmanFilterBatch-inl.h>
@@ -181,7 +181,7 @@ SharedDiagonal Gaussian::QR(Matrix& Ab) const {
   if(debug) gtsam::print(Ab, "Whitened Ab: ");
 
   // Eigen QR - much faster than older householder approach
-  inplace_QR(Ab);
+  inplace_QR_staircase(Ab);
 
   // hand-coded householder implementation
   // TODO: necessary to isolate last column?
@@ -401,11 +401,40 @@ Constrained::shared_ptr Constrained::unit() const {
   return MixedSigmas(mu_, sigmas);
 }
 
+/* ************************************************************************* */
+namespace {
+// Householder QR of the whitened soft rows of Ab, on columns j to n, for when
+// no hard constraint has support there any more.  Fails, leaving Rd as it is,
+// when a pivot is too small, as skipping uninformative columns needs Gram-Schmidt.
+bool softRowsQR(const Matrix& Ab, const Vector& sigmas, size_t j, size_t maxRows,
+    Matrix& Rd) {
+  const size_t m = Ab.rows(), n = Ab.cols() - 1;
+  size_t soft = 0;
+  for (size_t i = 0; i < m; ++i)
+    if (sigmas(i) != 0.0)
+      ++soft;
+  Matrix whitened(soft, n + 1 - j);
+  for (size_t i = 0, r = 0; i < m; ++i)
+    if (sigmas(i) != 0.0)
+      whitened.row(r++) = Ab.row(i).tail(n + 1 - j) / sigmas(i);
+  inplace_QR_staircase(whitened);
+
+  const size_t rows = std::min(std::min(soft, n - j), maxRows);
+  for (size_t t = 0; t < rows; ++t)
+    if (whitened(t, t) * whitened(t, t) < 1e-8)
+      return false;
+  Rd = whitened.topRows(rows);
+  return true;
+}
+}
+
 /* ************************************************************************* */
 // Special version of QR for Constrained calls slower but smarter code
 // that deals with possibly zero sigmas
 // It is Gram-Schmidt orthogonalization rather than Householder
 // Previously Diagonal::QR
+// Once no hard constraint has support in the remaining columns, these are
+// finished with Householder QR on the soft rows instead
 SharedDiagonal Constrained::QR(Matrix& Ab) const {
   bool verbose = false;
   if (verbose) cout << "\nStarting Constrained::QR" << endl;
@@ -422,11 +451,38 @@ SharedDiagonal Constrained::QR(Matrix& Ab) const {
   Vector invsigmas = reciprocal(sigmas_);
   Vector weights = emul(invsigmas,invsigmas); // calculate weights once
 
+  // Rows of the hard constraints, and [R d] of the soft rows from softColumn on
+  vector<size_t> hardRows;
+  for (size_t i=0; i<m; ++i)
+    if (sigmas_(i) == 0.0)
+      hardRows.push_back(i);
+  Matrix softRd;
+  size_t softColumn = n;
+  bool softTried = false;
+
   // We loop over all columns, because the columns that can be eliminated
   // are not necessarily contiguous. For each one, estimate the corresponding
   // scalar variable x as d-rS, with S the separator (remaining columns).
   // Then update A and b by substituting x with d-rS, zero-ing out x's column.
   for (size_t j=0; j<n; ++j) {
+    // Without hard constraints left, Gram-Schmidt would only combine the soft
+    // rows from here on, which Householder does faster
+    if (!softTried) {
+      bool hard = false;
+      BOOST_FOREACH(size_t i, hardRows)
+        hard = hard || Ab.row(i).segment(j, n-j).cwiseAbs().maxCoeff() >= 1e-9;
+      if (!hard) {
+        softTried = true;
+        gttic(constrained_QR_soft_rows);
+        const bool finished = softRowsQR(Ab, sigmas_, j, maxRank - Rd.size(), softRd);
+        gttoc(constrained_QR_soft_rows);
+        if (finished) {
+          softColumn = j;
+          break;
+        }
+      }
+    }
+
     // extract the first column of A
     Vector a = Ab.col(j);
 
@@ -461,7 +517,7 @@ SharedDiagonal Constrained::QR(Matrix& Ab) const {
   }
 
   // Create storage for precisions
-  Vector precisions(Rd.size());
+  Vector precisions(Rd.size() + softRd.rows());
 
   gttic(constrained_QR_write_back_into_Ab);
   // Write back result in Ab, imperative as we are
@@ -479,6 +535,14 @@ SharedDiagonal Constrained::QR(Matrix& Ab) const {
       Ab(i,j2) = rd(j2);
     i+=1;
   }
+  // Rows of the soft part, scaled to a unit diagonal as those of Gram-Schmidt
+  for (DenseIndex t=0; t<softRd.rows(); ++t) {
+    const double pivot = softRd(t,t);
+    precisions(i) = pivot * pivot;
+    Ab.row(i).head(softColumn + t).setZero();
+    Ab.row(i).tail(n + 1 - softColumn - t) = softRd.row(t).tail(n + 1 - softColumn - t) / pivot;
+    i+=1;
+  }
   gttoc(constrained_QR_write_back_into_Ab);
 
   // Must include mu, as the defaults might be higher, resulting in non-convergence
@@ -559,11 +623,7 @@ Vector Base::weight(const Vector &error) const {
 
 /** square root version of the weight function */
 Vector Base::sqrtWeight(const Vector &error) const {
-  const size_t n = error.rows();
-  Vector w(n);
-  for ( size_t i = 0 ; i < n ; ++i )
-    w(i) = sqrtWeight(error(i));
-  return w;
+  return weight(error).array().sqrt();
 }
 
 
@@ -671,6 +731,9 @@ Fair::Fair(const double c, const ReweightScheme reweight)
 double Fair::weight(const double &error) const
 { return 1.0 / (1.0 + fabs(error)/c_); }
 
+Vector Fair::weight(const Vector &error) const
+{ return (1.0 + error.array().abs() / c_).inverse(); }
+
 void Fair::print(const std::string &s="") const
 { cout << s << "fair (" << c_ << ")" << endl; }
 
@@ -699,6 +762,10 @@ double Huber::weight(const double &error) const {
   return (error < k_) ? (1.0) : (k_ / fabs(error));
 }
 
+Vector Huber::weight(const Vector &error) const {
+  return (error.array() < k_).select(1.0, k_ / error.array().abs());
+}
+
 void Huber::print(const std::string &s="") const {
   cout << s << "huber (" << k_ << ")" << endl;
 }
@@ -729,6 +796,10 @@ double Cauchy::weight(const double &error) const {
   return k_*k_ / (k_*k_ + error*error);
 }
 
+Vector Cauchy::weight(const Vector &error) const {
+  return k_*k_ / (k_*k_ + error.array().square());
+}
+
 void Cauchy::print(const std::string &s="") const {
   cout << s << "cauchy (" << k_ << ")" << endl;
 }
@@ -759,6 +830,11 @@ double Tukey::weight(const double &error) const {
   return 0.0;
 }
 
+Vector Tukey::weight(const Vector &error) const {
+  const Eigen::ArrayXd xc2 = (error.array() / c_).square();
+  return (error.array().abs() <= c_).select((1.0 - xc2).square(), 0.0);
+}
+
 void Tukey::print(const std::string &s="") const {
   std::cout << s << ": Tukey (" << c_ << ")" << std::endl;
 }
@@ -785,6 +861,10 @@ double Welsh::weight(const double &error) const {
   return std::exp(-xc2);
 }
 
+Vector Welsh::weight(const Vector &error) const {
+  return (-(error.array() / c_).square()).exp();
+}
+
 void Welsh::print(const std::string &s="") const {
   std::cout << s << ": Welsh (" << c_ << ")" << std::endl;
 }
@@ -636,9 +636,12 @@ namespace gtsam {
         inline double sqrtWeight(const double &error) const
         { return std::sqrt(weight(error)); }
 
+        /// how rows are reweighted
+        ReweightScheme reweightScheme() const { return reweight_; }
+
         /** produce a weight vector according to an error vector and the implemented
-        * robust function */
-        Vector weight(const Vector &error) const;
+        * robust function, derived classes evaluate it in one array expression */
+        virtual Vector weight(const Vector &error) const;
 
         /** square root version of the weight function */
         Vector sqrtWeight(const Vector &error) const;
@@ -667,6 +670,7 @@ namespace gtsam {
         Null(const ReweightScheme reweight = Block) : Base(reweight) {}
         virtual ~Null() {}
         virtual double weight(const double &error) const { return 1.0; }
+        virtual Vector weight(const Vector &error) const { return ones(error.size()); }
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, const double tol=1e-8) const { return true; }
         static shared_ptr Create() ;
@@ -688,6 +692,7 @@ namespace gtsam {
         Fair(const double c = 1.3998, const ReweightScheme reweight = Block);
         virtual ~Fair() {}
         virtual double weight(const double &error) const ;
+        virtual Vector weight(const Vector &error) const ;
         virtual void print(const std::string &s) const ;
         virtual bool equals(const Base& expected, const double tol=1e-8) const ;
         static shared_ptr Create(const double c, const ReweightScheme reweight = Block) ;
@@ -713,6 +718,7 @@ namespace gtsam {
         virtual ~Huber() {}
         Huber(const double k = 1.345, const ReweightScheme reweight = Block);
         virtual double weight(const double &error) const ;
+        virtual Vector weight(const Vector &error) const ;
         virtual void print(const std::string &s) const ;
         virtual bool equals(const Base& expected, const double tol=1e-8) const ;
         static shared_ptr Create(const double k, const ReweightScheme reweight = Block) ;
@@ -742,6 +748,7 @@ namespace gtsam {
         virtual ~Cauchy() {}
         Cauchy(const double k = 0.1, const ReweightScheme reweight = Block);
         virtual double weight(const double &error) const ;
+        virtual Vector weight(const Vector &error) const ;
         virtual void print(const std::string &s) const ;
         virtual bool equals(const Base& expected, const double tol=1e-8) const ;
         static shared_ptr Create(const double k, const ReweightScheme reweight = Block) ;
@@ -767,6 +774,7 @@ namespace gtsam {
         Tukey(const double c = 4.6851, const ReweightScheme reweight = Block);
         virtual ~Tukey() {}
         virtual double weight(const double &error) const ;
+        virtual Vector weight(const Vector &error) const ;
         virtual void print(const std::string &s) const ;
         virtual bool equals(const Base& expected, const double tol=1e-8) const ;
         static shared_ptr Create(const double k, const ReweightScheme reweight = Block) ;
@@ -792,6 +800,7 @@ namespace gtsam {
         Welsh(const double c = 2.9846, const ReweightScheme reweight = Block);
         virtual ~Welsh() {}
         virtual double weight(const double &error) const ;
+        virtual Vector weight(const Vector &error) const ;
         virtual void print(const std::string &s) const ;
         virtual bool equals(const Base& expected, const double tol=1e-8) const ;
         static shared_ptr Create(const double k, const ReweightScheme reweight = Block) ;
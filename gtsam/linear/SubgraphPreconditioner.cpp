@@ -16,6 +16,7 @@
  */
 
 #include <gtsam/base/DSFVector.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianBayesNet.h>
@@ -243,17 +244,17 @@ std::string SubgraphBuilderParameters::augmentationWeightTranslator(Augmentation
 }
 
 /****************************************************************/
-std::vector<size_t> SubgraphBuilder::buildTree(const GaussianFactorGraph &gfg, const FastMap<Key, size_t> &ordering, const std::vector<double> &w) const {
+std::vector<size_t> SubgraphBuilder::buildTree(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex, const std::vector<double> &w) const {
   const SubgraphBuilderParameters &p = parameters_;
   switch (p.skeleton_) {
   case SubgraphBuilderParameters::NATURALCHAIN:
     return natural_chain(gfg);
     break;
   case SubgraphBuilderParameters::BFS:
-    return bfs(gfg);
+    return bfs(gfg, variableIndex);
     break;
   case SubgraphBuilderParameters::KRUSKAL:
-    return kruskal(gfg, ordering, w);
+    return kruskal(gfg, variableIndex, w);
     break;
   default:
     cerr << "SubgraphBuilder::buildTree undefined skeleton type" << endl;
@@ -291,10 +292,9 @@ std::vector<size_t> SubgraphBuilder::natural_chain(const GaussianFactorGraph &gf
 }
 
 /****************************************************************/
-std::vector<size_t> SubgraphBuilder::bfs(const GaussianFactorGraph &gfg) const {
-  const VariableIndex variableIndex(gfg);
+std::vector<size_t> SubgraphBuilder::bfs(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex) const {
   /* start from the first key of the first factor */
-  Key seed = gfg[0]->keys()[0];
+  const size_t seed = variableIndex.index(gfg[0]->keys()[0]);
 
   const size_t n = variableIndex.size();
 
@@ -306,18 +306,19 @@ std::vector<size_t> SubgraphBuilder::bfs(const GaussianFactorGraph &gfg) const {
   std::queue<size_t> q;
   q.push(seed);
 
-  std::set<size_t> flags;
-  flags.insert(seed);
+  std::vector<bool> flags(n, false);
+  flags[seed] = true;
 
   /* traversal */
   while ( !q.empty() ) {
     const size_t head = q.front(); q.pop();
-    BOOST_FOREACH ( const size_t id, variableIndex[head] ) {
+    BOOST_FOREACH ( const size_t id, variableIndex.factors(head) ) {
       const GaussianFactor &gf = *gfg[id];
-      BOOST_FOREACH ( const size_t key, gf.keys() ) {
-        if ( flags.count(key) == 0 ) {
-          q.push(key);
-          flags.insert(key);
+      BOOST_FOREACH ( const Key key, gf.keys() ) {
+        const size_t j = variableIndex.index(key);
+        if ( !flags[j] ) {
+          q.push(j);
+          flags[j] = true;
           result.push_back(id);
         }
       }
@@ -327,8 +328,7 @@ std::vector<size_t> SubgraphBuilder::bfs(const GaussianFactorGraph &gfg) const {
 }
 
 /****************************************************************/
-std::vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg, const FastMap<Key, size_t> &ordering, const std::vector<double> &w) const {
-  const VariableIndex variableIndex(gfg);
+std::vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex, const std::vector<double> &w) const {
   const size_t n = variableIndex.size();
   const vector<size_t> idx = sort_idx(w) ;
 
@@ -343,9 +343,9 @@ std::vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg, con
   BOOST_FOREACH (const size_t id, idx) {
     const GaussianFactor &gf = *gfg[id];
     if ( gf.keys().size() != 2 ) continue;
-    const size_t u = ordering.find(gf.keys()[0])->second,
+    const size_t u = variableIndex.index(gf.keys()[0]),
                  u_root = D.find(u),
-                 v = ordering.find(gf.keys()[1])->second,
+                 v = variableIndex.index(gf.keys()[1]),
                  v_root = D.find(v) ;
     if ( u_root != v_root ) {
       D.merge(u_root, v_root) ;
@@ -364,14 +364,17 @@ std::vector<size_t> SubgraphBuilder::sample(const std::vector<double> &weights,
 
 /****************************************************************/
 Subgraph::shared_ptr SubgraphBuilder::operator() (const GaussianFactorGraph &gfg) const {
+  return (*this)(gfg, CompressedVariableIndex(gfg));
+}
+
+/****************************************************************/
+Subgraph::shared_ptr SubgraphBuilder::operator() (const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex) const {
 
   const SubgraphBuilderParameters &p = parameters_;
-  const Ordering inverse_ordering = Ordering::Natural(gfg);
-  const FastMap<Key, size_t> forward_ordering = inverse_ordering.invert();
-  const size_t n = inverse_ordering.size(), t = n * p.complexity_ ;
+  const size_t n = variableIndex.size(), t = n * p.complexity_ ;
 
   vector<double> w = weights(gfg);
-  const vector<size_t> tree = buildTree(gfg, forward_ordering, w);
+  const vector<size_t> tree = buildTree(gfg, variableIndex, w);
 
   /* sanity check */
   if ( tree.size() != n-1 ) {
@@ -30,6 +30,7 @@ namespace gtsam {
   class GaussianBayesNet;
   class GaussianFactorGraph;
   class VectorValues;
+  class CompressedVariableIndex;
 
   struct GTSAM_EXPORT SubgraphEdge {
     size_t index_;   /* edge id */
@@ -147,12 +148,16 @@ namespace gtsam {
     virtual ~SubgraphBuilder() {}
     virtual boost::shared_ptr<Subgraph> operator() (const GaussianFactorGraph &jfg) const ;
 
+    /** Build the subgraph using the precomputed variable index of \c jfg, whose dense indices
+     *  identify the vertices of the spanning tree */
+    virtual boost::shared_ptr<Subgraph> operator() (const GaussianFactorGraph &jfg, const CompressedVariableIndex &variableIndex) const ;
+
   private:
-    std::vector<size_t> buildTree(const GaussianFactorGraph &gfg, const FastMap<Key, size_t> &ordering, const std::vector<double> &weights) const ;
+    std::vector<size_t> buildTree(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex, const std::vector<double> &weights) const ;
     std::vector<size_t> unary(const GaussianFactorGraph &gfg) const ;
     std::vector<size_t> natural_chain(const GaussianFactorGraph &gfg) const ;
-    std::vector<size_t> bfs(const GaussianFactorGraph &gfg) const ;
-    std::vector<size_t> kruskal(const GaussianFactorGraph &gfg, const FastMap<Key, size_t> &ordering, const std::vector<double> &w) const ;
+    std::vector<size_t> bfs(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex) const ;
+    std::vector<size_t> kruskal(const GaussianFactorGraph &gfg, const CompressedVariableIndex &variableIndex, const std::vector<double> &w) const ;
     std::vector<size_t> sample(const std::vector<double> &weights, const size_t t) const ;
     Weights weights(const GaussianFactorGraph &gfg) const;
     SubgraphBuilderParameters parameters_;
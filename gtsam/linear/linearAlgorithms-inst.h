@@ -55,7 +55,7 @@ namespace gtsam
           OptimizeData myData;
           myData.parentData = parentData;
           // Take any ancestor results we'll need
-          BOOST_FOREACH(Key parent, clique->conditional_->parents())
+          BOOST_FOREACH(Key parent, clique->conditional()->parents())
             myData.cliqueResults.insert(std::make_pair(parent, myData.parentData->cliqueResults.at(parent)));
           // Solve and store in our results
           //collectedResult.insert(clique->conditional()->solve(collectedResult/*myData.ancestorResults*/));
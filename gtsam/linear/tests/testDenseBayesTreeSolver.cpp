@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDenseBayesTreeSolver.cpp
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/DenseBayesTreeSolver.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/make_shared.hpp>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// A grid of variables of alternating dimensions, whose Bayes tree has many branches
+static GaussianFactorGraph createGrid(size_t side) {
+  GaussianFactorGraph graph;
+  const SharedDiagonal sigma = noiseModel::Isotropic::Sigma(2, 0.5);
+  graph += JacobianFactor(X(0), eye(2), Vector2(1.0, -1.0));
+  for(size_t r = 0; r < side; ++r) {
+    for(size_t c = 0; c < side; ++c) {
+      const size_t j = r * side + c;
+      const size_t dj = j % 2 ? 3 : 2;
+      const Matrix Aj = Matrix::Identity(2, dj) + 0.1 * double(j % 5) * Matrix::Ones(2, dj);
+      if(dj == 3)
+        graph += JacobianFactor(X(j), (Matrix(1, 3) << 0.0, 0.0, 1.0).finished(), (Vector(1) << 0.5).finished());
+      if(c + 1 < side)
+        graph += JacobianFactor(X(j), Aj, X(j + 1), -Matrix::Identity(2, (j + 1) % 2 ? 3 : 2),
+          Vector2(1.0, 0.1 * double(j)), sigma);
+      if(r + 1 < side)
+        graph += JacobianFactor(X(j), Aj, X(j + side), -Matrix::Identity(2, (j + side) % 2 ? 3 : 2),
+          Vector2(0.2 * double(c), 1.0));
+    }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(DenseBayesTreeSolver, optimize) {
+  const GaussianBayesTree bayesTree = *createGrid(8).eliminateMultifrontal();
+  const VectorValues expected = bayesTree.optimize();
+
+  // Serially and on several threads, with the frontal variables solved in place
+  for(size_t nThreads = 1; nThreads <= 4; nThreads += 3) {
+    DenseBayesTreeSolver solver(bayesTree, nThreads);
+    LONGS_EQUAL(long(nThreads), long(solver.nThreads()));
+    LONGS_EQUAL(long(bayesTree.size()), long(solver.nrCliques()));
+    EXPECT(assert_equal(expected, solver.optimize().toVectorValues(), 1e-9));
+
+    // Solving again reuses the solution
+    DenseVectorValues x = solver.zero();
+    solver.optimize(x);
+    solver.optimize(x);
+    EXPECT(assert_equal(expected, x.toVectorValues(), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(DenseBayesTreeSolver, existingIndexer) {
+  const GaussianFactorGraph graph = createGrid(6);
+  const GaussianBayesTree bayesTree = *graph.eliminateMultifrontal();
+
+  // In key order the frontal variables of a clique are not contiguous, and the scratch space is used
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(graph);
+  DenseBayesTreeSolver solver(bayesTree, indexer, 3);
+  DenseVectorValues x(indexer, VectorValues::Zero(bayesTree.optimize()));
+  solver.optimize(x);
+  EXPECT(assert_equal(bayesTree.optimize(), x.toVectorValues(), 1e-9));
+
+  // A layout by another indexer is refused
+  DenseBayesTreeSolver other(bayesTree, 1);
+  CHECK_EXCEPTION(other.optimize(x), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DenseBayesTreeSolver, gradientAtZero) {
+  const GaussianBayesTree bayesTree = *createGrid(8).eliminateMultifrontal();
+  const VectorValues expected = bayesTree.gradientAtZero();
+
+  for(size_t nThreads = 1; nThreads <= 4; nThreads += 3) {
+    DenseBayesTreeSolver solver(bayesTree, nThreads);
+    DenseVectorValues g = solver.zero();
+    g.vector().setConstant(1.0);
+    solver.gradientAtZero(g);
+    EXPECT(assert_equal(expected, g.toVectorValues(), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(DenseBayesTreeSolver, empty) {
+  DenseBayesTreeSolver solver((GaussianBayesTree()));
+  DenseVectorValues x = solver.zero();
+  solver.optimize(x);
+  solver.gradientAtZero(x);
+  LONGS_EQUAL(0, long(x.size()));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
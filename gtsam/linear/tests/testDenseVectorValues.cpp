@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDenseVectorValues.cpp
+ * @brief   Unit tests for DenseVectorValues and the dense key mode factor operations
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/DenseVectorValues.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/make_shared.hpp>
+using namespace boost::assign;
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+/* ************************************************************************* */
+// A graph on Symbol keys mixing Jacobian and Hessian factors of different dimensions
+static GaussianFactorGraph createGraph() {
+  const SharedDiagonal sigma2 = noiseModel::Isotropic::Sigma(2, 0.5);
+  GaussianFactorGraph graph;
+  graph += JacobianFactor(X(1), 10 * eye(2), Vector2(1.0, -1.0), sigma2);
+  graph += JacobianFactor(X(1), (Matrix(2, 2) << 1.0, 2.0, 3.0, 4.0).finished(),
+      X(2), (Matrix(2, 3) << -1.0, 0.0, 2.0, 0.5, 1.5, -2.0).finished(), Vector2(0.5, 2.0), sigma2);
+  graph += JacobianFactor(X(2), (Matrix(2, 3) << 1.0, 0.0, -1.0, 2.0, 1.0, 0.0).finished(),
+      L(1), (Matrix(2, 1) << 3.0, -2.0).finished(), Vector2(-1.0, 0.25));
+  graph += HessianFactor(JacobianFactor(L(1), (Matrix(1, 1) << 2.0).finished(),
+      X(1), (Matrix(1, 2) << 1.0, -3.0).finished(), (Vector(1) << 0.7).finished()));
+  return graph;
+}
+
+/* ************************************************************************* */
+static VectorValues createValues() {
+  VectorValues x;
+  x.insert(X(1), Vector2(0.3, -1.2));
+  x.insert(X(2), Vector3(2.0, 0.1, -0.5));
+  x.insert(L(1), (Vector(1) << 1.5).finished());
+  return x;
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, roundTrip) {
+  const VectorValues x = createValues();
+  const FastVector<Key> keys = list_of(X(2))(L(1))(X(1));
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(keys);
+  const DenseVectorValues dense(indexer, x);
+
+  LONGS_EQUAL(3, (long)dense.size());
+  LONGS_EQUAL(6, (long)dense.dim());
+  LONGS_EQUAL(3, (long)dense.offset(1));
+  LONGS_EQUAL(4, (long)dense.offset(2));
+  EXPECT(assert_equal(x.at(L(1)), Vector(dense[1])));
+  EXPECT(assert_equal(x.at(X(1)), Vector(dense.at(X(1)))));
+  EXPECT(assert_equal(x, dense.toVectorValues()));
+
+  const DenseVectorValues zero = DenseVectorValues::Zero(dense);
+  EXPECT(assert_equal(VectorValues::Zero(x), zero.toVectorValues()));
+  EXPECT(!dense.equals(zero));
+
+  VectorValues missing = x;
+  missing.erase(L(1));
+  CHECK_EXCEPTION(DenseVectorValues(indexer, missing), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, zeroDenseVectorValues) {
+  const GaussianFactorGraph graph = createGraph();
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(graph);
+  const DenseVectorValues zero = graph.zeroDenseVectorValues(indexer);
+  EXPECT(assert_equal(VectorValues::Zero(createValues()), zero.toVectorValues()));
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, multiplyHessianAdd) {
+  const GaussianFactorGraph graph = createGraph();
+  const VectorValues x = createValues();
+  const FastVector<Key> keys = list_of(L(1))(X(2))(X(1));
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(keys);
+  const KeyIndexer::FactorIndices factorIndices = indexer->indexFactors(graph);
+
+  VectorValues expected = VectorValues::Zero(x);
+  graph.multiplyHessianAdd(0.5, x, expected);
+
+  const DenseVectorValues xDense(indexer, x);
+  DenseVectorValues actual = DenseVectorValues::Zero(xDense);
+  graph.multiplyHessianAdd(0.5, xDense, actual, factorIndices);
+  EXPECT(assert_equal(expected, actual.toVectorValues()));
+}
+
+/* ************************************************************************* */
+TEST(DenseVectorValues, gradientAtZero) {
+  const GaussianFactorGraph graph = createGraph();
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(graph);
+  const KeyIndexer::FactorIndices factorIndices = indexer->indexFactors(graph);
+
+  DenseVectorValues actual = graph.zeroDenseVectorValues(indexer);
+  graph.gradientAtZero(actual, factorIndices);
+  EXPECT(assert_equal(graph.gradientAtZero(), actual.toVectorValues()));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -30,6 +30,8 @@ using namespace boost::assign;
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/inference/SupernodalStructure.h>
+#include <gtsam/inference/VariableIndex.h>
 
 using namespace std;
 using namespace gtsam;
@@ -285,6 +287,32 @@ TEST(GaussianBayesTree, ComputeSteepestDescentPointBT) {
 }
 
 
+/* ************************************************************************* */
+TEST(GaussianBayesTree, relaxedSupernodes)
+{
+  // A 6x6 grid of 2-dimensional variables with a prior on one corner
+  const size_t n = 6;
+  const SharedDiagonal gridNoise = noiseModel::Isotropic::Sigma(2, 0.5);
+  GaussianFactorGraph grid;
+  grid.add(0, eye(2), zero(2), noiseModel::Isotropic::Sigma(2, 0.1));
+  for(size_t r = 0; r < n; ++r) {
+    for(size_t c = 0; c < n; ++c) {
+      const Key j = r * n + c;
+      if(c + 1 < n) grid.add(j, -eye(2), j + 1, eye(2), (Vector(2) << 1.0, 0.0), gridNoise);
+      if(r + 1 < n) grid.add(j, -eye(2), j + n, eye(2), (Vector(2) << 0.0, 1.0), gridNoise);
+    }
+  }
+  const Ordering ordering = Ordering::COLAMD(grid);
+
+  // Fewer, larger cliques with explicit zeros give the same solution
+  SupernodalStructure structure(VariableIndex(grid), ordering, SupernodeParams(8, 32, 64, 0.9, 0.5, 0.2));
+  GaussianBayesTree expected = *grid.eliminateMultifrontal(ordering);
+  EXPECT(structure.nrSupernodes() < expected.size());
+  GaussianBayesTree actual = *GaussianJunctionTree(grid, structure).eliminate(EliminateCholesky).first;
+  LONGS_EQUAL(structure.nrSupernodes(), actual.size());
+  EXPECT(assert_equal(expected.optimize(), actual.optimize(), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -19,6 +19,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/TestableAssertions.h>
@@ -28,6 +29,7 @@
 #include <boost/assign/list_of.hpp>
 #include <boost/assign/std/vector.hpp>
 #include <boost/assign/std/map.hpp>
+#include <boost/ref.hpp>
 using namespace boost::assign;
 
 #include <vector>
@@ -474,6 +476,87 @@ TEST(HessianFactor, hessianDiagonal)
   EXPECT(assert_equal(G22,actualBD[1]));
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, assemblyPlan)
+{
+  GaussianFactorGraph gfg;
+  gfg.add(2, (Matrix(3,1) << 1.0, 2.0, 3.0), 0, (Matrix(3,2) << 1.0, 0.0, 0.0, 1.0, 1.0, 1.0),
+      (Vector(3) << 1.0, 2.0, 3.0), noiseModel::Isotropic::Sigma(3, 0.5));
+  gfg.push_back(HessianFactor(JacobianFactor(1, 2.0 * eye(3), ones(3))));
+  gfg.add(0, eye(2), 1, (Matrix(2,3) << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0), (Vector(2) << -1.0, 1.0));
+
+  // Ordered variables first, then the others in key order as with Scatter
+  Ordering ordering(list_of(1));
+  AssemblyPlan plan(gfg, ordering);
+  FastVector<Key> expectedKeys = list_of(1)(0)(2);
+  FastVector<DenseIndex> expectedDims = list_of(3)(2)(1)(1);
+  EXPECT(assert_container_equality(expectedKeys, plan.keys));
+  EXPECT(assert_container_equality(expectedDims, plan.dims));
+  LONGS_EQUAL(3, plan.slots.size());
+  FastVector<DenseIndex> expectedSlots0 = list_of(2)(1), expectedSlots1 = list_of(0), expectedSlots2 = list_of(1)(0);
+  EXPECT(assert_container_equality(expectedSlots0, plan.slots[0]));
+  EXPECT(assert_container_equality(expectedSlots1, plan.slots[1]));
+  EXPECT(assert_container_equality(expectedSlots2, plan.slots[2]));
+
+  // Assembling from the plan gives the factor assembled with a Scatter
+  Scatter scatter(gfg, ordering);
+  EXPECT(assert_equal(HessianFactor(gfg, scatter), HessianFactor(gfg, plan), 1e-9));
+  std::pair<GaussianConditional::shared_ptr, HessianFactor::shared_ptr> expected =
+    EliminateCholesky(gfg, ordering);
+  std::pair<GaussianConditional::shared_ptr, HessianFactor::shared_ptr> actual =
+    EliminateCholeskyWithPlan(gfg, ordering, plan);
+  EXPECT(assert_equal(*expected.first, *actual.first, 1e-9));
+  EXPECT(assert_equal(*expected.second, *actual.second, 1e-9));
+
+  // The plan matches graphs of the same structure only
+  GaussianFactorGraph sameStructure = gfg;
+  sameStructure.add(2, ones(1,1), ones(1));
+  EXPECT(!plan.matches(sameStructure));
+  sameStructure.resize(gfg.size());
+  EXPECT(plan.matches(sameStructure, ordering));
+  EXPECT(!plan.matches(gfg, Ordering(list_of(0))));
+  GaussianFactorGraph otherDimension = gfg;
+  otherDimension.replace(1, boost::make_shared<JacobianFactor>(1, eye(2), ones(2)));
+  EXPECT(!plan.matches(otherDimension));
+}
+
+/* ************************************************************************* */
+TEST(HessianFactor, assemblyPlanCache)
+{
+  // A chain with priors on both ends, linearized at two different points
+  const size_t n = 6;
+  GaussianFactorGraph first, second;
+  for(size_t j = 0; j + 1 < n; ++j) {
+    first.add(j, -eye(2), j + 1, eye(2), ones(2), noiseModel::Isotropic::Sigma(2, 0.1));
+    second.add(j, -1.5 * eye(2), j + 1, eye(2), 2.0 * ones(2), noiseModel::Isotropic::Sigma(2, 0.1));
+  }
+  first.add(0, eye(2), zero(2), noiseModel::Isotropic::Sigma(2, 0.01));
+  first.add(n - 1, eye(2), ones(2), noiseModel::Isotropic::Sigma(2, 0.5));
+  second.add(0, eye(2), ones(2), noiseModel::Isotropic::Sigma(2, 0.01));
+  second.add(n - 1, eye(2), zero(2), noiseModel::Isotropic::Sigma(2, 0.5));
+  const Ordering ordering = Ordering::COLAMD(first);
+
+  // Eliminating keeps one plan per clique, each giving the result of EliminateCholesky
+  AssemblyPlanCache cache;
+  GaussianBayesTree::shared_ptr actual = first.eliminateMultifrontal(ordering, boost::cref(cache));
+  EXPECT(assert_equal(*first.eliminateMultifrontal(ordering, EliminateCholesky), *actual, 1e-9));
+  LONGS_EQUAL(actual->size(), cache.size());
+  const Key rootFrontal = actual->roots().front()->conditional()->front();
+  AssemblyPlanCache::sharedPlan rootPlan = cache.plan(rootFrontal);
+  CHECK(rootPlan);
+
+  // The same structure at another linearization point reuses the plans
+  actual = second.eliminateMultifrontal(ordering, boost::cref(cache));
+  EXPECT(assert_equal(*second.eliminateMultifrontal(ordering, EliminateCholesky), *actual, 1e-9));
+  EXPECT(rootPlan == cache.plan(rootFrontal));
+
+  // A loop closure changes the structure, so the plans are made again
+  second.add(0, -eye(2), n - 1, eye(2), zero(2), noiseModel::Isotropic::Sigma(2, 0.1));
+  actual = second.eliminateMultifrontal(ordering, boost::cref(cache));
+  EXPECT(assert_equal(*second.eliminateMultifrontal(ordering, EliminateCholesky), *actual, 1e-9));
+  EXPECT(rootPlan != cache.plan(actual->roots().front()->conditional()->front()));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testKalmanFilterBatch.cpp
+ * @brief   Test a batch of linear Kalman filters against KalmanFilter
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/KalmanFilterBatch.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Constant velocity targets in the plane, state [x y vx vy], measured in position
+static const double dt = 0.1;
+static const Matrix F = (Matrix(4, 4) <<
+    1.0, 0.0, dt, 0.0,
+    0.0, 1.0, 0.0, dt,
+    0.0, 0.0, 1.0, 0.0,
+    0.0, 0.0, 0.0, 1.0);
+static const Matrix H = (Matrix(2, 4) <<
+    1.0, 0.0, 0.0, 0.0,
+    0.0, 1.0, 0.0, 0.0);
+static const SharedDiagonal modelQ = noiseModel::Diagonal::Sigmas((Vector(4) << 0.01, 0.01, 0.1, 0.1));
+static const SharedDiagonal modelR = noiseModel::Isotropic::Sigma(2, 0.05);
+static const SharedDiagonal P0 = noiseModel::Diagonal::Sigmas((Vector(4) << 1.0, 1.0, 2.0, 2.0));
+
+/* ************************************************************************* */
+TEST( KalmanFilterBatch, multiTarget ) {
+
+  // More filters than fit in one block, and not a multiple of a block
+  const size_t n = 2 * KalmanFilterBatch<4>::Lanes + 5;
+  KalmanFilterBatch<4> batch(n);
+  batch.init(Vector4::Zero(), P0);
+
+  KalmanFilter kf(4);
+  vector<KalmanFilter::State> expected(n);
+  for(size_t f = 0; f < n; ++f) {
+    const Vector4 x0(double(f), -0.5 * f, 1.0, 0.1 * f);
+    batch.init(f, x0, P0);
+    expected[f] = kf.init(x0, P0);
+  }
+
+  Matrix controls(4, n), Z(2, n);
+  for(size_t k = 1; k <= 5; ++k) {
+    for(size_t f = 0; f < n; ++f) {
+      controls.col(f) << 0.0, 0.0, 0.01 * f, -0.02;
+      Z.col(f) << double(f) + 0.1 * k + 0.01 * (f % 3), -0.5 * f + 0.01 * f * k;
+      expected[f] = kf.update(
+          kf.predict(expected[f], F, eye(4), controls.col(f), modelQ), H, Z.col(f), modelR);
+    }
+    batch.predict(F, controls, modelQ);
+    batch.update<2>(H, Z, modelR);
+  }
+
+  LONGS_EQUAL((long)KalmanFilter::step(expected[0]), (long)batch.step());
+  for(size_t f = 0; f < n; ++f) {
+    EXPECT(assert_equal(expected[f]->mean(), Vector(batch.mean(f)), 1e-9));
+    EXPECT(assert_equal(expected[f]->covariance(), Matrix(batch.covariance(f)), 1e-9));
+    EXPECT(assert_equal(expected[f]->information(), batch.state(f)->information(), 1e-6));
+  }
+}
+
+/* ************************************************************************* */
+TEST( KalmanFilterBatch, fullCovariance ) {
+
+  // Full process and measurement covariances, as KalmanFilter::predictQ and updateQ
+  const Matrix Q = (Matrix(4, 4) <<
+      0.02, 0.00, 0.01, 0.00,
+      0.00, 0.02, 0.00, 0.01,
+      0.01, 0.00, 0.10, 0.02,
+      0.00, 0.01, 0.02, 0.10);
+  const Matrix R = (Matrix(2, 2) << 0.01, 0.004, 0.004, 0.02);
+
+  KalmanFilter kf(4);
+  KalmanFilter::State expected = kf.init(Vector4(1.0, 2.0, 0.5, -0.5), P0);
+  KalmanFilterBatch<4> batch(3);
+  batch.init(Vector4::Zero(), P0);
+  batch.setState(1, expected);
+
+  expected = kf.predictQ(expected, F, zeros(4, 1), zero(1), Q);
+  batch.predict(F, noiseModel::Gaussian::Covariance(Q));
+  Matrix Z = zeros(2, 3);
+  Z.col(1) << 1.1, 1.9;
+  expected = kf.updateQ(expected, H, Z.col(1), R);
+  batch.update<2>(H, Z, noiseModel::Gaussian::Covariance(R));
+
+  EXPECT(assert_equal(expected->mean(), Vector(batch.mean(1)), 1e-9));
+  EXPECT(assert_equal(expected->covariance(), Matrix(batch.covariance(1)), 1e-9));
+
+  // Constrained noise models are not supported
+  CHECK_EXCEPTION(batch.update<2>(H, Z, noiseModel::Constrained::All(2)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
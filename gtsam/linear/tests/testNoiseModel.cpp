@@ -267,6 +267,65 @@ TEST(NoiseModel, QRNan )
   EXPECT(assert_equal(expectedAb,Ab));
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, QRMixed )
+{
+  // Hard constraints on the first columns: Householder finishes the soft rows
+  Matrix Ab1 = (Matrix(5, 5) <<
+      1., 0., 0., 0., 1.,
+      0., 1.,-1., 0., 2.,
+      2., 0., 1., 1., 0.5,
+      0., 0., 3., 0., 1.,
+      1., 1., 0., 2.,-1.);
+  SharedDiagonal actual1 = noiseModel::Constrained::MixedSigmas(
+      (Vector(5) << 0., 0., 0.5, 1., 0.2))->QR(Ab1);
+  Matrix expectedRd1 = (Matrix(4, 5) <<
+      1., 0., 0., 0., 1.,
+      0., 1.,-1., 0., 2.,
+      0., 0., 1., 1.421052632,-2.710526316,
+      0., 0., 0., 1.,-2.187258687);
+  SharedDiagonal expected1 = noiseModel::Constrained::MixedSigmas(
+      (Vector(4) << 0., 0., 0.162221421, 0.191519024));
+  EXPECT(assert_equal(*expected1, *actual1, 1e-6));
+  EXPECT(assert_equal(expectedRd1, Matrix(Ab1.topRows(4)), 1e-6));
+
+  // A hard constraint on a later column: Gram-Schmidt until it is used
+  Matrix Ab2 = (Matrix(5, 5) <<
+      2., 0., 1., 1., 0.5,
+      0., 0., 1., 0., 1.,
+      0., 0., 3., 0., 1.,
+      1., 1., 0., 2.,-1.,
+      0., 3., 0., 1., 2.);
+  SharedDiagonal actual2 = noiseModel::Constrained::MixedSigmas(
+      (Vector(5) << 0.5, 0., 1., 0.2, 0.1))->QR(Ab2);
+  Matrix expectedRd2 = (Matrix(4, 5) <<
+      1., 0.6097560976, 0.1951219512, 1.414634146,-0.512195122,
+      0., 1.,-0.005361930295, 0.345844504, 0.6461126005,
+      0., 0., 1., 0., 1.,
+      0., 0., 0., 1.,-1.214285714);
+  SharedDiagonal expected2 = noiseModel::Constrained::MixedSigmas(
+      (Vector(4) << 0.156173762, 0.0331541206, 0., 0.27590297));
+  EXPECT(assert_equal(*expected2, *actual2, 1e-6));
+  EXPECT(assert_equal(expectedRd2, Matrix(Ab2.topRows(4)), 1e-6));
+
+  // A column without information is skipped, as before
+  Matrix Ab3 = (Matrix(4, 5) <<
+      1., 0., 0., 0., 1.,
+      2., 0., 1., 0., 0.5,
+      0., 1., 3., 0., 1.,
+      1., 1., 0., 0.,-1.);
+  SharedDiagonal actual3 = noiseModel::Constrained::MixedSigmas(
+      (Vector(4) << 0., 0.5, 1., 0.2))->QR(Ab3);
+  Matrix expectedRd3 = (Matrix(3, 5) <<
+      1., 0., 0., 0., 1.,
+      0., 1., 0.1153846154, 0.,-1.884615385,
+      0., 0., 1., 0., 0.2097264438);
+  SharedDiagonal expected3 = noiseModel::Constrained::MixedSigmas(
+      (Vector(3) << 0., 0.196116135, 0.281118046));
+  EXPECT(assert_equal(*expected3, *actual3, 1e-6));
+  EXPECT(assert_equal(expectedRd3, Matrix(Ab3.topRows(3)), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST(NoiseModel, SmartSqrtInformation )
 {
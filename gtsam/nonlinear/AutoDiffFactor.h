@@ -0,0 +1,243 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    AutoDiffFactor.h
+ * @brief   NoiseModelFactors whose Jacobians are computed by automatic differentiation
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/geometry/AutoDiff.h>
+
+namespace gtsam {
+
+  namespace internal {
+
+    /** The value of a residual evaluated on Dual numbers */
+    template<int M, int N>
+    Vector DualValue(const Eigen::Matrix<autodiff::Dual<N>, M, 1>& e) {
+      Vector value(M);
+      for (int i = 0; i < M; ++i)
+        value(i) = e(i).a;
+      return value;
+    }
+
+    /** The derivatives of a residual evaluated on Dual numbers with respect to the D variables
+     *  from offset, written into H without reallocating it if it already has the right size */
+    template<int D, int M, int N>
+    void DualJacobian(const Eigen::Matrix<autodiff::Dual<N>, M, 1>& e, int offset, Matrix& H) {
+      H.resize(M, D);
+      for (int i = 0; i < M; ++i)
+        H.row(i) = e(i).v.template segment<D>(offset).transpose();
+    }
+
+  } // namespace internal
+
+  /* ************************************************************************* */
+  /**
+   * A NoiseModelFactor1 whose Jacobian is computed by forward-mode automatic differentiation,
+   * so that only the error function has to be written.  RESIDUAL is a functor with the
+   * measurement and other constants of the factor, which declares the error dimension and
+   * computes the unwhitened error as a function templated on the scalar type:
+   * \code
+   * struct PointPrior {
+   *   enum { dimension = 3 };
+   *   Point3 prior;
+   *   template<typename T>
+   *   Eigen::Matrix<T, 3, 1> operator()(const autodiff::Point3<T>& p) const {
+   *     return (p - autodiff::Point3<T>(prior)).vector();
+   *   }
+   * };
+   * AutoDiffFactor1<Point3, PointPrior> factor(model, key, PointPrior(...));
+   * \endcode
+   * The arguments are the counterparts of VALUE in gtsam/geometry/AutoDiff.h, with scalars double
+   * when the error is evaluated, and Dual numbers with one derivative per local coordinate of the
+   * variables when the Jacobians are requested.  Both are fixed-size, so the derivatives are
+   * computed without allocating memory.
+   */
+  template<class VALUE, class RESIDUAL>
+  class AutoDiffFactor1: public NoiseModelFactor1<VALUE> {
+
+  public:
+
+    typedef NoiseModelFactor1<VALUE> Base;
+    typedef AutoDiffFactor1<VALUE, RESIDUAL> This;
+    typedef boost::shared_ptr<This> shared_ptr;
+
+    enum { D1 = autodiff::Traits<VALUE>::dimension, M = RESIDUAL::dimension };
+
+  protected:
+
+    RESIDUAL residual_; ///< the error function and its constants
+
+  public:
+
+    /** Default constructor for I/O only */
+    AutoDiffFactor1() {}
+
+    /** Constructor from a noise model, the key of the variable, and the error function */
+    AutoDiffFactor1(const SharedNoiseModel& noiseModel, Key key1, const RESIDUAL& residual) :
+      Base(noiseModel, key1), residual_(residual) {}
+
+    virtual ~AutoDiffFactor1() {}
+
+    /// @return a deep copy of this factor
+    virtual NonlinearFactor::shared_ptr clone() const {
+      return boost::static_pointer_cast<NonlinearFactor>(NonlinearFactor::shared_ptr(new This(*this))); }
+
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
+    /** The error function */
+    const RESIDUAL& residual() const { return residual_; }
+
+    /** Evaluate the error, and its Jacobian by automatic differentiation if requested */
+    virtual Vector evaluateError(const VALUE& x1, boost::optional<Matrix&> H1 = boost::none) const {
+      typedef typename autodiff::Traits<VALUE>::template Type<double>::type Value1;
+      if (!H1)
+        return residual_(Value1(x1));
+      const Eigen::Matrix<autodiff::Dual<D1>, M, 1> e =
+        residual_(autodiff::Traits<VALUE>::template Lift<D1>(x1, 0));
+      internal::DualJacobian<D1>(e, 0, *H1);
+      return internal::DualValue(e);
+    }
+  };
+
+  /* ************************************************************************* */
+  /**
+   * A NoiseModelFactor2 whose Jacobians are computed by forward-mode automatic differentiation,
+   * see AutoDiffFactor1.  RESIDUAL::operator() takes the counterparts of VALUE1 and VALUE2, e.g.
+   * autodiff::Pose3<T> and autodiff::Point3<T> for a projection factor.
+   */
+  template<class VALUE1, class VALUE2, class RESIDUAL>
+  class AutoDiffFactor2: public NoiseModelFactor2<VALUE1, VALUE2> {
+
+  public:
+
+    typedef NoiseModelFactor2<VALUE1, VALUE2> Base;
+    typedef AutoDiffFactor2<VALUE1, VALUE2, RESIDUAL> This;
+    typedef boost::shared_ptr<This> shared_ptr;
+
+    enum {
+      D1 = autodiff::Traits<VALUE1>::dimension,
+      D2 = autodiff::Traits<VALUE2>::dimension,
+      M = RESIDUAL::dimension
+    };
+
+  protected:
+
+    RESIDUAL residual_; ///< the error function and its constants
+
+  public:
+
+    /** Default constructor for I/O only */
+    AutoDiffFactor2() {}
+
+    /** Constructor from a noise model, the keys of the variables, and the error function */
+    AutoDiffFactor2(const SharedNoiseModel& noiseModel, Key key1, Key key2, const RESIDUAL& residual) :
+      Base(noiseModel, key1, key2), residual_(residual) {}
+
+    virtual ~AutoDiffFactor2() {}
+
+    /// @return a deep copy of this factor
+    virtual NonlinearFactor::shared_ptr clone() const {
+      return boost::static_pointer_cast<NonlinearFactor>(NonlinearFactor::shared_ptr(new This(*this))); }
+
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
+    /** The error function */
+    const RESIDUAL& residual() const { return residual_; }
+
+    /** Evaluate the error, and its Jacobians by automatic differentiation if requested */
+    virtual Vector evaluateError(const VALUE1& x1, const VALUE2& x2,
+        boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 = boost::none) const {
+      typedef typename autodiff::Traits<VALUE1>::template Type<double>::type Value1;
+      typedef typename autodiff::Traits<VALUE2>::template Type<double>::type Value2;
+      if (!H1 && !H2)
+        return residual_(Value1(x1), Value2(x2));
+      const Eigen::Matrix<autodiff::Dual<D1 + D2>, M, 1> e =
+        residual_(autodiff::Traits<VALUE1>::template Lift<D1 + D2>(x1, 0),
+            autodiff::Traits<VALUE2>::template Lift<D1 + D2>(x2, D1));
+      if (H1) internal::DualJacobian<D1>(e, 0, *H1);
+      if (H2) internal::DualJacobian<D2>(e, D1, *H2);
+      return internal::DualValue(e);
+    }
+  };
+
+  /* ************************************************************************* */
+  /**
+   * A NoiseModelFactor3 whose Jacobians are computed by forward-mode automatic differentiation,
+   * see AutoDiffFactor1.
+   */
+  template<class VALUE1, class VALUE2, class VALUE3, class RESIDUAL>
+  class AutoDiffFactor3: public NoiseModelFactor3<VALUE1, VALUE2, VALUE3> {
+
+  public:
+
+    typedef NoiseModelFactor3<VALUE1, VALUE2, VALUE3> Base;
+    typedef AutoDiffFactor3<VALUE1, VALUE2, VALUE3, RESIDUAL> This;
+    typedef boost::shared_ptr<This> shared_ptr;
+
+    enum {
+      D1 = autodiff::Traits<VALUE1>::dimension,
+      D2 = autodiff::Traits<VALUE2>::dimension,
+      D3 = autodiff::Traits<VALUE3>::dimension,
+      M = RESIDUAL::dimension
+    };
+
+  protected:
+
+    RESIDUAL residual_; ///< the error function and its constants
+
+  public:
+
+    /** Default constructor for I/O only */
+    AutoDiffFactor3() {}
+
+    /** Constructor from a noise model, the keys of the variables, and the error function */
+    AutoDiffFactor3(const SharedNoiseModel& noiseModel, Key key1, Key key2, Key key3,
+        const RESIDUAL& residual) :
+      Base(noiseModel, key1, key2, key3), residual_(residual) {}
+
+    virtual ~AutoDiffFactor3() {}
+
+    /// @return a deep copy of this factor
+    virtual NonlinearFactor::shared_ptr clone() const {
+      return boost::static_pointer_cast<NonlinearFactor>(NonlinearFactor::shared_ptr(new This(*this))); }
+
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
+    /** The error function */
+    const RESIDUAL& residual() const { return residual_; }
+
+    /** Evaluate the error, and its Jacobians by automatic differentiation if requested */
+    virtual Vector evaluateError(const VALUE1& x1, const VALUE2& x2, const VALUE3& x3,
+        boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 = boost::none,
+        boost::optional<Matrix&> H3 = boost::none) const {
+      typedef typename autodiff::Traits<VALUE1>::template Type<double>::type Value1;
+      typedef typename autodiff::Traits<VALUE2>::template Type<double>::type Value2;
+      typedef typename autodiff::Traits<VALUE3>::template Type<double>::type Value3;
+      if (!H1 && !H2 && !H3)
+        return residual_(Value1(x1), Value2(x2), Value3(x3));
+      const Eigen::Matrix<autodiff::Dual<D1 + D2 + D3>, M, 1> e =
+        residual_(autodiff::Traits<VALUE1>::template Lift<D1 + D2 + D3>(x1, 0),
+            autodiff::Traits<VALUE2>::template Lift<D1 + D2 + D3>(x2, D1),
+            autodiff::Traits<VALUE3>::template Lift<D1 + D2 + D3>(x3, D1 + D2));
+      if (H1) internal::DualJacobian<D1>(e, 0, *H1);
+      if (H2) internal::DualJacobian<D2>(e, D1, *H2);
+      if (H3) internal::DualJacobian<D3>(e, D1 + D2, *H3);
+      return internal::DualValue(e);
+    }
+  };
+
+} // namespace gtsam
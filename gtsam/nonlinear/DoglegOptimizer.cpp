@@ -54,7 +54,7 @@ std::string DoglegParams::verbosityDLTranslator(VerbosityDL verbosityDL) const {
 void DoglegOptimizer::iterate(void) {
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_.values);
+  GaussianFactorGraph::shared_ptr linear = linearizeGraph(state_.values, params_);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -63,18 +63,18 @@ void DoglegOptimizer::iterate(void) {
   DoglegOptimizerImpl::IterationResult result;
 
   if ( params_.isMultifrontal() ) {
-    GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
+    GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, eliminationFunction(params_));
     VectorValues dx_u = bt.optimizeGradientSearch();
     VectorValues dx_n = bt.optimize();
     result = DoglegOptimizerImpl::Iterate(state_.Delta, DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bt, graph_, state_.values, state_.error, dlVerbose);
+      DoglegOptimizerImpl::CachedModel::FromBayesTree(bt, dx_u, dx_n), graph_, state_.values, state_.error, dlVerbose);
   }
   else if ( params_.isSequential() ) {
-    GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
+    GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, eliminationFunction(params_));
     VectorValues dx_u = bn.optimizeGradientSearch();
     VectorValues dx_n = bn.optimize();
     result = DoglegOptimizerImpl::Iterate(state_.Delta, DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bn, graph_, state_.values, state_.error, dlVerbose);
+      DoglegOptimizerImpl::CachedModel::FromBayesNet(bn, dx_u, dx_n), graph_, state_.values, state_.error, dlVerbose);
   }
   else if ( params_.isIterative() ) {
     throw runtime_error("Dogleg is not currently compatible with the linear conjugate gradient solver");
@@ -18,6 +18,13 @@
 #include <cmath>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 
+#include <boost/foreach.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -57,6 +64,18 @@ VectorValues DoglegOptimizerImpl::ComputeBlend(double Delta, const VectorValues&
   const double uu = dot(x_u, x_u);
   const double nn = dot(x_n, x_n);
 
+  // Compute blending parameter
+  const double tau = ComputeBlendFraction(Delta, uu, nn, un);
+
+  // Compute blended point
+  if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
+  VectorValues blend = (1. - tau) * x_u;  axpy(tau, x_n, blend);
+  return blend;
+}
+
+/* ************************************************************************* */
+double DoglegOptimizerImpl::ComputeBlendFraction(double Delta, double uu, double nn, double un) {
+
   // Compute quadratic formula terms
   const double a = uu - 2.*un + nn;
   const double b = 2. * (un - uu);
@@ -75,11 +94,117 @@ VectorValues DoglegOptimizerImpl::ComputeBlend(double Delta, const VectorValues&
     assert(0.0 <= tau2 && tau2 <= 1.0);
     tau = tau2;
   }
+  return tau;
+}
 
-  // Compute blended point
-  if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
-  VectorValues blend = (1. - tau) * x_u;  axpy(tau, x_n, blend);
-  return blend;
+/* ************************************************************************* */
+DoglegOptimizerImpl::CachedModel::Products::Products(const GaussianConditional& conditional,
+    const VectorValues& u, const VectorValues& dx_n)
+{
+  const Vector Au = conditional * u;
+  const Vector An = conditional * dx_n;
+  const Vector d = conditional.get_model() ?
+      conditional.get_model()->whiten(conditional.get_d()) : Vector(conditional.get_d());
+  AuAu = Au.squaredNorm();
+  AnAn = An.squaredNorm();
+  AuAn = Au.dot(An);
+  Aud = Au.dot(d);
+  And = An.dot(d);
+  dd = d.squaredNorm();
+}
+
+/* ************************************************************************* */
+namespace {
+#ifdef GTSAM_USE_TBB
+  struct _ModelProducts {
+    const vector<GaussianConditional::shared_ptr>& conditionals;
+    const VectorValues& dx_u;
+    const VectorValues& dx_n;
+    vector<DoglegOptimizerImpl::CachedModel::Products>& products;
+    _ModelProducts(const vector<GaussianConditional::shared_ptr>& conditionals,
+        const VectorValues& dx_u, const VectorValues& dx_n,
+        vector<DoglegOptimizerImpl::CachedModel::Products>& products) :
+        conditionals(conditionals), dx_u(dx_u), dx_n(dx_n), products(products) {}
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for(size_t i = r.begin(); i != r.end(); ++i)
+        products[i] = DoglegOptimizerImpl::CachedModel::Products(*conditionals[i], dx_u, dx_n);
+    }
+  };
+#endif
+}
+
+/* ************************************************************************* */
+DoglegOptimizerImpl::CachedModel::CachedModel(const vector<GaussianConditional::shared_ptr>& conditionals,
+    const VectorValues& dx_u, const VectorValues& dx_n) :
+    dx_u_(dx_u), dx_n_(dx_n)
+{
+  gttic(DoglegOptimizerImpl_CachedModel);
+  vector<Products> products(conditionals.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, conditionals.size()),
+    _ModelProducts(conditionals, dx_u, dx_n, products));
+#else
+  for(size_t i = 0; i < conditionals.size(); ++i)
+    products[i] = Products(*conditionals[i], dx_u, dx_n);
+#endif
+
+  // Summed in a fixed order, so that the result does not depend on the scheduling
+  Products sum;
+  BOOST_FOREACH(const Products& p, products)
+    sum += p;
+  init(sum, 1.0);
+}
+
+/* ************************************************************************* */
+DoglegOptimizerImpl::CachedModel::CachedModel(const Products& products, double step,
+    const VectorValues& dx_u, const VectorValues& dx_n) :
+    dx_u_(dx_u), dx_n_(dx_n)
+{
+  init(products, step);
+}
+
+/* ************************************************************************* */
+void DoglegOptimizerImpl::CachedModel::init(const Products& products, double step) {
+  uu_ = dot(dx_u_, dx_u_);
+  nn_ = dot(dx_n_, dx_n_);
+  un_ = dot(dx_u_, dx_n_);
+  // R dx_u = step * R u
+  AuAu_ = step*step * products.AuAu;
+  AnAn_ = products.AnAn;
+  AuAn_ = step * products.AuAn;
+  Aud_ = step * products.Aud;
+  And_ = products.And;
+  dd_ = products.dd;
+}
+
+/* ************************************************************************* */
+double DoglegOptimizerImpl::CachedModel::decrease(double a, double b) const {
+  // M(x) = 0.5 |R x - d|^2 with x = a dx_u + b dx_n, expanded and subtracted
+  // from M(0) = 0.5 |d|^2, which avoids cancellation for small steps
+  return a * Aud_ + b * And_ - 0.5 * (a*a * AuAu_ + b*b * AnAn_ + 2.0 * a*b * AuAn_);
+}
+
+/* ************************************************************************* */
+double DoglegOptimizerImpl::CachedModel::doglegPoint(double Delta, VectorValues& dx_d, const bool verbose) const {
+  // Same segments as ComputeDoglegPoint, from the cached norms
+  assert(Delta >= 0.0);
+  const double DeltaSq = Delta*Delta;
+  if(verbose) cout << "Steepest descent magnitude " << std::sqrt(uu_) << ", Newton's method magnitude " << std::sqrt(nn_) << endl;
+  if(DeltaSq < uu_) {
+    const double a = std::sqrt(DeltaSq / uu_);
+    if(verbose) cout << "In steepest descent region with fraction " << a << " of steepest descent magnitude" << endl;
+    dx_d = a * dx_u_;
+    return decrease(a, 0.0);
+  } else if(DeltaSq < nn_) {
+    const double tau = ComputeBlendFraction(Delta, uu_, nn_, un_);
+    if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
+    dx_d = (1. - tau) * dx_u_;  axpy(tau, dx_n_, dx_d);
+    return decrease(1. - tau, tau);
+  } else {
+    if(verbose) cout << "In pure Newton's method region" << endl;
+    dx_d = dx_n_;
+    return decrease(0.0, 1.0);
+  }
 }
 
 }
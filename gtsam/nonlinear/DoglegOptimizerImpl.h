@@ -17,8 +17,10 @@
 #pragma once
 
 #include <iomanip>
+#include <vector>
 
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/inference/Ordering.h>
 
 namespace gtsam {
@@ -96,6 +98,103 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
       double Delta, TrustRegionAdaptationMode mode, const VectorValues& dx_u, const VectorValues& dx_n,
       const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose=false);
 
+  /**
+   * The quadratic model \f$ M(\delta x) \f$ restricted to the dogleg path,
+   * precomputed so that the retries of Iterate() after changing the trust
+   * region radius neither recompute the norms of the steepest descent and
+   * Newton's method points nor evaluate \f$ M \f$ on the whole Bayes' net or
+   * tree.  Every dogleg point is \f$ a\delta x_u + b\delta x_n \f$, so
+   * \f$ M \f$ at any of them follows from the inner products of
+   * \f$ R\delta x_u \f$, \f$ R\delta x_n \f$ and \f$ d \f$, which are
+   * computed once per conditional, in parallel if TBB is enabled.
+   */
+  class GTSAM_EXPORT CachedModel {
+  public:
+    /** Inner products of \f$ R u \f$, \f$ R\delta x_n \f$ and \f$ d \f$, whitened, of
+     * one conditional or summed over several, for a direction \f$ u \f$ of which
+     * the steepest descent point is a multiple.  With \f$ u \f$ the gradient, they
+     * can be kept per clique and summed again after an incremental update. */
+    struct GTSAM_EXPORT Products {
+      double AuAu, AnAn, AuAn, Aud, And, dd;
+
+      /** Zero, to sum products into */
+      Products() : AuAu(0.0), AnAn(0.0), AuAn(0.0), Aud(0.0), And(0.0), dd(0.0) {}
+
+      /** The products of one conditional */
+      Products(const GaussianConditional& conditional, const VectorValues& u, const VectorValues& dx_n);
+
+      /** Add the products of other conditionals */
+      Products& operator+=(const Products& other) {
+        AuAu += other.AuAu; AnAn += other.AnAn; AuAn += other.AuAn;
+        Aud += other.Aud; And += other.And; dd += other.dd;
+        return *this;
+      }
+    };
+
+  private:
+    VectorValues dx_u_, dx_n_;
+    double uu_, nn_, un_;                  ///< Inner products of dx_u and dx_n
+    double AuAu_, AnAn_, AuAn_, Aud_, And_, dd_; ///< Inner products of R dx_u, R dx_n and d, whitened
+
+    void init(const Products& products, double step);
+
+  public:
+    /** Precompute the model from the conditionals of a Bayes' net or tree, and
+     * the steepest descent and Newton's method points */
+    CachedModel(const std::vector<GaussianConditional::shared_ptr>& conditionals,
+        const VectorValues& dx_u, const VectorValues& dx_n);
+
+    /** The model from the products summed over all conditionals for a direction
+     * \f$ u \f$, where the steepest descent point is dx_u = step * u */
+    CachedModel(const Products& products, double step,
+        const VectorValues& dx_u, const VectorValues& dx_n);
+
+    /** Precompute the model from a Bayes' net, BayesNet<GaussianConditional> or GaussianBayesNet */
+    template<class BAYESNET>
+    static CachedModel FromBayesNet(const BAYESNET& bayesNet, const VectorValues& dx_u, const VectorValues& dx_n) {
+      return CachedModel(std::vector<GaussianConditional::shared_ptr>(bayesNet.begin(), bayesNet.end()), dx_u, dx_n);
+    }
+
+    /** Precompute the model from a Bayes' tree with GaussianConditional s, such as
+     * GaussianBayesTree or ISAM2 */
+    template<class BAYESTREE>
+    static CachedModel FromBayesTree(const BAYESTREE& bayesTree, const VectorValues& dx_u, const VectorValues& dx_n) {
+      std::vector<GaussianConditional::shared_ptr> conditionals;
+      std::vector<typename BAYESTREE::sharedClique> stack(bayesTree.roots().begin(), bayesTree.roots().end());
+      while(!stack.empty()) {
+        const typename BAYESTREE::sharedClique clique = stack.back();
+        stack.pop_back();
+        conditionals.push_back(clique->conditional());
+        stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+      }
+      return CachedModel(conditionals, dx_u, dx_n);
+    }
+
+    const VectorValues& dx_u() const { return dx_u_; } ///< The steepest descent point
+    const VectorValues& dx_n() const { return dx_n_; } ///< The Newton's method point
+
+    /** The error of the model at zero */
+    double errorAtZero() const { return 0.5 * dd_; }
+
+    /** The decrease of the model from zero to \f$ a\delta x_u + b\delta x_n \f$ */
+    double decrease(double a, double b) const;
+
+    /** The dogleg point for the trust region radius Delta, as ComputeDoglegPoint(),
+     * returning the decrease of the model from zero to it */
+    double doglegPoint(double Delta, VectorValues& dx_d, const bool verbose=false) const;
+  };
+
+  /**
+   * As Iterate() above, with the quadratic approximation precomputed in a
+   * CachedModel, which also holds the steepest descent and Newton's method
+   * points.  Each change of the trust region radius costs a blend of the two
+   * points and an evaluation of \f$ f \f$, but no pass over the Bayes' net or tree.
+   */
+  template<class F, class VALUES>
+  static IterationResult Iterate(
+      double Delta, TrustRegionAdaptationMode mode, const CachedModel& model,
+      const F& f, const VALUES& x0, const double f_error, const bool verbose=false);
+
   /**
    * Compute the dogleg point given a trust region radius \f$ \Delta \f$.  The
    * dogleg point is the intersection between the dogleg path and the trust
@@ -130,6 +229,34 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double Delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+  /** The blending parameter \f$ \tau \f$ of ComputeBlend(), from the inner
+   * products \f$ \delta x_u^T\delta x_u \f$, \f$ \delta x_n^T\delta x_n \f$
+   * and \f$ \delta x_u^T\delta x_n \f$ */
+  static double ComputeBlendFraction(double Delta, double uu, double nn, double un);
+
+private:
+  /** The model of Iterate() evaluated directly on the Bayes' net or tree */
+  template<class M>
+  struct DirectModel {
+    const VectorValues& dx_u;
+    const VectorValues& dx_n;
+    const M& Rd;
+    const double zeroError;
+    DirectModel(const VectorValues& dx_u, const VectorValues& dx_n, const M& Rd) :
+      dx_u(dx_u), dx_n(dx_n), Rd(Rd), zeroError(Rd.error(VectorValues::Zero(dx_u))) {}
+    double errorAtZero() const { return zeroError; }
+    double doglegPoint(double Delta, VectorValues& dx_d, const bool verbose) const {
+      dx_d = ComputeDoglegPoint(Delta, dx_u, dx_n, verbose);
+      return zeroError - Rd.error(dx_d);
+    }
+  };
+
+  /** The loop of Iterate(), for either model */
+  template<class MODEL, class F, class VALUES>
+  static IterationResult IterateModel(
+      double Delta, TrustRegionAdaptationMode mode, const MODEL& model,
+      const F& f, const VALUES& x0, const double f_error, const bool verbose);
 };
 
 
@@ -138,9 +265,27 @@ template<class M, class F, class VALUES>
 typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
     double Delta, TrustRegionAdaptationMode mode, const VectorValues& dx_u, const VectorValues& dx_n,
     const M& Rd, const F& f, const VALUES& x0, const double f_error, const bool verbose)
+{
+  return IterateModel(Delta, mode, DirectModel<M>(dx_u, dx_n, Rd), f, x0, f_error, verbose);
+}
+
+/* ************************************************************************* */
+template<class F, class VALUES>
+typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
+    double Delta, TrustRegionAdaptationMode mode, const CachedModel& model,
+    const F& f, const VALUES& x0, const double f_error, const bool verbose)
+{
+  return IterateModel(Delta, mode, model, f, x0, f_error, verbose);
+}
+
+/* ************************************************************************* */
+template<class MODEL, class F, class VALUES>
+typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::IterateModel(
+    double Delta, TrustRegionAdaptationMode mode, const MODEL& model,
+    const F& f, const VALUES& x0, const double f_error, const bool verbose)
 {
   gttic(M_error);
-  const double M_error = Rd.error(VectorValues::Zero(dx_u));
+  const double M_error = model.errorAtZero();
   gttoc(M_error);
 
   // Result to return
@@ -150,8 +295,8 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   enum { NONE, INCREASED_DELTA, DECREASED_DELTA } lastAction = NONE; // Used to prevent alternating between increasing and decreasing in one iteration
   while(stay) {
     gttic(Dog_leg_point);
-    // Compute dog leg point
-    result.dx_d = ComputeDoglegPoint(Delta, dx_u, dx_n, verbose);
+    // Compute dog leg point and decrease in M
+    const double M_decrease = model.doglegPoint(Delta, result.dx_d, verbose);
     gttoc(Dog_leg_point);
 
     if(verbose) std::cout << "Delta = " << Delta << ", dx_d_norm = " << result.dx_d.norm() << std::endl;
@@ -166,20 +311,15 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
     result.f_error = f.error(x_d);
     gttoc(decrease_in_f);
 
-    gttic(new_M_error);
-    // Compute decrease in M
-    const double new_M_error = Rd.error(result.dx_d);
-    gttoc(new_M_error);
-
     if(verbose) std::cout << std::setprecision(15) << "f error: " << f_error << " -> " << result.f_error << std::endl;
-    if(verbose) std::cout << std::setprecision(15) << "M error: " << M_error << " -> " << new_M_error << std::endl;
+    if(verbose) std::cout << std::setprecision(15) << "M error: " << M_error << " -> " << M_error - M_decrease << std::endl;
 
     gttic(adjust_Delta);
     // Compute gain ratio.  Here we take advantage of the invariant that the
     // Bayes' net error at zero is equal to the nonlinear error
-    const double rho = fabs(f_error - result.f_error) < 1e-15 || fabs(M_error - new_M_error) < 1e-15 ?
+    const double rho = fabs(f_error - result.f_error) < 1e-15 || fabs(M_decrease) < 1e-15 ?
         0.5 :
-        (f_error - result.f_error) / (M_error - new_M_error);
+        (f_error - result.f_error) / M_decrease;
 
     if(verbose) std::cout << std::setprecision(15) << "rho = " << rho << std::endl;
 
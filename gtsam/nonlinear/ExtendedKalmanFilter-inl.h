@@ -59,14 +59,50 @@ namespace gtsam {
     return x;
   }
 
+  /* ************************************************************************* */
+  template<class VALUE>
+  void ExtendedKalmanFilter<VALUE>::rotate_(Matrix& system, DenseIndex j,
+      DenseIndex pivot, DenseIndex first, DenseIndex last)
+  {
+    const DenseIndex columns = system.cols() - j;
+    for(DenseIndex i = first; i < last; ++i) {
+      if(system(i, j) == 0.0)
+        continue;
+      Eigen::JacobiRotation<double> G;
+      G.makeGivens(system(pivot, j), system(i, j));
+      system.rightCols(columns).applyOnTheLeft(pivot, i, G.adjoint());
+      system(i, j) = 0.0;
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  typename ExtendedKalmanFilter<VALUE>::T ExtendedKalmanFilter<VALUE>::solveSquareRoot_(
+      const Matrix& system, DenseIndex offset)
+  {
+    // With R and d of the new density in rows and columns offset to offset + n,
+    // the mean moves by R^-1 d, and relative to the mean d is zero
+    const DenseIndex n = R_.rows();
+    R_ = system.block(offset, offset, n, n).template triangularView<Eigen::Upper>();
+    delta_ = system.block(offset, system.cols() - 1, n, 1);
+    R_.template triangularView<Eigen::Upper>().solveInPlace(delta_);
+    x_ = x_.retract(delta_);
+    return x_;
+  }
+
   /* ************************************************************************* */
   template<class VALUE>
   ExtendedKalmanFilter<VALUE>::ExtendedKalmanFilter(Key key_initial, T x_initial,
-      noiseModel::Gaussian::shared_ptr P_initial) {
+      noiseModel::Gaussian::shared_ptr P_initial, Mode mode) : mode_(mode) {
 
     // Set the initial linearization point to the provided mean
     x_ = x_initial;
 
+    if(mode_ == SQUARE_ROOT) {
+      R_ = P_initial->R();
+      return;
+    }
+
     // Create a Jacobian Prior Factor directly P_initial.
     // Since x0 is set to the provided mean, the b vector in the prior will be zero
     // TODO Frank asks: is there a reason why noiseModel is not simply P_initial ?
@@ -84,6 +120,31 @@ namespace gtsam {
     // Calling predict() then update() with drastically
     // different keys will still compute as if a common key-set was used
 
+    if(mode_ == SQUARE_ROOT) {
+      // Whitened Jacobians of the motion model at x_, with b = -error
+      if(boost::dynamic_pointer_cast<noiseModel::Constrained>(motionFactor.get_noiseModel()))
+        throw std::invalid_argument("ExtendedKalmanFilter: constrained noise models need the FACTOR_GRAPH mode");
+      b_ = -motionFactor.evaluateError(x_, x_, H1_, H2_);
+      motionFactor.get_noiseModel()->WhitenSystem(H1_, H2_, b_);
+      const DenseIndex n = R_.rows(), m = b_.size();
+      if(m < n)
+        throw std::invalid_argument("ExtendedKalmanFilter: the motion model has fewer rows than the state dimension");
+
+      // Stack [R 0 0; H1 H2 b], eliminate x_t, and triangularize what remains on x_{t+1}
+      if(predictSystem_.rows() != n + m || predictSystem_.cols() != 2 * n + 1)
+        predictSystem_.resize(n + m, 2 * n + 1);
+      predictSystem_.setZero();
+      predictSystem_.topLeftCorner(n, n) = R_;
+      predictSystem_.block(n, 0, m, n) = H1_;
+      predictSystem_.block(n, n, m, n) = H2_;
+      predictSystem_.block(n, 2 * n, m, 1) = b_;
+      for(DenseIndex j = 0; j < n; ++j)
+        rotate_(predictSystem_, j, j, n, n + m);
+      for(DenseIndex j = n; j < 2 * n; ++j)
+        rotate_(predictSystem_, j, j, j + 1, n + m);
+      return solveSquareRoot_(predictSystem_, n);
+    }
+
     // Create Keys
     Key x0 = motionFactor.key1();
     Key x1 = motionFactor.key2();
@@ -119,6 +180,26 @@ namespace gtsam {
     // Calling predict() then update() with drastically
     // different keys will still compute as if a common key-set was used
 
+    if(mode_ == SQUARE_ROOT) {
+      // Whitened Jacobian of the measurement model at x_, with b = -error
+      if(boost::dynamic_pointer_cast<noiseModel::Constrained>(measurementFactor.get_noiseModel()))
+        throw std::invalid_argument("ExtendedKalmanFilter: constrained noise models need the FACTOR_GRAPH mode");
+      b_ = -measurementFactor.evaluateError(x_, H1_);
+      measurementFactor.get_noiseModel()->WhitenSystem(H1_, b_);
+      const DenseIndex n = R_.rows(), m = b_.size();
+
+      // Stack [R 0; H b] and rotate the measurement rows into R
+      if(updateSystem_.rows() != n + m || updateSystem_.cols() != n + 1)
+        updateSystem_.resize(n + m, n + 1);
+      updateSystem_.setZero();
+      updateSystem_.topLeftCorner(n, n) = R_;
+      updateSystem_.block(n, 0, m, n) = H1_;
+      updateSystem_.block(n, n, m, 1) = b_;
+      for(DenseIndex j = 0; j < n; ++j)
+        rotate_(updateSystem_, j, j, n, n + m);
+      return solveSquareRoot_(updateSystem_, 0);
+    }
+
     // Create Keys
     Key x0 = measurementFactor.key();
 
@@ -37,6 +37,12 @@ namespace gtsam {
    *
    * The class provides a "predict" and "update" function to perform these steps independently.
    * TODO: a "predictAndUpdate" that combines both steps for some computational savings.
+   *
+   * In the SQUARE_ROOT mode, the density is kept as a square-root information matrix R, of
+   * the dimension of the state, which predict and update rotate in place with the whitened
+   * Jacobians of the factor, without building factor graphs or eliminating them.  The
+   * Jacobians then come from evaluateError and the noise model of the factor, which may not
+   * be constrained, rather than from linearize.
    * \nosubgrouping
    */
 
@@ -49,21 +55,38 @@ namespace gtsam {
     typedef NoiseModelFactor2<VALUE, VALUE> MotionFactor;
     typedef NoiseModelFactor1<VALUE> MeasurementFactor;
 
+    /// How predict and update compute the new density
+    enum Mode {
+      FACTOR_GRAPH, ///< Eliminate a small factor graph in every step
+      SQUARE_ROOT   ///< Rotate a square-root information matrix in place
+    };
+
   protected:
     T x_; // linearization point
-    JacobianFactor::shared_ptr priorFactor_; // density
+    JacobianFactor::shared_ptr priorFactor_; // density, in FACTOR_GRAPH mode
+    Mode mode_;
+    Matrix R_; // square-root information matrix of the density at x_, in SQUARE_ROOT mode
+    Matrix predictSystem_, updateSystem_; // Stacked density and whitened factor, kept between steps
+    Matrix H1_, H2_; // Jacobians of the last factor
+    Vector b_, delta_;
 
     T solve_(const GaussianFactorGraph& linearFactorGraph,
         const Values& linearizationPoints,
         Key x, JacobianFactor::shared_ptr& newPrior) const;
 
+    /// Zero column j of rows [first, last) of the stacked system with Givens rotations against row pivot
+    static void rotate_(Matrix& system, DenseIndex j, DenseIndex pivot, DenseIndex first, DenseIndex last);
+
+    /// Move to the mean of the density R, d in the given block of the stacked system, and keep R
+    T solveSquareRoot_(const Matrix& system, DenseIndex offset);
+
   public:
 
     /// @name Standard Constructors
     /// @{
 
     ExtendedKalmanFilter(Key key_initial, T x_initial,
-        noiseModel::Gaussian::shared_ptr P_initial);
+        noiseModel::Gaussian::shared_ptr P_initial, Mode mode = FACTOR_GRAPH);
 
     /// @}
     /// @name Testable
@@ -73,7 +96,22 @@ namespace gtsam {
     void print(const std::string& s="") const {
       std::cout << s << "\n";
       x_.print(s+"x");
-      priorFactor_->print(s+"density");
+      if(mode_ == SQUARE_ROOT)
+        gtsam::print(R_, s+"density R");
+      else
+        priorFactor_->print(s+"density");
+    }
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// The mode given to the constructor
+    Mode mode() const { return mode_; }
+
+    /// Square-root information matrix R of the current density \f$ |R (x \ominus \hat{x})|^2 \f$, up to rotation
+    Matrix sqrtInformation() const {
+      return mode_ == SQUARE_ROOT ? R_ : priorFactor_->jacobian().first;
     }
 
     /// @}
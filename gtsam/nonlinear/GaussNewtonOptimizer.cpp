@@ -30,7 +30,7 @@ void GaussNewtonOptimizer::iterate() {
   const NonlinearOptimizerState& current = state_;
 
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(current.values);
+  GaussianFactorGraph::shared_ptr linear = linearizeGraph(current.values, params_);
 
   // Solve Factor Graph
   const VectorValues delta = solve(*linear, current.values, params_);
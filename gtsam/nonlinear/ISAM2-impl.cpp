@@ -203,9 +203,12 @@ FastSet<Key> ISAM2::Impl::CheckRelinearizationPartial(const FastVector<ISAM2::sh
 void ISAM2::Impl::FindAll(ISAM2Clique::shared_ptr clique, FastSet<Key>& keys, const FastSet<Key>& markedMask)
 {
   static const bool debug = false;
-  // does the separator contain any of the variables?
+  // does the separator contain any of the variables?  Only the keys are
+  // needed, so spilled cliques are not read back.
+  const FastVector<Key>& cliqueKeys = clique->conditionalKeys();
+  const size_t nrFrontals = clique->nrConditionalFrontals();
   bool found = false;
-  BOOST_FOREACH(Key key, clique->conditional()->parents()) {
+  BOOST_FOREACH(Key key, std::make_pair(cliqueKeys.begin() + nrFrontals, cliqueKeys.end())) {
     if (markedMask.exists(key)) {
       found = true;
       break;
@@ -213,9 +216,9 @@ void ISAM2::Impl::FindAll(ISAM2Clique::shared_ptr clique, FastSet<Key>& keys, co
   }
   if (found) {
     // then add this clique
-    keys.insert(clique->conditional()->beginFrontals(), clique->conditional()->endFrontals());
+    keys.insert(cliqueKeys.begin(), cliqueKeys.begin() + nrFrontals);
     if(debug) clique->print("Key(s) marked in clique ");
-    if(debug) cout << "so marking key " << clique->conditional()->front() << endl;
+    if(debug) cout << "so marking key " << cliqueKeys.front() << endl;
   }
   BOOST_FOREACH(const ISAM2Clique::shared_ptr& child, clique->children) {
     FindAll(child, keys, markedMask);
@@ -272,7 +275,8 @@ inline static void optimizeInPlace(const boost::shared_ptr<ISAM2Clique>& clique,
 
 /* ************************************************************************* */
 size_t ISAM2::Impl::UpdateGaussNewtonDelta(const FastVector<ISAM2::sharedClique>& roots,
-    const FastSet<Key>& replacedKeys, VectorValues& delta, double wildfireThreshold) {
+    const FastSet<Key>& replacedKeys, VectorValues& delta, double wildfireThreshold,
+    boost::optional<FastSet<Key>&> changedKeys) {
 
   size_t lastBacksubVariableCount;
 
@@ -281,13 +285,20 @@ size_t ISAM2::Impl::UpdateGaussNewtonDelta(const FastVector<ISAM2::sharedClique>
     BOOST_FOREACH(const ISAM2::sharedClique& root, roots)
       internal::optimizeInPlace(root, delta);
     lastBacksubVariableCount = delta.size();
+    if(changedKeys) {
+      BOOST_FOREACH(const VectorValues::KeyValuePair& key_delta, delta)
+        changedKeys->insert(key_delta.first);
+    }
 
   } else {
     // Optimize with wildfire
     lastBacksubVariableCount = 0;
+    FastSet<Key> changed;
     BOOST_FOREACH(const ISAM2::sharedClique& root, roots)
       lastBacksubVariableCount += optimizeWildfireNonRecursive(
-      root, wildfireThreshold, replacedKeys, delta); // modifies delta
+      root, wildfireThreshold, replacedKeys, delta, changed); // modifies delta
+    if(changedKeys)
+      changedKeys->insert(changed.begin(), changed.end());
 
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
     for(size_t j=0; j<delta.size(); ++j)
@@ -305,9 +316,10 @@ void updateRgProd(const boost::shared_ptr<ISAM2Clique>& clique, const FastSet<Ke
 
   // Check if any frontal or separator keys were recalculated, if so, we need
   // update deltas and recurse to children, but if not, we do not need to
-  // recurse further because of the running separator property.
+  // recurse further because of the running separator property.  Only the keys
+  // are needed for this check, so spilled cliques are not read back.
   bool anyReplaced = false;
-  BOOST_FOREACH(Key j, *clique->conditional()) {
+  BOOST_FOREACH(Key j, clique->conditionalKeys()) {
     if(replacedKeys.exists(j)) {
       anyReplaced = true;
       break;
@@ -359,16 +371,66 @@ size_t ISAM2::Impl::UpdateRgProd(const ISAM2::Roots& roots, const FastSet<Key>&
 /* ************************************************************************* */
 VectorValues ISAM2::Impl::ComputeGradientSearch(const VectorValues& gradAtZero,
                                      const VectorValues& RgProd)
+{
+  // Compute steepest descent point
+  return GradientSearchStep(gradAtZero, RgProd) * gradAtZero;
+}
+
+/* ************************************************************************* */
+double ISAM2::Impl::GradientSearchStep(const VectorValues& gradAtZero, const VectorValues& RgProd)
 {
   // Compute gradient squared-magnitude
   const double gradientSqNorm = gradAtZero.dot(gradAtZero);
-  
+
   // Compute minimizing step size
   double RgNormSq = RgProd.vector().squaredNorm();
-  double step = -gradientSqNorm / RgNormSq;
+  return -gradientSqNorm / RgNormSq;
+}
 
-  // Compute steepest descent point
-  return step * gradAtZero;
+/* ************************************************************************* */
+namespace internal {
+const DoglegOptimizerImpl::CachedModel::Products& updateDoglegProducts(
+    const boost::shared_ptr<ISAM2Clique>& clique, const FastSet<Key>& changedKeys,
+    const VectorValues& grad, const VectorValues& deltaNewton) {
+
+  // The cliques involving a variable are connected through the one where it is
+  // frontal, and the wildfire only changes the Newton's method step below
+  // cliques where it changed, so a clique involving none of the changed keys
+  // has none below it either, and the sum over its subtree is still valid.
+  // Only the keys are needed for this check, so spilled cliques are not read back.
+  bool anyChanged = false;
+  BOOST_FOREACH(Key j, clique->conditionalKeys()) {
+    if(changedKeys.exists(j)) {
+      anyChanged = true;
+      break;
+    }
+  }
+
+  if(anyChanged || !clique->doglegProductsValid_) {
+    clique->doglegProducts_ = DoglegOptimizerImpl::CachedModel::Products(*clique->conditional(), grad, deltaNewton);
+    clique->doglegProductsValid_ = true;
+  }
+
+  if(anyChanged || !clique->doglegSubtreeValid_) {
+    clique->doglegSubtree_ = clique->doglegProducts_;
+    BOOST_FOREACH(const ISAM2Clique::shared_ptr& child, clique->children) {
+      clique->doglegSubtree_ += updateDoglegProducts(child, changedKeys, grad, deltaNewton); }
+    clique->doglegSubtreeValid_ = true;
+  }
+
+  return clique->doglegSubtree_;
+}
+}
+
+/* ************************************************************************* */
+DoglegOptimizerImpl::CachedModel::Products ISAM2::Impl::UpdateDoglegProducts(const ISAM2::Roots& roots,
+    const FastSet<Key>& changedKeys, const VectorValues& gradAtZero, const VectorValues& deltaNewton)
+{
+  DoglegOptimizerImpl::CachedModel::Products products;
+  BOOST_FOREACH(const ISAM2::sharedClique& root, roots) {
+    products += internal::updateDoglegProducts(root, changedKeys, gradAtZero, deltaNewton);
+  }
+  return products;
 }
 
 }
@@ -125,9 +125,11 @@ struct GTSAM_EXPORT ISAM2::Impl {
 
   /**
    * Update the Newton's method step point, using wildfire
+   * @param changedKeys If given, receives the variables whose delta may have changed
    */
   static size_t UpdateGaussNewtonDelta(const FastVector<ISAM2::sharedClique>& roots,
-      const FastSet<Key>& replacedKeys, VectorValues& delta, double wildfireThreshold);
+      const FastSet<Key>& replacedKeys, VectorValues& delta, double wildfireThreshold,
+      boost::optional<FastSet<Key>&> changedKeys = boost::none);
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -142,6 +144,20 @@ struct GTSAM_EXPORT ISAM2::Impl {
   static VectorValues ComputeGradientSearch(const VectorValues& gradAtZero,
                                             const VectorValues& RgProd);
 
+  /**
+   * Compute the step size along the gradient to the gradient-search point.  Only used in Dogleg.
+   */
+  static double GradientSearchStep(const VectorValues& gradAtZero, const VectorValues& RgProd);
+
+  /**
+   * Update the products of the Dogleg model with the gradient kept in each
+   * clique, recomputing them only in the cliques involving \c changedKeys,
+   * whose gradient or Newton's method step changed, and return their sum.
+   * Only used in Dogleg.
+   */
+  static DoglegOptimizerImpl::CachedModel::Products UpdateDoglegProducts(const ISAM2::Roots& roots,
+      const FastSet<Key>& changedKeys, const VectorValues& gradAtZero, const VectorValues& deltaNewton);
+
 };
 
 }
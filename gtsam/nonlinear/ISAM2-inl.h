@@ -259,6 +259,14 @@ template<class CLIQUE>
 size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root, double threshold, const FastSet<Key>& keys, VectorValues& delta)
 {
   FastSet<Key> changed;
+  return optimizeWildfireNonRecursive(root, threshold, keys, delta, changed);
+}
+
+/* ************************************************************************* */
+template<class CLIQUE>
+size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root, double threshold, const FastSet<Key>& keys,
+    VectorValues& delta, FastSet<Key>& changed)
+{
   size_t count = 0;
 
   if (root) {
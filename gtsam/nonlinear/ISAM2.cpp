@@ -21,6 +21,8 @@ using namespace boost::assign;
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/chrono.hpp>
+#include <boost/ref.hpp>
 namespace br { using namespace boost::range; using namespace boost::adaptors; }
 
 #include <gtsam/base/timing.h>
@@ -123,6 +125,10 @@ void ISAM2Clique::setEliminationResult(const FactorGraphType::EliminationResult&
 {
   conditional_ = eliminationResult.first;
   cachedFactor_ = eliminationResult.second;
+  page_.reset();
+  spilled_.store(false);
+  doglegProductsValid_ = false;
+  doglegSubtreeValid_ = false;
   // Compute gradient contribution
   gradientContribution_.resize(conditional_->cols() - 1);
   // Rewrite -(R * P')'*d   as   -(d' * R * P')'   for computational speed reasons
@@ -130,8 +136,21 @@ void ISAM2Clique::setEliminationResult(const FactorGraphType::EliminationResult&
     -conditional_->get_S().transpose() * conditional_->get_d();
 }
 
+/* ************************************************************************* */
+void ISAM2Clique::peek(sharedConditional& conditional, Base::FactorType::shared_ptr& cachedFactor) const
+{
+  if(store_) {
+    store_->peek(*this, conditional, cachedFactor);
+  } else {
+    conditional = conditional_;
+    cachedFactor = cachedFactor_;
+  }
+}
+
 /* ************************************************************************* */
 bool ISAM2Clique::equals(const This& other, double tol) const {
+  ensureResident();
+  other.ensureResident();
   return Base::equals(other) &&
     ((!cachedFactor_ && !other.cachedFactor_)
     || (cachedFactor_ && other.cachedFactor_
@@ -142,6 +161,7 @@ bool ISAM2Clique::equals(const This& other, double tol) const {
 void ISAM2Clique::print(const std::string& s, const KeyFormatter& formatter) const
 {
   Base::print(s,formatter);
+  ensureResident();
   if(cachedFactor_)
     cachedFactor_->print(s + "Cached: ", formatter);
   else
@@ -150,10 +170,50 @@ void ISAM2Clique::print(const std::string& s, const KeyFormatter& formatter) con
     gtsam::print(gradientContribution_, "Gradient contribution: ");
 }
 
+/* ************************************************************************* */
+void ISAM2CheckpointJournal::markRemoved(const FastSet<Key>& keys) {
+  if(!active)
+    return;
+  BOOST_FOREACH(Key key, keys) {
+    variables.erase(key);
+    deltas.erase(key);
+  }
+  removed.insert(keys.begin(), keys.end());
+}
+
+/* ************************************************************************* */
+void ISAM2CheckpointJournal::restart() {
+  active = true;
+  allDeltas = false;
+  variables.clear();
+  deltas.clear();
+  removed.clear();
+  slots.clear();
+  cliques.clear();
+}
+
+/* ************************************************************************* */
+void ISAM2CheckpointJournal::stop() {
+  restart();
+  active = false;
+}
+
+/* ************************************************************************* */
+void ISAM2CheckpointJournal::limit(size_t nrVariables) {
+  const size_t bound = std::max<size_t>(nrVariables, 64);
+  if(active && (cliques.size() > bound || removed.size() > bound))
+    stop();
+}
+
 /* ************************************************************************* */
 ISAM2::ISAM2(const ISAM2Params& params): params_(params), update_count_(0) {
   if(params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ = boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
+  if(params_.spillAfterUpdates > 0) {
+    if(params_.enableSnapshots)
+      throw invalid_argument("ISAM2: spillAfterUpdates cannot be combined with enableSnapshots");
+    cliqueStore_ = boost::make_shared<ISAM2CliqueStore>(params_.pageFile);
+  }
 }
 
 /* ************************************************************************* */
@@ -259,6 +319,111 @@ GaussianFactorGraph ISAM2::getCachedBoundaryFactors(Cliques& orphans) {
   return cachedBoundary;
 }
 
+namespace {
+  /* ************************************************************************* */
+  // Wall-clock stopwatch for ISAM2Telemetry, cheap enough to always run
+  class PhaseTimer {
+    boost::chrono::steady_clock::time_point last_;
+  public:
+    PhaseTimer() : last_(boost::chrono::steady_clock::now()) {}
+    /// Seconds since construction or the previous lap
+    double lap() {
+      const boost::chrono::steady_clock::time_point now = boost::chrono::steady_clock::now();
+      const double seconds = boost::chrono::duration<double>(now - last_).count();
+      last_ = now;
+      return seconds;
+    }
+  };
+
+  /* ************************************************************************* */
+  size_t matrixBytes(const GaussianFactor::shared_ptr& factor) {
+    if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get()))
+      return jacobian->matrixObject().matrix().size() * sizeof(double);
+    if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor.get()))
+      return hessian->info().size() * sizeof(double);
+    return 0;
+  }
+
+  /* ************************************************************************* */
+  // Size and depth of the newly eliminated cliques, which end at the orphans
+  void measureNewCliques(const FastVector<ISAM2::sharedClique>& roots, const ISAM2::Cliques& orphans,
+      ISAM2Telemetry& telemetry) {
+    FastSet<const ISAM2Clique*> old;
+    BOOST_FOREACH(const ISAM2::sharedClique& orphan, orphans)
+      old.insert(orphan.get());
+    std::vector<std::pair<const ISAM2Clique*, size_t> > stack;
+    BOOST_FOREACH(const ISAM2::sharedClique& root, roots)
+      stack.push_back(std::make_pair(root.get(), size_t(1)));
+    while(!stack.empty()) {
+      const ISAM2Clique& clique = *stack.back().first;
+      const size_t depth = stack.back().second;
+      stack.pop_back();
+      const GaussianConditional& conditional = *clique.conditional();
+      telemetry.subtreeDepth = std::max(telemetry.subtreeDepth, depth);
+      if(conditional.size() > telemetry.largestClique) {
+        telemetry.largestClique = conditional.size();
+        telemetry.largestCliqueDim = conditional.matrixObject().matrix().cols() - 1;
+      }
+      telemetry.bytesAllocated += conditional.matrixObject().matrix().size() * sizeof(double)
+          + matrixBytes(clique.cachedFactor_);
+      BOOST_FOREACH(const ISAM2::sharedClique& child, clique.children)
+        if(!old.exists(child.get()))
+          stack.push_back(std::make_pair(child.get(), depth + 1));
+    }
+  }
+
+  /* ************************************************************************* */
+  // Snapshot node of a clique, creating those of the cliques below it that have none.  A clique
+  // without a node only has ancestors without a node, as they were all re-eliminated or modified.
+  ISAM2Snapshot::sharedNode snapshotNode(const ISAM2::sharedClique& subtree, const Values& theta) {
+    // Post-order traversal with an explicit stack, marking cliques whose children are done
+    std::vector<std::pair<ISAM2Clique*, bool> > stack;
+    stack.push_back(std::make_pair(subtree.get(), false));
+    while(!stack.empty()) {
+      ISAM2Clique& clique = *stack.back().first;
+      const bool childrenDone = stack.back().second;
+      stack.back().second = true;
+      if(clique.snapshotNode_) {
+        stack.pop_back();
+      } else if(!childrenDone) {
+        BOOST_FOREACH(const ISAM2::sharedClique& child, clique.children)
+          if(!child->snapshotNode_)
+            stack.push_back(std::make_pair(child.get(), false));
+      } else {
+        boost::shared_ptr<ISAM2Snapshot::Node> node = boost::make_shared<ISAM2Snapshot::Node>();
+        node->conditional = clique.conditional();
+        BOOST_FOREACH(Key frontal, clique.conditional()->frontals())
+          node->theta.insert(frontal, theta.at(frontal));
+        node->children.reserve(clique.children.size());
+        BOOST_FOREACH(const ISAM2::sharedClique& child, clique.children)
+          node->children.push_back(child->snapshotNode_);
+        clique.snapshotNode_ = node;
+        stack.pop_back();
+      }
+    }
+    return subtree->snapshotNode_;
+  }
+
+  /* ************************************************************************* */
+  // Drop the snapshot nodes of a clique modified in place and of its ancestors
+  void invalidateSnapshotNodes(ISAM2::sharedClique clique) {
+    while(clique && clique->snapshotNode_) {
+      clique->snapshotNode_.reset();
+      clique = clique->parent();
+    }
+  }
+
+  // Recompute the Dogleg model products of a clique whose conditional or subtree
+  // changes in place, and of the cliques above it, which involve its separator
+  void invalidateDoglegProducts(ISAM2::sharedClique clique) {
+    while(clique) {
+      clique->doglegProductsValid_ = false;
+      clique->doglegSubtreeValid_ = false;
+      clique = clique->parent();
+    }
+  }
+}
+
 /* ************************************************************************* */
 boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKeys, const FastSet<Key>& relinKeys,
                                                     const vector<Key>& observedKeys,
@@ -337,6 +502,7 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
     br::copy(variableIndex_ | br::map_keys, std::inserter(*affectedKeysSet, affectedKeysSet->end()));
     gttoc(add_keys);
 
+    PhaseTimer timer;
     gttic(ordering);
     Ordering order;
     if(constrainKeys)
@@ -359,17 +525,23 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
       }
     }
     gttoc(ordering);
+    result.telemetry.symbolic += timer.lap();
 
     gttic(linearize);
     GaussianFactorGraph linearized = *nonlinearFactors_.linearize(theta_);
     if(params_.cacheLinearizedFactors)
       linearFactors_ = linearized;
     gttoc(linearize);
+    result.telemetry.linearize += timer.lap();
 
     gttic(eliminate);
-    ISAM2BayesTree::shared_ptr bayesTree = ISAM2JunctionTree(GaussianEliminationTree(linearized, variableIndex_, order))
-      .eliminate(params_.getEliminationFunction()).first;
+    ISAM2JunctionTree junctionTree(GaussianEliminationTree(linearized, variableIndex_, order));
+    result.telemetry.symbolic += timer.lap();
+    ISAM2BayesTree::shared_ptr bayesTree = junctionTree.eliminate(recalculateEliminationFunction()).first;
+    result.telemetry.numeric += timer.lap();
     gttoc(eliminate);
+    measureNewCliques(bayesTree->roots(), Cliques(), result.telemetry);
+    trackNewCliques(bayesTree->roots(), Cliques());
 
     gttic(insert);
     this->clear();
@@ -401,10 +573,12 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
     FastList<Key> affectedAndNewKeys;
     affectedAndNewKeys.insert(affectedAndNewKeys.end(), affectedKeys.begin(), affectedKeys.end());
     affectedAndNewKeys.insert(affectedAndNewKeys.end(), observedKeys.begin(), observedKeys.end());
+    PhaseTimer timer;
     gttic(relinearizeAffected);
     GaussianFactorGraph factors(*relinearizeAffectedFactors(affectedAndNewKeys, relinKeys));
     if(debug) factors.print("Relinearized factors: ");
     gttoc(relinearizeAffected);
+    result.telemetry.linearize += timer.lap();
 
     if(debug) { cout << "Affected keys: "; BOOST_FOREACH(const Key key, affectedKeys) { cout << key << " "; } cout << endl; }
 
@@ -446,6 +620,7 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
 
     // 3. Re-order and eliminate the factor graph into a Bayes net (Algorithm [alg:eliminate]), and re-assemble into a new Bayes tree (Algorithm [alg:BayesTree])
 
+    timer.lap();
     gttic(reorder_and_eliminate);
 
     gttic(list_to_set);
@@ -484,10 +659,14 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
     Ordering ordering = Ordering::COLAMDConstrained(affectedFactorsVarIndex, constraintGroups);
     gttoc(Ordering);
 
-    ISAM2BayesTree::shared_ptr bayesTree = ISAM2JunctionTree(GaussianEliminationTree(
-      factors, affectedFactorsVarIndex, ordering)).eliminate(params_.getEliminationFunction()).first;
+    ISAM2JunctionTree junctionTree(GaussianEliminationTree(factors, affectedFactorsVarIndex, ordering));
+    result.telemetry.symbolic += timer.lap();
+    ISAM2BayesTree::shared_ptr bayesTree = junctionTree.eliminate(recalculateEliminationFunction()).first;
+    result.telemetry.numeric += timer.lap();
 
     gttoc(reorder_and_eliminate);
+    measureNewCliques(bayesTree->roots(), orphans, result.telemetry);
+    trackNewCliques(bayesTree->roots(), orphans);
 
     gttic(reassemble);
     this->roots_.insert(this->roots_.end(), bayesTree->roots().begin(), bayesTree->roots().end());
@@ -506,6 +685,9 @@ boost::shared_ptr<FastSet<Key> > ISAM2::recalculate(const FastSet<Key>& markedKe
         result.detail->variableStatus[var].inRootClique = true;
   }
 
+  // The removed cliques were all headed by affected keys
+  evictAssemblyPlans(*affectedKeysSet);
+
   return affectedKeysSet;
 }
 
@@ -520,8 +702,11 @@ ISAM2Result ISAM2::update(
   const bool verbose = ISDEBUG("ISAM2 update verbose");
 
   gttic(ISAM2_update);
+  PhaseTimer totalTimer, timer;
 
   this->update_count_++;
+  if(cliqueStore_)
+    cliqueStore_->tick();
 
   lastAffectedVariableCount = 0;
   lastAffectedFactorCount = 0;
@@ -532,6 +717,7 @@ ISAM2Result ISAM2::update(
   ISAM2Result result;
   if(params_.enableDetailedResults)
     result.detail = ISAM2Result::DetailedResults();
+  result.telemetry.update = update_count_;
   const bool relinearizeThisStep = force_relinearize
       || (params_.enableRelinearization && update_count_ % params_.relinearizeSkip == 0);
 
@@ -542,16 +728,21 @@ ISAM2Result ISAM2::update(
 
   // Update delta if we need it to check relinearization later
   if(relinearizeThisStep) {
+    timer.lap();
     gttic(updateDelta);
     updateDelta(disableReordering);
     gttoc(updateDelta);
+    result.telemetry.backSubstitution += timer.lap();
   }
 
+  timer.lap();
   gttic(push_back_factors);
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
   // Add the new factor indices to the result struct
   if(debug || verbose) newFactors.print("The new factors are: ");
   Impl::AddFactorsStep1(newFactors, params_.findUnusedFactorSlots, nonlinearFactors_, result.newFactorsIndices);
+  checkpointJournal_.markSlots(result.newFactorsIndices);
+  checkpointJournal_.markSlots(removeFactorIndices);
 
   // Remove the removed factors
   NonlinearFactorGraph removeFactors; removeFactors.reserve(removeFactorIndices.size());
@@ -590,10 +781,17 @@ ISAM2Result ISAM2::update(
   gttic(add_new_variables);
   // 2. Initialize any new variables \Theta_{new} and add \Theta:=\Theta\cup\Theta_{new}.
   Impl::AddVariables(newTheta, theta_, delta_, deltaNewton_, RgProd_);
+  if(estimateCache_.active()) {
+    const KeyList newKeys = newTheta.keys();
+    estimateCache_.markChanged(FastSet<Key>(newKeys.begin(), newKeys.end()));
+  }
+  if(checkpointJournal_.active)
+    checkpointJournal_.markVariables(newTheta.keys());
   // New keys for detailed results
   if(params_.enableDetailedResults) {
     BOOST_FOREACH(Key key, newTheta.keys()) { result.detail->variableStatus[key].isNew = true; } }
   gttoc(add_new_variables);
+  result.telemetry.addFactors += timer.lap();
 
   gttic(evaluate_error_before);
   if(params_.evaluateNonlinearError)
@@ -634,6 +832,7 @@ ISAM2Result ISAM2::update(
   // Check relinearization if we're at the nth step, or we are using a looser loop relin threshold
   FastSet<Key> relinKeys;
   if (relinearizeThisStep) {
+    timer.lap();
     gttic(gather_relinearize_keys);
     // 4. Mark keys in \Delta above threshold \beta: J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
     if(params_.enablePartialRelinearizationCheck)
@@ -687,15 +886,20 @@ ISAM2Result ISAM2::update(
 
     gttic(expmap);
     // 6. Update linearization point for marked variables: \Theta_{J}:=\Theta_{J}+\Delta_{J}.
-    if (!relinKeys.empty())
+    if (!relinKeys.empty()) {
       Impl::ExpmapMasked(theta_, delta_, markedRelinMask, delta_);
+      estimateCache_.markRelinearized(markedRelinMask);
+      checkpointJournal_.markVariables(markedRelinMask);
+    }
     gttoc(expmap);
+    result.telemetry.relinearizationCheck += timer.lap();
 
     result.variablesRelinearized = markedKeys.size();
   } else {
     result.variablesRelinearized = 0;
   }
 
+  timer.lap();
   gttic(linearize_new);
   // 7. Linearize new factors
   if(params_.cacheLinearizedFactors) {
@@ -715,6 +919,7 @@ ISAM2Result ISAM2::update(
     gttoc(linearize);
   }
   gttoc(linearize_new);
+  result.telemetry.linearize += timer.lap();
 
   gttic(augment_VI);
   // Augment the variable index with the new factors
@@ -723,6 +928,7 @@ ISAM2Result ISAM2::update(
   else
     variableIndex_.augment(newFactors);
   gttoc(augment_VI);
+  result.telemetry.addFactors += timer.lap();
 
   gttic(recalculate);
   // 8. Redo top of Bayes tree
@@ -740,15 +946,29 @@ ISAM2Result ISAM2::update(
     gttic(remove_variables);
     Impl::RemoveVariables(unusedKeys, roots_, theta_, variableIndex_, delta_, deltaNewton_, RgProd_,
         deltaReplacedMask_, Base::nodes_, fixedVariables_);
+    estimateCache_.markRemoved(unusedKeys);
+    checkpointJournal_.markRemoved(unusedKeys);
+    evictAssemblyPlans(unusedKeys);
     gttoc(remove_variables);
   }
   result.cliques = this->nodes().size();
 
+  if(params_.enableSnapshots)
+    publishSnapshot();
+
   gttic(evaluate_error_after);
   if(params_.evaluateNonlinearError)
     result.errorAfter.reset(nonlinearFactors_.error(calculateEstimate()));
   gttoc(evaluate_error_after);
 
+  if(cliqueStore_)
+    cliqueStore_->spillCold(params_.spillAfterUpdates);
+  checkpointJournal_.limit(theta_.size());
+
+  result.telemetry.total = totalTimer.lap();
+  if(telemetryBuffer_)
+    *telemetryBuffer_ << result.telemetry;
+
   return result;
 }
 
@@ -804,6 +1024,9 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         // marginal factor.  So, now associate this marginal factor with the
         // parent of this clique.
         marginalFactors[clique->parent()->conditional()->front()].push_back(marginalFactor);
+        invalidateSnapshotNodes(clique->parent());
+        invalidateDoglegProducts(clique->parent());
+        checkpointJournal_.markClique(clique->parent());
         // Now remove this clique and its subtree - all of its marginal
         // information has been stored in marginalFactors.
         const Cliques removedCliques = this->removeSubtree(clique); // Remove the subtree and throw away the cliques
@@ -829,6 +1052,10 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         // the marginals from the marginalFactors multimap, which come from any
         // subtrees already marginalized out.
         
+        invalidateSnapshotNodes(clique);
+        invalidateDoglegProducts(clique);
+        checkpointJournal_.markClique(clique);
+
         // Add child marginals and remove marginalized subtrees
         GaussianFactorGraph graph;
         FastSet<size_t> factorsInSubtreeRoot;
@@ -898,6 +1125,9 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         while(leafKeys.exists(clique->conditional()->keys()[nToRemove]))
           ++ nToRemove;
 
+        // Split a copy, as conditionals may be shared with snapshots and checkpoint writers
+        clique->conditional_ = boost::make_shared<GaussianConditional>(*clique->conditional());
+
         // Make the clique's matrix appear as a subset
         const DenseIndex dimToRemove = clique->conditional()->matrixObject().offset(nToRemove);
         clique->conditional()->matrixObject().firstBlock() = nToRemove;
@@ -932,6 +1162,7 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
         factorsToAdd.push_back(factor);
         if(marginalFactorsIndices)
           marginalFactorsIndices->push_back(nonlinearFactors_.size());
+        checkpointJournal_.markSlot(nonlinearFactors_.size());
         nonlinearFactors_.push_back(boost::make_shared<LinearContainerFactor>(
           factor));
         if(params_.cacheLinearizedFactors)
@@ -952,6 +1183,7 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
       linearFactors_.remove(i);
   }
   variableIndex_.remove(factorIndicesToRemove.begin(), factorIndicesToRemove.end(), removedFactors);
+  checkpointJournal_.markSlots(factorIndicesToRemove);
 
   if(deletedFactorsIndices)
     deletedFactorsIndices->assign(factorIndicesToRemove.begin(), factorIndicesToRemove.end());
@@ -959,6 +1191,71 @@ void ISAM2::marginalizeLeaves(const FastList<Key>& leafKeysList,
   // Remove the marginalized variables
   Impl::RemoveVariables(FastSet<Key>(leafKeys.begin(), leafKeys.end()), roots_, theta_, variableIndex_, delta_, deltaNewton_, RgProd_,
     deltaReplacedMask_, nodes_, fixedVariables_);
+  estimateCache_.markRemoved(leafKeys);
+  checkpointJournal_.markRemoved(leafKeys);
+  checkpointJournal_.limit(theta_.size());
+  evictAssemblyPlans(leafKeys);
+
+  if(params_.enableSnapshots)
+    publishSnapshot();
+}
+
+/* ************************************************************************* */
+void ISAM2::publishSnapshot()
+{
+  gttic(publishSnapshot);
+  std::vector<ISAM2Snapshot::sharedNode> roots;
+  roots.reserve(roots_.size());
+  BOOST_FOREACH(const sharedClique& root, roots_)
+    roots.push_back(snapshotNode(root, theta_));
+  boost::atomic_store(&snapshot_, ISAM2Snapshot::shared_ptr(new ISAM2Snapshot(update_count_, roots)));
+}
+
+/* ************************************************************************* */
+// Register the newly eliminated cliques, which end at the orphans, with the clique store and
+// the checkpoint journal
+void ISAM2::trackNewCliques(const FastVector<sharedClique>& roots, const Cliques& orphans)
+{
+  if(!cliqueStore_ && !checkpointJournal_.active)
+    return;
+  FastSet<const ISAM2Clique*> old;
+  BOOST_FOREACH(const sharedClique& orphan, orphans)
+    old.insert(orphan.get());
+  std::vector<sharedClique> stack(roots.begin(), roots.end());
+  while(!stack.empty()) {
+    const sharedClique clique = stack.back();
+    stack.pop_back();
+    if(cliqueStore_) {
+      clique->store_ = cliqueStore_;
+      cliqueStore_->touched(clique);
+    }
+    checkpointJournal_.markClique(clique);
+    BOOST_FOREACH(const sharedClique& child, clique->children)
+      if(!old.exists(child.get()))
+        stack.push_back(child);
+  }
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::Eliminate ISAM2::recalculateEliminationFunction() const
+{
+  // Cliques whose factors keep their structure across updates reuse their assembly plans
+  if(params_.cacheAssemblyPlans && params_.factorization == ISAM2Params::CHOLESKY)
+    return boost::cref(assemblyPlans_);
+  return params_.getEliminationFunction();
+}
+
+/* ************************************************************************* */
+void ISAM2::evictAssemblyPlans(const FastSet<Key>& keys)
+{
+  // Plans are kept by the first frontal variable of their clique
+  if(assemblyPlans_.size() == 0)
+    return;
+  BOOST_FOREACH(Key key, keys) {
+    Nodes::const_iterator node = nodes_.find(key);
+    if(node == nodes_.end() || node->second->conditionalKeys().front() != key)
+      assemblyPlans_.erase(key);
+  }
 }
 
 /* ************************************************************************* */
@@ -971,8 +1268,16 @@ void ISAM2::updateDelta(bool forceFullSolve) const
         boost::get<ISAM2GaussNewtonParams>(params_.optimizationParams);
     const double effectiveWildfireThreshold = forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
-    lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, delta_, effectiveWildfireThreshold);
+    if(estimateCache_.active() || checkpointJournal_.active) {
+      FastSet<Key> changed;
+      lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(
+          roots_, deltaReplacedMask_, delta_, effectiveWildfireThreshold, changed);
+      estimateCache_.markChanged(changed);
+      checkpointJournal_.markDeltas(changed);
+    } else {
+      lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(
+          roots_, deltaReplacedMask_, delta_, effectiveWildfireThreshold);
+    }
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
 
@@ -987,20 +1292,30 @@ void ISAM2::updateDelta(bool forceFullSolve) const
 
     // Compute Newton's method step
     gttic(Wildfire_update);
-    lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_, deltaNewton_, effectiveWildfireThreshold);
+    FastSet<Key> changed;
+    lastBacksubVariableCount = Impl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_, deltaNewton_, effectiveWildfireThreshold, changed);
     gttoc(Wildfire_update);
     
     // Compute steepest descent step
     const VectorValues gradAtZero = this->gradientAtZero(); // Compute gradient
     Impl::UpdateRgProd(roots_, deltaReplacedMask_, gradAtZero, RgProd_); // Update RgProd
-    const VectorValues dx_u = Impl::ComputeGradientSearch(gradAtZero, RgProd_); // Compute gradient search point
+    const double step = Impl::GradientSearchStep(gradAtZero, RgProd_);
+    const VectorValues dx_u = step * gradAtZero; // Compute gradient search point
     
+    // Update the model products of the cliques whose gradient or Newton's method step changed
+    gttic(Dogleg_products);
+    changed.insert(deltaReplacedMask_.begin(), deltaReplacedMask_.end());
+    const DoglegOptimizerImpl::CachedModel::Products products =
+        Impl::UpdateDoglegProducts(roots_, changed, gradAtZero, deltaNewton_);
+    gttoc(Dogleg_products);
+
     // Clear replaced keys mask because now we've updated deltaNewton_ and RgProd_
     deltaReplacedMask_.clear();
     
     // Compute dogleg point
     DoglegOptimizerImpl::IterationResult doglegResult(DoglegOptimizerImpl::Iterate(
-        *doglegDelta_, doglegParams.adaptationMode, dx_u, deltaNewton_, *this, nonlinearFactors_,
+        *doglegDelta_, doglegParams.adaptationMode,
+        DoglegOptimizerImpl::CachedModel(products, step, dx_u, deltaNewton_), nonlinearFactors_,
         theta_, nonlinearFactors_.error(theta_), doglegParams.verbose));
     gttoc(Dogleg_Iterate);
 
@@ -1008,6 +1323,8 @@ void ISAM2::updateDelta(bool forceFullSolve) const
     // Update Delta and linear step
     doglegDelta_ = doglegResult.Delta;
     delta_ = doglegResult.dx_d; // Copy the VectorValues containing with the linear solution
+    estimateCache_.markAllChanged();
+    checkpointJournal_.markAllDeltas();
     gttoc(Copy_dx_d);
   }
 }
@@ -1021,6 +1338,13 @@ Values ISAM2::calculateEstimate() const {
   gttoc(Expmap);
 }
 
+/* ************************************************************************* */
+const Values& ISAM2::calculateEstimateIncremental(double tolerance) const {
+  gttic(ISAM2_calculateEstimateIncremental);
+  const VectorValues& delta(getDelta());
+  return estimateCache_.refresh(theta_, delta, tolerance);
+}
+
 /* ************************************************************************* */
 const Value& ISAM2::calculateEstimate(Key key) const {
   const Vector& delta = getDelta()[key];
@@ -1053,15 +1377,13 @@ double ISAM2::error(const VectorValues& x) const
 
 /* ************************************************************************* */
 static void gradientAtZeroTreeAdder(const boost::shared_ptr<ISAM2Clique>& root, VectorValues& g) {
-  // Loop through variables in each clique, adding contributions
+  // Loop through variables in each clique, adding contributions in place.  Only
+  // the keys are needed, so spilled cliques are not read back.
   DenseIndex variablePosition = 0;
-  for(GaussianConditional::const_iterator jit = root->conditional()->begin(); jit != root->conditional()->end(); ++jit) {
-    const DenseIndex dim = root->conditional()->getDim(jit);
-    pair<VectorValues::iterator, bool> pos_ins =
-      g.tryInsert(*jit, root->gradientContribution().segment(variablePosition, dim));
-    if(!pos_ins.second)
-      pos_ins.first->second += root->gradientContribution().segment(variablePosition, dim);
-    variablePosition += dim;
+  BOOST_FOREACH(Key j, root->conditionalKeys()) {
+    Vector& gj = g.at(j);
+    gj += root->gradientContribution().segment(variablePosition, gj.size());
+    variablePosition += gj.size();
   }
 
   // Recursively add contributions from children
@@ -1074,8 +1396,8 @@ static void gradientAtZeroTreeAdder(const boost::shared_ptr<ISAM2Clique>& root,
 /* ************************************************************************* */
 VectorValues ISAM2::gradientAtZero() const
 {
-  // Create result
-  VectorValues g;
+  // Create result, with a zero vector for every variable to add contributions into
+  VectorValues g = VectorValues::Zero(delta_);
   
   // Sum up contributions for each clique
   BOOST_FOREACH(const ISAM2::sharedClique& root, this->roots())
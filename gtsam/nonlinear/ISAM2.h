@@ -21,9 +21,15 @@
 
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
+#include <gtsam/nonlinear/ISAM2Telemetry.h>
+#include <gtsam/nonlinear/ISAM2Snapshot.h>
+#include <gtsam/nonlinear/ISAM2EstimateCache.h>
+#include <gtsam/nonlinear/ISAM2CliqueStore.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 
+#include <boost/atomic.hpp>
 #include <boost/variant.hpp>
+#include <boost/cstdint.hpp>
 
 namespace gtsam {
 
@@ -169,6 +175,32 @@ struct GTSAM_EXPORT ISAM2Params {
   /// having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** Publish an ISAM2Snapshot at the end of every update, for threads reading the estimate concurrently
+   * (default: false).  This keeps a copy of the linearization point of every variable in the snapshot
+   * tree, and costs a few allocations per re-eliminated clique.  See ISAM2::snapshot().
+   */
+  bool enableSnapshots;
+
+  /** Spill the conditionals and cached factors of cliques not used in this many updates to a memory-mapped
+   * file, and read them back when they are used again (default: 0, never).  Bounds the memory of the Bayes
+   * tree of long-running problems where most cliques are untouched by updates, at the cost of disk reads
+   * for the cliques reached by relinearization, marginals, or full back-substitution.  See ISAM2CliqueStore.
+   * Cannot be combined with enableSnapshots, as the published snapshot holds every conditional, so that
+   * spilling would free nothing.
+   */
+  size_t spillAfterUpdates;
+
+  /** File to which cliques are spilled, replaced if it exists (default: empty, a temporary file). */
+  std::string pageFile;
+
+  /** Keep the AssemblyPlan of every clique eliminated with Cholesky, and reuse it while the clique's factors
+   * keep their structure (default: false).  This pays off when most re-eliminated cliques keep their structure,
+   * e.g. when relinearization rather than new factors causes the re-elimination.  In incremental SLAM the top
+   * cliques gain factors with every update, so that plans are often stale, and looking them up costs more than
+   * the Scatters they save.  See AssemblyPlanCache.
+   */
+  bool cacheAssemblyPlans;
+
   /** Specify parameters as constructor arguments */
   ISAM2Params(
       OptimizationParams _optimizationParams = ISAM2GaussNewtonParams(), ///< see ISAM2Params::optimizationParams
@@ -184,7 +216,8 @@ struct GTSAM_EXPORT ISAM2Params {
       evaluateNonlinearError(_evaluateNonlinearError), factorization(_factorization),
       cacheLinearizedFactors(_cacheLinearizedFactors), keyFormatter(_keyFormatter),
       enableDetailedResults(false), enablePartialRelinearizationCheck(false),
-      findUnusedFactorSlots(false) {}
+      findUnusedFactorSlots(false), enableSnapshots(false), spillAfterUpdates(0),
+      cacheAssemblyPlans(false) {}
 
   void print(const std::string& str = "") const {
     std::cout << str << "\n";
@@ -211,6 +244,10 @@ struct GTSAM_EXPORT ISAM2Params {
     std::cout << "enableDetailedResults:             " << enableDetailedResults << "\n";
     std::cout << "enablePartialRelinearizationCheck: " << enablePartialRelinearizationCheck << "\n";
     std::cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots << "\n";
+    std::cout << "enableSnapshots:                   " << enableSnapshots << "\n";
+    std::cout << "spillAfterUpdates:                 " << spillAfterUpdates << "\n";
+    std::cout << "pageFile:                          " << pageFile << "\n";
+    std::cout << "cacheAssemblyPlans:                " << cacheAssemblyPlans << "\n";
     std::cout.flush();
   }
 
@@ -225,6 +262,10 @@ struct GTSAM_EXPORT ISAM2Params {
   KeyFormatter getKeyFormatter() const { return keyFormatter; }
   bool isEnableDetailedResults() const { return enableDetailedResults; }
   bool isEnablePartialRelinearizationCheck() const { return enablePartialRelinearizationCheck; }
+  bool isEnableSnapshots() const { return enableSnapshots; }
+  size_t getSpillAfterUpdates() const { return spillAfterUpdates; }
+  std::string getPageFile() const { return pageFile; }
+  bool isCacheAssemblyPlans() const { return cacheAssemblyPlans; }
 
   void setOptimizationParams(OptimizationParams optimizationParams) { this->optimizationParams = optimizationParams; }
   void setRelinearizeThreshold(RelinearizationThreshold relinearizeThreshold) { this->relinearizeThreshold = relinearizeThreshold; }
@@ -236,6 +277,10 @@ struct GTSAM_EXPORT ISAM2Params {
   void setKeyFormatter(KeyFormatter keyFormatter) { this->keyFormatter = keyFormatter; }
   void setEnableDetailedResults(bool enableDetailedResults) { this->enableDetailedResults = enableDetailedResults; }
   void setEnablePartialRelinearizationCheck(bool enablePartialRelinearizationCheck) { this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck; }
+  void setEnableSnapshots(bool enableSnapshots) { this->enableSnapshots = enableSnapshots; }
+  void setSpillAfterUpdates(size_t spillAfterUpdates) { this->spillAfterUpdates = spillAfterUpdates; }
+  void setPageFile(const std::string& pageFile) { this->pageFile = pageFile; }
+  void setCacheAssemblyPlans(bool cacheAssemblyPlans) { this->cacheAssemblyPlans = cacheAssemblyPlans; }
 
   Factorization factorizationTranslator(const std::string& str) const;
   std::string factorizationTranslator(const Factorization& value) const;
@@ -340,6 +385,10 @@ struct GTSAM_EXPORT ISAM2Result {
    * Detail for information about the results data stored here. */
   boost::optional<DetailedResults> detail;
 
+  /** Wall time of each phase of the update and the size of the re-eliminated
+   * part of the Bayes tree, always computed, see ISAM2Telemetry. */
+  ISAM2Telemetry telemetry;
+
 
   void print(const std::string str = "") const {
     std::cout << str << "  Reelimintated: " << variablesReeliminated << "  Relinearized: " << variablesRelinearized << "  Cliques: " << cliques << std::endl;
@@ -355,7 +404,8 @@ struct GTSAM_EXPORT ISAM2Result {
  * Specialized Clique structure for ISAM2, incorporating caching and gradient contribution
  * TODO: more documentation
  */
-class GTSAM_EXPORT ISAM2Clique : public BayesTreeCliqueBase<ISAM2Clique, GaussianFactorGraph>
+class GTSAM_EXPORT ISAM2Clique : public BayesTreeCliqueBase<ISAM2Clique, GaussianFactorGraph>,
+  public boost::enable_shared_from_this<ISAM2Clique>
 {
 public:
   typedef ISAM2Clique This;
@@ -368,13 +418,26 @@ public:
   Base::FactorType::shared_ptr cachedFactor_;
   Vector gradientContribution_;
   FastMap<Key, VectorValues::iterator> solnPointers_;
+  ISAM2Snapshot::sharedNode snapshotNode_; ///< Node of this clique in published snapshots, if any
+  ISAM2CliqueStore::shared_ptr store_; ///< Store to which this clique may be spilled, if any
+  boost::uint64_t checkpointId_; ///< Id of this clique in checkpoint records, 0 if not written, see ISAM2Checkpoint
+  DoglegOptimizerImpl::CachedModel::Products doglegProducts_; ///< Dogleg model products of the conditional with the gradient
+  DoglegOptimizerImpl::CachedModel::Products doglegSubtree_;  ///< Sum of doglegProducts_ over the subtree of this clique
+  bool doglegProductsValid_;  ///< Whether doglegProducts_ was computed from the current conditional
+  bool doglegSubtreeValid_;   ///< Whether doglegSubtree_ was summed over the current subtree
 
   /// Default constructor
-  ISAM2Clique() : Base() {}
+  ISAM2Clique() : Base(), checkpointId_(0), doglegProductsValid_(false), doglegSubtreeValid_(false),
+    spilled_(false), lastAccess_(0) {}
 
   /// Copy constructor, does *not* copy solution pointers as these are invalid in different trees.
   ISAM2Clique(const ISAM2Clique& other) :
-    Base(other), cachedFactor_(other.cachedFactor_), gradientContribution_(other.gradientContribution_) {}
+    Base(other), boost::enable_shared_from_this<ISAM2Clique>(),
+    cachedFactor_(other.cachedFactor_), gradientContribution_(other.gradientContribution_),
+    snapshotNode_(other.snapshotNode_), store_(other.store_), checkpointId_(other.checkpointId_),
+    doglegProducts_(other.doglegProducts_), doglegSubtree_(other.doglegSubtree_),
+    doglegProductsValid_(other.doglegProductsValid_), doglegSubtreeValid_(other.doglegSubtreeValid_),
+    page_(other.page_), spilled_(other.spilled_.load()), lastAccess_(other.lastAccess_.load()) {}
 
   /// Assignment operator, does *not* copy solution pointers as these are invalid in different trees.
   ISAM2Clique& operator=(const ISAM2Clique& other)
@@ -382,14 +445,50 @@ public:
     Base::operator=(other);
     cachedFactor_ = other.cachedFactor_;
     gradientContribution_ = other.gradientContribution_;
+    snapshotNode_ = other.snapshotNode_;
+    store_ = other.store_;
+    checkpointId_ = other.checkpointId_;
+    doglegProducts_ = other.doglegProducts_;
+    doglegSubtree_ = other.doglegSubtree_;
+    doglegProductsValid_ = other.doglegProductsValid_;
+    doglegSubtreeValid_ = other.doglegSubtreeValid_;
+    page_ = other.page_;
+    spilled_.store(other.spilled_.load());
+    lastAccess_.store(other.lastAccess_.load());
     return *this;
   }
 
   /// Overridden to also store the remaining factor and gradient contribution
   void setEliminationResult(const FactorGraphType::EliminationResult& eliminationResult);
 
+  /** Mark the clique as used and read back the conditional and cached factor if they were
+   * spilled, see ISAM2CliqueStore.  Only reading back takes the store's lock. */
+  void ensureResident() const {
+    if(store_) {
+      const size_t now = store_->now();
+      if(lastAccess_.load(boost::memory_order_relaxed) != now)
+        lastAccess_.store(now, boost::memory_order_relaxed);
+      if(spilled_.load(boost::memory_order_acquire))
+        store_->access(*this);
+    }
+  }
+
+  /** Whether the conditional and cached factor are in memory */
+  bool resident() const { return !spilled_.load(boost::memory_order_acquire); }
+
+  /** Keys of the conditional, frontals first, without reading back a spilled clique */
+  const FastVector<Key>& conditionalKeys() const {
+    return page_ ? page_->conditional().keys : conditional_->keys(); }
+
+  /** Number of frontal variables of the conditional, without reading back a spilled clique */
+  size_t nrConditionalFrontals() const {
+    return page_ ? page_->conditional().nrFrontals : conditional_->nrFrontals(); }
+
+  /** The conditional and cached factor, without reading back a spilled clique or counting it as used */
+  void peek(sharedConditional& conditional, Base::FactorType::shared_ptr& cachedFactor) const;
+
   /** Access the cached factor */
-  Base::FactorType::shared_ptr& cachedFactor() { return cachedFactor_; }
+  Base::FactorType::shared_ptr& cachedFactor() { ensureResident(); return cachedFactor_; }
 
   /** Access the gradient contribution */
   const Vector& gradientContribution() const { return gradientContribution_; }
@@ -405,12 +504,82 @@ private:
   friend class boost::serialization::access;
   template<class ARCHIVE>
   void serialize(ARCHIVE & ar, const unsigned int version) {
+    ensureResident();
     ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
     ar & BOOST_SERIALIZATION_NVP(cachedFactor_);
     ar & BOOST_SERIALIZATION_NVP(gradientContribution_);
   }
+
+  friend class ISAM2CliqueStore;
+  mutable ISAM2CliqueStore::sharedPage page_; ///< Where the matrices are while spilled
+  mutable boost::atomic<bool> spilled_;       ///< Whether page_ is set, checked without the store's lock
+  mutable boost::atomic<size_t> lastAccess_;  ///< Update in which this clique was last used
 }; // \struct ISAM2Clique
 
+/**
+ * @addtogroup ISAM2
+ * What changed in an ISAM2 since the last record of an ISAM2Checkpoint writer,
+ * so that the next record costs time in proportion to the changes and not to
+ * the size of the problem.  The journal is inactive, and ignores reports of
+ * changes, until the writer writes a full record, and the writer clears it
+ * after every record.  It stops recording when the writer detaches from the
+ * ISAM2, or when more changes pile up than a full record would hold, so that
+ * it does not grow once no more records are written.
+ */
+class GTSAM_EXPORT ISAM2CheckpointJournal {
+public:
+  typedef FastMap<const ISAM2Clique*, boost::weak_ptr<ISAM2Clique> > CliqueSet;
+
+  bool active;              ///< Whether changes are recorded
+  bool allDeltas;           ///< Whether the deltas of all variables changed
+  FastSet<Key> variables;   ///< Variables added or relinearized
+  FastSet<Key> deltas;      ///< Variables whose delta changed
+  FastSet<Key> removed;     ///< Variables removed
+  FastSet<size_t> slots;    ///< Nonlinear factor slots filled or emptied
+  CliqueSet cliques;        ///< Cliques created, or whose conditional or children changed
+
+  /// Create an inactive journal
+  ISAM2CheckpointJournal() : active(false), allDeltas(false) {}
+
+  /// Report variables added or relinearized
+  template<class KEYS>
+  void markVariables(const KEYS& keys) {
+    if(active) variables.insert(keys.begin(), keys.end()); }
+
+  /// Report variables whose delta changed
+  void markDeltas(const FastSet<Key>& keys) {
+    if(active) deltas.insert(keys.begin(), keys.end()); }
+
+  /// Report that the deltas of all variables changed
+  void markAllDeltas() { if(active) allDeltas = true; }
+
+  /// Report removed variables
+  void markRemoved(const FastSet<Key>& keys);
+
+  /// Report a nonlinear factor slot that was filled or emptied
+  void markSlot(size_t index) { if(active) slots.insert(index); }
+
+  /// Report nonlinear factor slots that were filled or emptied
+  template<class SLOTS>
+  void markSlots(const SLOTS& indices) {
+    if(active) slots.insert(indices.begin(), indices.end()); }
+
+  /// Report a clique that was created, or whose conditional or children changed
+  void markClique(const boost::shared_ptr<ISAM2Clique>& clique) {
+    if(active) cliques[clique.get()] = clique; }
+
+  /// Forget the changes reported so far, and record the following ones
+  void restart();
+
+  /// Forget the changes reported so far, and stop recording
+  void stop();
+
+  /// Stop recording if more cliques or removed variables were reported than an
+  /// ISAM2 with nrVariables variables, and so at most as many cliques, holds,
+  /// as a full record then costs about as much as the next incremental one
+  void limit(size_t nrVariables);
+};
+
 /**
  * @addtogroup ISAM2
  * Implementation of the full ISAM2 algorithm for incremental nonlinear optimization.
@@ -470,6 +639,27 @@ protected:
 
   int update_count_; ///< Counter incremented every update(), used to determine periodic relinearization
 
+  ISAM2TelemetryBuffer::shared_ptr telemetryBuffer_; ///< Receives the telemetry of every update, if set
+
+  /** The last published snapshot, only accessed atomically */
+  ISAM2Snapshot::shared_ptr snapshot_;
+
+  /** The estimate maintained by calculateEstimateIncremental(), told about changes once it is active */
+  mutable ISAM2EstimateCache estimateCache_;
+
+  /** The file cold cliques are spilled to, if ISAM2Params::spillAfterUpdates is set */
+  ISAM2CliqueStore::shared_ptr cliqueStore_;
+
+  /** The changes since the last checkpoint record, told about changes once a writer is attached */
+  mutable ISAM2CheckpointJournal checkpointJournal_;
+
+  /** Assembly plans of the cliques recalculate() eliminated with Cholesky, if ISAM2Params::cacheAssemblyPlans,
+   *  reused while their structure holds.  Plans of cliques that are gone are evicted, so there are at most as
+   *  many plans as cliques. */
+  AssemblyPlanCache assemblyPlans_;
+
+  friend class ISAM2Checkpoint;
+
 public:
 
   typedef ISAM2 This; ///< This class
@@ -574,6 +764,27 @@ public:
   /** Return marginal on any variable as a covariance matrix */
   Matrix marginalCovariance(Key key) const;
 
+  /** Compute an estimate from the current linearization point and delta, maintained incrementally
+   * between calls: only the variables whose linearization point changed, or whose delta changed by
+   * more than tolerance (in max-norm) since they were last retracted, are retracted again.  The first
+   * call retracts all variables.  With a tolerance of zero the result equals calculateEstimate().
+   * The reference stays valid until the next call.
+   */
+  const Values& calculateEstimateIncremental(double tolerance = 0.0) const;
+
+  /** The version of the estimate returned by calculateEstimateIncremental(), incremented by every
+   * call that changes it, and 0 before the first call */
+  size_t estimateVersion() const { return estimateCache_.version(); }
+
+  /** The variables changed, added, or removed in the estimate returned by
+   * calculateEstimateIncremental() since the given version, sorted.  Only the
+   * changes of the last ISAM2EstimateCache::DefaultHistoryLength versions are kept.
+   * @return false if the changes since version are no longer kept, in which case
+   * keys holds all variables and the caller has to resync with the whole estimate.
+   */
+  bool estimateChangedKeys(size_t sinceVersion, KeyVector& keys) const {
+    return estimateCache_.changedSince(sinceVersion, keys); }
+
   /// @name Public members for non-typical usage
   /// @{
 
@@ -608,6 +819,25 @@ public:
 
   const ISAM2Params& params() const { return params_; }
 
+  /** Stream the telemetry of every following update into buffer, or stop if
+   * buffer is null.  The buffer may be read concurrently, e.g., by a watchdog. */
+  void setTelemetryBuffer(const ISAM2TelemetryBuffer::shared_ptr& buffer) { telemetryBuffer_ = buffer; }
+
+  /** The buffer receiving the telemetry of every update, if any */
+  const ISAM2TelemetryBuffer::shared_ptr& telemetryBuffer() const { return telemetryBuffer_; }
+
+  /** The estimate as of the last update() or marginalizeLeaves(), if ISAM2Params::enableSnapshots is set,
+   * or null.  This may be called from any thread, also while update() runs, and the snapshot returned
+   * may be queried without locking.  See ISAM2Snapshot. */
+  ISAM2Snapshot::shared_ptr snapshot() const { return boost::atomic_load(&snapshot_); }
+
+  /** The store cold cliques are spilled to, if ISAM2Params::spillAfterUpdates is set, or null.  Copies
+   * of this ISAM2 share the store. */
+  const ISAM2CliqueStore::shared_ptr& cliqueStore() const { return cliqueStore_; }
+
+  /** The assembly plans kept for the cliques eliminated with Cholesky, see AssemblyPlanCache */
+  const AssemblyPlanCache& assemblyPlans() const { return assemblyPlans_; }
+
   /** prints out clique statistics */
   void printStats() const { getCliqueData().getStats().print(); }
   
@@ -630,6 +860,12 @@ protected:
   virtual boost::shared_ptr<FastSet<Key> > recalculate(const FastSet<Key>& markedKeys, const FastSet<Key>& relinKeys,
       const std::vector<Key>& observedKeys, const FastSet<Key>& unusedIndices, const boost::optional<FastMap<Key,int> >& constrainKeys, ISAM2Result& result);
   void updateDelta(bool forceFullSolve = false) const;
+  GaussianFactorGraph::Eliminate recalculateEliminationFunction() const;
+
+  /** Evict the assembly plans of those of keys that no longer head a clique */
+  void evictAssemblyPlans(const FastSet<Key>& keys);
+  void publishSnapshot();
+  void trackNewCliques(const FastVector<sharedClique>& roots, const Cliques& orphans);
 
 }; // ISAM2
 
@@ -652,6 +888,11 @@ template<class CLIQUE>
 size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root,
     double threshold, const FastSet<Key>& replaced, VectorValues& delta);
 
+/// As above, and also insert into \c changed the variables whose delta was changed
+template<class CLIQUE>
+size_t optimizeWildfireNonRecursive(const boost::shared_ptr<CLIQUE>& root,
+    double threshold, const FastSet<Key>& replaced, VectorValues& delta, FastSet<Key>& changed);
+
 /// calculate the number of non-zero entries for the tree starting at clique (use root for complete matrix)
 template<class CLIQUE>
 int calculate_nnz(const boost::shared_ptr<CLIQUE>& clique);
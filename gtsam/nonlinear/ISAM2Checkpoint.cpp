@@ -0,0 +1,662 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Checkpoint.cpp
+ * @brief   Versioned binary checkpoints of ISAM2, written incrementally
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Checkpoint.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/linear/HessianFactor.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+  typedef boost::uint64_t uint64;
+  typedef boost::uint32_t uint32;
+
+  const uint32 magic = 0x4b433249; // "I2CK" in little-endian files
+  enum { FullRecord = 1, IncrementalRecord = 2 };
+  enum { NoFactor = 0, Jacobian = 1, Conditional = 2, Hessian = 3 };
+  enum { NoModel = 0, UnitModel = 1, IsotropicModel = 2, DiagonalModel = 3, ConstrainedModel = 4 };
+
+  /* ************************************************************************* */
+  // Raw native-endian values and arrays
+  template<typename T>
+  void put(ostream& os, const T& x) {
+    os.write(reinterpret_cast<const char*>(&x), sizeof(T));
+  }
+
+  template<typename T>
+  T get(istream& is) {
+    T x;
+    is.read(reinterpret_cast<char*>(&x), sizeof(T));
+    if(!is)
+      throw runtime_error("ISAM2Checkpoint: record ends unexpectedly");
+    return x;
+  }
+
+  void putDoubles(ostream& os, const double* data, size_t n) {
+    os.write(reinterpret_cast<const char*>(data), n * sizeof(double));
+  }
+
+  void getDoubles(istream& is, double* data, size_t n) {
+    is.read(reinterpret_cast<char*>(data), n * sizeof(double));
+    if(!is)
+      throw runtime_error("ISAM2Checkpoint: record ends unexpectedly");
+  }
+
+  void putVector(ostream& os, const Vector& v) {
+    put(os, uint64(v.size()));
+    putDoubles(os, v.data(), v.size());
+  }
+
+  Vector getVector(istream& is) {
+    Vector v(get<uint64>(is));
+    getDoubles(is, v.data(), v.size());
+    return v;
+  }
+
+  template<class KEYS>
+  void putKeys(ostream& os, const KEYS& keys) {
+    put(os, uint64(keys.size()));
+    BOOST_FOREACH(Key key, keys)
+      put(os, uint64(key));
+  }
+
+  FastVector<Key> getKeys(istream& is) {
+    FastVector<Key> keys(get<uint64>(is));
+    BOOST_FOREACH(Key& key, keys)
+      key = Key(get<uint64>(is));
+    return keys;
+  }
+
+  void putString(ostream& os, const string& s) {
+    put(os, uint64(s.size()));
+    os.write(s.data(), s.size());
+  }
+
+  /* ************************************************************************* */
+  // The payload of a record, read into memory once and parsed where it lies
+  class RecordBuffer : public std::streambuf {
+  public:
+    RecordBuffer(const char* data, size_t size) {
+      char* begin = const_cast<char*>(data);
+      setg(begin, begin, begin + size);
+    }
+    const char* position() const { return gptr(); }
+    size_t available() const { return size_t(egptr() - gptr()); }
+    void skip(size_t n) { setg(eback(), gptr() + n, egptr()); }
+  };
+
+  // A Boost.Serialization archive written by putString, deserialized without copying it out of the
+  // record, which must be read through a RecordBuffer
+  template<class T>
+  void getSerialized(istream& is, T& output) {
+    const uint64 size = get<uint64>(is);
+    RecordBuffer& record = static_cast<RecordBuffer&>(*is.rdbuf());
+    if(size > record.available())
+      throw runtime_error("ISAM2Checkpoint: record ends unexpectedly");
+    RecordBuffer archived(record.position(), size);
+    istream archiveStream(&archived);
+    boost::archive::binary_iarchive archive(archiveStream);
+    archive >> boost::serialization::make_nvp("data", output);
+    record.skip(size);
+  }
+
+  /* ************************************************************************* */
+  // 64-bit FNV-1a hash of a record payload
+  uint64 checksum(const char* payload, size_t size) {
+    uint64 hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < size; ++i) {
+      hash ^= uint64(static_cast<unsigned char>(payload[i]));
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /* ************************************************************************* */
+  void putModel(ostream& os, const SharedDiagonal& model) {
+    if(!model) {
+      put(os, uint32(NoModel));
+    } else if(boost::dynamic_pointer_cast<noiseModel::Unit>(model)) {
+      put(os, uint32(UnitModel));
+      put(os, uint64(model->dim()));
+    } else if(noiseModel::Isotropic::shared_ptr isotropic =
+        boost::dynamic_pointer_cast<noiseModel::Isotropic>(model)) {
+      put(os, uint32(IsotropicModel));
+      put(os, uint64(isotropic->dim()));
+      put(os, isotropic->sigma());
+    } else if(noiseModel::Constrained::shared_ptr constrained =
+        boost::dynamic_pointer_cast<noiseModel::Constrained>(model)) {
+      put(os, uint32(ConstrainedModel));
+      putVector(os, constrained->mu());
+      putVector(os, constrained->sigmas());
+    } else {
+      put(os, uint32(DiagonalModel));
+      putVector(os, model->sigmas());
+    }
+  }
+
+  SharedDiagonal getModel(istream& is) {
+    switch(get<uint32>(is)) {
+    case NoModel:
+      return SharedDiagonal();
+    case UnitModel:
+      return noiseModel::Unit::Create(get<uint64>(is));
+    case IsotropicModel: {
+      const size_t dim = get<uint64>(is);
+      return noiseModel::Isotropic::Sigma(dim, get<double>(is), false); }
+    case ConstrainedModel: {
+      const Vector mu = getVector(is);
+      return noiseModel::Constrained::MixedSigmas(mu, getVector(is)); }
+    case DiagonalModel:
+      return noiseModel::Diagonal::Sigmas(getVector(is), false);
+    default:
+      throw runtime_error("ISAM2Checkpoint: unknown noise model kind");
+    }
+  }
+
+  /* ************************************************************************* */
+  // Block dimensions of the active part of a block matrix, including the rhs
+  template<class BLOCKMATRIX>
+  void putDims(ostream& os, const BLOCKMATRIX& matrix) {
+    put(os, uint64(matrix.nBlocks()));
+    for(DenseIndex block = 0; block < matrix.nBlocks(); ++block) {
+      // The last block ends at the end of the matrix, as offset() only takes existing blocks
+      const DenseIndex end = block + 1 < matrix.nBlocks() ? matrix.offset(block + 1) : matrix.offset(0) + matrix.cols();
+      put(os, uint64(end - matrix.offset(block)));
+    }
+  }
+
+  FastVector<DenseIndex> getDims(istream& is) {
+    FastVector<DenseIndex> dims(get<uint64>(is));
+    BOOST_FOREACH(DenseIndex& dim, dims)
+      dim = DenseIndex(get<uint64>(is));
+    return dims;
+  }
+
+  /* ************************************************************************* */
+  // Active part of a matrix, written in one piece when it is the whole matrix
+  template<class BLOCK>
+  void putMatrix(ostream& os, const Matrix& whole, const BLOCK& active) {
+    if(active.rows() == whole.rows() && active.cols() == whole.cols()) {
+      putDoubles(os, whole.data(), whole.size());
+    } else {
+      const Matrix copy = active;
+      putDoubles(os, copy.data(), copy.size());
+    }
+  }
+
+  /* ************************************************************************* */
+  // Jacobian and Hessian factors and conditionals, as raw matrix data
+  void putFactor(ostream& os, const GaussianFactor::shared_ptr& factor) {
+    if(!factor) {
+      put(os, uint32(NoFactor));
+    } else if(const GaussianConditional* conditional =
+        dynamic_cast<const GaussianConditional*>(factor.get())) {
+      put(os, uint32(Conditional));
+      putKeys(os, conditional->keys());
+      put(os, uint64(conditional->nrFrontals()));
+      const VerticalBlockMatrix& Ab = conditional->matrixObject();
+      putDims(os, Ab);
+      put(os, uint64(Ab.rows()));
+      putModel(os, conditional->get_model());
+      putMatrix(os, Ab.matrix(), Ab.full());
+    } else if(const JacobianFactor* jacobian =
+        dynamic_cast<const JacobianFactor*>(factor.get())) {
+      put(os, uint32(Jacobian));
+      putKeys(os, jacobian->keys());
+      const VerticalBlockMatrix& Ab = jacobian->matrixObject();
+      putDims(os, Ab);
+      put(os, uint64(Ab.rows()));
+      putModel(os, jacobian->get_model());
+      putMatrix(os, Ab.matrix(), Ab.full());
+    } else if(const HessianFactor* hessian =
+        dynamic_cast<const HessianFactor*>(factor.get())) {
+      put(os, uint32(Hessian));
+      putKeys(os, hessian->keys());
+      const SymmetricBlockMatrix& info = hessian->matrixObject();
+      putDims(os, info);
+      const Matrix& whole = info.matrix().nestedExpression();
+      putMatrix(os, whole, whole.bottomRightCorner(info.rows(), info.cols()));
+    } else {
+      throw invalid_argument(
+          "ISAM2Checkpoint: only Jacobian and Hessian factors and Gaussian conditionals can be written");
+    }
+  }
+
+  GaussianFactor::shared_ptr getFactor(istream& is) {
+    const uint32 kind = get<uint32>(is);
+    if(kind == NoFactor)
+      return GaussianFactor::shared_ptr();
+    const FastVector<Key> keys = getKeys(is);
+    if(kind == Jacobian || kind == Conditional) {
+      const size_t nrFrontals = (kind == Conditional) ? size_t(get<uint64>(is)) : 0;
+      const FastVector<DenseIndex> dims = getDims(is);
+      VerticalBlockMatrix Ab(dims, DenseIndex(get<uint64>(is)));
+      const SharedDiagonal model = getModel(is);
+      getDoubles(is, Ab.matrix().data(), Ab.matrix().size());
+      if(kind == Conditional)
+        return boost::make_shared<GaussianConditional>(keys, nrFrontals, Ab, model);
+      else
+        return boost::make_shared<JacobianFactor>(keys, Ab, model);
+    } else if(kind == Hessian) {
+      SymmetricBlockMatrix info(getDims(is));
+      Matrix& matrix = info.matrix().nestedExpression();
+      getDoubles(is, matrix.data(), matrix.size());
+      return boost::make_shared<HessianFactor>(keys, info);
+    }
+    throw runtime_error("ISAM2Checkpoint: unknown factor kind");
+  }
+
+  /* ************************************************************************* */
+  void putVectorValues(ostream& os, const VectorValues& values) {
+    put(os, uint64(values.size()));
+    BOOST_FOREACH(const VectorValues::KeyValuePair& value, values) {
+      put(os, uint64(value.first));
+      putVector(os, value.second);
+    }
+  }
+
+  // Only the entries of the given keys that values has
+  void putVectorValues(ostream& os, const VectorValues& values, const FastSet<Key>& keys) {
+    FastVector<Key> present;
+    BOOST_FOREACH(Key key, keys)
+      if(values.exists(key))
+        present.push_back(key);
+    put(os, uint64(present.size()));
+    BOOST_FOREACH(Key key, present) {
+      put(os, uint64(key));
+      putVector(os, values.at(key));
+    }
+  }
+
+  VectorValues getVectorValues(istream& is) {
+    VectorValues values;
+    const uint64 n = get<uint64>(is);
+    for(uint64 i = 0; i < n; ++i) {
+      const Key key = Key(get<uint64>(is));
+      values.insert(key, getVector(is));
+    }
+    return values;
+  }
+
+  // Overwrite or add the entries written by putVectorValues
+  void updateVectorValues(istream& is, VectorValues& values) {
+    const uint64 n = get<uint64>(is);
+    for(uint64 i = 0; i < n; ++i) {
+      const Key key = Key(get<uint64>(is));
+      const Vector value = getVector(is);
+      std::pair<VectorValues::iterator, bool> inserted = values.tryInsert(key, value);
+      if(!inserted.second)
+        inserted.first->second = value;
+    }
+  }
+
+  /* ************************************************************************* */
+  // A clique restored so far, with the ids of its children
+  struct RestoredClique {
+    GaussianFactorGraph::EliminationResult result;
+    FastVector<Key> children;
+  };
+
+  // Everything restored so far while replaying records
+  struct RestoredState {
+    int updateCount;
+    boost::optional<double> doglegDelta;
+    Values theta;
+    std::vector<NonlinearFactor::shared_ptr> factors;
+    VectorValues delta, deltaNewton, RgProd;
+    FastVector<Key> replacedMask, fixedVariables;
+    FastMap<uint64, RestoredClique> cliques; ///< Cliques in the tree, and ones replaced since the last pruning
+    FastVector<Key> roots;                   ///< Ids of the root cliques
+    size_t prunedSize;                       ///< Number of cliques after the last pruning
+
+    RestoredState() : updateCount(0), prunedSize(0) {}
+  };
+
+  /* ************************************************************************* */
+  // Forget the cliques no longer in the tree
+  void pruneCliques(RestoredState& state) {
+    FastMap<uint64, RestoredClique> current;
+    FastVector<uint64> stack(state.roots.begin(), state.roots.end());
+    while(!stack.empty()) {
+      const uint64 id = stack.back();
+      stack.pop_back();
+      const RestoredClique& clique = state.cliques.at(id);
+      current[id] = clique;
+      stack.insert(stack.end(), clique.children.begin(), clique.children.end());
+    }
+    state.cliques.swap(current);
+    state.prunedSize = state.cliques.size();
+  }
+
+  /* ************************************************************************* */
+  void readRecord(istream& is, bool full, RestoredState& state) {
+    if(full)
+      state = RestoredState();
+
+    state.updateCount = int(get<uint64>(is));
+    if(get<uint32>(is))
+      state.doglegDelta = get<double>(is);
+    else
+      state.doglegDelta = boost::none;
+
+    // Variables removed, then added or relinearized
+    const FastVector<Key> removedKeys = getKeys(is);
+    BOOST_FOREACH(Key key, removedKeys) {
+      if(state.theta.exists(key))
+        state.theta.erase(key);
+      state.delta.erase(key);
+      state.deltaNewton.erase(key);
+      state.RgProd.erase(key);
+    }
+    Values changedTheta;
+    getSerialized(is, changedTheta);
+    BOOST_FOREACH(const Values::ConstKeyValuePair& value, changedTheta) {
+      if(state.theta.exists(value.key))
+        state.theta.update(value.key, value.value);
+      else
+        state.theta.insert(value.key, value.value);
+    }
+
+    // Deltas, all of them or those that changed
+    if(get<uint32>(is)) {
+      state.delta = getVectorValues(is);
+      state.deltaNewton = getVectorValues(is);
+      state.RgProd = getVectorValues(is);
+    } else {
+      updateVectorValues(is, state.delta);
+      updateVectorValues(is, state.deltaNewton);
+      updateVectorValues(is, state.RgProd);
+    }
+    state.replacedMask = getKeys(is);
+    state.fixedVariables = getKeys(is);
+
+    // Nonlinear factor slots that were filled or emptied
+    state.factors.resize(get<uint64>(is));
+    const FastVector<Key> changedSlots = getKeys(is);
+    NonlinearFactorGraph changedFactors;
+    getSerialized(is, changedFactors);
+    if(changedFactors.size() != changedSlots.size())
+      throw runtime_error("ISAM2Checkpoint: inconsistent factor record");
+    for(size_t k = 0; k < changedSlots.size(); ++k)
+      state.factors.at(changedSlots[k]) = changedFactors[k];
+
+    // Cliques created or changed, then the roots
+    const uint64 nrCliques = get<uint64>(is);
+    for(uint64 k = 0; k < nrCliques; ++k) {
+      RestoredClique& clique = state.cliques[get<uint64>(is)];
+      clique.result.first = boost::dynamic_pointer_cast<GaussianConditional>(getFactor(is));
+      if(!clique.result.first)
+        throw runtime_error("ISAM2Checkpoint: clique without a conditional");
+      clique.result.second = getFactor(is);
+      clique.children = getKeys(is);
+    }
+    state.roots = getKeys(is);
+
+    // Replaced cliques pile up, forget them once they are as many as the ones in the tree
+    if(full || state.cliques.size() > 2 * std::max<size_t>(state.prunedSize, 64))
+      pruneCliques(state);
+  }
+
+  /* ************************************************************************* */
+  ISAM2::sharedClique restoreClique(const RestoredClique& restored) {
+    ISAM2::sharedClique clique = boost::make_shared<ISAM2Clique>();
+    clique->setEliminationResult(restored.result);
+    return clique;
+  }
+}
+
+/* ************************************************************************* */
+ISAM2Checkpoint::ISAM2Checkpoint() : written_(0), nextCliqueId_(1) {}
+
+/* ************************************************************************* */
+void ISAM2Checkpoint::reset() {
+  written_ = 0;
+}
+
+/* ************************************************************************* */
+void ISAM2Checkpoint::detach(const ISAM2& isam) {
+  isam.checkpointJournal_.stop();
+  if(written_ == &isam)
+    written_ = 0;
+}
+
+/* ************************************************************************* */
+size_t ISAM2Checkpoint::write(const ISAM2& isam, std::ostream& os) {
+  gttic(ISAM2Checkpoint_write);
+  ISAM2CheckpointJournal& journal = isam.checkpointJournal_;
+  const bool full = written_ != &isam || !journal.active;
+  ostringstream record;
+
+  put(record, uint64(isam.update_count_));
+  put(record, uint32(isam.doglegDelta_ ? 1 : 0));
+  if(isam.doglegDelta_)
+    put(record, *isam.doglegDelta_);
+
+  // Variables removed, then the values of those added or relinearized
+  if(full) {
+    putKeys(record, FastVector<Key>());
+    putString(record, serializeBinary(isam.theta_));
+  } else {
+    putKeys(record, journal.removed);
+    Values changedTheta;
+    BOOST_FOREACH(Key key, journal.variables)
+      changedTheta.insert(key, isam.theta_.at(key));
+    putString(record, serializeBinary(changedTheta));
+  }
+
+  // Deltas, all of them after a Dogleg step, which replaces them
+  if(full || journal.allDeltas) {
+    put(record, uint32(1));
+    putVectorValues(record, isam.delta_);
+    putVectorValues(record, isam.deltaNewton_);
+    putVectorValues(record, isam.RgProd_);
+  } else {
+    put(record, uint32(0));
+    FastSet<Key> changed = journal.deltas;
+    changed.insert(journal.variables.begin(), journal.variables.end());
+    putVectorValues(record, isam.delta_, changed);
+    putVectorValues(record, isam.deltaNewton_, changed);
+    putVectorValues(record, isam.RgProd_, changed);
+  }
+  putKeys(record, isam.deltaReplacedMask_);
+  putKeys(record, isam.fixedVariables_);
+
+  // Nonlinear factor slots that were filled or emptied
+  const NonlinearFactorGraph& factors = isam.nonlinearFactors_;
+  put(record, uint64(factors.size()));
+  if(full) {
+    FastVector<size_t> slots(factors.size());
+    for(size_t i = 0; i < factors.size(); ++i)
+      slots[i] = i;
+    putKeys(record, slots);
+    putString(record, serializeBinary(factors));
+  } else {
+    FastVector<size_t> slots;
+    NonlinearFactorGraph changedFactors;
+    BOOST_FOREACH(size_t i, journal.slots) {
+      if(i < factors.size()) {
+        slots.push_back(i);
+        changedFactors.push_back(factors[i]);
+      }
+    }
+    putKeys(record, slots);
+    putString(record, serializeBinary(changedFactors));
+  }
+
+  // Cliques created or changed, all of them in a full record, with new ids if they have none
+  std::vector<ISAM2::sharedClique> cliques;
+  if(full) {
+    std::vector<ISAM2::sharedClique> stack(isam.roots().rbegin(), isam.roots().rend());
+    while(!stack.empty()) {
+      cliques.push_back(stack.back());
+      stack.pop_back();
+      stack.insert(stack.end(), cliques.back()->children.rbegin(), cliques.back()->children.rend());
+    }
+    BOOST_FOREACH(const ISAM2::sharedClique& clique, cliques)
+      clique->checkpointId_ = nextCliqueId_++;
+  } else {
+    BOOST_FOREACH(const ISAM2CheckpointJournal::CliqueSet::value_type& reported, journal.cliques) {
+      // Skip cliques removed from the tree since, without reading back spilled ones
+      const ISAM2::sharedClique clique = reported.second.lock();
+      if(!clique)
+        continue;
+      ISAM2::Nodes::const_iterator node = isam.nodes().find(clique->conditionalKeys().front());
+      if(node == isam.nodes().end() || node->second != clique)
+        continue;
+      cliques.push_back(clique);
+      if(clique->checkpointId_ == 0)
+        clique->checkpointId_ = nextCliqueId_++;
+    }
+  }
+  put(record, uint64(cliques.size()));
+  BOOST_FOREACH(const ISAM2::sharedClique& clique, cliques) {
+    put(record, clique->checkpointId_);
+    // Spilled cliques are written from the page file and stay spilled
+    ISAM2Clique::sharedConditional conditional;
+    GaussianFactor::shared_ptr cachedFactor;
+    clique->peek(conditional, cachedFactor);
+    putFactor(record, conditional);
+    putFactor(record, cachedFactor);
+    put(record, uint64(clique->children.size()));
+    BOOST_FOREACH(const ISAM2::sharedClique& child, clique->children) {
+      if(child->checkpointId_ == 0)
+        throw runtime_error("ISAM2Checkpoint: a clique was created without being reported to the journal");
+      put(record, child->checkpointId_);
+    }
+  }
+  put(record, uint64(isam.roots().size()));
+  BOOST_FOREACH(const ISAM2::sharedClique& root, isam.roots())
+    put(record, root->checkpointId_);
+  journal.restart();
+
+  // Header, then the payload
+  const string payload = record.str();
+  put(os, magic);
+  put(os, uint32(FormatVersion));
+  put(os, uint32(full ? FullRecord : IncrementalRecord));
+  put(os, uint64(payload.size()));
+  put(os, checksum(payload.data(), payload.size()));
+  os.write(payload.data(), payload.size());
+  os.flush();
+  if(!os) {
+    // The changes in this record are lost to the next one, which has to be full
+    written_ = 0;
+    throw runtime_error("ISAM2Checkpoint: could not write record");
+  }
+  written_ = &isam;
+  return 3 * sizeof(uint32) + 2 * sizeof(uint64) + payload.size();
+}
+
+/* ************************************************************************* */
+size_t ISAM2Checkpoint::Restore(std::istream& is, ISAM2& isam) {
+  gttic(ISAM2Checkpoint_Restore);
+  RestoredState state;
+  std::vector<char> payload; // Reused for all records
+  size_t nrRecords = 0;
+  bool restored = false;
+  while(true) {
+    // Header, stopping at the end or at a record cut short
+    uint32 header[3];
+    uint64 length, sum;
+    is.read(reinterpret_cast<char*>(header), sizeof(header));
+    is.read(reinterpret_cast<char*>(&length), sizeof(length));
+    is.read(reinterpret_cast<char*>(&sum), sizeof(sum));
+    if(!is)
+      break;
+    if(header[0] != magic || header[1] != FormatVersion)
+      throw runtime_error("ISAM2Checkpoint: not a checkpoint of this version and byte order");
+    if(header[2] != FullRecord && (header[2] != IncrementalRecord || !restored))
+      throw runtime_error("ISAM2Checkpoint: checkpoint does not start with a full record");
+    payload.resize(length);
+    if(length > 0)
+      is.read(&payload[0], length);
+    if(!is || checksum(payload.empty() ? 0 : &payload[0], payload.size()) != sum)
+      break;
+
+    RecordBuffer buffer(payload.empty() ? 0 : &payload[0], payload.size());
+    istream record(&buffer);
+    readRecord(record, header[2] == FullRecord, state);
+    restored = true;
+    ++nrRecords;
+  }
+  if(!restored)
+    throw runtime_error("ISAM2Checkpoint: no complete record to restore");
+
+  // Nonlinear state
+  isam.clear();
+  isam.estimateCache_.clear();
+  isam.update_count_ = state.updateCount;
+  isam.doglegDelta_ = state.doglegDelta;
+  isam.theta_ = state.theta;
+  isam.nonlinearFactors_ = NonlinearFactorGraph();
+  isam.nonlinearFactors_.reserve(state.factors.size());
+  BOOST_FOREACH(const NonlinearFactor::shared_ptr& factor, state.factors)
+    isam.nonlinearFactors_.push_back(factor);
+  isam.variableIndex_ = VariableIndex(isam.nonlinearFactors_);
+  isam.fixedVariables_ = FastSet<Key>(state.fixedVariables);
+
+  // Cached linearized factors, which are linearized at the current linearization point
+  isam.linearFactors_ = GaussianFactorGraph();
+  if(isam.params_.cacheLinearizedFactors)
+    isam.linearFactors_ = *isam.nonlinearFactors_.linearize(isam.theta_);
+
+  // Linear solution
+  isam.delta_ = state.delta;
+  isam.deltaNewton_ = state.deltaNewton;
+  isam.RgProd_ = state.RgProd;
+  isam.deltaReplacedMask_ = FastSet<Key>(state.replacedMask);
+
+  // Bayes tree, the children of every clique in the order they were written
+  std::vector<std::pair<ISAM2::sharedClique, const RestoredClique*> > stack;
+  BOOST_FOREACH(uint64 id, state.roots) {
+    const RestoredClique& restoredRoot = state.cliques.at(id);
+    isam.roots_.push_back(restoreClique(restoredRoot));
+    stack.push_back(make_pair(isam.roots_.back(), &restoredRoot));
+  }
+  while(!stack.empty()) {
+    const ISAM2::sharedClique clique = stack.back().first;
+    const RestoredClique& restoredClique = *stack.back().second;
+    stack.pop_back();
+    BOOST_FOREACH(Key frontal, clique->conditional()->frontals())
+      isam.nodes_.insert(make_pair(frontal, clique));
+    BOOST_FOREACH(uint64 id, restoredClique.children) {
+      const RestoredClique& restoredChild = state.cliques.at(id);
+      const ISAM2::sharedClique child = restoreClique(restoredChild);
+      child->parent_ = clique;
+      clique->children.push_back(child);
+      stack.push_back(make_pair(child, &restoredChild));
+    }
+  }
+  isam.trackNewCliques(isam.roots_, ISAM2::Cliques());
+
+  if(isam.params_.enableSnapshots)
+    isam.publishSnapshot();
+
+  return nrRecords;
+}
+
+} // namespace gtsam
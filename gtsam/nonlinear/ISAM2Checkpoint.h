@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Checkpoint.h
+ * @brief   Versioned binary checkpoints of ISAM2, written incrementally
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <boost/cstdint.hpp>
+
+#include <iosfwd>
+
+namespace gtsam {
+
+/**
+ * Writes the state of an ISAM2 as a sequence of binary records, and restores
+ * it from them, for crash recovery of long-running estimators.
+ *
+ * The first record written is a full snapshot.  Writing it activates the
+ * checkpoint journal of the ISAM2, in which update() and marginalizeLeaves()
+ * record what they change, and each later record only holds those changes:
+ * the variables added, relinearized, or removed, the deltas that changed, the
+ * factor slots that were filled or emptied, and the cliques that were created
+ * or changed, with the ids of their children.  So a record costs time in
+ * proportion to the changes since the previous one, which the writer finds
+ * without comparing the ISAM2 with what it wrote before, and the writer keeps
+ * no references to the state of the ISAM2.  Cliques spilled to an
+ * ISAM2CliqueStore are written from the page file and stay spilled.
+ *
+ * The linear parts (conditionals, cached factors, and the deltas) are written
+ * as raw matrix data and restored with one read per matrix.  Only variable
+ * values and nonlinear factors, whose types are not known here, go through
+ * Boost.Serialization, so those types need to be exported as for
+ * gtsam/base/serialization.h.  Cached linearized factors are not written, as
+ * Restore() recomputes them from the factors and the linearization point.
+ *
+ * Records are appended to the stream given to write().  Each one starts with
+ * a header holding the format version, written in native byte order, and its
+ * length and checksum, so that Restore() can stop at a record that was cut
+ * short by a crash and recover the state as of the last complete record.  To
+ * compact a file, call reset() and write to a new file.
+ *
+ * Only one writer may be used with an ISAM2, since it takes the changes from
+ * the journal of the ISAM2.  Call detach() when no more records of an ISAM2
+ * will be written, or the journal keeps recording its changes, though never
+ * more than a full record would hold.
+ */
+class GTSAM_EXPORT ISAM2Checkpoint {
+public:
+  static const unsigned int FormatVersion = 2; ///< Version written in each record header
+
+  typedef boost::shared_ptr<ISAM2Checkpoint> shared_ptr;
+
+private:
+  const ISAM2* written_;        ///< The ISAM2 written since the last full record, if any
+  boost::uint64_t nextCliqueId_;
+
+public:
+  /// Create a writer whose first record will be a full snapshot
+  ISAM2Checkpoint();
+
+  /**
+   * Append a record of the state of isam to os, a full snapshot on the first
+   * call, after reset(), or when given another ISAM2 than in the previous
+   * call, and otherwise only the changes since the previous call.
+   * @return The number of bytes written
+   */
+  size_t write(const ISAM2& isam, std::ostream& os);
+
+  /// Make the next record a full snapshot, e.g., to start a new file
+  void reset();
+
+  /// Stop isam from recording changes, when no more records of it will be
+  /// written, so that its journal does not grow.  The next record of isam is
+  /// then a full snapshot.
+  void detach(const ISAM2& isam);
+
+  /**
+   * Replay the records in is and restore the state they describe into isam,
+   * which should be constructed with the parameters of the ISAM2 that was
+   * written.  A last record cut short by a crash is ignored.  Cached
+   * linearized factors are relinearized if the parameters of isam require
+   * them.
+   * @return The number of records restored
+   */
+  static size_t Restore(std::istream& is, ISAM2& isam);
+};
+
+} // namespace gtsam
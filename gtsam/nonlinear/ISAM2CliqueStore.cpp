@@ -0,0 +1,358 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2CliqueStore.cpp
+ * @brief   Memory-mapped file to which ISAM2 spills the matrices of cliques it has not used recently
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2CliqueStore.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+#ifndef _WIN32
+#  include <sys/types.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+  enum { SpilledNone = 0, SpilledConditional = 1, SpilledJacobian = 2, SpilledHessian = 3 };
+
+  const size_t minimumFileSize = 1 << 20;
+
+  // Block dimensions of the active part of a block matrix, including the rhs
+  template<class BLOCKMATRIX>
+  FastVector<DenseIndex> blockDims(const BLOCKMATRIX& matrix) {
+    FastVector<DenseIndex> dims(matrix.nBlocks());
+    for(DenseIndex block = 0; block < matrix.nBlocks(); ++block)
+      dims[block] = (block + 1 < matrix.nBlocks() ? matrix.offset(block + 1) : matrix.offset(0) + matrix.cols())
+          - matrix.offset(block);
+    return dims;
+  }
+}
+
+/* ************************************************************************* */
+ISAM2CliqueStore::Page::~Page() {
+  if(ISAM2CliqueStore::shared_ptr store = store_.lock())
+    store->release(offset_, bytes_);
+}
+
+/* ************************************************************************* */
+ISAM2CliqueStore::ISAM2CliqueStore(const string& path) :
+    path_(path), now_(0), end_(0), capacity_(0), spilledBytes_(0), pages_(0)
+{
+  if(path_.empty())
+    path_ = (boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("gtsam-isam2-%%%%-%%%%-%%%%.pages")).string();
+#ifdef _WIN32
+  file_.open(path_.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+  if(!file_)
+    throw runtime_error("ISAM2CliqueStore: cannot create " + path_);
+#else
+  map_ = 0;
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if(fd_ < 0)
+    throw runtime_error("ISAM2CliqueStore: cannot create " + path_ + ": " + strerror(errno));
+  // The descriptor and the mapping keep a temporary file until they are closed, also by a crash
+  if(path.empty())
+    ::unlink(path_.c_str());
+#endif
+}
+
+/* ************************************************************************* */
+ISAM2CliqueStore::~ISAM2CliqueStore() {
+#ifdef _WIN32
+  file_.close();
+#else
+  if(map_)
+    ::munmap(map_, capacity_);
+  ::close(fd_);
+#endif
+  boost::system::error_code ignored;
+  boost::filesystem::remove(path_, ignored);
+}
+
+/* ************************************************************************* */
+size_t ISAM2CliqueStore::allocate(size_t bytes) {
+  // Best fit among the free extents, or else at the end of the file
+  multimap<size_t, size_t>::iterator fit = freeBySize_.lower_bound(bytes);
+  if(fit == freeBySize_.end()) {
+    const size_t offset = end_;
+    reserve(end_ + bytes);
+    end_ += bytes;
+    return offset;
+  }
+  const size_t offset = fit->second, size = fit->first;
+  freeBySize_.erase(fit);
+  freeByOffset_.erase(offset);
+  if(size > bytes) {
+    freeBySize_.insert(make_pair(size - bytes, offset + bytes));
+    freeByOffset_.insert(make_pair(offset + bytes, size - bytes));
+  }
+  return offset;
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::release(size_t offset, size_t bytes) {
+  boost::mutex::scoped_lock lock(mutex_);
+  spilledBytes_ -= bytes;
+  -- pages_;
+
+  // Merge with the free extents on either side
+  map<size_t, size_t>::iterator next = freeByOffset_.lower_bound(offset);
+  if(next != freeByOffset_.begin()) {
+    map<size_t, size_t>::iterator previous = next;
+    -- previous;
+    if(previous->first + previous->second == offset) {
+      offset = previous->first;
+      bytes += previous->second;
+      for(multimap<size_t, size_t>::iterator it = freeBySize_.lower_bound(previous->second); ; ++it)
+        if(it->second == previous->first) { freeBySize_.erase(it); break; }
+      freeByOffset_.erase(previous);
+    }
+  }
+  if(next != freeByOffset_.end() && offset + bytes == next->first) {
+    bytes += next->second;
+    for(multimap<size_t, size_t>::iterator it = freeBySize_.lower_bound(next->second); ; ++it)
+      if(it->second == next->first) { freeBySize_.erase(it); break; }
+    freeByOffset_.erase(next);
+  }
+
+  if(offset + bytes == end_) {
+    end_ = offset;
+  } else {
+    freeBySize_.insert(make_pair(bytes, offset));
+    freeByOffset_.insert(make_pair(offset, bytes));
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::reserve(size_t end) {
+  if(end <= capacity_)
+    return;
+  const size_t capacity = std::max(std::max(end, 2 * capacity_), minimumFileSize);
+#ifdef _WIN32
+  capacity_ = capacity;
+#else
+  if(::ftruncate(fd_, off_t(capacity)) != 0)
+    throw runtime_error("ISAM2CliqueStore: cannot grow " + path_ + ": " + strerror(errno));
+  if(map_)
+    ::munmap(map_, capacity_);
+  void* map = ::mmap(0, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if(map == MAP_FAILED) {
+    map_ = 0;
+    capacity_ = 0;
+    throw runtime_error("ISAM2CliqueStore: cannot map " + path_ + ": " + strerror(errno));
+  }
+  map_ = static_cast<char*>(map);
+  capacity_ = capacity;
+#endif
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::write(size_t offset, const double* data, size_t n) {
+#ifdef _WIN32
+  file_.seekp(offset);
+  file_.write(reinterpret_cast<const char*>(data), n * sizeof(double));
+  if(!file_)
+    throw runtime_error("ISAM2CliqueStore: cannot write to " + path_);
+#else
+  memcpy(map_ + offset, data, n * sizeof(double));
+#endif
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::read(size_t offset, double* data, size_t n) {
+#ifdef _WIN32
+  file_.seekg(offset);
+  file_.read(reinterpret_cast<char*>(data), n * sizeof(double));
+  if(!file_)
+    throw runtime_error("ISAM2CliqueStore: cannot read from " + path_);
+#else
+  memcpy(data, map_ + offset, n * sizeof(double));
+#endif
+}
+
+/* ************************************************************************* */
+size_t ISAM2CliqueStore::writeFactor(const GaussianFactor::shared_ptr& factor, size_t offset, Layout& layout) {
+  layout.size = 0;
+  layout.nrFrontals = 0;
+  layout.rows = 0;
+  if(!factor) {
+    layout.kind = SpilledNone;
+    return 0;
+  }
+  layout.keys.assign(factor->begin(), factor->end());
+  if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get())) {
+    // Also conditionals, which derive from JacobianFactor
+    const GaussianConditional* conditional = dynamic_cast<const GaussianConditional*>(jacobian);
+    layout.kind = conditional ? SpilledConditional : SpilledJacobian;
+    layout.nrFrontals = conditional ? conditional->nrFrontals() : 0;
+    const VerticalBlockMatrix& Ab = jacobian->matrixObject();
+    layout.dims = blockDims(Ab);
+    layout.rows = Ab.rows();
+    layout.model = jacobian->get_model();
+    const Matrix active = Ab.full();
+    layout.size = active.size();
+    write(offset, active.data(), layout.size);
+  } else if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor.get())) {
+    layout.kind = SpilledHessian;
+    const SymmetricBlockMatrix& info = hessian->matrixObject();
+    layout.dims = blockDims(info);
+    const Matrix& whole = info.matrix().nestedExpression();
+    const Matrix active = whole.bottomRightCorner(info.rows(), info.cols());
+    layout.size = active.size();
+    write(offset, active.data(), layout.size);
+  } else {
+    throw invalid_argument("ISAM2CliqueStore: only Jacobian and Hessian factors and Gaussian conditionals can be spilled");
+  }
+  return layout.size;
+}
+
+/* ************************************************************************* */
+GaussianFactor::shared_ptr ISAM2CliqueStore::readFactor(size_t offset, const Layout& layout) {
+  if(layout.kind == SpilledNone)
+    return GaussianFactor::shared_ptr();
+  if(layout.kind == SpilledHessian) {
+    SymmetricBlockMatrix info(layout.dims);
+    Matrix& matrix = info.matrix().nestedExpression();
+    read(offset, matrix.data(), layout.size);
+    return boost::make_shared<HessianFactor>(layout.keys, info);
+  }
+  VerticalBlockMatrix Ab(layout.dims, layout.rows);
+  read(offset, Ab.matrix().data(), layout.size);
+  if(layout.kind == SpilledConditional)
+    return boost::make_shared<GaussianConditional>(layout.keys, layout.nrFrontals, Ab, layout.model);
+  else
+    return boost::make_shared<JacobianFactor>(layout.keys, Ab, layout.model);
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::tick() {
+  boost::mutex::scoped_lock lock(mutex_);
+  ++now_;
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::touched(const boost::shared_ptr<ISAM2Clique>& clique) {
+  boost::mutex::scoped_lock lock(mutex_);
+  clique->lastAccess_.store(now_);
+  queue_.push_back(make_pair(now_, boost::weak_ptr<ISAM2Clique>(clique)));
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::access(const ISAM2Clique& clique) {
+  sharedPage page; // Released after unlocking, as it frees its space under the lock
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if(!clique.page_)
+      return; // Read back by another thread meanwhile
+    gttic(ISAM2CliqueStore_read);
+    // Logically const: the clique has the same conditional and cached factor after reading them back
+    ISAM2Clique& mutableClique = const_cast<ISAM2Clique&>(clique);
+    const Page& spilled = *clique.page_;
+    mutableClique.conditional_ = spilled.conditionalObject_.lock();
+    if(!mutableClique.conditional_)
+      mutableClique.conditional_ = boost::static_pointer_cast<GaussianConditional>(
+          readFactor(spilled.offset_, spilled.conditional_));
+    mutableClique.cachedFactor_ = spilled.cachedFactorObject_.lock();
+    if(!mutableClique.cachedFactor_)
+      mutableClique.cachedFactor_ = readFactor(
+          spilled.offset_ + spilled.conditional_.size * sizeof(double), spilled.cachedFactor_);
+    page.swap(mutableClique.page_);
+    clique.spilled_.store(false, boost::memory_order_release);
+    queue_.push_back(make_pair(now_, boost::weak_ptr<ISAM2Clique>(mutableClique.shared_from_this())));
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::peek(const ISAM2Clique& clique, boost::shared_ptr<GaussianConditional>& conditional,
+    GaussianFactor::shared_ptr& cachedFactor) {
+  boost::mutex::scoped_lock lock(mutex_);
+  if(!clique.page_) {
+    conditional = clique.conditional_;
+    cachedFactor = clique.cachedFactor_;
+    return;
+  }
+  gttic(ISAM2CliqueStore_peek);
+  const Page& spilled = *clique.page_;
+  conditional = spilled.conditionalObject_.lock();
+  if(!conditional)
+    conditional = boost::static_pointer_cast<GaussianConditional>(readFactor(spilled.offset_, spilled.conditional_));
+  cachedFactor = spilled.cachedFactorObject_.lock();
+  if(!cachedFactor)
+    cachedFactor = readFactor(spilled.offset_ + spilled.conditional_.size * sizeof(double), spilled.cachedFactor_);
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::spill(ISAM2Clique& clique) {
+  const GaussianConditional& conditional = *clique.conditional_;
+  size_t n = conditional.matrixObject().rows() * conditional.matrixObject().cols();
+  if(const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(clique.cachedFactor_.get()))
+    n += jacobian->matrixObject().rows() * jacobian->matrixObject().cols();
+  else if(const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(clique.cachedFactor_.get()))
+    n += hessian->matrixObject().rows() * hessian->matrixObject().cols();
+
+  sharedPage page = boost::make_shared<Page>();
+  page->bytes_ = n * sizeof(double);
+  page->offset_ = allocate(page->bytes_);
+  const size_t conditionalSize = writeFactor(clique.conditional_, page->offset_, page->conditional_);
+  writeFactor(clique.cachedFactor_, page->offset_ + conditionalSize * sizeof(double), page->cachedFactor_);
+  page->conditionalObject_ = clique.conditional_;
+  page->cachedFactorObject_ = clique.cachedFactor_;
+  page->store_ = shared_from_this();
+  spilledBytes_ += page->bytes_;
+  ++ pages_;
+
+  clique.page_ = page;
+  clique.spilled_.store(true, boost::memory_order_release);
+  clique.conditional_.reset();
+  clique.cachedFactor_.reset();
+}
+
+/* ************************************************************************* */
+void ISAM2CliqueStore::spillCold(size_t age) {
+  gttic(ISAM2CliqueStore_spillCold);
+  // Cliques looked at are released after unlocking, as releasing the last
+  // reference to a spilled clique frees its space under the lock
+  vector<boost::shared_ptr<ISAM2Clique> > cliques;
+  boost::mutex::scoped_lock lock(mutex_);
+  while(!queue_.empty() && queue_.front().first + age <= now_) {
+    cliques.push_back(queue_.front().second.lock());
+    queue_.pop_front();
+    ISAM2Clique* clique = cliques.back().get();
+    if(!clique || clique->page_ || !clique->conditional_)
+      continue;
+    const size_t lastAccess = clique->lastAccess_.load();
+    if(lastAccess + age > now_)
+      queue_.push_back(make_pair(lastAccess, boost::weak_ptr<ISAM2Clique>(cliques.back()))); // Used since
+    else
+      spill(*clique);
+  }
+}
+
+} // namespace gtsam
@@ -0,0 +1,169 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2CliqueStore.h
+ * @brief   Memory-mapped file to which ISAM2 spills the matrices of cliques it has not used recently
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+#include <deque>
+#include <map>
+#include <string>
+#ifdef _WIN32
+#  include <fstream>
+#endif
+
+namespace gtsam {
+
+// Forward declaration
+class ISAM2Clique;
+
+/**
+ * A file, mapped into memory, holding the conditionals and cached factors of
+ * the cliques of an ISAM2 that were not used for a number of updates, see
+ * ISAM2Params::spillAfterUpdates.  The matrices of a clique are written as
+ * raw doubles and released from memory, while the keys, block dimensions,
+ * and noise models stay with the clique.  Any access to the conditional or
+ * cached factor of a spilled clique reads them back, so that removeTop(),
+ * wildfire back-substitution, and marginals reach spilled cliques as usual.
+ *
+ * The store also keeps the cliques in the order in which they were last
+ * used, so that finding the cold ones costs time in proportion to the
+ * cliques created or used since the last update and not to the size of the
+ * tree.  Space of cliques read back is reused, and the file is removed when
+ * the store is destroyed: it is not meant to persist, see ISAM2Checkpoint.
+ * A temporary file is removed from the file system as soon as it is created,
+ * so that it does not outlive a process that crashes.
+ *
+ * Reading back and spilling are serialized by the store's mutex, so spilled
+ * cliques may be read from several threads.  Resident cliques are marked as
+ * used and checked for being spilled without the lock, see
+ * ISAM2Clique::ensureResident, so they are read as fast as without a store.
+ *
+ * On Windows the file is read and written with streams instead of mapped,
+ * and a temporary file is only removed when the store is destroyed.
+ */
+class GTSAM_EXPORT ISAM2CliqueStore : public boost::enable_shared_from_this<ISAM2CliqueStore> {
+public:
+  typedef boost::shared_ptr<ISAM2CliqueStore> shared_ptr;
+
+  /// Layout of a spilled factor, kept in memory to rebuild it
+  struct Layout {
+    int kind;                      ///< None, conditional, Jacobian or Hessian
+    FastVector<Key> keys;
+    size_t nrFrontals;
+    FastVector<DenseIndex> dims;   ///< Block dimensions, including the right-hand side
+    DenseIndex rows;
+    SharedDiagonal model;
+    size_t size;                   ///< Number of doubles in the file
+  };
+
+  /** Where the matrices of a spilled clique are.  Copies of a clique share
+   * their page, and its space is freed once the last of them is destroyed or
+   * read back. */
+  class GTSAM_EXPORT Page {
+    friend class ISAM2CliqueStore;
+    boost::weak_ptr<ISAM2CliqueStore> store_;
+    size_t offset_, bytes_;
+    Layout conditional_, cachedFactor_;
+    boost::weak_ptr<GaussianConditional> conditionalObject_; ///< Reused if still held elsewhere, e.g., by a snapshot
+    boost::weak_ptr<GaussianFactor> cachedFactorObject_;
+  public:
+    ~Page();
+    /// Layout of the spilled conditional, whose keys stay in memory
+    const Layout& conditional() const { return conditional_; }
+  };
+  typedef boost::shared_ptr<Page> sharedPage;
+
+private:
+  boost::mutex mutex_;
+  std::string path_;
+  size_t now_;                                  ///< Number of ISAM2 updates
+  std::deque<std::pair<size_t, boost::weak_ptr<ISAM2Clique> > > queue_; ///< Cliques by time of last use, roughly
+  size_t end_;                                  ///< End of the used part of the file
+  size_t capacity_;                             ///< Size of the file
+  size_t spilledBytes_;
+  size_t pages_;
+  std::multimap<size_t, size_t> freeBySize_;    ///< Free extents, size to offset
+  std::map<size_t, size_t> freeByOffset_;       ///< Free extents, offset to size
+#ifdef _WIN32
+  std::fstream file_;
+#else
+  int fd_;
+  char* map_;
+#endif
+
+  size_t allocate(size_t bytes);
+  void release(size_t offset, size_t bytes);
+  void reserve(size_t end);
+  void write(size_t offset, const double* data, size_t n);
+  void read(size_t offset, double* data, size_t n);
+  size_t writeFactor(const GaussianFactor::shared_ptr& factor, size_t offset, Layout& layout);
+  GaussianFactor::shared_ptr readFactor(size_t offset, const Layout& layout);
+  void spill(ISAM2Clique& clique);
+
+public:
+  /// Create the file at path, replacing any file there.  With an empty path, a temporary file is used.
+  explicit ISAM2CliqueStore(const std::string& path = "");
+
+  /// Unmap and remove the file
+  ~ISAM2CliqueStore();
+
+  /// The path of the file, which no longer exists if it was temporary
+  const std::string& path() const { return path_; }
+
+  /// Count one more ISAM2 update
+  void tick();
+
+  /// The number of ISAM2 updates counted
+  size_t now() const { return now_; }
+
+  /// Register a new clique, or one read back, as used now
+  void touched(const boost::shared_ptr<ISAM2Clique>& clique);
+
+  /// Read back a spilled clique, called by ISAM2Clique::ensureResident on access to it
+  void access(const ISAM2Clique& clique);
+
+  /// The conditional and cached factor of a clique, read into new objects if it is spilled,
+  /// without reading it back or marking it as used, e.g. to write it to a checkpoint
+  void peek(const ISAM2Clique& clique, boost::shared_ptr<GaussianConditional>& conditional,
+      GaussianFactor::shared_ptr& cachedFactor);
+
+  /// Spill the registered cliques not used in the last age updates
+  void spillCold(size_t age);
+
+  /// The number of cliques spilled and not read back
+  size_t spilledCliques() const { return pages_; }
+
+  /// The bytes of matrix data of the spilled cliques
+  size_t spilledBytes() const { return spilledBytes_; }
+
+  /// The size of the file
+  size_t fileSize() const { return capacity_; }
+
+private:
+  ISAM2CliqueStore(const ISAM2CliqueStore&);
+  ISAM2CliqueStore& operator=(const ISAM2CliqueStore&);
+};
+
+} // namespace gtsam
@@ -0,0 +1,340 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Distributed.cpp
+ * @brief   Distributed smoothing with one ISAM2 per agent, fused by a coordinator over separator summaries
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Distributed.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+  typedef boost::uint64_t uint64;
+  typedef boost::uint32_t uint32;
+
+  const uint32 magic = 0x53443249; // "I2DS" in little-endian messages
+  const uint32 formatVersion = 1;
+  enum { SummaryMessage = 1, EstimateMessage = 2 };
+
+  /* ************************************************************************* */
+  // Raw native-endian values, as messages stay on one machine or between alike ones
+  template<typename T>
+  void put(ostream& os, const T& x) {
+    os.write(reinterpret_cast<const char*>(&x), sizeof(T));
+  }
+
+  template<typename T>
+  T get(istream& is) {
+    T x;
+    is.read(reinterpret_cast<char*>(&x), sizeof(T));
+    if(!is)
+      throw runtime_error("ISAM2Distributed: message ends unexpectedly");
+    return x;
+  }
+
+  // Throws if the rest of the message is shorter than count items of the given
+  // size, so that lengths read from a message are checked before allocating
+  void checkRemaining(istream& is, uint64 count, uint64 size) {
+    const streamsize available = is.rdbuf()->in_avail();
+    if(available < 0 || count > uint64(available) / size)
+      throw runtime_error("ISAM2Distributed: message ends unexpectedly");
+  }
+
+  void putString(ostream& os, const string& s) {
+    put(os, uint64(s.size()));
+    os.write(s.data(), s.size());
+  }
+
+  string getString(istream& is) {
+    const uint64 length = get<uint64>(is);
+    checkRemaining(is, length, 1);
+    string s(size_t(length), '\0');
+    if(!s.empty())
+      is.read(&s[0], s.size());
+    if(!is)
+      throw runtime_error("ISAM2Distributed: message ends unexpectedly");
+    return s;
+  }
+
+  /* ************************************************************************* */
+  void putHeader(ostream& os, uint32 type) {
+    put(os, magic);
+    put(os, formatVersion);
+    put(os, type);
+  }
+
+  uint32 getHeader(istream& is) {
+    if(get<uint32>(is) != magic)
+      throw runtime_error("ISAM2Distributed: not a distributed ISAM2 message");
+    if(get<uint32>(is) != formatVersion)
+      throw runtime_error("ISAM2Distributed: unsupported message format version");
+    return get<uint32>(is);
+  }
+
+  /* ************************************************************************* */
+  typedef pair<size_t, ISAM2::sharedClique> DepthClique;
+
+  bool deeper(const DepthClique& a, const DepthClique& b) {
+    return a.first > b.first;
+  }
+}
+
+/* ************************************************************************* */
+string ISAM2SeparatorSummary::serialize() const {
+  ostringstream os;
+  putHeader(os, SummaryMessage);
+  put(os, uint64(agent));
+  put(os, uint64(sequence));
+  put(os, uint32(factor ? 1 : 0));
+  if(factor) {
+    const HessianFactor::shared_ptr hessian = boost::dynamic_pointer_cast<HessianFactor>(factor->factor());
+    if(!hessian || !factor->hasLinearizationPoint())
+      throw invalid_argument("ISAM2SeparatorSummary: the summary has to be a HessianFactor with a linearization point");
+    put(os, uint64(hessian->size()));
+    for(HessianFactor::const_iterator key = hessian->begin(); key != hessian->end(); ++key) {
+      put(os, uint64(*key));
+      put(os, uint64(hessian->getDim(key)));
+    }
+    // Upper triangle of the augmented information matrix, by rows
+    const Matrix information = hessian->augmentedInformation();
+    for(DenseIndex i = 0; i < information.rows(); ++i)
+      for(DenseIndex j = i; j < information.cols(); ++j)
+        put(os, information(i, j));
+    putString(os, serializeBinary(*factor->linearizationPoint()));
+  }
+  return os.str();
+}
+
+/* ************************************************************************* */
+ISAM2SeparatorSummary ISAM2SeparatorSummary::Deserialize(const string& message) {
+  istringstream is(message);
+  if(getHeader(is) != SummaryMessage)
+    throw runtime_error("ISAM2SeparatorSummary: the message is not a separator summary");
+  ISAM2SeparatorSummary summary;
+  summary.agent = size_t(get<uint64>(is));
+  summary.sequence = size_t(get<uint64>(is));
+  if(get<uint32>(is)) {
+    const uint64 n = get<uint64>(is);
+    checkRemaining(is, n, 2 * sizeof(uint64));
+    FastVector<Key> keys((size_t(n)));
+    FastVector<DenseIndex> dims((size_t(n)));
+    DenseIndex total = 1;
+    for(size_t k = 0; k < n; ++k) {
+      keys[k] = Key(get<uint64>(is));
+      const uint64 dim = get<uint64>(is);
+      // The upper triangle has at least total entries
+      checkRemaining(is, uint64(total) + dim, sizeof(double));
+      dims[k] = DenseIndex(dim);
+      total += dims[k];
+    }
+    checkRemaining(is, uint64(total) * uint64(total + 1) / 2, sizeof(double));
+    Matrix information(total, total);
+    for(DenseIndex i = 0; i < information.rows(); ++i)
+      for(DenseIndex j = i; j < information.cols(); ++j)
+        information(i, j) = get<double>(is);
+    Values linearizationPoint;
+    deserializeBinary(getString(is), linearizationPoint);
+    const HessianFactor hessian(keys, SymmetricBlockMatrix(dims, information, true));
+    summary.factor = boost::make_shared<LinearContainerFactor>(hessian, linearizationPoint);
+  }
+  return summary;
+}
+
+/* ************************************************************************* */
+ISAM2Agent::ISAM2Agent(size_t id, const ISAM2Params& params) :
+    id_(id), isam_(params), sequence_(0) {}
+
+/* ************************************************************************* */
+void ISAM2Agent::addSeparator(const KeyVector& keys) {
+  separator_.insert(keys.begin(), keys.end());
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2Agent::update(const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const vector<size_t>& removeFactorIndices) {
+  // Like the default of ISAM2, the variables of the new factors go near the
+  // top, and the separator variables above them
+  FastMap<Key, int> constrainedKeys;
+  BOOST_FOREACH(Key key, newFactors.keys())
+    constrainedKeys[key] = 1;
+  BOOST_FOREACH(Key key, separator_)
+    if(isam_.getLinearizationPoint().exists(key) || newTheta.exists(key))
+      constrainedKeys[key] = 2;
+  return isam_.update(newFactors, newTheta, removeFactorIndices, constrainedKeys);
+}
+
+/* ************************************************************************* */
+void ISAM2Agent::marginalizeLeaves(const FastList<Key>& leafKeys) {
+  BOOST_FOREACH(Key key, leafKeys)
+    if(separator_.exists(key))
+      throw invalid_argument("ISAM2Agent: separator variables cannot be marginalized");
+  isam_.marginalizeLeaves(leafKeys);
+}
+
+/* ************************************************************************* */
+ISAM2SeparatorSummary ISAM2Agent::summarize() {
+  gttic(ISAM2Agent_summarize);
+  ISAM2SeparatorSummary summary;
+  summary.agent = id_;
+  summary.sequence = ++sequence_;
+
+  // Cliques on the paths from the roots to the separator variables, with their
+  // depth.  The cliques off these paths integrate to one.
+  FastMap<const ISAM2Clique*, size_t> visited;
+  vector<DepthClique> cliques;
+  Values linearizationPoint;
+  BOOST_FOREACH(Key key, separator_) {
+    ISAM2::Nodes::const_iterator node = isam_.nodes().find(key);
+    if(node == isam_.nodes().end())
+      continue;
+    linearizationPoint.insert(key, isam_.getLinearizationPoint().at(key));
+    vector<ISAM2::sharedClique> path;
+    for(ISAM2::sharedClique clique = node->second; clique && !visited.exists(clique.get()); clique = clique->parent())
+      path.push_back(clique);
+    // Depth from the first clique already visited, or from a root
+    const size_t top = path.empty() ? 0 :
+        (path.back()->parent() ? visited[path.back()->parent().get()] + 1 : 0);
+    for(size_t i = 0; i < path.size(); ++i) {
+      const size_t depth = top + path.size() - 1 - i;
+      visited[path[i].get()] = depth;
+      cliques.push_back(make_pair(depth, path[i]));
+    }
+  }
+  if(cliques.empty())
+    return summary;
+
+  // Eliminate all other variables from the bottom up, to avoid fill-in
+  std::stable_sort(cliques.begin(), cliques.end(), deeper);
+  GaussianFactorGraph graph;
+  Ordering ordering;
+  BOOST_FOREACH(const DepthClique& clique, cliques) {
+    graph.push_back(clique.second->conditional());
+    BOOST_FOREACH(Key frontal, clique.second->conditional()->frontals())
+      if(!separator_.exists(frontal))
+        ordering.push_back(frontal);
+  }
+  const GaussianFactorGraph marginal = ordering.empty() ? graph :
+      *graph.eliminatePartialSequential(ordering, EliminatePreferCholesky).second;
+  summary.factor = boost::make_shared<LinearContainerFactor>(HessianFactor(marginal), linearizationPoint);
+  return summary;
+}
+
+/* ************************************************************************* */
+bool ISAM2Agent::poll(ISAM2Transport& transport) {
+  bool received = false;
+  string message;
+  while(transport.receive(message)) {
+    istringstream is(message);
+    if(getHeader(is) != EstimateMessage)
+      throw runtime_error("ISAM2Agent: the message is not a separator estimate");
+    Values fused;
+    deserializeBinary(getString(is), fused);
+    fused_.swap(fused);
+    received = true;
+  }
+  return received;
+}
+
+/* ************************************************************************* */
+ISAM2Coordinator::ISAM2Coordinator(const ISAM2Params& params) : isam_(params) {}
+
+/* ************************************************************************* */
+void ISAM2Coordinator::addFactors(const NonlinearFactorGraph& factors, const Values& newValues) {
+  pendingFactors_.push_back(factors);
+  pendingValues_.insert(newValues);
+}
+
+/* ************************************************************************* */
+bool ISAM2Coordinator::receive(const ISAM2SeparatorSummary& summary) {
+  FastMap<size_t, size_t>::iterator last = sequences_.find(summary.agent);
+  if(last != sequences_.end() && summary.sequence <= last->second)
+    return false;
+  sequences_[summary.agent] = summary.sequence;
+  pending_[summary.agent] = summary;
+  return true;
+}
+
+/* ************************************************************************* */
+size_t ISAM2Coordinator::poll(ISAM2Transport& transport) {
+  size_t taken = 0;
+  string message;
+  while(transport.receive(message))
+    if(receive(ISAM2SeparatorSummary::Deserialize(message)))
+      ++ taken;
+  return taken;
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2Coordinator::update() {
+  gttic(ISAM2Coordinator_update);
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+  vector<size_t> removeFactors;
+  vector<size_t> agents; // Agent of each new summary factor
+
+  typedef pair<const size_t, ISAM2SeparatorSummary> AgentSummary;
+  BOOST_FOREACH(const AgentSummary& agent_summary, pending_) {
+    FastMap<size_t, size_t>::iterator slot = slots_.find(agent_summary.first);
+    if(slot != slots_.end()) {
+      removeFactors.push_back(slot->second);
+      slots_.erase(slot);
+    }
+    const boost::shared_ptr<LinearContainerFactor>& factor = agent_summary.second.factor;
+    if(factor) {
+      newFactors.push_back(factor);
+      agents.push_back(agent_summary.first);
+      // Variables new to the coordinator start at the linearization point of the summary
+      BOOST_FOREACH(Key key, factor->keys())
+        if(!isam_.getLinearizationPoint().exists(key) && !newValues.exists(key) && !pendingValues_.exists(key))
+          newValues.insert(key, factor->linearizationPoint()->at(key));
+    }
+  }
+  newFactors.push_back(pendingFactors_);
+  newValues.insert(pendingValues_);
+
+  const ISAM2Result result = isam_.update(newFactors, newValues, removeFactors);
+  for(size_t i = 0; i < agents.size(); ++i)
+    slots_[agents[i]] = result.newFactorsIndices[i];
+
+  pending_.clear();
+  pendingFactors_ = NonlinearFactorGraph();
+  pendingValues_.clear();
+  return result;
+}
+
+/* ************************************************************************* */
+void ISAM2Coordinator::broadcast(ISAM2Transport& transport) const {
+  ostringstream os;
+  putHeader(os, EstimateMessage);
+  putString(os, serializeBinary(calculateEstimate()));
+  transport.send(os.str());
+}
+
+} // namespace gtsam
@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Distributed.h
+ * @brief   Distributed smoothing with one ISAM2 per agent, fused by a coordinator over separator summaries
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/ISAM2Transport.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+
+#include <string>
+
+namespace gtsam {
+
+/**
+ * The information of one agent on its separator variables: the marginal of
+ * its local map on them, as a HessianFactor in a LinearContainerFactor at the
+ * linearization point of the agent.  Its size depends only on the number and
+ * dimensions of the separator variables.
+ */
+struct GTSAM_EXPORT ISAM2SeparatorSummary {
+  size_t agent;     ///< Id of the agent that sent the summary
+  size_t sequence;  ///< Increasing number of the summary, older ones are ignored
+  boost::shared_ptr<LinearContainerFactor> factor; ///< The marginal, null if no separator variable is known yet
+
+  ISAM2SeparatorSummary() : agent(0), sequence(0) {}
+
+  /** Encode as a message.  The linearization point goes through
+   * Boost.Serialization, so its value types need to be exported as for
+   * gtsam/base/serialization.h. */
+  std::string serialize() const;
+
+  /// Decode a message created by serialize(), throws std::runtime_error on malformed messages
+  static ISAM2SeparatorSummary Deserialize(const std::string& message);
+};
+
+/**
+ * One agent of a distributed smoother: a local ISAM2 over the map of the
+ * agent, and the set of separator variables it shares with other agents,
+ * e.g. common landmarks or poses of rendezvous.
+ *
+ * update() constrains the separator variables to be eliminated last, so
+ * they stay at the top of the local Bayes tree.  The marginal on them is
+ * then that of the conditionals on the paths from the roots to their
+ * cliques, and summarize() eliminates only those, in time that depends on
+ * the separator and the depth of its cliques but not on the size of the map.
+ *
+ * Each factor has to be in one agent, or in the coordinator, only: shared
+ * information is otherwise counted twice.  Local variables may be removed
+ * with marginalizeLeaves(), which leaves the summaries unchanged.
+ */
+class GTSAM_EXPORT ISAM2Agent {
+  size_t id_;
+  ISAM2 isam_;
+  FastSet<Key> separator_;
+  size_t sequence_;
+  Values fused_; ///< Separator estimate as last received from the coordinator
+
+public:
+  /// Create agent id with an empty local map
+  explicit ISAM2Agent(size_t id, const ISAM2Params& params = ISAM2Params());
+
+  /// Id of the agent, unique among the agents of a coordinator
+  size_t id() const { return id_; }
+
+  /// Add variables shared with other agents, existing or not yet added
+  void addSeparator(const KeyVector& keys);
+
+  /// The variables shared with other agents
+  const FastSet<Key>& separator() const { return separator_; }
+
+  /// Update the local map as ISAM2::update(), keeping the separator variables at the top of the tree
+  ISAM2Result update(const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+      const Values& newTheta = Values(),
+      const std::vector<size_t>& removeFactorIndices = std::vector<size_t>());
+
+  /// Marginalize out local variables, as ISAM2::marginalizeLeaves(); throws std::invalid_argument for separator variables
+  void marginalizeLeaves(const FastList<Key>& leafKeys);
+
+  /// The marginal of the local map on the separator variables it already has
+  ISAM2SeparatorSummary summarize();
+
+  /// Send a summary to the coordinator
+  void publish(ISAM2Transport& transport) { transport.send(summarize().serialize()); }
+
+  /// Take the separator estimates sent by the coordinator, returns whether there were any
+  bool poll(ISAM2Transport& transport);
+
+  /// The fused estimate of the separator variables, as last received from the coordinator
+  const Values& fusedSeparatorEstimate() const { return fused_; }
+
+  /// The local ISAM2
+  const ISAM2& isam() const { return isam_; }
+
+  /// The estimate of the local map
+  Values calculateEstimate() const { return isam_.calculateEstimate(); }
+};
+
+/**
+ * The coordinator of a distributed smoother, which fuses the separator
+ * summaries of the agents, and any factors between separator variables of
+ * different agents, in its own ISAM2.  A new summary of an agent replaces
+ * its previous one.  The coordinator only holds separator variables, so its
+ * solve time and the size of the messages depend on the separators and not
+ * on the maps of the agents.
+ */
+class GTSAM_EXPORT ISAM2Coordinator {
+  ISAM2 isam_;
+  FastMap<size_t, size_t> sequences_;    ///< Last summary received from each agent
+  FastMap<size_t, size_t> slots_;        ///< Factor index of the summary of each agent
+  FastMap<size_t, ISAM2SeparatorSummary> pending_; ///< Summaries received since the last update
+  NonlinearFactorGraph pendingFactors_;  ///< Factors between agents added since the last update
+  Values pendingValues_;
+
+public:
+  /// Create a coordinator with no agents
+  explicit ISAM2Coordinator(const ISAM2Params& params = ISAM2Params());
+
+  /// Add factors between separator variables, and initial values for new variables, fused at the next update()
+  void addFactors(const NonlinearFactorGraph& factors, const Values& newValues = Values());
+
+  /// Take a summary, fused at the next update(); returns false if it is older than one already taken
+  bool receive(const ISAM2SeparatorSummary& summary);
+
+  /// Take all summaries that arrived, returns the number that were not outdated
+  size_t poll(ISAM2Transport& transport);
+
+  /// Replace the summaries of agents by those received since the last call, and re-solve
+  ISAM2Result update();
+
+  /// The fused estimate of the separator variables, with a full back-substitution
+  Values calculateEstimate() const { return isam_.calculateBestEstimate(); }
+
+  /// Send the fused estimate of the separator variables to an agent
+  void broadcast(ISAM2Transport& transport) const;
+
+  /// The ISAM2 of the coordinator
+  const ISAM2& isam() const { return isam_; }
+};
+
+} // namespace gtsam
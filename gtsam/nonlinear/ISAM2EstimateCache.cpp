@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2EstimateCache.cpp
+ * @brief   Incrementally maintained estimate of ISAM2, with a history of changed variables
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2EstimateCache.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ISAM2EstimateCache::ISAM2EstimateCache(size_t historyLength) :
+    active_(false), allDirty_(true), version_(0), historyLength_(historyLength) {
+  if(historyLength == 0)
+    throw invalid_argument("ISAM2EstimateCache: the history length must be positive");
+}
+
+/* ************************************************************************* */
+void ISAM2EstimateCache::markChanged(const FastSet<Key>& keys) {
+  if(active_ && !allDirty_)
+    dirty_.insert(keys.begin(), keys.end());
+}
+
+/* ************************************************************************* */
+void ISAM2EstimateCache::markRelinearized(const FastSet<Key>& keys) {
+  if(active_) {
+    relinearized_.insert(keys.begin(), keys.end());
+    if(!allDirty_)
+      dirty_.insert(keys.begin(), keys.end());
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2EstimateCache::markRemoved(const FastSet<Key>& keys) {
+  if(active_) {
+    BOOST_FOREACH(Key key, keys) {
+      if(estimate_.exists(key)) {
+        estimate_.erase(key);
+        retracted_.erase(key);
+        removed_.insert(key);
+      }
+      dirty_.erase(key);
+      relinearized_.erase(key);
+    }
+  }
+}
+
+/* ************************************************************************* */
+const Values& ISAM2EstimateCache::refresh(const Values& theta, const VectorValues& delta, double tolerance) {
+  gttic(ISAM2EstimateCache_refresh);
+  if(allDirty_) {
+    dirty_.clear();
+    BOOST_FOREACH(Key key, theta.keys())
+      dirty_.insert(key);
+  }
+
+  KeyVector changed(removed_.begin(), removed_.end());
+  BOOST_FOREACH(Key key, dirty_) {
+    const Vector& keyDelta = delta.at(key);
+    VectorValues::iterator last = retracted_.find(key);
+    if(last != retracted_.end() && !relinearized_.exists(key)
+        && (keyDelta - last->second).lpNorm<Eigen::Infinity>() <= tolerance)
+      continue;
+
+    Value* retractedValue = theta.at(key).retract_(keyDelta);
+    if(last == retracted_.end()) {
+      estimate_.insert(key, *retractedValue);
+      retracted_.insert(key, keyDelta);
+    } else {
+      estimate_.update(key, *retractedValue);
+      last->second = keyDelta;
+    }
+    retractedValue->deallocate_();
+    changed.push_back(key);
+  }
+
+  dirty_.clear();
+  relinearized_.clear();
+  removed_.clear();
+  allDirty_ = false;
+
+  // The first refresh is version 1 even if there are no variables, so that
+  // version 0 always means "nothing seen yet"
+  if(!changed.empty() || !active_) {
+    ++version_;
+    sort(changed.begin(), changed.end());
+    changed.erase(unique(changed.begin(), changed.end()), changed.end());
+    history_.push_back(make_pair(version_, KeyVector()));
+    history_.back().second.swap(changed);
+    if(history_.size() > historyLength_)
+      history_.pop_front();
+  }
+  active_ = true;
+  return estimate_;
+}
+
+/* ************************************************************************* */
+bool ISAM2EstimateCache::changedSince(size_t version, KeyVector& keys) const {
+  keys.clear();
+  if(version >= version_)
+    return true;
+
+  // Changes of versions version+1 and later are kept if the oldest kept is at most version+1
+  if(version > 0 && !history_.empty() && history_.front().first <= version + 1) {
+    FastSet<Key> changed;
+    typedef pair<size_t, KeyVector> Version;
+    BOOST_FOREACH(const Version& entry, history_)
+      if(entry.first > version)
+        changed.insert(entry.second.begin(), entry.second.end());
+    keys.assign(changed.begin(), changed.end());
+    return true;
+  }
+
+  const KeyList all = estimate_.keys();
+  keys.assign(all.begin(), all.end());
+  return version == 0;
+}
+
+/* ************************************************************************* */
+void ISAM2EstimateCache::clear() {
+  estimate_.clear();
+  retracted_ = VectorValues();
+  dirty_.clear();
+  relinearized_.clear();
+  removed_.clear();
+  active_ = false;
+  allDirty_ = true;
+  // Skip a version without history, so that all consumers see they have to resync
+  ++version_;
+  history_.clear();
+}
+
+} // namespace gtsam
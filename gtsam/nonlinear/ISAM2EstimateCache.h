@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2EstimateCache.h
+ * @brief   Incrementally maintained estimate of ISAM2, with a history of changed variables
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Key.h>
+
+#include <deque>
+
+namespace gtsam {
+
+/**
+ * The estimate \f$ \Theta \oplus \Delta \f$ of an ISAM2, kept between calls
+ * and retracted again only for the variables whose delta changed by more than
+ * a tolerance since they were last retracted, or whose linearization point
+ * changed.  Used by ISAM2::calculateEstimateIncremental().
+ *
+ * ISAM2 reports the variables whose delta may have changed, which wildfire
+ * back-substitution already knows, so refreshing the estimate costs time in
+ * proportion to those and not to the number of variables.  Each refresh that
+ * changes the estimate increments its version and records the variables it
+ * changed, added, or removed, so that consumers of the estimate can apply
+ * only the differences since the version they last saw.
+ *
+ * The cache is inactive, and ignores reports of changes, until the first
+ * refresh, which retracts all variables.
+ */
+class GTSAM_EXPORT ISAM2EstimateCache {
+public:
+  static const size_t DefaultHistoryLength = 256; ///< Default number of versions whose changes are kept
+
+private:
+  Values estimate_;            ///< The cached estimate
+  VectorValues retracted_;     ///< The delta each cached variable was retracted by
+  FastSet<Key> dirty_;         ///< Variables whose delta may have changed since the last refresh
+  FastSet<Key> relinearized_;  ///< Variables whose linearization point changed since the last refresh
+  FastSet<Key> removed_;       ///< Variables removed since the last refresh
+  bool active_;                ///< Whether the estimate was computed at least once
+  bool allDirty_;              ///< Whether all variables need to be checked at the next refresh
+  size_t version_;             ///< Incremented by each refresh that changes the estimate
+  size_t historyLength_;
+  std::deque<std::pair<size_t, KeyVector> > history_; ///< Variables changed by each recent version
+
+public:
+  /// Create an inactive cache keeping the changes of the last historyLength versions
+  explicit ISAM2EstimateCache(size_t historyLength = DefaultHistoryLength);
+
+  /// Whether the estimate was computed at least once, and changes are tracked
+  bool active() const { return active_; }
+
+  /// Report variables whose delta may have changed, including new variables
+  void markChanged(const FastSet<Key>& keys);
+
+  /// Report that the delta of any variable may have changed
+  void markAllChanged() { allDirty_ = true; }
+
+  /// Report variables whose linearization point changed
+  void markRelinearized(const FastSet<Key>& keys);
+
+  /// Report removed variables
+  void markRemoved(const FastSet<Key>& keys);
+
+  /**
+   * Bring the estimate up to date with linearization point theta and delta,
+   * retracting again the reported variables whose linearization point changed
+   * or whose delta differs by more than tolerance in max-norm from the one
+   * they were last retracted by.
+   */
+  const Values& refresh(const Values& theta, const VectorValues& delta, double tolerance);
+
+  /// The estimate as of the last refresh
+  const Values& estimate() const { return estimate_; }
+
+  /// The current version, 0 before the first refresh
+  size_t version() const { return version_; }
+
+  /**
+   * The variables changed, added, or removed since the given version, sorted.
+   * @return false if the changes since version are no longer kept, in which
+   * case keys holds all current variables and the consumer has to resync.
+   */
+  bool changedSince(size_t version, KeyVector& keys) const;
+
+  /// Forget the estimate and the history of changes, and become inactive
+  void clear();
+};
+
+} // namespace gtsam
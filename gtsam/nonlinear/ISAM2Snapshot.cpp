@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Snapshot.cpp
+ * @brief   Immutable versions of the ISAM2 Bayes tree and estimate, for concurrent readers
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Snapshot.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <boost/foreach.hpp>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+vector<const ISAM2Snapshot::Node*> ISAM2Snapshot::pathTo(Key key) const {
+  // Depth-first search with an explicit stack, as trees of long trajectories are deep.
+  // Each entry is a node and the number of its children already visited.
+  vector<pair<const Node*, size_t> > stack;
+  BOOST_FOREACH(const sharedNode& root, roots_) {
+    stack.push_back(make_pair(root.get(), 0));
+    if(root->conditional->find(key) < root->conditional->endFrontals())
+      break;
+    while(!stack.empty()) {
+      pair<const Node*, size_t>& top = stack.back();
+      if(top.second == top.first->children.size()) {
+        stack.pop_back();
+        continue;
+      }
+      const Node* child = top.first->children[top.second++].get();
+      stack.push_back(make_pair(child, 0));
+      if(child->conditional->find(key) < child->conditional->endFrontals())
+        break;
+    }
+    if(!stack.empty())
+      break;
+  }
+  if(stack.empty())
+    throw out_of_range("ISAM2Snapshot: requested variable is not in the snapshot");
+
+  vector<const Node*> path;
+  path.reserve(stack.size());
+  typedef pair<const Node*, size_t> Entry;
+  BOOST_FOREACH(const Entry& entry, stack)
+    path.push_back(entry.first);
+  return path;
+}
+
+/* ************************************************************************* */
+VectorValues ISAM2Snapshot::solvePath(const vector<const Node*>& path) {
+  VectorValues delta;
+  BOOST_FOREACH(const Node* node, path)
+    delta.insert(node->conditional->solve(delta));
+  return delta;
+}
+
+/* ************************************************************************* */
+bool ISAM2Snapshot::exists(Key key) const {
+  try {
+    pathTo(key);
+    return true;
+  } catch(const out_of_range&) {
+    return false;
+  }
+}
+
+/* ************************************************************************* */
+VectorValues ISAM2Snapshot::getDelta() const {
+  gttic(ISAM2Snapshot_getDelta);
+  VectorValues delta;
+  vector<const Node*> stack;
+  BOOST_FOREACH(const sharedNode& root, roots_)
+    stack.push_back(root.get());
+  while(!stack.empty()) {
+    const Node* node = stack.back();
+    stack.pop_back();
+    delta.insert(node->conditional->solve(delta));
+    BOOST_FOREACH(const sharedNode& child, node->children)
+      stack.push_back(child.get());
+  }
+  return delta;
+}
+
+/* ************************************************************************* */
+Vector ISAM2Snapshot::getDelta(Key key) const {
+  return solvePath(pathTo(key)).at(key);
+}
+
+/* ************************************************************************* */
+Values ISAM2Snapshot::calculateEstimate() const {
+  gttic(ISAM2Snapshot_calculateEstimate);
+  Values estimate;
+  VectorValues delta;
+  vector<const Node*> stack;
+  BOOST_FOREACH(const sharedNode& root, roots_)
+    stack.push_back(root.get());
+  while(!stack.empty()) {
+    const Node* node = stack.back();
+    stack.pop_back();
+    const VectorValues frontalDelta = node->conditional->solve(delta);
+    BOOST_FOREACH(const Values::ConstKeyValuePair& key_value, node->theta) {
+      Value* retracted = key_value.value.retract_(frontalDelta.at(key_value.key));
+      estimate.insert(key_value.key, *retracted);
+      retracted->deallocate_();
+    }
+    delta.insert(frontalDelta);
+    BOOST_FOREACH(const sharedNode& child, node->children)
+      stack.push_back(child.get());
+  }
+  return estimate;
+}
+
+/* ************************************************************************* */
+Matrix ISAM2Snapshot::marginalCovariance(Key key) const {
+  gttic(ISAM2Snapshot_marginalCovariance);
+  // The cliques off the path integrate to one, so the marginal of key is that
+  // of the conditionals from the root down to its clique.  Eliminate all
+  // other variables, from the bottom up to avoid fill-in.
+  const vector<const Node*> path = pathTo(key);
+  GaussianFactorGraph graph;
+  Ordering ordering;
+  for(vector<const Node*>::const_reverse_iterator node = path.rbegin(); node != path.rend(); ++node) {
+    graph.push_back((*node)->conditional);
+    BOOST_FOREACH(Key frontal, (*node)->conditional->frontals())
+      if(frontal != key)
+        ordering.push_back(frontal);
+  }
+  const GaussianFactorGraph::shared_ptr marginal =
+      graph.eliminatePartialSequential(ordering, EliminateQR).second;
+  return marginal->hessian().first.inverse();
+}
+
+} // namespace gtsam
@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Snapshot.h
+ * @brief   Immutable versions of the ISAM2 Bayes tree and estimate, for concurrent readers
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * An immutable version of an ISAM2 Bayes tree and of the linearization point,
+ * published by ISAM2 at the end of every update() and marginalizeLeaves() when
+ * ISAM2Params::enableSnapshots is set, and obtained with ISAM2::snapshot().
+ *
+ * Any number of threads may query a snapshot while ISAM2 keeps updating,
+ * without locking: nothing in a snapshot is modified once it is published.
+ * Consecutive snapshots share the nodes of all cliques that were not
+ * re-eliminated in between, so publishing one costs time and memory in
+ * proportion to the top of the tree that update() redid, not to its size.
+ *
+ * Queries solve the tree from scratch instead of using the wildfire-updated
+ * delta of ISAM2, so calculateEstimate() matches ISAM2::calculateBestEstimate().
+ * The cost is paid by the reading thread: a full back-substitution for the
+ * whole estimate, and a search of the tree plus a solve along the path from
+ * the root for a single variable.
+ */
+class GTSAM_EXPORT ISAM2Snapshot {
+public:
+  /** A clique of the snapshot tree, shared between snapshots as long as the
+   * clique is not re-eliminated. */
+  struct Node {
+    GaussianConditional::shared_ptr conditional; ///< The conditional of the clique, never modified
+    Values theta;                                ///< Linearization point of the frontal variables
+    std::vector<boost::shared_ptr<const Node> > children;
+  };
+
+  typedef boost::shared_ptr<const Node> sharedNode;
+  typedef boost::shared_ptr<const ISAM2Snapshot> shared_ptr;
+
+private:
+  size_t version_;
+  std::vector<sharedNode> roots_;
+
+  /// Nodes from a root down to the one with key as a frontal variable, throws if there is none
+  std::vector<const Node*> pathTo(Key key) const;
+
+  /// Solve the conditionals along a path from a root
+  static VectorValues solvePath(const std::vector<const Node*>& path);
+
+public:
+  /// Create a snapshot from the roots of its tree
+  ISAM2Snapshot(size_t version, const std::vector<sharedNode>& roots) :
+    version_(version), roots_(roots) {}
+
+  /// The number of ISAM2 updates done when the snapshot was published
+  size_t version() const { return version_; }
+
+  /// The roots of the snapshot tree
+  const std::vector<sharedNode>& roots() const { return roots_; }
+
+  /// Whether the snapshot has no variables
+  bool empty() const { return roots_.empty(); }
+
+  /// Whether key is a variable of the snapshot, searching the whole tree
+  bool exists(Key key) const;
+
+  /// The linear delta, computed by a full back-substitution
+  VectorValues getDelta() const;
+
+  /// The linear delta of one variable, solving along the path from the root
+  Vector getDelta(Key key) const;
+
+  /// The estimate of all variables, as with ISAM2::calculateBestEstimate()
+  Values calculateEstimate() const;
+
+  /// The estimate of one variable, solving along the path from the root
+  template<class VALUE>
+  VALUE calculateEstimate(Key key) const {
+    const std::vector<const Node*> path = pathTo(key);
+    return path.back()->theta.at<VALUE>(key).retract(solvePath(path).at(key));
+  }
+
+  /// The marginal covariance of one variable, from the conditionals along the path from the root
+  Matrix marginalCovariance(Key key) const;
+};
+
+} // namespace gtsam
@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Telemetry.cpp
+ * @brief   Per-update performance figures of ISAM2, and a ring buffer to keep them in
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Telemetry.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+const char* ISAM2Telemetry::slowestPhase() const {
+  const char* names[] = { "addFactors", "relinearizationCheck", "linearize", "symbolic",
+      "numeric", "backSubstitution" };
+  const double times[] = { addFactors, relinearizationCheck, linearize, symbolic,
+      numeric, backSubstitution };
+  size_t slowest = 0;
+  for (size_t k = 1; k < 6; ++k)
+    if (times[k] > times[slowest]) slowest = k;
+  return names[slowest];
+}
+
+/* ************************************************************************* */
+void ISAM2Telemetry::print(const std::string& str) const {
+  cout << str << *this << endl;
+}
+
+/* ************************************************************************* */
+std::ostream& operator<<(std::ostream& os, const ISAM2Telemetry& t) {
+  os << "update=" << t.update << " total=" << t.total << " addFactors=" << t.addFactors
+      << " relinearizationCheck=" << t.relinearizationCheck << " linearize=" << t.linearize
+      << " symbolic=" << t.symbolic << " numeric=" << t.numeric
+      << " backSubstitution=" << t.backSubstitution << " bytesAllocated=" << t.bytesAllocated
+      << " largestClique=" << t.largestClique << " largestCliqueDim=" << t.largestCliqueDim
+      << " subtreeDepth=" << t.subtreeDepth;
+  return os;
+}
+
+/* ************************************************************************* */
+ISAM2TelemetryBuffer::ISAM2TelemetryBuffer(size_t capacity) :
+    records_(capacity), next_(0), size_(0) {
+  if (capacity == 0)
+    throw invalid_argument("ISAM2TelemetryBuffer: capacity must be positive");
+}
+
+/* ************************************************************************* */
+void ISAM2TelemetryBuffer::push(const ISAM2Telemetry& telemetry) {
+  boost::mutex::scoped_lock lock(mutex_);
+  records_[next_] = telemetry;
+  next_ = (next_ + 1) % records_.size();
+  if (size_ < records_.size()) ++size_;
+}
+
+/* ************************************************************************* */
+std::vector<ISAM2Telemetry> ISAM2TelemetryBuffer::snapshot() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  std::vector<ISAM2Telemetry> result;
+  result.reserve(size_);
+  for (size_t k = 0; k < size_; ++k)
+    result.push_back(records_[(next_ + records_.size() - size_ + k) % records_.size()]);
+  return result;
+}
+
+/* ************************************************************************* */
+ISAM2Telemetry ISAM2TelemetryBuffer::latest() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  if (size_ == 0)
+    return ISAM2Telemetry();
+  return records_[(next_ + records_.size() - 1) % records_.size()];
+}
+
+/* ************************************************************************* */
+size_t ISAM2TelemetryBuffer::size() const {
+  boost::mutex::scoped_lock lock(mutex_);
+  return size_;
+}
+
+/* ************************************************************************* */
+void ISAM2TelemetryBuffer::clear() {
+  boost::mutex::scoped_lock lock(mutex_);
+  next_ = 0;
+  size_ = 0;
+}
+
+} // namespace gtsam
@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Telemetry.h
+ * @brief   Per-update performance figures of ISAM2, and a ring buffer to keep them in
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/global_includes.h>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Cheap performance figures of one call to ISAM2::update(), always filled in
+ * ISAM2Result::telemetry, independently of the timing build and of
+ * ISAM2Params::enableDetailedResults.  Times are wall-clock seconds.
+ *
+ * Back-substitution is done lazily by ISAM2, so backSubstitution only counts
+ * the delta update done at the start of update() before checking for
+ * relinearization, not the one done later by calculateEstimate().
+ */
+struct GTSAM_EXPORT ISAM2Telemetry {
+  size_t update;            ///< Number of the update, counting from 1
+  double addFactors;        ///< Adding and removing factors and variables, including the variable index
+  double relinearizationCheck; ///< Finding the variables to relinearize, and updating their linearization points
+  double linearize;         ///< Linearizing new and affected factors
+  double symbolic;          ///< Ordering and building the elimination and junction trees
+  double numeric;           ///< Numerical elimination into new cliques
+  double backSubstitution;  ///< Updating delta before the relinearization check
+  double total;             ///< The whole update, including the phases above and bookkeeping
+  size_t bytesAllocated;    ///< Bytes of matrices in the conditionals and cached factors of the re-eliminated cliques
+  size_t largestClique;     ///< Number of variables in the largest re-eliminated clique, frontal and separator
+  size_t largestCliqueDim;  ///< Scalar dimension of that clique
+  size_t subtreeDepth;      ///< Depth in cliques of the re-eliminated top of the Bayes tree
+
+  ISAM2Telemetry() :
+      update(0), addFactors(0), relinearizationCheck(0), linearize(0), symbolic(0), numeric(0),
+      backSubstitution(0), total(0), bytesAllocated(0), largestClique(0), largestCliqueDim(0),
+      subtreeDepth(0) {}
+
+  /// Name of the phase that took the longest, e.g., "numeric"
+  const char* slowestPhase() const;
+
+  /// Print on one line
+  void print(const std::string& str = "") const;
+};
+
+/// Write the telemetry of one update on one line, as name=value pairs
+GTSAM_EXPORT std::ostream& operator<<(std::ostream& os, const ISAM2Telemetry& telemetry);
+
+/**
+ * Fixed-capacity ring buffer of ISAM2Telemetry, keeping the most recent
+ * updates.  One thread may write with operator<< or push while another, e.g.,
+ * a watchdog, takes snapshots.
+ */
+class GTSAM_EXPORT ISAM2TelemetryBuffer {
+public:
+  typedef boost::shared_ptr<ISAM2TelemetryBuffer> shared_ptr;
+
+private:
+  mutable boost::mutex mutex_;
+  std::vector<ISAM2Telemetry> records_;
+  size_t next_;   ///< Slot of the next record
+  size_t size_;   ///< Number of records kept, up to the capacity
+
+public:
+  /// Create a buffer keeping the last capacity updates
+  explicit ISAM2TelemetryBuffer(size_t capacity);
+
+  /// Add the telemetry of an update, overwriting the oldest if full
+  void push(const ISAM2Telemetry& telemetry);
+
+  /// Add the telemetry of an update, overwriting the oldest if full
+  ISAM2TelemetryBuffer& operator<<(const ISAM2Telemetry& telemetry) {
+    push(telemetry); return *this; }
+
+  /// The records kept, oldest first
+  std::vector<ISAM2Telemetry> snapshot() const;
+
+  /// The most recent record, or a zero one if there is none
+  ISAM2Telemetry latest() const;
+
+  /// Number of records kept
+  size_t size() const;
+
+  /// Maximum number of records kept
+  size_t capacity() const { return records_.size(); }
+
+  /// Remove all records
+  void clear();
+};
+
+} // namespace gtsam
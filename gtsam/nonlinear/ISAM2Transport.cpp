@@ -0,0 +1,244 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Transport.cpp
+ * @brief   Message transports between the agents and the coordinator of a distributed ISAM2
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Transport.h>
+
+#include <boost/cstdint.hpp>
+
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#  include <sys/types.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void ISAM2InProcessTransport::send(const string& message) {
+  boost::mutex::scoped_lock lock(mutex_);
+  queue_.push_back(message);
+}
+
+/* ************************************************************************* */
+bool ISAM2InProcessTransport::receive(string& message) {
+  boost::mutex::scoped_lock lock(mutex_);
+  if(queue_.empty())
+    return false;
+  message.swap(queue_.front());
+  queue_.pop_front();
+  return true;
+}
+
+/* ************************************************************************* */
+size_t ISAM2InProcessTransport::size() {
+  boost::mutex::scoped_lock lock(mutex_);
+  return queue_.size();
+}
+
+#ifndef _WIN32
+
+namespace {
+  /* ************************************************************************* */
+  runtime_error socketError(const string& what) {
+    return runtime_error("ISAM2SocketTransport: " + what + ": " + strerror(errno));
+  }
+
+  /* ************************************************************************* */
+  sockaddr_un socketAddress(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path))
+      throw invalid_argument("ISAM2SocketTransport: socket path is too long: " + path);
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+  }
+}
+
+/* ************************************************************************* */
+const size_t ISAM2SocketTransport::DefaultMaxMessageSize;
+
+/* ************************************************************************* */
+ISAM2SocketTransport::ISAM2SocketTransport(int fd) :
+    fd_(fd), closed_(false), maxMessageSize_(DefaultMaxMessageSize) {}
+
+/* ************************************************************************* */
+ISAM2SocketTransport::~ISAM2SocketTransport() {
+  ::close(fd_);
+}
+
+/* ************************************************************************* */
+pair<ISAM2SocketTransport::shared_ptr, ISAM2SocketTransport::shared_ptr> ISAM2SocketTransport::Pair() {
+  int fds[2];
+  if(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    throw socketError("cannot create socket pair");
+  return make_pair(shared_ptr(new ISAM2SocketTransport(fds[0])), shared_ptr(new ISAM2SocketTransport(fds[1])));
+}
+
+/* ************************************************************************* */
+ISAM2SocketTransport::shared_ptr ISAM2SocketTransport::Connect(const string& path) {
+  const sockaddr_un address = socketAddress(path);
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if(fd < 0)
+    throw socketError("cannot create socket");
+  if(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    const runtime_error error = socketError("cannot connect to " + path);
+    ::close(fd);
+    throw error;
+  }
+  return shared_ptr(new ISAM2SocketTransport(fd));
+}
+
+/* ************************************************************************* */
+void ISAM2SocketTransport::send(const string& message) {
+  // Length and message in one buffer, so that a message is sent with one call in most cases
+  const boost::uint64_t length = message.size();
+  string frame(reinterpret_cast<const char*>(&length), sizeof(length));
+  frame += message;
+
+#ifdef MSG_NOSIGNAL
+  const int flags = MSG_NOSIGNAL; // Report a closed connection as an error and not with SIGPIPE
+#else
+  const int flags = 0;
+#endif
+  size_t sent = 0;
+  while(sent < frame.size()) {
+    const ssize_t n = ::send(fd_, frame.data() + sent, frame.size() - sent, flags);
+    if(n < 0) {
+      if(errno == EINTR)
+        continue;
+      if(errno == EPIPE)
+        closed_ = true;
+      throw socketError("cannot send");
+    }
+    sent += size_t(n);
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2SocketTransport::readFully(char* data, size_t size) {
+  size_t read = 0;
+  while(read < size) {
+    const ssize_t n = ::recv(fd_, data + read, size - read, 0);
+    if(n < 0) {
+      if(errno == EINTR)
+        continue;
+      throw socketError("cannot receive");
+    }
+    if(n == 0) {
+      closed_ = true;
+      throw runtime_error("ISAM2SocketTransport: connection closed in the middle of a message");
+    }
+    read += size_t(n);
+  }
+}
+
+/* ************************************************************************* */
+bool ISAM2SocketTransport::receive(string& message) {
+  if(closed_)
+    return false;
+
+  pollfd request;
+  request.fd = fd_;
+  request.events = POLLIN;
+  request.revents = 0;
+  const int ready = ::poll(&request, 1, 0);
+  if(ready < 0) {
+    if(errno == EINTR)
+      return false;
+    throw socketError("cannot poll");
+  }
+  if(ready == 0)
+    return false;
+
+  // Readable at the end of the stream means the other end closed the connection
+  char first;
+  const ssize_t peeked = ::recv(fd_, &first, 1, MSG_PEEK);
+  if(peeked == 0) {
+    closed_ = true;
+    return false;
+  } else if(peeked < 0) {
+    if(errno == EINTR || errno == EAGAIN)
+      return false;
+    throw socketError("cannot receive");
+  }
+
+  boost::uint64_t length;
+  readFully(reinterpret_cast<char*>(&length), sizeof(length));
+  if(length > maxMessageSize_) {
+    ::shutdown(fd_, SHUT_RDWR);
+    closed_ = true;
+    throw runtime_error("ISAM2SocketTransport: message is longer than the maximum message size, closed the connection");
+  }
+  message.resize(size_t(length));
+  if(length > 0)
+    readFully(&message[0], size_t(length));
+  return true;
+}
+
+/* ************************************************************************* */
+ISAM2SocketListener::ISAM2SocketListener(const string& path) : path_(path) {
+  const sockaddr_un address = socketAddress(path);
+  fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if(fd_ < 0)
+    throw socketError("cannot create socket");
+  // Only a socket left by an earlier listener is replaced
+  struct stat status;
+  if(::lstat(path.c_str(), &status) == 0) {
+    if(!S_ISSOCK(status.st_mode)) {
+      ::close(fd_);
+      throw runtime_error("ISAM2SocketListener: " + path + " exists and is not a socket");
+    }
+    ::unlink(path.c_str());
+  }
+  if(::bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+      || ::listen(fd_, SOMAXCONN) != 0) {
+    const runtime_error error = socketError("cannot listen on " + path);
+    ::close(fd_);
+    throw error;
+  }
+}
+
+/* ************************************************************************* */
+ISAM2SocketListener::~ISAM2SocketListener() {
+  ::close(fd_);
+  ::unlink(path_.c_str());
+}
+
+/* ************************************************************************* */
+ISAM2SocketTransport::shared_ptr ISAM2SocketListener::accept() {
+  while(true) {
+    const int fd = ::accept(fd_, 0, 0);
+    if(fd >= 0)
+      return ISAM2SocketTransport::shared_ptr(new ISAM2SocketTransport(fd));
+    if(errno != EINTR)
+      throw socketError("cannot accept a connection");
+  }
+}
+
+#endif
+
+} // namespace gtsam
@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Transport.h
+ * @brief   Message transports between the agents and the coordinator of a distributed ISAM2
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/global_includes.h>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * A one-way channel for the messages of ISAM2Agent and ISAM2Coordinator.
+ * Messages are opaque byte strings, delivered whole and in order.
+ */
+class GTSAM_EXPORT ISAM2Transport {
+public:
+  typedef boost::shared_ptr<ISAM2Transport> shared_ptr;
+
+  virtual ~ISAM2Transport() {}
+
+  /// Send a message
+  virtual void send(const std::string& message) = 0;
+
+  /// Take the next message if one has arrived, without waiting for one
+  virtual bool receive(std::string& message) = 0;
+};
+
+/**
+ * A queue of messages in memory, for agents and a coordinator running in
+ * threads of one process.  Any number of threads may send to and receive from
+ * the same queue.
+ */
+class GTSAM_EXPORT ISAM2InProcessTransport : public ISAM2Transport {
+  boost::mutex mutex_;
+  std::deque<std::string> queue_;
+
+public:
+  virtual void send(const std::string& message);
+  virtual bool receive(std::string& message);
+
+  /// The number of messages sent and not yet received
+  size_t size();
+};
+
+#ifndef _WIN32
+/**
+ * A connected Unix-domain stream socket, for agents and a coordinator running
+ * in separate processes on one machine.  Each message is framed by its length
+ * in native byte order.  Each end can both send and receive.  A received
+ * message longer than maxMessageSize() is not allocated; the connection is
+ * closed instead, as the stream cannot be resynchronized.
+ */
+class GTSAM_EXPORT ISAM2SocketTransport : public ISAM2Transport {
+  int fd_;
+  bool closed_;
+  size_t maxMessageSize_;
+
+  void readFully(char* data, size_t size);
+
+public:
+  typedef boost::shared_ptr<ISAM2SocketTransport> shared_ptr;
+
+  /// Default limit on the length of received messages, 256 MiB
+  static const size_t DefaultMaxMessageSize = size_t(1) << 28;
+
+  /// Take ownership of a connected socket
+  explicit ISAM2SocketTransport(int fd);
+
+  virtual ~ISAM2SocketTransport();
+
+  /// Two connected ends, e.g. for a process and the child it forks
+  static std::pair<shared_ptr, shared_ptr> Pair();
+
+  /// Connect to an ISAM2SocketListener bound to path
+  static shared_ptr Connect(const std::string& path);
+
+  virtual void send(const std::string& message);
+
+  /// Take the next message if one has started to arrive, waiting for the rest
+  /// of it.  Throws std::runtime_error and closes the connection if the message
+  /// is longer than maxMessageSize().
+  virtual bool receive(std::string& message);
+
+  /// Limit on the length of received messages
+  size_t maxMessageSize() const { return maxMessageSize_; }
+
+  /// Set the limit on the length of received messages
+  void setMaxMessageSize(size_t size) { maxMessageSize_ = size; }
+
+  /// Whether the other end closed the connection
+  bool closed() const { return closed_; }
+
+private:
+  ISAM2SocketTransport(const ISAM2SocketTransport&);
+  ISAM2SocketTransport& operator=(const ISAM2SocketTransport&);
+};
+
+/** A Unix-domain socket bound to a path in the file system, on which a
+ * coordinator accepts the connections of its agents. */
+class GTSAM_EXPORT ISAM2SocketListener {
+  int fd_;
+  std::string path_;
+
+public:
+  /// Bind to path, replacing a stale socket file.  Throws std::runtime_error if
+  /// path exists and is not a socket.
+  explicit ISAM2SocketListener(const std::string& path);
+
+  /// Close the socket and remove its file
+  ~ISAM2SocketListener();
+
+  /// Wait for the next agent to connect
+  ISAM2SocketTransport::shared_ptr accept();
+
+private:
+  ISAM2SocketListener(const ISAM2SocketListener&);
+  ISAM2SocketListener& operator=(const ISAM2SocketListener&);
+};
+#endif
+
+} // namespace gtsam
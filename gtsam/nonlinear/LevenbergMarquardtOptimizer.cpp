@@ -217,7 +217,9 @@ void LevenbergMarquardtOptimizer::iterate() {
   // Linearize graph
   if (lmVerbosity >= LevenbergMarquardtParams::DAMPED)
     cout << "linearizing = " << endl;
-  GaussianFactorGraph::shared_ptr linear = linearize();
+  GaussianFactorGraph::shared_ptr linear =
+      params_.linearizeInPlace || params_.linearizeRobustInBatch ?
+      linearizeGraph(state_.values, params_) : linearize();
 
   if(state_.totalNumberInnerIterations==0) // write initial error
     writeLogFile(state_.error);
@@ -277,7 +277,8 @@ protected:
   LevenbergMarquardtParams ensureHasOrdering(LevenbergMarquardtParams params,
       const NonlinearFactorGraph& graph) const;
 
-  /** linearize, can  be overwritten */
+  /** linearize, can  be overwritten.  Not called by iterate() if params.linearizeInPlace or
+   *  params.linearizeRobustInBatch */
   virtual GaussianFactorGraph::shared_ptr linearize() const;
 };
 
@@ -220,6 +220,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /** g(x) with optional derivative */
     Vector evaluateError(const X& x1, boost::optional<Matrix&> H = boost::none) const {
       if (H) (*H) = eye(x1.dim());
@@ -280,6 +282,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /** g(x) with optional derivative2 */
     Vector evaluateError(const X& x1, const X& x2,
         boost::optional<Matrix&> H1 = boost::none,
@@ -23,6 +23,8 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/assign/list_of.hpp>
 
+#include <typeinfo>
+
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/linear/JacobianFactor.h>
@@ -38,6 +40,14 @@
   return boost::static_pointer_cast<gtsam::NonlinearFactor>( \
       gtsam::NonlinearFactor::shared_ptr(new Derived(*this))); }
 
+/**
+ * Macro to opt a NoiseModelFactor into in-place relinearization, see
+ * NoiseModelFactor::supportsLinearizeInPlace().  The class must define \c This, and derived
+ * classes, whose linearize() may differ, are not opted in.
+ */
+#define GTSAM_SUPPORTS_LINEARIZE_IN_PLACE \
+  virtual bool supportsLinearizeInPlace() const { return typeid(*this) == typeid(This); }
+
 namespace gtsam {
 
 using boost::assign::cref_list_of;
@@ -128,6 +138,19 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Relinearize into \c linear, a factor returned by an earlier call to linearize(), overwriting
+   * its storage instead of allocating a new factor.  \c jacobians is storage for the Jacobians
+   * of the error function, kept by the caller from one call to the next.  Returns false if the
+   * factor cannot be relinearized in place, e.g. it is inactive or \c linear has another shape,
+   * in which case \c linear is unspecified and linearize() is to be called instead.  The default
+   * implementation always returns false.  See PooledLinearizer.
+   */
+  virtual bool linearizeInPlace(const Values& c, GaussianFactor& linear,
+      std::vector<Matrix>& jacobians) const {
+    return false;
+  }
+
   /**
    * Create a symbolic factor using the given ordering to determine the
    * variable indices.
@@ -333,6 +356,55 @@ public:
       return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
   }
 
+  /**
+   * Whether linearizeInPlace() gives the same factor as linearize().  False by default, since a
+   * derived class may override linearize(), and true in factors that opt in, such as
+   * BetweenFactor.  Classes opt in with GTSAM_SUPPORTS_LINEARIZE_IN_PLACE, which checks that the
+   * factor is not of a derived class, whose linearize() may differ.
+   */
+  virtual bool supportsLinearizeInPlace() const { return false; }
+
+  /**
+   * Relinearize into a JacobianFactor returned by an earlier call to linearize(), overwriting its
+   * Jacobians and right-hand side, if supportsLinearizeInPlace().  This saves the allocation of
+   * the factor and its matrix, and of the Jacobians, which are kept in \c A, but the error vector
+   * is still returned by unwhitenedError() as a new Vector.
+   */
+  virtual bool linearizeInPlace(const Values& x, GaussianFactor& linear,
+      std::vector<Matrix>& A) const {
+    if (!supportsLinearizeInPlace())
+      return false;
+
+    // The factor must still be active and have the shape and kind of model of linearize()
+    JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(&linear);
+    if (!jacobian || !this->active(x) || jacobian->keys() != this->keys())
+      return false;
+    const bool constrained = dynamic_cast<const noiseModel::Constrained*>(noiseModel_.get()) != 0;
+    if (constrained != bool(jacobian->get_model()))
+      return false;
+
+    // Evaluate into the kept Jacobians, and whiten as in linearize()
+    A.resize(this->size());
+    Vector b = -unwhitenedError(x, A);
+    if ((size_t) b.size() != jacobian->rows())
+      return false;
+    if(noiseModel_)
+    {
+      if((size_t) b.size() != noiseModel_->dim())
+        throw std::invalid_argument("This factor was created with a NoiseModel of incorrect dimension.");
+
+      this->noiseModel_->WhitenSystem(A,b);
+    }
+
+    for(size_t j=0; j<this->size(); ++j) {
+      if (A[j].cols() != jacobian->getDim(jacobian->begin() + j))
+        return false;
+      jacobian->getA(jacobian->begin() + j) = A[j];
+    }
+    jacobian->getb() = b;
+    return true;
+  }
+
 private:
 
   /** Serialization function */
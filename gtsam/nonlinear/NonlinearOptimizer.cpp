@@ -29,6 +29,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/ref.hpp>
 
 #include <stdexcept>
 #include <iostream>
@@ -96,6 +97,37 @@ const Values& NonlinearOptimizer::optimizeSafely() {
   }
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::Eliminate NonlinearOptimizer::eliminationFunction(
+    const NonlinearOptimizerParams& params) const {
+  // The plans are used by reference so they survive from one iteration to the next
+  if (params.linearSolverType == NonlinearOptimizerParams::MULTIFRONTAL_CHOLESKY
+      || params.linearSolverType == NonlinearOptimizerParams::SEQUENTIAL_CHOLESKY) {
+    // Plans of the cliques of another ordering would not be used again
+    if (!params.ordering || !assemblyPlansOrdering_
+        || !assemblyPlansOrdering_->equals(*params.ordering)) {
+      assemblyPlans_.clear();
+      assemblyPlansOrdering_ = params.ordering;
+    }
+    return boost::cref(assemblyPlans_);
+  }
+  return params.getEliminationFunction();
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearOptimizer::linearizeGraph(const Values& values,
+    const NonlinearOptimizerParams& params) const {
+  if (params.linearizeRobustInBatch) {
+    if (!robustLinearizer_)
+      robustLinearizer_ = RobustLinearizer(graph_);
+    if (robustLinearizer_->nrRobustFactors() > 0)
+      return robustLinearizer_->linearize(values);
+  }
+  if (params.linearizeInPlace)
+    return linearizer_.linearize(graph_, values);
+  return graph_.linearize(values);
+}
+
 /* ************************************************************************* */
 VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph &gfg,
     const Values& initial, const NonlinearOptimizerParams& params) const {
@@ -106,10 +138,10 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph &gfg,
   // Check which solver we are using
   if (params.isMultifrontal()) {
     // Multifrontal QR or Cholesky (decided by params.getEliminationFunction())
-    delta = gfg.optimize(*params.ordering, params.getEliminationFunction());
+    delta = gfg.optimize(*params.ordering, eliminationFunction(params));
   } else if (params.isSequential()) {
     // Sequential QR or Cholesky (decided by params.getEliminationFunction())
-    delta = gfg.eliminateSequential(*params.ordering, params.getEliminationFunction())->optimize();
+    delta = gfg.eliminateSequential(*params.ordering, eliminationFunction(params))->optimize();
   } else if (params.isIterative()) {
 
     // Conjugate Gradient -> needs params.iterativeParams
@@ -20,6 +20,8 @@
 
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearOptimizerParams.h>
+#include <gtsam/nonlinear/PooledLinearizer.h>
+#include <gtsam/nonlinear/RobustLinearizer.h>
 
 namespace gtsam {
 
@@ -136,6 +138,19 @@ class GTSAM_EXPORT NonlinearOptimizer {
 protected:
   NonlinearFactorGraph graph_;
 
+  /** Assembly plans of the cliques of earlier iterations, reused when eliminating with Cholesky.
+   *  They are kept per clique of assemblyPlansOrdering_, so there is at most one per variable. */
+  mutable AssemblyPlanCache assemblyPlans_;
+
+  /** The ordering the cliques of assemblyPlans_ come from, its plans are dropped when it changes */
+  mutable boost::optional<Ordering> assemblyPlansOrdering_;
+
+  /** The linear graph of the previous iteration, overwritten by linearizeGraph */
+  mutable PooledLinearizer linearizer_;
+
+  /** The robust factors of graph_, created by linearizeGraph when first needed */
+  mutable boost::optional<RobustLinearizer> robustLinearizer_;
+
 public:
   /** A shared pointer to this class */
   typedef boost::shared_ptr<const NonlinearOptimizer> shared_ptr;
@@ -201,6 +216,16 @@ protected:
 
   virtual const NonlinearOptimizerParams& _params() const = 0;
 
+  /** The elimination function for params, reusing assemblyPlans_ if it is a Cholesky one, after
+   *  clearing them if params.ordering is not the one they were made with */
+  GaussianFactorGraph::Eliminate eliminationFunction(const NonlinearOptimizerParams& params) const;
+
+  /** Linearize graph_ at values, into the graph of the previous call if params.linearizeInPlace,
+   *  and with a RobustLinearizer if params.linearizeRobustInBatch and graph_ has robust factors.
+   *  The result is then only valid until the next call. */
+  GaussianFactorGraph::shared_ptr linearizeGraph(const Values& values,
+      const NonlinearOptimizerParams& params) const;
+
   /** Constructor for initial construction of base classes. */
   NonlinearOptimizer(const NonlinearFactorGraph& graph) : graph_(graph) {}
 
@@ -81,6 +81,8 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   std::cout << "         maximum iterations: " << maxIterations << "\n";
   std::cout << "                  verbosity: " << verbosityTranslator(verbosity)
       << "\n";
+  std::cout << "         linearize in place: " << linearizeInPlace << "\n";
+  std::cout << "  linearize robust in batch: " << linearizeRobustInBatch << "\n";
   std::cout.flush();
 
   switch (linearSolverType) {
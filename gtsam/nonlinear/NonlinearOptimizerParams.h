@@ -42,10 +42,12 @@ public:
   double absoluteErrorTol; ///< The maximum absolute error decrease to stop iterating (default 1e-5)
   double errorTol; ///< The maximum total error to stop iterating (default 0.0)
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
+  bool linearizeInPlace; ///< Relinearize into the linear graph of the previous iteration, see PooledLinearizer (default false)
+  bool linearizeRobustInBatch; ///< Linearize factors with robust noise models together, see RobustLinearizer (default false)
 
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
-          0.0), verbosity(SILENT), linearSolverType(MULTIFRONTAL_CHOLESKY) {
+          0.0), verbosity(SILENT), linearizeInPlace(false), linearizeRobustInBatch(false), linearSolverType(MULTIFRONTAL_CHOLESKY) {
   }
 
   virtual ~NonlinearOptimizerParams() {
@@ -67,6 +69,12 @@ public:
   std::string getVerbosity() const {
     return verbosityTranslator(verbosity);
   }
+  bool getLinearizeInPlace() const {
+    return linearizeInPlace;
+  }
+  bool getLinearizeRobustInBatch() const {
+    return linearizeRobustInBatch;
+  }
 
   void setMaxIterations(int value) {
     maxIterations = value;
@@ -83,6 +91,12 @@ public:
   void setVerbosity(const std::string &src) {
     verbosity = verbosityTranslator(src);
   }
+  void setLinearizeInPlace(bool value) {
+    linearizeInPlace = value;
+  }
+  void setLinearizeRobustInBatch(bool value) {
+    linearizeRobustInBatch = value;
+  }
 
   static Verbosity verbosityTranslator(const std::string &s) ;
   static std::string verbosityTranslator(Verbosity value) ;
@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PooledLinearizer.cpp
+ * @brief   Repeated linearization of a graph into the same GaussianFactorGraph
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/PooledLinearizer.h>
+
+#include <boost/make_shared.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  void PooledLinearizer::linearizeFactor(const NonlinearFactorGraph& graph, size_t i,
+      const Values& x) {
+    GaussianFactor::shared_ptr& result = (*linear_)[i];
+    if (!graph[i]) {
+      result.reset();
+      return;
+    }
+
+    // Overwrite the storage of an earlier call if the factor still has the same shape
+    GaussianFactor::shared_ptr& kept = kept_[i];
+    if (kept && graph[i]->linearizeInPlace(x, *kept, jacobians_[i])) {
+      result = kept;
+      return;
+    }
+
+    result = graph[i]->linearize(x);
+    if (result)
+      kept = result;
+  }
+
+#ifdef GTSAM_USE_TBB
+  /* ************************************************************************* */
+  struct PooledLinearizer::LinearizeFactors {
+    PooledLinearizer& linearizer;
+    const NonlinearFactorGraph& graph;
+    const Values& x;
+    LinearizeFactors(PooledLinearizer& linearizer, const NonlinearFactorGraph& graph,
+        const Values& x) :
+        linearizer(linearizer), graph(graph), x(x) {
+    }
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for (size_t i = r.begin(); i != r.end(); ++i)
+        linearizer.linearizeFactor(graph, i, x);
+    }
+  };
+#endif
+
+  /* ************************************************************************* */
+  GaussianFactorGraph::shared_ptr PooledLinearizer::linearize(const NonlinearFactorGraph& graph,
+      const Values& x) {
+    gttic(PooledLinearizer_linearize);
+
+    // The pool follows the factor indices of graph, start over if it was made for another size
+    if (!linear_ || linear_->size() != graph.size()) {
+      clear();
+      linear_ = boost::make_shared<GaussianFactorGraph>();
+      linear_->resize(graph.size());
+      kept_.resize(graph.size());
+      jacobians_.resize(graph.size());
+    }
+
+#ifdef GTSAM_USE_TBB
+    TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, graph.size()),
+        LinearizeFactors(*this, graph, x));
+#else
+    for (size_t i = 0; i < graph.size(); ++i)
+      linearizeFactor(graph, i, x);
+#endif
+
+    return linear_;
+  }
+
+  /* ************************************************************************* */
+  void PooledLinearizer::clear() {
+    linear_.reset();
+    kept_.clear();
+    jacobians_.clear();
+  }
+
+/* ************************************************************************* */
+} // namespace gtsam
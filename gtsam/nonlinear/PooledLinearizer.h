@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PooledLinearizer.h
+ * @brief   Repeated linearization of a graph into the same GaussianFactorGraph
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * Linearizes a NonlinearFactorGraph again and again into the same GaussianFactorGraph.
+   *
+   * NonlinearFactorGraph::linearize allocates a new graph of new JacobianFactors, each with its
+   * own VerticalBlockMatrix, in every iteration of an optimizer, although the shapes of the
+   * factors rarely change.  Here, the factors of the previous call are kept and every factor is
+   * first relinearized into its old storage with NonlinearFactor::linearizeInPlace, which
+   * overwrites the Jacobians and right-hand side.  The Jacobians passed to the factor's error
+   * function are kept from call to call as well, though the error vector is still allocated by
+   * the factor.  Only factors that do not support this, see
+   * NoiseModelFactor::supportsLinearizeInPlace, or whose shape or activity changed, are
+   * linearized as usual.
+   *
+   * The result is the same as NonlinearFactorGraph::linearize.  Note that the returned graph and
+   * its factors are owned by the linearizer and overwritten by the next call to linearize, so a
+   * graph that must outlive that call has to be cloned.
+   */
+  class GTSAM_EXPORT PooledLinearizer {
+
+  public:
+
+    typedef boost::shared_ptr<PooledLinearizer> shared_ptr;
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Create an empty linearizer */
+    PooledLinearizer() {}
+
+    /** Copies start out empty, so that two linearizers never overwrite the same factors */
+    PooledLinearizer(const PooledLinearizer&) {}
+
+    /** Assignment empties this linearizer, see the copy constructor */
+    PooledLinearizer& operator=(const PooledLinearizer&) { clear(); return *this; }
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** Linearize graph at x, overwriting the result of the previous call, see class documentation */
+    GaussianFactorGraph::shared_ptr linearize(const NonlinearFactorGraph& graph, const Values& x);
+
+    /** Release all kept storage */
+    void clear();
+
+    /// @}
+
+  protected:
+
+    GaussianFactorGraph::shared_ptr linear_;         ///< the graph returned by linearize
+    std::vector<GaussianFactor::shared_ptr> kept_;   ///< storage of each factor, kept while inactive
+    std::vector<std::vector<Matrix> > jacobians_;    ///< Jacobians of each factor's error function
+
+    /// Relinearize factor i into its kept storage, or linearize it as usual
+    void linearizeFactor(const NonlinearFactorGraph& graph, size_t i, const Values& x);
+
+    struct LinearizeFactors; ///< TBB body for linearizeFactor
+  };
+
+} // namespace gtsam
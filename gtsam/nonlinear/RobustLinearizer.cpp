@@ -0,0 +1,234 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    RobustLinearizer.cpp
+ * @brief   Iteratively reweighted linearization of graphs with robust noise models
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/RobustLinearizer.h>
+
+#include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+
+#include <typeinfo>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  RobustLinearizer::RobustLinearizer(const NonlinearFactorGraph& graph) :
+      graph_(graph) {
+    findRobustFactors();
+  }
+
+  /* ************************************************************************* */
+  RobustLinearizer::RobustLinearizer(const RobustLinearizer& other) :
+      graph_(other.graph_) {
+    findRobustFactors();
+  }
+
+  /* ************************************************************************* */
+  RobustLinearizer& RobustLinearizer::operator=(const RobustLinearizer& other) {
+    if (this != &other) {
+      graph_ = other.graph_;
+      findRobustFactors();
+    }
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  void RobustLinearizer::findRobustFactors() {
+    robust_.clear();
+    groups_.clear();
+    robustIndex_.assign(graph_.size(), -1);
+    size_t rows = 0;
+    for (size_t i = 0; i < graph_.size(); ++i) {
+      const NoiseModelFactor* factor =
+          dynamic_cast<const NoiseModelFactor*>(graph_[i].get());
+      if (!factor) continue;
+      noiseModel::Robust::shared_ptr model =
+          boost::dynamic_pointer_cast<noiseModel::Robust>(factor->get_noiseModel());
+      if (!model || boost::dynamic_pointer_cast<noiseModel::Constrained>(model->noise()))
+        continue;
+
+      RobustFactor robust;
+      robust.factor = i;
+      robust.row = rows;
+      robust.dim = model->dim();
+      robust.noise = model->noise();
+      robust.active = false;
+
+      // Find a group with an equal m-estimator, or start a new one
+      const MEstimator& estimator = *model->robust();
+      robust.group = groups_.size();
+      for (size_t g = 0; g < groups_.size(); ++g) {
+        const MEstimator& other = *groups_[g].robust;
+        if (typeid(other) == typeid(estimator) && other.equals(estimator)
+            && other.reweightScheme() == estimator.reweightScheme()) {
+          robust.group = g;
+          break;
+        }
+      }
+      if (robust.group == groups_.size()) {
+        groups_.push_back(Group());
+        groups_.back().robust = model->robust();
+      }
+      groups_[robust.group].members.push_back(robust_.size());
+
+      robustIndex_[i] = int(robust_.size());
+      robust_.push_back(robust);
+      rows += robust.dim;
+    }
+
+    // Block reweighting needs one error per factor, scalar one per row
+    BOOST_FOREACH(Group& group, groups_) {
+      size_t n = group.members.size();
+      if (group.robust->reweightScheme() == MEstimator::Scalar) {
+        n = 0;
+        BOOST_FOREACH(size_t m, group.members)
+          n += robust_[m].dim;
+      }
+      group.errors.resize(n);
+    }
+    residuals_ = zero(rows);
+    weights_ = ones(rows);
+  }
+
+  /* ************************************************************************* */
+  void RobustLinearizer::linearizeFactor(size_t i, const Values& x,
+      GaussianFactorGraph& result) {
+    if (!graph_[i]) {
+      result[i] = GaussianFactor::shared_ptr();
+      return;
+    }
+    if (robustIndex_[i] < 0) {
+      result[i] = graph_[i]->linearize(x);
+      return;
+    }
+
+    RobustFactor& robust = robust_[robustIndex_[i]];
+    const NoiseModelFactor& factor = static_cast<const NoiseModelFactor&>(*graph_[i]);
+    robust.active = factor.active(x);
+    if (!robust.active) {
+      residuals_.segment(robust.row, robust.dim).setZero();
+      return;
+    }
+
+    // Whiten with the Gaussian part only, weights are applied later.  The Jacobians are
+    // evaluated into the matrices of the previous call, and b is negated in place.
+    robust.A.resize(factor.size());
+    Vector b = factor.unwhitenedError(x, robust.A);
+    if ((size_t) b.size() != robust.dim)
+      throw std::invalid_argument("This factor was created with a NoiseModel of incorrect dimension.");
+    b = -b;
+    robust.noise->WhitenSystem(robust.A, b);
+
+    // Allocate the Jacobian once, then overwrite it
+    if (!robust.jacobian) {
+      std::vector<std::pair<Key, Matrix> > terms(factor.size());
+      for (size_t j = 0; j < factor.size(); ++j) {
+        terms[j].first = factor.keys()[j];
+        terms[j].second = robust.A[j];
+      }
+      robust.jacobian = boost::make_shared<JacobianFactor>(terms, b);
+    } else {
+      for (size_t j = 0; j < factor.size(); ++j)
+        robust.jacobian->getA(robust.jacobian->begin() + j) = robust.A[j];
+      robust.jacobian->getb() = b;
+    }
+    residuals_.segment(robust.row, robust.dim) = b;
+  }
+
+#ifdef GTSAM_USE_TBB
+  /* ************************************************************************* */
+  struct RobustLinearizer::LinearizeFactors {
+    RobustLinearizer& linearizer;
+    const Values& x;
+    GaussianFactorGraph& result;
+    LinearizeFactors(RobustLinearizer& linearizer, const Values& x,
+        GaussianFactorGraph& result) :
+        linearizer(linearizer), x(x), result(result) {
+    }
+    void operator()(const tbb::blocked_range<size_t>& r) const {
+      for (size_t i = r.begin(); i != r.end(); ++i)
+        linearizer.linearizeFactor(i, x, result);
+    }
+  };
+#endif
+
+  /* ************************************************************************* */
+  void RobustLinearizer::updateWeights() {
+    BOOST_FOREACH(Group& group, groups_) {
+      const bool block = group.robust->reweightScheme() == MEstimator::Block;
+
+      // Gather errors, evaluate the m-estimator on all of them, and scatter
+      size_t k = 0;
+      BOOST_FOREACH(size_t m, group.members) {
+        const RobustFactor& robust = robust_[m];
+        if (block)
+          group.errors(k++) = residuals_.segment(robust.row, robust.dim).norm();
+        else {
+          group.errors.segment(k, robust.dim) = residuals_.segment(robust.row, robust.dim);
+          k += robust.dim;
+        }
+      }
+      const Vector w = group.robust->sqrtWeight(group.errors);
+      k = 0;
+      BOOST_FOREACH(size_t m, group.members) {
+        const RobustFactor& robust = robust_[m];
+        if (block)
+          weights_.segment(robust.row, robust.dim).setConstant(w(k++));
+        else {
+          weights_.segment(robust.row, robust.dim) = w.segment(k, robust.dim);
+          k += robust.dim;
+        }
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  GaussianFactorGraph::shared_ptr RobustLinearizer::linearize(const Values& x) {
+    gttic(RobustLinearizer_linearize);
+    GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+    linearFG->resize(graph_.size());
+
+    // Evaluate all factors, robust ones into residuals_
+#ifdef GTSAM_USE_TBB
+    TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, graph_.size()),
+        LinearizeFactors(*this, x, *linearFG));
+#else
+    for (size_t i = 0; i < graph_.size(); ++i)
+      linearizeFactor(i, x, *linearFG);
+#endif
+
+    updateWeights();
+
+    // Scale the rows of the stored Jacobians, including the rhs
+    BOOST_FOREACH(RobustFactor& robust, robust_) {
+      if (!robust.active) continue;
+      robust.jacobian->matrixObject().full().array().colwise() *=
+          weights_.segment(robust.row, robust.dim).array();
+      (*linearFG)[robust.factor] = robust.jacobian;
+    }
+    return linearFG;
+  }
+
+/* ************************************************************************* */
+} // namespace gtsam
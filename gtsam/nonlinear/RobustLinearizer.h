@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    RobustLinearizer.h
+ * @brief   Iteratively reweighted linearization of graphs with robust noise models
+ * @date    October 19, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+
+namespace gtsam {
+
+  /**
+   * Linearizes a NonlinearFactorGraph for iteratively reweighted least squares.
+   *
+   * NoiseModelFactor::linearize whitens each factor through the virtual
+   * noiseModel::Robust::WhitenSystem, which computes the robust weight of that
+   * one factor, and allocates a new JacobianFactor. Here, factors with a
+   * noiseModel::Robust are instead linearized in three passes:
+   *  1. the Jacobians are whitened by the Gaussian part of the model only and
+   *     written into JacobianFactors kept from the previous call, while the
+   *     whitened residuals go into one flat array;
+   *  2. the weights of all robust factors are computed from that array, with
+   *     one call to mEstimator::Base::weight(Vector) per group of identical
+   *     m-estimators, e.g., all Huber(1.345) kernels created by load2D;
+   *  3. the rows of the stored Jacobians are scaled by the square-root weights.
+   * All other factors are linearized as usual.
+   *
+   * The Jacobians of the error functions are kept from call to call as well, so
+   * the only allocation per robust factor is the error vector returned by
+   * unwhitenedError, which the usual path allocates too.
+   *
+   * The result is the same as NonlinearFactorGraph::linearize. Note that the
+   * JacobianFactors of robust factors in the returned graph are owned by the
+   * linearizer and overwritten by the next call to linearize, so a graph that
+   * must outlive that call has to be cloned.  Optimizers linearize with it if
+   * NonlinearOptimizerParams::linearizeRobustInBatch is set.
+   */
+  class GTSAM_EXPORT RobustLinearizer {
+
+  public:
+
+    typedef boost::shared_ptr<RobustLinearizer> shared_ptr;
+
+  protected:
+
+    typedef noiseModel::mEstimator::Base MEstimator;
+
+    /// A factor with a robust noise model
+    struct RobustFactor {
+      size_t factor;                        ///< index in the graph
+      size_t row;                           ///< first row in residuals_ and weights_
+      size_t dim;                           ///< number of rows
+      size_t group;                         ///< index of its m-estimator group
+      noiseModel::Base::shared_ptr noise;   ///< Gaussian part of the noise model
+      JacobianFactor::shared_ptr jacobian;  ///< storage reused across calls
+      std::vector<Matrix> A;                ///< Jacobians of the error function, reused across calls
+      bool active;                          ///< whether it was active in the last call
+    };
+
+    /// Robust factors with equal m-estimators, whose weights are computed together
+    struct Group {
+      MEstimator::shared_ptr robust;        ///< the shared m-estimator
+      std::vector<size_t> members;          ///< indices into robust_
+      Vector errors;                        ///< one error per row or per factor
+    };
+
+    NonlinearFactorGraph graph_;            ///< the graph being linearized
+    std::vector<RobustFactor> robust_;      ///< the robust factors
+    std::vector<Group> groups_;             ///< m-estimator groups
+    std::vector<int> robustIndex_;          ///< index in robust_ for each factor, or -1
+    Vector residuals_;                      ///< whitened, unweighted residuals
+    Vector weights_;                        ///< square-root weights of every row
+
+    /// Find the robust factors of graph_ and group their m-estimators
+    void findRobustFactors();
+
+    /// Linearize factor i into result, or for a robust factor, whiten it into
+    /// its stored Jacobian and residuals_
+    void linearizeFactor(size_t i, const Values& x, GaussianFactorGraph& result);
+
+    /// Recompute weights_ from residuals_, before linearize scales the rows with them
+    void updateWeights();
+
+    struct LinearizeFactors; ///< TBB body for linearizeFactor
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Find the robust factors of graph and group their m-estimators */
+    explicit RobustLinearizer(const NonlinearFactorGraph& graph);
+
+    /** Copy the graph only, so that the copy does not share the stored
+     *  Jacobians, which linearize overwrites */
+    RobustLinearizer(const RobustLinearizer& other);
+
+    /** Assignment copies the graph only, see the copy constructor */
+    RobustLinearizer& operator=(const RobustLinearizer& other);
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Linearize the graph at x, see class documentation.  The robust factors of
+    /// the returned graph are overwritten by the next call.
+    GaussianFactorGraph::shared_ptr linearize(const Values& x);
+
+    /// Number of factors with a robust noise model
+    size_t nrRobustFactors() const { return robust_.size(); }
+
+    /// Number of distinct m-estimators
+    size_t nrGroups() const { return groups_.size(); }
+
+    /// Whitened, unweighted residuals of the robust factors, in graph order
+    const Vector& residuals() const { return residuals_; }
+
+    /// Square-root weights of the rows in residuals()
+    const Vector& weights() const { return weights_; }
+
+    /// @}
+  };
+
+} // namespace gtsam
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testAutoDiffFactor.cpp
+ * @brief   Unit tests for AutoDiffFactor1, AutoDiffFactor2 and AutoDiffFactor3
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/AutoDiffFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel model2 = noiseModel::Isotropic::Sigma(2, 0.5);
+static const Cal3_S2::shared_ptr K(new Cal3_S2(500.0, 480.0, 0.1, 320.0, 240.0));
+static const Pose3 pose(Rot3::ypr(0.3, -0.2, 1.1), Point3(0.5, -1.0, -12.0));
+static const Point3 point(1.0, 2.0, 4.0);
+
+/* ************************************************************************* */
+// Prior on a point
+struct PointPrior {
+  enum { dimension = 3 };
+  Point3 prior;
+  PointPrior(const Point3& prior) : prior(prior) {}
+  template<typename T>
+  Eigen::Matrix<T, 3, 1> operator()(const autodiff::Point3<T>& p) const {
+    return (p - autodiff::Point3<T>(prior)).vector();
+  }
+};
+
+// Reprojection error with a known calibration
+struct Reprojection {
+  enum { dimension = 2 };
+  Point2 measured;
+  Cal3_S2 K;
+  Reprojection(const Point2& measured, const Cal3_S2& K) : measured(measured), K(K) {}
+  template<typename T>
+  Eigen::Matrix<T, 2, 1> operator()(const autodiff::Pose3<T>& pose, const autodiff::Point3<T>& point) const {
+    const autodiff::PinholeCamera<T> camera(pose, autodiff::Cal3_S2<T>(K));
+    return (camera.project(point) - autodiff::Point2<T>(measured)).vector();
+  }
+};
+
+// Reprojection error with an unknown calibration
+struct CalibratedReprojection {
+  enum { dimension = 2 };
+  Point2 measured;
+  CalibratedReprojection(const Point2& measured) : measured(measured) {}
+  template<typename T>
+  Eigen::Matrix<T, 2, 1> operator()(const autodiff::Pose3<T>& pose, const autodiff::Point3<T>& point,
+      const autodiff::Cal3_S2<T>& K) const {
+    return (autodiff::PinholeCamera<T>(pose, K).project(point) - autodiff::Point2<T>(measured)).vector();
+  }
+};
+
+/* ************************************************************************* */
+TEST(AutoDiffFactor, prior) {
+  const Point3 prior(1.0, 1.5, 3.0);
+  const SharedNoiseModel model3 = noiseModel::Isotropic::Sigma(3, 0.1);
+  AutoDiffFactor1<Point3, PointPrior> factor(model3, 1, PointPrior(prior));
+  PriorFactor<Point3> expected(1, prior, model3);
+
+  Values values;
+  values.insert(1, point);
+  EXPECT_DOUBLES_EQUAL(expected.error(values), factor.error(values), 1e-9);
+  EXPECT(assert_equal(*expected.linearize(values), *factor.linearize(values), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(AutoDiffFactor, projection) {
+  const Point2 measured(330.0, 250.0);
+  AutoDiffFactor2<Pose3, Point3, Reprojection> factor(model2, 1, 2, Reprojection(measured, *K));
+  GenericProjectionFactor<Pose3, Point3> expected(measured, model2, 1, 2, K);
+
+  Values values;
+  values.insert(1, pose);
+  values.insert(2, point);
+  EXPECT_DOUBLES_EQUAL(expected.error(values), factor.error(values), 1e-9);
+  EXPECT(assert_equal(*expected.linearize(values), *factor.linearize(values), 1e-9));
+
+  // Only the requested Jacobians are computed
+  Matrix expectedH2, H2;
+  const Vector error = factor.evaluateError(pose, point, boost::none, H2);
+  EXPECT(assert_equal(expected.evaluateError(pose, point, boost::none, expectedH2), error, 1e-9));
+  EXPECT(assert_equal(expectedH2, H2, 1e-9));
+}
+
+/* ************************************************************************* */
+static Vector calibratedError(const Pose3& pose, const Point3& point, const Cal3_S2& K,
+    const Point2& measured) {
+  return (PinholeCamera<Cal3_S2>(pose, K).project(point) - measured).vector();
+}
+
+TEST(AutoDiffFactor, calibration) {
+  const Point2 measured(330.0, 250.0);
+  AutoDiffFactor3<Pose3, Point3, Cal3_S2, CalibratedReprojection> factor(
+      model2, 1, 2, 3, CalibratedReprojection(measured));
+
+  Matrix H1, H2, H3;
+  const Vector actual = factor.evaluateError(pose, point, *K, H1, H2, H3);
+  EXPECT(assert_equal(calibratedError(pose, point, *K, measured), actual, 1e-9));
+
+  boost::function<Vector(const Pose3&, const Point3&, const Cal3_S2&)> f =
+    boost::bind(calibratedError, _1, _2, _3, measured);
+  EXPECT(assert_equal(numericalDerivative31(f, pose, point, *K), H1, 1e-5));
+  EXPECT(assert_equal(numericalDerivative32(f, pose, point, *K), H2, 1e-5));
+  EXPECT(assert_equal(numericalDerivative33(f, pose, point, *K), H3, 1e-5));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPooledLinearizer.cpp
+ * @brief   Unit tests for PooledLinearizer
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/PooledLinearizer.h>
+#include <gtsam/nonlinear/NonlinearEquality.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/RangeFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedDiagonal model = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.2, 0.05));
+
+/* ************************************************************************* */
+// Inequality constraint x > x0 on a pose, which is only active when violated
+class XBound : public NoiseModelFactor1<Pose2> {
+  double x0_;
+public:
+  XBound(Key j, double x0) :
+      NoiseModelFactor1<Pose2>(noiseModel::Isotropic::Sigma(1, 0.1), j), x0_(x0) {}
+  virtual bool active(const Values& c) const { return c.at<Pose2>(key()).x() < x0_; }
+  virtual bool supportsLinearizeInPlace() const { return true; }
+  Vector evaluateError(const Pose2& pose, boost::optional<Matrix&> H = boost::none) const {
+    if (H)
+      *H = (Matrix(1, 3) << cos(pose.theta()), -sin(pose.theta()), 0.0);
+    return (Vector(1) << pose.x() - x0_);
+  }
+};
+
+// BetweenFactor with its own linearize, like TriangulationFactor, which must not be relinearized
+// in place although BetweenFactor is
+class OwnLinearize : public BetweenFactor<Pose2> {
+public:
+  OwnLinearize(Key j1, Key j2, const Pose2& measured) :
+      BetweenFactor<Pose2>(j1, j2, measured, model) {}
+  virtual GaussianFactor::shared_ptr linearize(const Values& x) const {
+    GaussianFactor::shared_ptr linear = BetweenFactor<Pose2>::linearize(x);
+    return linear->negate();
+  }
+};
+
+/* ************************************************************************* */
+// Small pose graph with hard constraints, constrained noise models, an inequality constraint that
+// is active for some values only, a factor with its own linearize, and a null factor
+static NonlinearFactorGraph createGraph() {
+  NonlinearFactorGraph graph;
+  graph.add(NonlinearEquality<Pose2>(0, Pose2()));
+  for (Key j = 0; j < 3; ++j)
+    graph.add(BetweenFactor<Pose2>(j, j + 1, Pose2(1, 0, M_PI_2), model));
+  graph.push_back(NonlinearFactor::shared_ptr());
+  graph.add(BetweenFactor<Pose2>(3, 0, Pose2(1.1, 0, M_PI_2),
+      noiseModel::Constrained::MixedSigmas((Vector(3) << 0.0, 0.1, 0.1))));
+  graph.add(NonlinearEquality1<Pose2>(Pose2(1, 1, M_PI), 2));
+  graph.add(XBound(1, 1.2));
+  graph.add(OwnLinearize(1, 3, Pose2(-1, 1, M_PI)));
+  graph.add(PriorFactor<Pose2>(2, Pose2(1, 1, M_PI), model));
+  return graph;
+}
+
+static Values createValues(double perturbation) {
+  Values values;
+  values.insert(0, Pose2(0.0, 0.0, 0.0));
+  values.insert(1, Pose2(1.0 + perturbation, 0.1, M_PI_2));
+  values.insert(2, Pose2(1.1, 1.0 - perturbation, M_PI));
+  values.insert(3, Pose2(0.0, 1.2, -M_PI_2 + perturbation));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST( PooledLinearizer, sameAsLinearize ) {
+  const NonlinearFactorGraph graph = createGraph();
+  PooledLinearizer linearizer;
+
+  // The inequality constraint is active for the first and third values only
+  const double perturbations[] = { 0.05, 0.35, 0.1, 0.4 };
+  vector<GaussianFactorGraph> results;
+  GaussianFactorGraph::shared_ptr first;
+  for (size_t k = 0; k < 4; ++k) {
+    const Values values = createValues(perturbations[k]);
+    GaussianFactorGraph::shared_ptr linear = linearizer.linearize(graph, values);
+    EXPECT(assert_equal(*graph.linearize(values), *linear, 1e-9));
+    if (k == 0)
+      first = linear;
+    EXPECT(first == linear); // every call overwrites the same graph
+    results.push_back(*linear);
+  }
+
+  // Factors that opt in keep their storage, also those with constrained models
+  const size_t inPlace[] = { 1, 2, 3, 5, 6, 9 };
+  BOOST_FOREACH(size_t i, inPlace)
+    for (size_t k = 1; k < 4; ++k)
+      EXPECT(results[0][i] == results[k][i]);
+
+  // NonlinearEquality and OwnLinearize override linearize, so they are linearized as usual
+  for (size_t k = 1; k < 4; ++k) {
+    EXPECT(results[k - 1][0] != results[k][0]);
+    EXPECT(results[k - 1][8] != results[k][8]);
+  }
+
+  // The inequality constraint is kept while inactive, and relinearized into the same storage
+  EXPECT(results[0][7]);
+  EXPECT(!results[1][7]);
+  EXPECT(results[0][7] == results[2][7]);
+  EXPECT(!results[3][7]);
+}
+
+/* ************************************************************************* */
+TEST( PooledLinearizer, shapeChange ) {
+  NonlinearFactorGraph graph = createGraph();
+  PooledLinearizer linearizer;
+  const GaussianFactorGraph before = *linearizer.linearize(graph, createValues(0.05));
+
+  // Factors on other keys, and on the same keys with fewer rows, are linearized anew
+  graph.replace(1, BetweenFactor<Pose2>::shared_ptr(
+      new BetweenFactor<Pose2>(0, 2, Pose2(1, 1, M_PI), model)));
+  graph.replace(2, RangeFactor<Pose2, Pose2>::shared_ptr(
+      new RangeFactor<Pose2, Pose2>(1, 2, 1.0, noiseModel::Isotropic::Sigma(1, 0.1))));
+  GaussianFactorGraph::shared_ptr after = linearizer.linearize(graph, createValues(0.05));
+  EXPECT(assert_equal(*graph.linearize(createValues(0.05)), *after, 1e-9));
+  EXPECT(before[1] != (*after)[1]);
+  EXPECT(before[2] != (*after)[2]);
+  EXPECT(before[3] == (*after)[3]);
+
+  // A graph of another size starts over
+  graph.add(PriorFactor<Pose2>(3, Pose2(0, 1, -M_PI_2), model));
+  GaussianFactorGraph::shared_ptr grown = linearizer.linearize(graph, createValues(0.05));
+  EXPECT(assert_equal(*graph.linearize(createValues(0.05)), *grown, 1e-9));
+  LONGS_EQUAL(long(graph.size()), long(grown->size()));
+}
+
+/* ************************************************************************* */
+TEST( PooledLinearizer, copy ) {
+  const NonlinearFactorGraph graph = createGraph();
+  PooledLinearizer linearizer;
+  GaussianFactorGraph::shared_ptr first = linearizer.linearize(graph, createValues(0.05));
+
+  // A copy does not share the pool
+  PooledLinearizer copy(linearizer);
+  GaussianFactorGraph::shared_ptr second = copy.linearize(graph, createValues(0.35));
+  EXPECT(first != second);
+  EXPECT(assert_equal(*graph.linearize(createValues(0.05)), *first, 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
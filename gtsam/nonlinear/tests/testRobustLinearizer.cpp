@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testRobustLinearizer.cpp
+ * @brief   Unit tests for RobustLinearizer
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/RobustLinearizer.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedDiagonal model = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.2, 0.05));
+
+/* ************************************************************************* */
+// Small pose graph with a loop closure that is an outlier
+static NonlinearFactorGraph createGraph(noiseModel::mEstimator::Base::ReweightScheme scheme) {
+  NonlinearFactorGraph graph;
+  graph.add(PriorFactor<Pose2>(0, Pose2(), model));
+  for (Key j = 0; j < 4; ++j)
+    graph.add(BetweenFactor<Pose2>(j, j + 1, Pose2(1, 0, M_PI_2),
+        noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.345, scheme), model)));
+  graph.add(BetweenFactor<Pose2>(4, 0, Pose2(3, 2, 0.5),
+      noiseModel::Robust::Create(noiseModel::mEstimator::Tukey::Create(4.6851, scheme), model)));
+  graph.add(BetweenFactor<Pose2>(1, 3, Pose2(0, 1.8, M_PI),
+      noiseModel::Robust::Create(noiseModel::mEstimator::Cauchy::Create(0.5, scheme), model)));
+  return graph;
+}
+
+static Values createValues(double perturbation) {
+  Values values;
+  values.insert(0, Pose2(0.0, 0.0, 0.0));
+  values.insert(1, Pose2(1.0 + perturbation, 0.1, M_PI_2));
+  values.insert(2, Pose2(1.1, 1.0 - perturbation, M_PI));
+  values.insert(3, Pose2(0.0, 1.2, -M_PI_2 + perturbation));
+  values.insert(4, Pose2(0.1, 0.0, perturbation));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST( RobustLinearizer, sameAsLinearize ) {
+  for (int s = 0; s < 2; ++s) {
+    noiseModel::mEstimator::Base::ReweightScheme scheme =
+        s ? noiseModel::mEstimator::Base::Scalar : noiseModel::mEstimator::Base::Block;
+    NonlinearFactorGraph graph = createGraph(scheme);
+    RobustLinearizer linearizer(graph);
+    LONGS_EQUAL(6, linearizer.nrRobustFactors());
+    LONGS_EQUAL(3, linearizer.nrGroups());
+    LONGS_EQUAL(18, linearizer.residuals().size());
+
+    // Twice, so the second call overwrites the stored Jacobians
+    for (int k = 0; k < 2; ++k) {
+      Values values = createValues(0.3 * k + 0.05);
+      GaussianFactorGraph expected = *graph.linearize(values);
+      GaussianFactorGraph actual = *linearizer.linearize(values);
+      EXPECT(assert_equal(expected, actual, 1e-9));
+    }
+
+    // The outlier loop closure is down-weighted
+    EXPECT(linearizer.weights()(12) < 1.0);
+  }
+}
+
+/* ************************************************************************* */
+TEST( RobustLinearizer, copy ) {
+  NonlinearFactorGraph graph = createGraph(noiseModel::mEstimator::Base::Block);
+  RobustLinearizer linearizer(graph);
+  GaussianFactorGraph::shared_ptr first = linearizer.linearize(createValues(0.05));
+
+  // A copy has its own storage, so it does not overwrite the graph of the original
+  RobustLinearizer copy(linearizer);
+  LONGS_EQUAL(6, copy.nrRobustFactors());
+  GaussianFactorGraph expected = *graph.linearize(createValues(0.05));
+  EXPECT(assert_equal(*graph.linearize(createValues(0.35)), *copy.linearize(createValues(0.35)), 1e-9));
+  EXPECT(assert_equal(expected, *first, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( RobustLinearizer, optimizer ) {
+  NonlinearFactorGraph graph = createGraph(noiseModel::mEstimator::Base::Block);
+  Values initial = createValues(0.05);
+  LevenbergMarquardtParams params;
+  Values expected = LevenbergMarquardtOptimizer(graph, initial, params).optimize();
+  params.setLinearizeRobustInBatch(true);
+  EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(graph, initial, params).optimize(), 1e-9));
+  params.setLinearizeInPlace(true);
+  EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(graph, initial, params).optimize(), 1e-9));
+  GaussNewtonParams gnParams;
+  gnParams.setLinearizeRobustInBatch(true);
+  EXPECT(assert_equal(GaussNewtonOptimizer(graph, initial).optimize(),
+      GaussNewtonOptimizer(graph, initial, gnParams).optimize(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( RobustLinearizer, vectorWeights ) {
+  Vector errors = (Vector(5) << -2.0, -0.5, 0.0, 0.7, 6.0);
+  vector<noiseModel::mEstimator::Base::shared_ptr> estimators;
+  estimators.push_back(noiseModel::mEstimator::Null::Create());
+  estimators.push_back(noiseModel::mEstimator::Fair::Create(1.3998));
+  estimators.push_back(noiseModel::mEstimator::Huber::Create(1.345));
+  estimators.push_back(noiseModel::mEstimator::Cauchy::Create(0.5));
+  estimators.push_back(noiseModel::mEstimator::Tukey::Create(4.6851));
+  estimators.push_back(noiseModel::mEstimator::Welsh::Create(2.9846));
+  BOOST_FOREACH(const noiseModel::mEstimator::Base::shared_ptr& estimator, estimators) {
+    Vector actual = estimator->weight(errors);
+    for (size_t i = 0; i < 5; ++i)
+      EXPECT_DOUBLES_EQUAL(estimator->weight(errors(i)), actual(i), 1e-12);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
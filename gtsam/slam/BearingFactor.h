@@ -61,6 +61,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /** h(x)-z -> between(z,h(x)) for Rot2 manifold */
     Vector evaluateError(const Pose& pose, const Point& point,
         boost::optional<Matrix&> H1, boost::optional<Matrix&> H2) const {
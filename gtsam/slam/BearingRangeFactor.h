@@ -65,6 +65,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /** Print */
     virtual void print(const std::string& s = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
       std::cout << s << "BearingRangeFactor("
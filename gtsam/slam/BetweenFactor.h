@@ -67,6 +67,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /** implement functions needed for Testable */
 
     /** print */
@@ -70,6 +70,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /**
      * print
      * @param s optional string naming the factor
@@ -159,6 +161,8 @@ namespace gtsam {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
           gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+    GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
     /**
      * print
      * @param s optional string naming the factor
@@ -95,6 +95,8 @@ public:
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
         gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
 
+  GTSAM_SUPPORTS_LINEARIZE_IN_PLACE
+
   /**
    * print
    * @param s optional string naming the factor
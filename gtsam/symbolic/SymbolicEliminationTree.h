@@ -40,8 +40,15 @@ namespace gtsam {
     SymbolicEliminationTree(const SymbolicFactorGraph& factorGraph,
       const VariableIndex& structure, const Ordering& order);
 
+    /** Build the elimination tree of a factor graph using pre-computed column structure in the
+     *  compressed form of a batch problem.
+     *  @param factorGraph The factor graph for which to build the elimination tree
+     *  @param structure The set of factors involving each variable */
+    SymbolicEliminationTree(const SymbolicFactorGraph& factorGraph,
+      const CompressedVariableIndex& structure, const Ordering& order);
+
     /** Build the elimination tree of a factor graph.  Note that this has to compute the column
-     *  structure as a VariableIndex, so if you already have this precomputed, use the other
+     *  structure as a CompressedVariableIndex, so if you already have this precomputed, use the other
      *  constructor instead.
      *  @param factorGraph The factor graph for which to build the elimination tree */
     SymbolicEliminationTree(const SymbolicFactorGraph& factorGraph,
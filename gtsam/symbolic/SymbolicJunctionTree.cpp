@@ -31,4 +31,9 @@ namespace gtsam {
     const SymbolicEliminationTree& eliminationTree) :
   Base(eliminationTree) {}
 
+  /* ************************************************************************* */
+  SymbolicJunctionTree::SymbolicJunctionTree(
+    const SymbolicFactorGraph& factorGraph, const SupernodalStructure& structure) :
+  Base(factorGraph, structure) {}
+
 }
@@ -61,6 +61,10 @@ namespace gtsam {
     * @return The elimination tree
     */
     SymbolicJunctionTree(const SymbolicEliminationTree& eliminationTree);
+
+    /** Build the junction tree with the (relaxed) supernodes of a SupernodalStructure, made from
+     *  the VariableIndex of \c factorGraph */
+    SymbolicJunctionTree(const SymbolicFactorGraph& factorGraph, const SupernodalStructure& structure);
   };
 
 }
@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testCompressedVariableIndex.cpp
+ * @brief   Unit tests for CompressedVariableIndex
+ * @date    October 19, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicEliminationTree.h>
+
+#include <boost/foreach.hpp>
+#include <boost/assign/list_of.hpp>
+using namespace boost::assign;
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A grid of rows x cols variables with a factor on every edge and a prior on the corner
+static SymbolicFactorGraph grid(size_t rows, size_t cols) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for(size_t r = 0; r < rows; ++r) {
+    for(size_t c = 0; c < cols; ++c) {
+      const Key j = r * cols + c;
+      if(c + 1 < cols) graph.push_factor(j, j + 1);
+      if(r + 1 < rows) graph.push_factor(j, j + cols);
+    }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, constructor)
+{
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 1);
+  graph.push_factor(0, 2);
+  graph.push_factor(5, 9);
+  graph.push_back(SymbolicFactor::shared_ptr()); // A null factor keeps its index
+  graph.push_factor(2, 3);
+  graph.push_factor(1, 3, 5);
+
+  const CompressedVariableIndex actual(graph);
+  const VariableIndex expected(graph);
+  LONGS_EQUAL(6, (long)actual.nFactors());
+  LONGS_EQUAL(expected.nEntries(), (long)actual.nEntries());
+  LONGS_EQUAL(expected.size(), (long)actual.size());
+
+  // Same factors for every key, with keys in increasing order
+  size_t j = 0;
+  BOOST_FOREACH(const VariableIndex::value_type& key_factors, expected) {
+    EXPECT_LONGS_EQUAL((long)key_factors.first, (long)actual.key(j));
+    EXPECT_LONGS_EQUAL((long)j, (long)actual.index(key_factors.first));
+    const FastVector<size_t> expectedFactors(key_factors.second.begin(), key_factors.second.end());
+    const FastVector<size_t> actualFactors(actual[key_factors.first].begin(), actual[key_factors.first].end());
+    EXPECT(assert_container_equality(expectedFactors, actualFactors));
+    ++ j;
+  }
+
+  // Keys that are not involved in any factor
+  EXPECT_LONGS_EQUAL((long)actual.size(), (long)actual.find(4));
+  CHECK_EXCEPTION(actual[4], std::invalid_argument);
+
+  EXPECT(assert_equal(actual, CompressedVariableIndex(graph)));
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, COLAMD)
+{
+  // COLAMD sees the same columns as from a VariableIndex
+  const SymbolicFactorGraph grid8 = grid(8, 8);
+  const CompressedVariableIndex compressed(grid8);
+  const VariableIndex variableIndex(grid8);
+  EXPECT(assert_equal(Ordering::COLAMD(variableIndex), Ordering::COLAMD(compressed)));
+
+  const vector<Key> last = list_of(63)(0);
+  EXPECT(assert_equal(Ordering::COLAMDConstrainedLast(variableIndex, last, true),
+    Ordering::COLAMDConstrainedLast(compressed, last, true)));
+  EXPECT(assert_equal(Ordering::COLAMDConstrainedFirst(variableIndex, last),
+    Ordering::COLAMDConstrainedFirst(compressed, last)));
+
+  // An empty graph gives an empty ordering
+  EXPECT(Ordering::COLAMD(CompressedVariableIndex(SymbolicFactorGraph())).empty());
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, eliminationTree)
+{
+  const SymbolicFactorGraph grid8 = grid(8, 8);
+  const Ordering ordering = Ordering::COLAMD(grid8);
+  SymbolicEliminationTree expected(grid8, VariableIndex(grid8), ordering);
+  SymbolicEliminationTree actual(grid8, CompressedVariableIndex(grid8), ordering);
+  EXPECT(assert_equal(expected, actual));
+
+  // Variables not in the graph cannot be eliminated
+  const Ordering wrong = list_of(0)(100);
+  CHECK_EXCEPTION(SymbolicEliminationTree(grid8, CompressedVariableIndex(grid8), wrong),
+    std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
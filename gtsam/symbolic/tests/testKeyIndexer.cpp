@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testKeyIndexer.cpp
+ * @brief   Unit tests for KeyIndexer
+ * @date    October 19, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <gtsam/inference/KeyIndexer.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesTree.h>
+
+#include <boost/assign/list_of.hpp>
+using namespace boost::assign;
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+/* ************************************************************************* */
+static SymbolicFactorGraph createGraph() {
+  SymbolicFactorGraph graph;
+  graph.push_factor(X(1));
+  graph.push_factor(X(1), X(2));
+  graph.push_factor(X(2), X(3));
+  graph.push_factor(X(1), L(1));
+  graph.push_factor(X(3), L(1));
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(KeyIndexer, fromGraph) {
+  const KeyIndexer indexer(createGraph());
+
+  // Keys are indexed in increasing order
+  const FastVector<Key> expected = list_of(L(1))(X(1))(X(2))(X(3));
+  EXPECT(assert_container_equality(expected, indexer.keys()));
+  LONGS_EQUAL(4, (long)indexer.size());
+  for(size_t j = 0; j < expected.size(); ++j)
+    LONGS_EQUAL((long)j, (long)indexer.index(expected[j]));
+
+  EXPECT(indexer.exists(X(2)));
+  EXPECT(!indexer.exists(X(4)));
+  EXPECT(indexer.find(X(4)) == KeyIndexer::None);
+  CHECK_EXCEPTION(indexer.index(X(4)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(KeyIndexer, fromOrdering) {
+  const SymbolicFactorGraph graph = createGraph();
+  const Ordering ordering = Ordering::COLAMD(graph);
+  const KeyIndexer indexer(ordering);
+
+  // Indices are elimination positions
+  for(size_t j = 0; j < ordering.size(); ++j) {
+    LONGS_EQUAL((long)j, (long)indexer.index(ordering[j]));
+    EXPECT_LONGS_EQUAL((long)ordering[j], (long)indexer.key(j));
+  }
+
+  const FastVector<Key> duplicates = list_of(X(1))(X(2))(X(1));
+  CHECK_EXCEPTION(KeyIndexer indexer2(duplicates), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(KeyIndexer, fromCompressedVariableIndex) {
+  const SymbolicFactorGraph graph = createGraph();
+  const CompressedVariableIndex variableIndex(graph);
+  EXPECT(assert_equal(KeyIndexer(graph), KeyIndexer(variableIndex)));
+}
+
+/* ************************************************************************* */
+TEST(KeyIndexer, indexFactors) {
+  SymbolicFactorGraph graph = createGraph();
+  graph.push_back(SymbolicFactor::shared_ptr());
+  graph.push_factor(X(3), X(1));
+  const FastVector<Key> keys = list_of(X(3))(X(2))(X(1))(L(1));
+  const KeyIndexer indexer(keys);
+
+  const KeyIndexer::FactorIndices factorIndices = indexer.indexFactors(graph);
+  LONGS_EQUAL((long)graph.size(), (long)factorIndices.size());
+  for(size_t i = 0; i < graph.size(); ++i) {
+    if(graph[i]) {
+      LONGS_EQUAL((long)graph[i]->size(), (long)(factorIndices.end(i) - factorIndices.begin(i)));
+      for(size_t k = 0; k < graph[i]->size(); ++k)
+        EXPECT_LONGS_EQUAL((long)graph[i]->keys()[k], (long)indexer.key(factorIndices.begin(i)[k]));
+    } else {
+      EXPECT(factorIndices.begin(i) == factorIndices.end(i));
+    }
+  }
+
+  SymbolicFactorGraph other;
+  other.push_factor(X(4));
+  CHECK_EXCEPTION(indexer.indexFactors(other), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(KeyIndexer, denseNodes) {
+  const SymbolicFactorGraph graph = createGraph();
+  const SymbolicBayesTree bayesTree = *graph.eliminateMultifrontal();
+  const FastVector<Key> keys = list_of(X(2))(X(4))(L(1));
+  const KeyIndexer indexer(keys);
+
+  const FastVector<SymbolicBayesTree::sharedClique> nodes = bayesTree.denseNodes(indexer);
+  LONGS_EQUAL(3, (long)nodes.size());
+  EXPECT(nodes[0] == bayesTree[X(2)]);
+  EXPECT(!nodes[1]);
+  EXPECT(nodes[2] == bayesTree[L(1)]);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
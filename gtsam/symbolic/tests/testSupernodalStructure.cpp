@@ -0,0 +1,143 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSupernodalStructure.cpp
+ * @brief   Unit tests for SupernodalStructure
+ * @date    October 19, 2026
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <gtsam/inference/SupernodalStructure.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesNet.h>
+#include <gtsam/symbolic/SymbolicBayesTree.h>
+#include <gtsam/symbolic/SymbolicConditional.h>
+#include <gtsam/symbolic/SymbolicJunctionTree.h>
+
+#include <boost/foreach.hpp>
+#include <boost/assign/list_of.hpp>
+using namespace boost::assign;
+
+#include <algorithm>
+
+#include "symbolicExampleGraphs.h"
+
+using namespace gtsam;
+using namespace std;
+
+/* ************************************************************************* */
+// A grid of rows x cols variables with a factor on every edge and a prior on the corner
+static SymbolicFactorGraph grid(size_t rows, size_t cols) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for(size_t r = 0; r < rows; ++r) {
+    for(size_t c = 0; c < cols; ++c) {
+      const Key j = r * cols + c;
+      if(c + 1 < cols) graph.push_factor(j, j + 1);
+      if(r + 1 < rows) graph.push_factor(j, j + cols);
+    }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+// Check the elimination tree and column counts against sequential symbolic elimination
+static bool checkCounts(const SymbolicFactorGraph& graph, const Ordering& ordering) {
+  SupernodalStructure structure(VariableIndex(graph), ordering);
+  const SymbolicBayesNet bayesNet = *graph.eliminateSequential(ordering);
+  FastMap<Key, SymbolicConditional::shared_ptr> conditionals;
+  BOOST_FOREACH(const SymbolicConditional::shared_ptr& conditional, bayesNet)
+    conditionals[conditional->firstFrontalKey()] = conditional;
+  const FastMap<Key, size_t> position = ordering.invert();
+  bool ok = structure.nrVariables() == ordering.size();
+  for(size_t j = 0; j < ordering.size(); ++j) {
+    const SymbolicConditional& conditional = *conditionals.at(ordering[j]);
+    ok = ok && structure.columnCount(j) == conditional.size();
+    size_t parent = SupernodalStructure::None;
+    BOOST_FOREACH(Key key, conditional.parents())
+      parent = min(parent, position.at(key));
+    ok = ok && structure.parent(j) == parent;
+  }
+  return ok;
+}
+
+/* ************************************************************************* */
+TEST(SupernodalStructure, columnCounts)
+{
+  EXPECT(checkCounts(simpleChain, Ordering(list_of(0)(1)(2)(3))));
+  EXPECT(checkCounts(simpleChain, Ordering(list_of(3)(0)(2)(1))));
+  EXPECT(checkCounts(asiaGraph, asiaOrdering));
+  const SymbolicFactorGraph grid8 = grid(8, 8);
+  EXPECT(checkCounts(grid8, Ordering::COLAMD(grid8)));
+  EXPECT(checkCounts(grid8, Ordering::Natural(grid8)));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalStructure, exactSupernodes)
+{
+  // Exact supernodes eliminate to the Bayes tree of the usual junction tree
+  const SymbolicFactorGraph grid8 = grid(8, 8);
+  const Ordering ordering = Ordering::COLAMD(grid8);
+  SupernodalStructure structure(VariableIndex(grid8), ordering, SupernodeParams::Exact());
+  DOUBLES_EQUAL(0.0, structure.nrExplicitZeros(), 1e-9);
+
+  SymbolicJunctionTree junctionTree(grid8, structure);
+  LONGS_EQUAL(1, junctionTree.roots().size());
+  SymbolicBayesTree actual = *junctionTree.eliminate(EliminateSymbolic).first;
+  SymbolicBayesTree expected = *grid8.eliminateMultifrontal(ordering);
+  LONGS_EQUAL(expected.size(), structure.nrSupernodes());
+  EXPECT(assert_equal(expected, actual));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalStructure, relaxedSupernodes)
+{
+  // Relaxing merges cliques of the grid at the cost of explicit zeros
+  const SymbolicFactorGraph grid8 = grid(8, 8);
+  const Ordering ordering = Ordering::COLAMD(grid8);
+  const VariableIndex variableIndex(grid8);
+  SupernodalStructure exact(variableIndex, ordering, SupernodeParams::Exact());
+  SupernodalStructure relaxed(variableIndex, ordering);
+  EXPECT(relaxed.nrSupernodes() < exact.nrSupernodes());
+  EXPECT(relaxed.nrExplicitZeros() > 0.0);
+
+  // Frontals of all supernodes are the ordering, each factor is in exactly one supernode, and
+  // supernodes come before their parents
+  size_t nrFrontals = 0, nrFactors = 0;
+  for(size_t s = 0; s < relaxed.nrSupernodes(); ++s) {
+    nrFrontals += relaxed.frontalsEnd(s) - relaxed.frontalsBegin(s);
+    nrFactors += relaxed.factorsEnd(s) - relaxed.factorsBegin(s);
+    EXPECT(relaxed.superParent(s) == SupernodalStructure::None || relaxed.superParent(s) > s);
+  }
+  LONGS_EQUAL(ordering.size(), nrFrontals);
+  LONGS_EQUAL(grid8.size(), nrFactors);
+  EXPECT(relaxed.remainingFactors().empty());
+
+  // The merged cliques hold the same joint distribution: every variable's conditional has
+  // at least the variables it has in the exact Bayes tree
+  SymbolicBayesTree exactTree = *SymbolicJunctionTree(grid8, exact).eliminate(EliminateSymbolic).first;
+  SymbolicBayesTree relaxedTree = *SymbolicJunctionTree(grid8, relaxed).eliminate(EliminateSymbolic).first;
+  LONGS_EQUAL(relaxed.nrSupernodes(), relaxedTree.size());
+  BOOST_FOREACH(Key j, ordering) {
+    const SymbolicConditional::shared_ptr exactClique = exactTree[j]->conditional();
+    const SymbolicConditional::shared_ptr relaxedClique = relaxedTree[j]->conditional();
+    BOOST_FOREACH(Key parent, exactClique->parents())
+      EXPECT(find(relaxedClique->begin(), relaxedClique->end(), parent) != relaxedClique->end());
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -33,6 +33,7 @@
 #pragma GCC diagnostic pop
 #endif
 #include <boost/assign/list_of.hpp> // for 'list_of()'
+#include <boost/foreach.hpp>
 #include <functional>
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -147,6 +148,85 @@ TEST(DoglegOptimizer, Iterate) {
   }
 }
 
+/* ************************************************************************* */
+TEST(DoglegOptimizer, CachedModel) {
+  // Bayes tree of a planar graph, with cliques of several sizes
+  GaussianFactorGraph fg = example::planarGraph(4).get<0>();
+  GaussianBayesTree bt = *fg.eliminateMultifrontal();
+
+  // The per-clique gradient and steepest descent point match the factor graph ones
+  EXPECT(assert_equal(GaussianFactorGraph(bt).gradientAtZero(), bt.gradientAtZero()));
+  EXPECT(assert_equal(GaussianFactorGraph(bt).optimizeGradientSearch(), bt.optimizeGradientSearch()));
+
+  const VectorValues dx_u = bt.optimizeGradientSearch();
+  const VectorValues dx_n = bt.optimize();
+  DoglegOptimizerImpl::CachedModel model = DoglegOptimizerImpl::CachedModel::FromBayesTree(bt, dx_u, dx_n);
+  const double M_error = bt.error(VectorValues::Zero(dx_u));
+  DOUBLES_EQUAL(M_error, model.errorAtZero(), 1e-9);
+
+  // In each segment of the dogleg path, the point and the decrease of the model
+  // are those computed directly
+  const double Deltas[] = { 0.5 * dx_u.norm(), 0.5 * (dx_u.norm() + dx_n.norm()), 2.0 * dx_n.norm() };
+  BOOST_FOREACH(double Delta, Deltas) {
+    VectorValues actual;
+    const double decrease = model.doglegPoint(Delta, actual);
+    const VectorValues expected = DoglegOptimizerImpl::ComputeDoglegPoint(Delta, dx_u, dx_n);
+    EXPECT(assert_equal(expected, actual, 1e-9));
+    DOUBLES_EQUAL(M_error - bt.error(expected), decrease, 1e-9);
+  }
+
+  // The same from a Bayes net
+  GaussianBayesNet gbn = *fg.eliminateSequential();
+  const VectorValues bn_u = gbn.optimizeGradientSearch();
+  const VectorValues bn_n = gbn.optimize();
+  DoglegOptimizerImpl::CachedModel bnModel = DoglegOptimizerImpl::CachedModel::FromBayesNet(gbn, bn_u, bn_n);
+  VectorValues actual;
+  const double decrease = bnModel.doglegPoint(0.5 * bn_u.norm(), actual);
+  DOUBLES_EQUAL(gbn.error(VectorValues::Zero(bn_u)) - gbn.error(actual), decrease, 1e-9);
+
+  // The same from the products of the conditionals with the gradient, and the
+  // step along it to the steepest descent point
+  const VectorValues g = gbn.gradientAtZero();
+  DoglegOptimizerImpl::CachedModel::Products products;
+  BOOST_FOREACH(const GaussianConditional::shared_ptr& conditional, gbn)
+    products += DoglegOptimizerImpl::CachedModel::Products(*conditional, g, bn_n);
+  const double step = -g.dot(g) / products.AuAu;
+  EXPECT(assert_equal(bn_u, step * g, 1e-9));
+  DoglegOptimizerImpl::CachedModel gradientModel(products, step, bn_u, bn_n);
+  DOUBLES_EQUAL(bnModel.errorAtZero(), gradientModel.errorAtZero(), 1e-9);
+  BOOST_FOREACH(double Delta, Deltas) {
+    VectorValues expectedPoint, actualPoint;
+    const double expectedDecrease = bnModel.doglegPoint(Delta, expectedPoint);
+    DOUBLES_EQUAL(expectedDecrease, gradientModel.doglegPoint(Delta, actualPoint), 1e-9);
+    EXPECT(assert_equal(expectedPoint, actualPoint, 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(DoglegOptimizer, IterateCachedModel) {
+  // Same iterations with the model precomputed as with the Bayes net
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Values config;
+  config.insert(X(1), Point2(3,0));
+
+  double Delta = 1.0;
+  for(size_t it=0; it<10; ++it) {
+    GaussianBayesNet gbn = *fg.linearize(config)->eliminateSequential();
+    VectorValues dx_u = gbn.optimizeGradientSearch();
+    VectorValues dx_n = gbn.optimize();
+    DoglegOptimizerImpl::IterationResult expected = DoglegOptimizerImpl::Iterate(Delta,
+      DoglegOptimizerImpl::SEARCH_EACH_ITERATION, dx_u, dx_n, gbn, fg, config, fg.error(config));
+    DoglegOptimizerImpl::IterationResult actual = DoglegOptimizerImpl::Iterate(Delta,
+      DoglegOptimizerImpl::SEARCH_EACH_ITERATION, DoglegOptimizerImpl::CachedModel::FromBayesNet(gbn, dx_u, dx_n),
+      fg, config, fg.error(config));
+    DOUBLES_EQUAL(expected.Delta, actual.Delta, 1e-9);
+    DOUBLES_EQUAL(expected.f_error, actual.f_error, 1e-9);
+    EXPECT(assert_equal(expected.dx_d, actual.dx_d, 1e-9));
+    Delta = actual.Delta;
+    config = config.retract(actual.dx_d);
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -20,6 +20,7 @@
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/geometry/Pose2.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -427,6 +428,45 @@ TEST( ExtendedKalmanFilter, nonlinear ) {
 }
 
 
+/* ************************************************************************* */
+TEST( ExtendedKalmanFilter, squareRoot ) {
+
+  // The nonlinear example above, in both modes
+  Point2 x_initial(0.90, 1.10);
+  SharedDiagonal P_initial = noiseModel::Diagonal::Sigmas((Vector(2) << 0.1, 0.1));
+  ExtendedKalmanFilter<Point2> ekf(X(0), x_initial, P_initial);
+  ExtendedKalmanFilter<Point2> srif(X(0), x_initial, P_initial, ExtendedKalmanFilter<Point2>::SQUARE_ROOT);
+  EXPECT(srif.mode() == ExtendedKalmanFilter<Point2>::SQUARE_ROOT);
+
+  for(unsigned int i = 0; i < 10; ++i){
+    NonlinearMotionModel motionFactor(X(i), X(i+1));
+    EXPECT(assert_equal(ekf.predict(motionFactor), srif.predict(motionFactor), 1e-9));
+    NonlinearMeasurementModel measurementFactor(X(i+1), (Vector(1) << double(i+1)));
+    EXPECT(assert_equal(ekf.update(measurementFactor), srif.update(measurementFactor), 1e-9));
+    Matrix expectedR = ekf.sqrtInformation(), actualR = srif.sqrtInformation();
+    EXPECT(assert_equal(Matrix(expectedR.transpose() * expectedR), Matrix(actualR.transpose() * actualR), 1e-6));
+  }
+
+  // Pose2 odometry with full-rank priors as measurements
+  SharedDiagonal Q = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.1, 0.05));
+  SharedDiagonal R = noiseModel::Diagonal::Sigmas((Vector(3) << 0.3, 0.3, 0.1));
+  ExtendedKalmanFilter<Pose2> ekf2(X(0), Pose2(), Q);
+  ExtendedKalmanFilter<Pose2> srif2(X(0), Pose2(), Q, ExtendedKalmanFilter<Pose2>::SQUARE_ROOT);
+  for(unsigned int i = 0; i < 10; ++i){
+    BetweenFactor<Pose2> motionFactor(X(i), X(i+1), Pose2(1.0, 0.0, 0.3), Q);
+    EXPECT(assert_equal(ekf2.predict(motionFactor), srif2.predict(motionFactor), 1e-9));
+    PriorFactor<Pose2> measurementFactor(X(i+1), Pose2(1.0 + i, 0.1 * i, 0.3 * (i+1) + 0.02), R);
+    EXPECT(assert_equal(ekf2.update(measurementFactor), srif2.update(measurementFactor), 1e-9));
+    Matrix expectedR = ekf2.sqrtInformation(), actualR = srif2.sqrtInformation();
+    EXPECT(assert_equal(Matrix(expectedR.transpose() * expectedR), Matrix(actualR.transpose() * actualR), 1e-6));
+  }
+
+  // Constrained noise models are left to the factor graph
+  PriorFactor<Pose2> constrained(X(11), Pose2(), noiseModel::Constrained::All(3));
+  CHECK_EXCEPTION(srif2.update(constrained), std::invalid_argument);
+}
+
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -848,6 +848,247 @@ TEST(ISAM2, calculate_nnz)
   EXPECT_LONGS_EQUAL(expected, actual);
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, telemetry)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+  ISAM2TelemetryBuffer::shared_ptr buffer(new ISAM2TelemetryBuffer(3));
+  isam.setTelemetryBuffer(buffer);
+
+  ISAM2Result result;
+  for(size_t i = 0; i < 5; ++i) {
+    NonlinearFactorGraph factors;
+    factors += BetweenFactor<Pose2>(11 + i, 12 + i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(12 + i, Pose2(double(12 + i), 0.01, 0.01));
+    result = isam.update(factors, init);
+  }
+
+  // Telemetry of the last update
+  const ISAM2Telemetry& t = result.telemetry;
+  EXPECT(t.total > 0.0);
+  EXPECT(t.total >= t.addFactors + t.relinearizationCheck + t.linearize
+      + t.symbolic + t.numeric + t.backSubstitution);
+  EXPECT(t.subtreeDepth >= 1);
+  EXPECT(t.largestClique >= 2);
+  EXPECT(t.largestCliqueDim >= 2 * t.largestClique);
+  EXPECT(t.bytesAllocated > 0);
+
+  // Only the last three updates are kept, oldest first
+  vector<ISAM2Telemetry> records = buffer->snapshot();
+  LONGS_EQUAL(3, (long)records.size());
+  LONGS_EQUAL((long)t.update - 2, (long)records[0].update);
+  LONGS_EQUAL((long)t.update, (long)records[2].update);
+  LONGS_EQUAL((long)t.update, (long)buffer->latest().update);
+  EXPECT(string(t.slowestPhase()) != "");
+}
+
+/* ************************************************************************* */
+namespace {
+  // Nodes reachable from the roots of a snapshot
+  FastSet<const ISAM2Snapshot::Node*> snapshotNodes(const ISAM2Snapshot& snapshot) {
+    FastSet<const ISAM2Snapshot::Node*> nodes;
+    vector<const ISAM2Snapshot::Node*> stack;
+    BOOST_FOREACH(const ISAM2Snapshot::sharedNode& root, snapshot.roots())
+      stack.push_back(root.get());
+    while(!stack.empty()) {
+      const ISAM2Snapshot::Node* node = stack.back();
+      stack.pop_back();
+      nodes.insert(node);
+      BOOST_FOREACH(const ISAM2Snapshot::sharedNode& child, node->children)
+        stack.push_back(child.get());
+    }
+    return nodes;
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, snapshots)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true);
+  EXPECT(!ISAM2().snapshot());
+  params.enableSnapshots = true;
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // The snapshot agrees with a full solve
+  ISAM2Snapshot::shared_ptr first = isam.snapshot();
+  CHECK(first);
+  LONGS_EQUAL((long)isam.size(), (long)snapshotNodes(*first).size());
+  const Values firstEstimate = isam.calculateBestEstimate();
+  EXPECT(assert_equal(firstEstimate, first->calculateEstimate()));
+  EXPECT(assert_equal(firstEstimate.at<Pose2>(5), first->calculateEstimate<Pose2>(5)));
+  EXPECT(assert_equal(firstEstimate.at<Point2>(100), first->calculateEstimate<Point2>(100)));
+  EXPECT(assert_equal(isam.marginalCovariance(5), first->marginalCovariance(5), 1e-7));
+  EXPECT(assert_equal(isam.marginalCovariance(100), first->marginalCovariance(100), 1e-7));
+  EXPECT(first->exists(100));
+  EXPECT(!first->exists(99));
+
+  // Extend the trajectory
+  for(size_t i = 11; i < 14; ++i) {
+    NonlinearFactorGraph factors;
+    factors += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i + 1, Pose2(double(i + 1), 0.01, 0.01));
+    isam.update(factors, init);
+  }
+
+  // The new snapshot shares the cliques that were not re-eliminated, and the old one is unchanged
+  ISAM2Snapshot::shared_ptr latest = isam.snapshot();
+  EXPECT(latest != first);
+  EXPECT(latest->version() > first->version());
+  EXPECT(assert_equal(isam.calculateBestEstimate(), latest->calculateEstimate()));
+  EXPECT(assert_equal(firstEstimate, first->calculateEstimate()));
+  const FastSet<const ISAM2Snapshot::Node*> firstNodes = snapshotNodes(*first), latestNodes = snapshotNodes(*latest);
+  size_t shared = 0;
+  BOOST_FOREACH(const ISAM2Snapshot::Node* node, latestNodes)
+    shared += firstNodes.count(node);
+  EXPECT(shared > 0);
+  EXPECT(shared < latestNodes.size());
+
+  // Marginalizing modifies cliques in place, but not those of published snapshots
+  isam.marginalizeLeaves(list_of(0));
+  EXPECT(assert_equal(isam.calculateBestEstimate(), isam.snapshot()->calculateEstimate()));
+  EXPECT(!isam.snapshot()->exists(0));
+  EXPECT(assert_equal(firstEstimate, first->calculateEstimate()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, calculateEstimateIncremental)
+{
+  for(int relinearize = 0; relinearize < 2; ++relinearize) {
+    ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 1, relinearize != 0, true));
+    LONGS_EQUAL(0, (long)isam.estimateVersion());
+
+    // The first call retracts everything
+    EXPECT(assert_equal(isam.calculateEstimate(), isam.calculateEstimateIncremental()));
+    LONGS_EQUAL(1, (long)isam.estimateVersion());
+    KeyVector keys;
+    EXPECT(isam.estimateChangedKeys(0, keys));
+    LONGS_EQUAL((long)isam.getLinearizationPoint().size(), (long)keys.size());
+    EXPECT(isam.estimateChangedKeys(1, keys));
+    EXPECT(keys.empty());
+
+    // Later calls agree with a full retraction, and report the new variables
+    for(size_t i = 11; i < 14; ++i) {
+      NonlinearFactorGraph factors;
+      factors += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+      Values init;
+      init.insert(i + 1, Pose2(double(i + 1), 0.01, 0.01));
+      isam.update(factors, init);
+      EXPECT(assert_equal(isam.calculateEstimate(), isam.calculateEstimateIncremental()));
+    }
+    LONGS_EQUAL(4, (long)isam.estimateVersion());
+    EXPECT(isam.estimateChangedKeys(1, keys));
+    EXPECT(std::find(keys.begin(), keys.end(), Key(12)) != keys.end());
+    EXPECT(std::find(keys.begin(), keys.end(), Key(14)) != keys.end());
+
+    // With a large tolerance, only the new variable is retracted
+    const Values previous = isam.calculateEstimateIncremental();
+    NonlinearFactorGraph factors;
+    factors += BetweenFactor<Pose2>(14, 15, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(15, Pose2(15.0, 0.01, 0.01));
+    isam.update(factors, init);
+    const size_t version = isam.estimateVersion();
+    const Values& estimate = isam.calculateEstimateIncremental(1e10);
+    EXPECT(isam.estimateChangedKeys(version, keys));
+    if(relinearize) {
+      // Relinearized variables have a new linearization point, so are always retracted
+      EXPECT(keys.size() >= 1);
+    } else {
+      LONGS_EQUAL(1, (long)keys.size());
+      LONGS_EQUAL(15, (long)keys.front());
+      EXPECT(assert_equal(previous.at<Pose2>(5), estimate.at<Pose2>(5)));
+    }
+    EXPECT(assert_equal(isam.calculateEstimate().at<Pose2>(15), estimate.at<Pose2>(15)));
+
+    // Removed variables are reported too
+    const size_t beforeRemoval = isam.estimateVersion();
+    isam.marginalizeLeaves(list_of(0));
+    EXPECT(assert_equal(isam.calculateEstimate(), isam.calculateEstimateIncremental()));
+    EXPECT(isam.estimateChangedKeys(beforeRemoval, keys));
+    EXPECT(std::find(keys.begin(), keys.end(), Key(0)) != keys.end());
+    EXPECT(!isam.calculateEstimateIncremental().exists(0));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, assemblyPlans)
+{
+  // A fixed-lag smoother, whose old cliques go away, keeps no more plans than cliques
+  ISAM2Params params(ISAM2GaussNewtonParams(), 0.01, 1);
+  params.cacheAssemblyPlans = true;
+  ISAM2 isam(params), withoutPlans(ISAM2Params(ISAM2GaussNewtonParams(), 0.01, 1));
+  for(size_t i = 0; i < 40; ++i) {
+    NonlinearFactorGraph factors;
+    Values init;
+    if(i == 0)
+      factors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      factors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.1), odoNoise);
+    init.insert(i, Pose2(0.01, -0.01, 0.1) * Pose2(double(i), 0.0, 0.0));
+    isam.update(factors, init);
+    withoutPlans.update(factors, init);
+    if(i >= 5) {
+      isam.marginalizeLeaves(list_of(i - 5));
+      withoutPlans.marginalizeLeaves(list_of(i - 5));
+    }
+    EXPECT(isam.assemblyPlans().size() > 0);
+    EXPECT(isam.assemblyPlans().size() <= isam.size());
+  }
+  EXPECT(assert_equal(withoutPlans.calculateEstimate(), isam.calculateEstimate()));
+
+  // Plans are only kept when asked for
+  LONGS_EQUAL(0, withoutPlans.assemblyPlans().size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, doglegProducts)
+{
+  // The Dogleg model products kept in the cliques are those of all cliques with
+  // the current gradient and Newton's method step, though only the cliques the
+  // updates reach recompute theirs
+  ISAM2 isam(ISAM2Params(ISAM2DoglegParams(1.0, 1e-12), 0.1, 1));
+  Values truth;
+  for(size_t i = 0; i < 30; ++i) {
+    truth.insert(i, i == 0 ? Pose2() : truth.at<Pose2>(i - 1) * Pose2(1.0, 0.0, 0.1));
+    NonlinearFactorGraph factors;
+    Values init;
+    if(i == 0)
+      factors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      factors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.1), odoNoise);
+    if(i == 20)
+      factors += BetweenFactor<Pose2>(5, 20,
+          truth.at<Pose2>(5).between(truth.at<Pose2>(20)) * Pose2(0.05, -0.05, 0.01), odoNoise);
+    init.insert(i, truth.at<Pose2>(i) * Pose2(0.02, -0.02, 0.005));
+    isam.update(factors, init);
+    isam.getDelta(); // Takes the Dogleg step, which updates the products
+
+    const VectorValues g = isam.gradientAtZero();
+    const VectorValues dx_n = GaussianFactorGraph(isam).optimize();
+    DoglegOptimizerImpl::CachedModel::Products expected, actual;
+    vector<ISAM2::sharedClique> stack(isam.roots().begin(), isam.roots().end());
+    while(!stack.empty()) {
+      const ISAM2::sharedClique clique = stack.back();
+      stack.pop_back();
+      EXPECT(clique->doglegProductsValid_ && clique->doglegSubtreeValid_);
+      expected += DoglegOptimizerImpl::CachedModel::Products(*clique->conditional(), g, dx_n);
+      stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+    }
+    BOOST_FOREACH(const ISAM2::sharedClique& root, isam.roots())
+      actual += root->doglegSubtree_;
+    const double tol = 1e-6 * (1.0 + expected.dd);
+    DOUBLES_EQUAL(expected.AuAu, actual.AuAu, 1e-6 * (1.0 + expected.AuAu));
+    DOUBLES_EQUAL(expected.AnAn, actual.AnAn, tol);
+    DOUBLES_EQUAL(expected.AuAn, actual.AuAn, 1e-6 * (1.0 + fabs(expected.AuAn)));
+    DOUBLES_EQUAL(expected.Aud, actual.Aud, 1e-6 * (1.0 + fabs(expected.Aud)));
+    DOUBLES_EQUAL(expected.And, actual.And, tol);
+    DOUBLES_EQUAL(expected.dd, actual.dd, tol);
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
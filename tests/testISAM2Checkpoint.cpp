@@ -0,0 +1,231 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testISAM2Checkpoint.cpp
+ * @brief   Unit tests for incremental binary checkpoints of ISAM2
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Checkpoint.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BearingRangeFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/serialization.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/foreach.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+
+// Values and factors go through Boost.Serialization
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Unit, "gtsam_noiseModel_Unit");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Isotropic, "gtsam_noiseModel_Isotropic");
+BOOST_CLASS_EXPORT_GUID(gtsam::SharedNoiseModel, "gtsam_SharedNoiseModel");
+BOOST_CLASS_EXPORT_GUID(gtsam::SharedDiagonal, "gtsam_SharedDiagonal");
+BOOST_CLASS_EXPORT(gtsam::Point2);
+BOOST_CLASS_EXPORT(gtsam::Pose2);
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<gtsam::Pose2>, "gtsam::PriorFactorPose2");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<gtsam::Pose2>, "gtsam::BetweenFactorPose2");
+typedef gtsam::BearingRangeFactor<gtsam::Pose2, gtsam::Point2> BearingRangeFactor2D;
+BOOST_CLASS_EXPORT_GUID(BearingRangeFactor2D, "gtsam::BearingRangeFactor2D");
+
+static const SharedDiagonal odoNoise = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.1, M_PI/100.0));
+static const SharedDiagonal brNoise = noiseModel::Diagonal::Sigmas((Vector(2) << M_PI/100.0, 0.1));
+
+static const Point2 landmark(8.0, 4.0);
+
+/* ************************************************************************* */
+// One step of a small SLAM problem, with landmark measurements every third pose.
+// Measurements agree with the poses along the x axis, so that relinearization
+// only reaches the newest variables.
+static void step(ISAM2& isam, size_t i) {
+  NonlinearFactorGraph factors;
+  Values init;
+  const Pose2 pose(double(i), 0.0, 0.0);
+  if(i == 0) {
+    factors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+  } else {
+    factors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+  }
+  init.insert(i, pose * Pose2(0.1, -0.1, 0.01));
+  if(i % 3 == 2) {
+    factors += BearingRangeFactor2D(i, 100, pose.bearing(landmark), pose.range(landmark), brNoise);
+    if(i == 2)
+      init.insert(100, landmark + Point2(0.1, -0.1));
+  }
+  isam.update(factors, init);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, incremental)
+{
+  for(int relinearize = 0; relinearize < 2; ++relinearize) {
+    ISAM2Params params(ISAM2GaussNewtonParams(), 0.01, 1);
+    params.enableRelinearization = relinearize;
+    params.factorization = relinearize ? ISAM2Params::QR : ISAM2Params::CHOLESKY;
+    ISAM2 isam(params);
+    ISAM2Checkpoint checkpoint;
+    stringstream file;
+
+    size_t fullSize = 0, lastSize = 0;
+    for(size_t i = 0; i < 12; ++i) {
+      step(isam, i);
+      if(i == 7)
+        fullSize = checkpoint.write(isam, file);
+      else if(i > 7)
+        lastSize = checkpoint.write(isam, file);
+    }
+    // Later records only hold the top of the tree
+    EXPECT(lastSize < fullSize);
+
+    ISAM2 restored(params);
+    LONGS_EQUAL(5, (long)ISAM2Checkpoint::Restore(file, restored));
+    EXPECT(assert_equal(isam, restored));
+    EXPECT(assert_equal(isam.getDelta(), restored.getDelta()));
+    EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+
+    // Both continue the same way
+    for(size_t i = 12; i < 15; ++i) {
+      step(isam, i);
+      step(restored, i);
+    }
+    EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, removeFactors)
+{
+  // Dogleg replaces all deltas at once
+  ISAM2Params params(ISAM2DoglegParams(), 0.01, 1);
+  ISAM2 isam(params);
+  ISAM2Checkpoint checkpoint;
+  stringstream file;
+  for(size_t i = 0; i < 8; ++i)
+    step(isam, i);
+  checkpoint.write(isam, file);
+
+  // Remove the landmark measurement of pose 5, which empties a slot, then add
+  // it back, which fills the slot again
+  vector<size_t> removed;
+  BOOST_FOREACH(size_t slot, isam.getVariableIndex()[100])
+    if(isam.getFactorsUnsafe()[slot]->front() == 5)
+      removed.push_back(slot);
+  const NonlinearFactor::shared_ptr measurement = isam.getFactorsUnsafe()[removed.front()];
+  isam.update(NonlinearFactorGraph(), Values(), removed);
+  checkpoint.write(isam, file);
+  NonlinearFactorGraph measurements;
+  measurements.push_back(measurement);
+  isam.update(measurements);
+  checkpoint.write(isam, file);
+  step(isam, 8);
+  checkpoint.write(isam, file);
+
+  ISAM2 restored(params);
+  LONGS_EQUAL(4, (long)ISAM2Checkpoint::Restore(file, restored));
+  EXPECT(assert_equal(isam, restored));
+  EXPECT(assert_equal(isam.getFactorsUnsafe(), restored.getFactorsUnsafe()));
+  EXPECT(assert_equal(isam.getDelta(), restored.getDelta()));
+  EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, detach)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(), 0.01, 1);
+  ISAM2 isam(params);
+  ISAM2Checkpoint checkpoint;
+  stringstream file;
+  for(size_t i = 0; i < 8; ++i)
+    step(isam, i);
+  checkpoint.write(isam, file);
+
+  // The journal stops recording, so the next record is a full snapshot again
+  checkpoint.detach(isam);
+  step(isam, 8);
+  step(isam, 9);
+  const size_t size = checkpoint.write(isam, file);
+  stringstream other;
+  LONGS_EQUAL((long)ISAM2Checkpoint().write(isam, other), (long)size);
+
+  ISAM2 restored(params);
+  LONGS_EQUAL(2, (long)ISAM2Checkpoint::Restore(file, restored));
+  EXPECT(assert_equal(isam, restored));
+  EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, spilled)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(), 0.01, 1);
+  ISAM2Params paging = params;
+  paging.spillAfterUpdates = 2;
+  ISAM2 isam(paging);
+  ISAM2Checkpoint checkpoint;
+  stringstream file;
+  for(size_t i = 0; i < 30; ++i)
+    step(isam, i);
+
+  // Spilled cliques are written without being read back
+  const size_t spilled = isam.cliqueStore()->spilledCliques();
+  EXPECT(spilled > 0);
+  checkpoint.write(isam, file);
+  LONGS_EQUAL((long)spilled, (long)isam.cliqueStore()->spilledCliques());
+
+  ISAM2 restored(params);
+  LONGS_EQUAL(1, (long)ISAM2Checkpoint::Restore(file, restored));
+  EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+  EXPECT(assert_equal(isam, restored));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, truncated)
+{
+  ISAM2 isam;
+  ISAM2Checkpoint checkpoint;
+  stringstream file;
+  for(size_t i = 0; i < 6; ++i)
+    step(isam, i);
+  checkpoint.write(isam, file);
+  ISAM2 expected = isam;
+  step(isam, 6);
+  checkpoint.write(isam, file);
+
+  // A record cut short by a crash is ignored
+  const string contents = file.str();
+  stringstream truncated(contents.substr(0, contents.size() - 10));
+  ISAM2 restored;
+  LONGS_EQUAL(1, (long)ISAM2Checkpoint::Restore(truncated, restored));
+  EXPECT(assert_equal(expected, restored));
+
+  // So is a corrupted one
+  string corrupted = contents;
+  corrupted[corrupted.size() - 10] ^= 1;
+  stringstream corruptedFile(corrupted);
+  LONGS_EQUAL(1, (long)ISAM2Checkpoint::Restore(corruptedFile, restored));
+
+  // But not a stream that is not a checkpoint
+  stringstream garbage(string(100, 'x'));
+  CHECK_EXCEPTION(ISAM2Checkpoint::Restore(garbage, restored), std::runtime_error);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
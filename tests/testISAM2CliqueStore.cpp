@@ -0,0 +1,193 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testISAM2CliqueStore.cpp
+ * @brief   Unit tests for spilling cold ISAM2 cliques to disk
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedDiagonal odoNoise = noiseModel::Diagonal::Sigmas((Vector(3) << 0.1, 0.1, M_PI/100.0));
+
+/* ************************************************************************* */
+// A clique with a hand-made conditional on 1 given 2, and a Hessian on 2
+static ISAM2::sharedClique clique() {
+  const GaussianConditional::shared_ptr conditional = boost::make_shared<GaussianConditional>(
+      1, (Vector(2) << 1.0, 2.0), (Matrix(2, 2) << 2.0, 0.5, 0.0, 3.0),
+      2, (Matrix(2, 1) << -1.0, 4.0), noiseModel::Diagonal::Sigmas((Vector(2) << 0.5, 2.0)));
+  const GaussianFactor::shared_ptr marginal = boost::make_shared<HessianFactor>(
+      2, (Matrix(1, 1) << 5.0), (Vector(1) << 1.5), 7.0);
+  ISAM2::sharedClique clique = boost::make_shared<ISAM2Clique>();
+  clique->setEliminationResult(make_pair(conditional, marginal));
+  return clique;
+}
+
+/* ************************************************************************* */
+TEST(ISAM2CliqueStore, spillAndRead)
+{
+  const string path = (boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gtsam-testISAM2CliqueStore-%%%%-%%%%.pages")).string();
+  ISAM2CliqueStore::shared_ptr store = boost::make_shared<ISAM2CliqueStore>(path);
+  EXPECT(boost::filesystem::exists(path));
+  const ISAM2::sharedClique expected = clique();
+  ISAM2::sharedClique actual = clique();
+  actual->store_ = store;
+  store->touched(actual);
+
+  // Cold after two updates without use
+  store->tick();
+  store->spillCold(2);
+  EXPECT(actual->resident());
+  store->tick();
+  store->spillCold(2);
+  EXPECT(!actual->resident());
+  LONGS_EQUAL(1, (long)store->spilledCliques());
+  LONGS_EQUAL((2 * 4 + 2 * 2) * sizeof(double), (long)store->spilledBytes());
+
+  // Read back on access, and the space is freed
+  EXPECT(assert_equal(*expected->conditional(), *actual->conditional()));
+  EXPECT(actual->resident());
+  EXPECT(assert_equal(*expected->cachedFactor(), *actual->cachedFactor()));
+  EXPECT(assert_equal(expected->gradientContribution(), actual->gradientContribution()));
+  LONGS_EQUAL(0, (long)store->spilledCliques());
+  LONGS_EQUAL(0, (long)store->spilledBytes());
+
+  // Cold again two updates after it was read back
+  store->tick();
+  store->spillCold(2);
+  EXPECT(actual->resident());
+  store->tick();
+  store->tick();
+  store->spillCold(2);
+  EXPECT(!actual->resident());
+
+  // Using a resident clique, which does not lock the store, also keeps it in memory
+  actual->conditional();
+  store->tick();
+  actual->cachedFactor();
+  store->tick();
+  store->spillCold(2);
+  EXPECT(actual->resident());
+  store->tick();
+  store->spillCold(2);
+  EXPECT(!actual->resident());
+
+  // The file goes with the store, which the cliques share
+  store.reset();
+  EXPECT(boost::filesystem::exists(path));
+  actual.reset();
+  EXPECT(!boost::filesystem::exists(path));
+
+  // A temporary file is removed at once, and still holds the spilled cliques
+  store = boost::make_shared<ISAM2CliqueStore>();
+  EXPECT(!boost::filesystem::exists(store->path()));
+  actual = clique();
+  actual->store_ = store;
+  store->touched(actual);
+  store->tick();
+  store->spillCold(1);
+  EXPECT(!actual->resident());
+  EXPECT(assert_equal(*expected->conditional(), *actual->conditional()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2CliqueStore, isam)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(), 0.01, 1);
+  ISAM2Params paging = params;
+  paging.spillAfterUpdates = 2;
+  ISAM2 expected(params), actual(paging);
+  EXPECT(!expected.cliqueStore());
+  EXPECT(actual.cliqueStore());
+
+  // Published snapshots would keep every spilled conditional in memory
+  ISAM2Params snapshots = paging;
+  snapshots.enableSnapshots = true;
+  CHECK_EXCEPTION(ISAM2 isam(snapshots), std::invalid_argument);
+
+  // Odometry chain with consistent initial values, so deltas settle and older
+  // cliques stop being visited by the wildfire update
+  Values truth;
+  size_t spilledBeforeClosure = 0;
+  for(size_t i = 0; i < 40; ++i) {
+    truth.insert(i, i == 0 ? Pose2() : truth.at<Pose2>(i - 1) * Pose2(1.0, 0.0, 0.1));
+    NonlinearFactorGraph factors;
+    Values init;
+    if(i == 0)
+      factors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      factors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.1), odoNoise);
+    if(i == 10)
+      factors += BetweenFactor<Pose2>(2, 10,
+          truth.at<Pose2>(2).between(truth.at<Pose2>(10)) * Pose2(0.05, -0.05, 0.01), odoNoise);
+    if(i == 36) {
+      // Reaches back into spilled cliques
+      spilledBeforeClosure = actual.cliqueStore()->spilledCliques();
+      factors += BetweenFactor<Pose2>(3, 36,
+          truth.at<Pose2>(3).between(truth.at<Pose2>(36)) * Pose2(-0.05, 0.05, -0.01), odoNoise);
+    }
+    init.insert(i, truth.at<Pose2>(i) * Pose2(0.02, -0.02, 0.005));
+    expected.update(factors, init);
+    actual.update(factors, init);
+  }
+
+  // Cliques were spilled, the loop closure read them back, and the results do not change
+  EXPECT(spilledBeforeClosure > 10);
+  EXPECT(actual.cliqueStore()->spilledCliques() < spilledBeforeClosure);
+  EXPECT(assert_equal(expected.calculateEstimate(), actual.calculateEstimate(), 1e-9));
+  EXPECT(assert_equal(expected.calculateBestEstimate(), actual.calculateBestEstimate(), 1e-9));
+  EXPECT(assert_equal(expected.marginalCovariance(3), actual.marginalCovariance(3), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2CliqueStore, dogleg)
+{
+  // Dogleg steps only read back the cliques whose model products change
+  ISAM2Params params(ISAM2DoglegParams(1.0, 1e-3), 0.1, 1);
+  ISAM2Params paging = params;
+  paging.spillAfterUpdates = 2;
+  ISAM2 expected(params), actual(paging);
+  Values truth;
+  for(size_t i = 0; i < 30; ++i) {
+    truth.insert(i, i == 0 ? Pose2() : truth.at<Pose2>(i - 1) * Pose2(1.0, 0.0, 0.1));
+    NonlinearFactorGraph factors;
+    Values init;
+    if(i == 0)
+      factors += PriorFactor<Pose2>(0, Pose2(), odoNoise);
+    else
+      factors += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.1), odoNoise);
+    init.insert(i, truth.at<Pose2>(i) * Pose2(0.02, -0.02, 0.005));
+    expected.update(factors, init);
+    actual.update(factors, init);
+    actual.getDelta();
+  }
+  EXPECT(actual.cliqueStore()->spilledCliques() > 10);
+  EXPECT(assert_equal(expected.calculateEstimate(), actual.calculateEstimate(), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
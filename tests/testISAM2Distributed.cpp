@@ -0,0 +1,236 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testISAM2Distributed.cpp
+ * @brief   Unit tests for distributed ISAM2 agents, coordinator and transports
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Distributed.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/serialization.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+using namespace std;
+using namespace gtsam;
+
+// Linearization points go through Boost.Serialization
+BOOST_CLASS_EXPORT(gtsam::Point2);
+
+static const SharedDiagonal priorNoise = noiseModel::Isotropic::Sigma(2, 0.1);
+static const SharedDiagonal odoNoise = noiseModel::Isotropic::Sigma(2, 0.2);
+static const SharedDiagonal landmarkNoise = noiseModel::Diagonal::Sigmas((Vector(2) << 0.3, 0.5));
+
+static const Key landmark = 1000;
+
+/* ************************************************************************* */
+// Step i of the chain of agent a, with keys 100*a + i, which sees the shared
+// landmark with a bias depending on the agent.  Also added to the whole graph.
+static void step(ISAM2Agent& agent, size_t i, NonlinearFactorGraph& all, Values& allValues) {
+  const size_t a = agent.id();
+  const Key key = 100 * a + i;
+  const Point2 start(10.0 * a, 0.0);
+  NonlinearFactorGraph factors;
+  Values init;
+  if(i == 0)
+    factors += PriorFactor<Point2>(key, start, priorNoise);
+  else
+    factors += BetweenFactor<Point2>(key - 1, key, Point2(1.0, 0.0), odoNoise);
+  const Point2 bias(0.1 * a, -0.05 * a);
+  factors += BetweenFactor<Point2>(key, landmark, Point2(5.0 - 10.0 * a - double(i), 3.0) + bias, landmarkNoise);
+  init.insert(key, start + Point2(double(i) + 0.2, 0.1));
+  if(!agent.isam().getLinearizationPoint().exists(landmark))
+    init.insert(landmark, Point2(5.0, 3.0) + bias);
+
+  agent.update(factors, init);
+  all.push_back(factors);
+  BOOST_FOREACH(const Values::ConstKeyValuePair& value, init)
+    if(!allValues.exists(value.key))
+      allValues.insert(value.key, value.value);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Distributed, fusion)
+{
+  ISAM2Agent agent0(0), agent1(1);
+  agent0.addSeparator(KeyVector(1, landmark));
+  agent1.addSeparator(KeyVector(1, landmark));
+  // Agents meet at their last poses, measured by the coordinator
+  agent0.addSeparator(KeyVector(1, 5));
+  agent1.addSeparator(KeyVector(1, 105));
+
+  NonlinearFactorGraph all;
+  Values allValues;
+  for(size_t i = 0; i < 6; ++i) {
+    step(agent0, i, all, allValues);
+    step(agent1, i, all, allValues);
+  }
+
+  ISAM2Coordinator coordinator;
+  NonlinearFactorGraph rendezvous;
+  rendezvous += BetweenFactor<Point2>(5, 105, Point2(4.9, 0.05), odoNoise);
+  coordinator.addFactors(rendezvous);
+  all.push_back(rendezvous);
+
+  // Summaries only hold the separator variables
+  const ISAM2SeparatorSummary summary0 = agent0.summarize();
+  EXPECT(summary0.factor);
+  LONGS_EQUAL(2, (long)summary0.factor->keys().size());
+  EXPECT(coordinator.receive(ISAM2SeparatorSummary::Deserialize(summary0.serialize())));
+  EXPECT(coordinator.receive(agent1.summarize()));
+  coordinator.update();
+
+  // The problem is linear, so the fused estimate is the optimum of the whole graph
+  const Values expected = GaussNewtonOptimizer(all, allValues).optimize();
+  const Values actual = coordinator.calculateEstimate();
+  LONGS_EQUAL(3, (long)actual.size());
+  EXPECT(assert_equal(expected.at<Point2>(landmark), actual.at<Point2>(landmark), 1e-6));
+  EXPECT(assert_equal(expected.at<Point2>(5), actual.at<Point2>(5), 1e-6));
+  EXPECT(assert_equal(expected.at<Point2>(105), actual.at<Point2>(105), 1e-6));
+
+  // Outdated summaries are ignored
+  EXPECT(!coordinator.receive(summary0));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Distributed, transport)
+{
+  ISAM2Agent agent0(0), agent1(1);
+  agent0.addSeparator(KeyVector(1, landmark));
+  agent1.addSeparator(KeyVector(1, landmark));
+  NonlinearFactorGraph all;
+  Values allValues;
+
+  ISAM2InProcessTransport toCoordinator, toAgent0;
+  ISAM2Coordinator coordinator;
+  size_t firstSize = 0;
+  for(size_t i = 0; i < 12; ++i) {
+    step(agent0, i, all, allValues);
+    step(agent1, i, all, allValues);
+    agent0.publish(toCoordinator);
+    agent1.publish(toCoordinator);
+    LONGS_EQUAL(2, (long)toCoordinator.size());
+
+    // Messages do not grow with the maps
+    string message;
+    EXPECT(toCoordinator.receive(message));
+    if(i == 0)
+      firstSize = message.size();
+    LONGS_EQUAL((long)firstSize, (long)message.size());
+    EXPECT(coordinator.receive(ISAM2SeparatorSummary::Deserialize(message)));
+    LONGS_EQUAL(1, (long)coordinator.poll(toCoordinator));
+    coordinator.update();
+  }
+
+  coordinator.broadcast(toAgent0);
+  EXPECT(agent0.poll(toAgent0));
+  const Values expected = GaussNewtonOptimizer(all, allValues).optimize();
+  EXPECT(assert_equal(expected.at<Point2>(landmark), agent0.fusedSeparatorEstimate().at<Point2>(landmark), 1e-6));
+
+  CHECK_EXCEPTION(ISAM2SeparatorSummary::Deserialize(string(40, 'x')), std::runtime_error);
+
+  // Lengths beyond the end of a message are rejected before allocating
+  string valid = ISAM2SeparatorSummary().serialize(), huge = valid;
+  const boost::uint32_t hasFactor = 1;
+  const boost::uint64_t count = boost::uint64_t(1) << 60;
+  huge.replace(huge.size() - sizeof(hasFactor), sizeof(hasFactor), reinterpret_cast<const char*>(&hasFactor), sizeof(hasFactor));
+  huge.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  CHECK_EXCEPTION(ISAM2SeparatorSummary::Deserialize(huge), std::runtime_error);
+  const boost::uint64_t one = 1;
+  huge.replace(huge.size() - sizeof(count), sizeof(count), reinterpret_cast<const char*>(&one), sizeof(one));
+  huge.append(reinterpret_cast<const char*>(&one), sizeof(one));
+  huge.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  CHECK_EXCEPTION(ISAM2SeparatorSummary::Deserialize(huge), std::runtime_error);
+}
+
+#ifndef _WIN32
+/* ************************************************************************* */
+TEST(ISAM2Distributed, socketTransport)
+{
+  pair<ISAM2SocketTransport::shared_ptr, ISAM2SocketTransport::shared_ptr> ends = ISAM2SocketTransport::Pair();
+  string message;
+  EXPECT(!ends.second->receive(message));
+
+  ends.first->send("summary");
+  ends.first->send("");
+  ends.first->send(string(4000, 's'));
+  ends.second->send("estimate");
+  EXPECT(ends.second->receive(message));
+  EXPECT(message == "summary");
+  EXPECT(ends.second->receive(message));
+  EXPECT(message.empty());
+  EXPECT(ends.second->receive(message));
+  LONGS_EQUAL(4000, (long)message.size());
+  EXPECT(!ends.second->receive(message));
+  EXPECT(ends.first->receive(message));
+  EXPECT(message == "estimate");
+
+  // Closing one end is seen by the other
+  ends.first.reset();
+  EXPECT(!ends.second->receive(message));
+  EXPECT(ends.second->closed());
+
+  // Messages over the limit close the connection without being allocated
+  ends = ISAM2SocketTransport::Pair();
+  ends.second->setMaxMessageSize(100);
+  ends.first->send(string(100, 's'));
+  ends.first->send(string(101, 's'));
+  EXPECT(ends.second->receive(message));
+  LONGS_EQUAL(100, (long)message.size());
+  CHECK_EXCEPTION(ends.second->receive(message), std::runtime_error);
+  EXPECT(ends.second->closed());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Distributed, socketListener)
+{
+  const string path = "/tmp/gtsam-testISAM2Distributed-" + boost::lexical_cast<string>(::getpid());
+  {
+    // A stale socket is replaced
+    { ISAM2SocketListener stale(path); }
+    ISAM2SocketListener listener(path);
+    ISAM2SocketTransport::shared_ptr agent = ISAM2SocketTransport::Connect(path);
+    ISAM2SocketTransport::shared_ptr coordinator = listener.accept();
+    agent->send("summary");
+    string message;
+    EXPECT(coordinator->receive(message));
+    EXPECT(message == "summary");
+  }
+
+  // Any other file is left alone
+  { std::ofstream file(path.c_str()); file << "data"; }
+  CHECK_EXCEPTION(ISAM2SocketListener listener(path), std::runtime_error);
+  std::ifstream file(path.c_str());
+  string contents;
+  file >> contents;
+  EXPECT(contents == "data");
+  ::unlink(path.c_str());
+}
+#endif
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -367,6 +367,36 @@ TEST(NonlinearOptimizer, MoreOptimizationWithHuber) {
   EXPECT(assert_equal(expected, DoglegOptimizer(fg, init).optimize()));
 }
 
+/* ************************************************************************* */
+TEST(NonlinearOptimizer, linearizeInPlace) {
+
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(0, Pose2(0,0,0), noiseModel::Isotropic::Sigma(3,1));
+  fg += BetweenFactor<Pose2>(0, 1, Pose2(1,0,M_PI/2), noiseModel::Isotropic::Sigma(3,1));
+  fg += BetweenFactor<Pose2>(1, 2, Pose2(1,0,M_PI/2), noiseModel::Isotropic::Sigma(3,1));
+
+  Values init;
+  init.insert(0, Pose2(3,4,0));
+  init.insert(1, Pose2(10,2,M_PI/3));
+  init.insert(2, Pose2(11,7,M_PI/2));
+
+  Values expected;
+  expected.insert(0, Pose2(0,0,0));
+  expected.insert(1, Pose2(1,0,M_PI/2));
+  expected.insert(2, Pose2(1,1,M_PI));
+
+  GaussNewtonParams gnParams;
+  gnParams.setLinearizeInPlace(true);
+  EXPECT(assert_equal(expected, GaussNewtonOptimizer(fg, init, gnParams).optimize()));
+  DoglegParams dlParams;
+  dlParams.setLinearizeInPlace(true);
+  EXPECT(assert_equal(expected, DoglegOptimizer(fg, init, dlParams).optimize()));
+
+  LevenbergMarquardtParams lmParams;
+  lmParams.setLinearizeInPlace(true);
+  EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(fg, init, lmParams).optimize()));
+}
+
 /* ************************************************************************* */
 TEST(NonlinearOptimizer, disconnected_graph) {
   Values expected;
@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeAutoDiff.cpp
+ * @brief   Reprojection Jacobians written by hand, by automatic differentiation, and numerically
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/nonlinear/AutoDiffFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/base/numericalDerivative.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+struct Reprojection {
+  enum { dimension = 2 };
+  Point2 measured;
+  Cal3_S2 K;
+  Reprojection(const Point2& measured, const Cal3_S2& K) : measured(measured), K(K) {}
+  template<typename T>
+  Eigen::Matrix<T, 2, 1> operator()(const autodiff::Pose3<T>& pose, const autodiff::Point3<T>& point) const {
+    const autodiff::PinholeCamera<T> camera(pose, autodiff::Cal3_S2<T>(K));
+    return (camera.project(point) - autodiff::Point2<T>(measured)).vector();
+  }
+};
+
+typedef GenericProjectionFactor<Pose3, Point3> HandWritten;
+typedef AutoDiffFactor2<Pose3, Point3, Reprojection> Automatic;
+
+static Vector handWrittenError(const HandWritten& factor, const Pose3& pose, const Point3& point) {
+  return factor.evaluateError(pose, point);
+}
+
+/* ************************************************************************* */
+// Usage: timeAutoDiff [calls, default 1000000]
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? size_t(atoi(argv[1])) : 1000000;
+
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(2, 1.0);
+  const Cal3_S2::shared_ptr K(new Cal3_S2(500.0, 480.0, 0.1, 320.0, 240.0));
+  const Point2 measured(330.0, 250.0);
+  const HandWritten handWritten(measured, model, 1, 2, K);
+  const Automatic automatic(model, 1, 2, Reprojection(measured, *K));
+  const Pose3 pose(Rot3::ypr(0.3, -0.2, 1.1), Point3(0.5, -1.0, -12.0));
+  const Point3 point(1.0, 2.0, 4.0);
+
+  // The Jacobians are kept across calls, as PooledLinearizer does
+  Matrix H1, H2, A1, A2;
+  double sum = 0.0;
+
+  boost::timer::cpu_timer timer;
+  for (size_t i = 0; i < n; ++i)
+    sum += handWritten.evaluateError(pose, point, H1, H2)(0);
+  const double handWrittenTime = double(timer.elapsed().wall) / n;
+
+  timer.start();
+  for (size_t i = 0; i < n; ++i)
+    sum += automatic.evaluateError(pose, point, A1, A2)(0);
+  const double automaticTime = double(timer.elapsed().wall) / n;
+
+  const boost::function<Vector(const Pose3&, const Point3&)> f =
+    boost::bind(handWrittenError, boost::cref(handWritten), _1, _2);
+  const size_t nNumerical = n / 10 + 1;
+  Matrix N1, N2;
+  timer.start();
+  for (size_t i = 0; i < nNumerical; ++i) {
+    N1 = numericalDerivative21(f, pose, point);
+    N2 = numericalDerivative22(f, pose, point);
+    sum += N1(0, 0);
+  }
+  const double numericalTime = double(timer.elapsed().wall) / nNumerical;
+
+  cout << boost::format("max difference automatic vs hand-written: %g, numerical vs hand-written: %g (%g)\n")
+    % std::max((A1 - H1).cwiseAbs().maxCoeff(), (A2 - H2).cwiseAbs().maxCoeff())
+    % std::max((N1 - H1).cwiseAbs().maxCoeff(), (N2 - H2).cwiseAbs().maxCoeff()) % sum;
+  cout << boost::format("%-14s %10.1f ns/call\n") % "hand-written" % handWrittenTime;
+  cout << boost::format("%-14s %10.1f ns/call\n") % "automatic" % automaticTime;
+  cout << boost::format("%-14s %10.1f ns/call\n") % "numerical" % numericalTime;
+  return 0;
+}
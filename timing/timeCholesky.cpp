@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeCholesky.cpp
+ * @brief   Sweep of choleskyPartial over clique sizes, against a single LLT
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/base/cholesky.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// choleskyPartial before it chose kernels by size: Eigen's LLT on the frontal
+// block, a triangular solve, and a rank update, for every size
+static bool referencePartial(Matrix& ABC, size_t nFrontal) {
+  const size_t n = ABC.rows(), nSeparator = n - nFrontal;
+  Eigen::LLT<Matrix, Eigen::Upper> llt = ABC.topLeftCorner(nFrontal, nFrontal).selfadjointView<Eigen::Upper>().llt();
+  ABC.topLeftCorner(nFrontal, nFrontal).triangularView<Eigen::Upper>() = llt.matrixU();
+  if(nSeparator > 0) {
+    ABC.topLeftCorner(nFrontal, nFrontal).triangularView<Eigen::Upper>().transpose().solveInPlace(
+        ABC.topRightCorner(nFrontal, nSeparator));
+    ABC.bottomRightCorner(nSeparator, nSeparator).selfadjointView<Eigen::Upper>().rankUpdate(
+        ABC.topRightCorner(nFrontal, nSeparator).transpose(), -1.0);
+  }
+  return llt.info() == Eigen::Success;
+}
+
+/* ************************************************************************* */
+// Average wall time in microseconds of one factorization of a copy of ABC
+template<class FUNCTION>
+static double timePartial(FUNCTION factor, const Matrix& ABC, size_t nFrontal, size_t reps) {
+  Matrix work(ABC.rows(), ABC.cols());
+  boost::timer::cpu_timer timer;
+  for(size_t rep = 0; rep < reps; ++rep) {
+    work = ABC;
+    if(!factor(work, nFrontal))
+      throw runtime_error("timeCholesky: factorization failed");
+  }
+  timer.stop();
+  // Copies are timed separately and subtracted
+  boost::timer::cpu_timer copies;
+  for(size_t rep = 0; rep < reps; ++rep)
+    work = ABC;
+  copies.stop();
+  return double(timer.elapsed().wall - copies.elapsed().wall) / 1e3 / double(reps);
+}
+
+/* ************************************************************************* */
+// Usage: timeCholesky [largest frontal size, default 3072]
+int main(int argc, char* argv[]) {
+  const size_t largest = argc > 1 ? size_t(atoi(argv[1])) : 3072;
+
+  // Variable sizes of small cliques, then doubling up to root cliques of SfM
+  // problems, each with a separator half its size up to 300 (none for roots)
+  const size_t small[] = { 1, 2, 3, 6 };
+  vector<size_t> sizes(small, small + 4);
+  for(size_t size = 12; size <= largest; size *= 2)
+    sizes.push_back(size);
+
+  cout << boost::format("%10s %10s %8s %14s %14s %8s\n")
+      % "frontal" % "separator" % "reps" % "LLT (us)" % "partial (us)" % "speedup";
+  for(size_t s = 0; s < sizes.size(); ++s) {
+    const size_t nFrontal = sizes[s], nSeparator = nFrontal >= 1000 ? 0 : min<size_t>(nFrontal / 2 + 1, 300);
+    const size_t n = nFrontal + nSeparator;
+
+    // Enough repetitions for about 1e9 flops
+    const size_t reps = max<size_t>(1, size_t(3e9 / (double(n) * double(n) * double(n) + 1e4)));
+
+    const Matrix M = Matrix::Random(n + 10, n);
+    const Matrix ABC = M.transpose() * M;
+    const double reference = timePartial(referencePartial, ABC, nFrontal, reps);
+    const double partial = timePartial(choleskyPartial, ABC, nFrontal, reps);
+    cout << boost::format("%10d %10d %8d %14.3f %14.3f %8.2f\n")
+        % nFrontal % nSeparator % reps % reference % partial % (reference / partial);
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeCompressedVariableIndex.cpp
+ * @brief   Building a VariableIndex and a CompressedVariableIndex, and ordering with each
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicEliminationTree.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Usage: timeCompressedVariableIndex [grid side, default 1000]
+int main(int argc, char* argv[]) {
+  const size_t side = argc > 1 ? size_t(atoi(argv[1])) : 1000;
+
+  // A grid with a factor on every edge, as in a large batch SLAM problem
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for(size_t r = 0; r < side; ++r) {
+    for(size_t c = 0; c < side; ++c) {
+      const Key j = r * side + c;
+      if(c + 1 < side) graph.push_factor(j, j + 1);
+      if(r + 1 < side) graph.push_factor(j, j + side);
+    }
+  }
+
+  boost::timer::cpu_timer timer;
+  const VariableIndex variableIndex(graph);
+  const double indexTime = double(timer.elapsed().wall) / 1e9;
+  timer.start();
+  const Ordering ordering = Ordering::COLAMD(variableIndex);
+  const double orderingTime = double(timer.elapsed().wall) / 1e9;
+  timer.start();
+  SymbolicEliminationTree etree(graph, variableIndex, ordering);
+  const double etreeTime = double(timer.elapsed().wall) / 1e9;
+
+  timer.start();
+  const CompressedVariableIndex compressed(graph);
+  const double compressedIndexTime = double(timer.elapsed().wall) / 1e9;
+  timer.start();
+  const Ordering compressedOrdering = Ordering::COLAMD(compressed);
+  const double compressedOrderingTime = double(timer.elapsed().wall) / 1e9;
+  timer.start();
+  SymbolicEliminationTree compressedEtree(graph, compressed, compressedOrdering);
+  const double compressedEtreeTime = double(timer.elapsed().wall) / 1e9;
+
+  cout << boost::format("%d variables, %d factors, same ordering: %s\n") % ordering.size()
+    % graph.size() % (ordering.equals(compressedOrdering) ? "yes" : "no");
+  cout << boost::format("%-24s %10s %10s %10s\n") % "" % "index (s)" % "COLAMD (s)" % "etree (s)";
+  cout << boost::format("%-24s %10.3f %10.3f %10.3f\n") % "VariableIndex" % indexTime % orderingTime % etreeTime;
+  cout << boost::format("%-24s %10.3f %10.3f %10.3f\n") % "CompressedVariableIndex"
+    % compressedIndexTime % compressedOrderingTime % compressedEtreeTime;
+  return 0;
+}
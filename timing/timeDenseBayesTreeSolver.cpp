@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeDenseBayesTreeSolver.cpp
+ * @brief   Bayes tree back-substitution and gradient with VectorValues and with DenseBayesTreeSolver
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/DenseBayesTreeSolver.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// Usage: timeDenseBayesTreeSolver [grid side, default 100] [repetitions, default 20] [threads, default all]
+int main(int argc, char* argv[]) {
+  const size_t side = argc > 1 ? size_t(atoi(argv[1])) : 100;
+  const size_t reps = argc > 2 ? size_t(atoi(argv[2])) : 20;
+  const size_t nThreads = argc > 3 ? size_t(atoi(argv[3])) : 0;
+
+  // A grid of 3-dimensional variables with a factor on every edge
+  GaussianFactorGraph graph;
+  const Matrix I = eye(3);
+  graph += JacobianFactor(X(0), I, zero(3));
+  for(size_t r = 0; r < side; ++r) {
+    for(size_t c = 0; c < side; ++c) {
+      const size_t j = r * side + c;
+      if(c + 1 < side) graph += JacobianFactor(X(j), I, X(j + 1), -I, ones(3));
+      if(r + 1 < side) graph += JacobianFactor(X(j), I, X(j + side), -I, ones(3));
+    }
+  }
+  const GaussianBayesTree bayesTree = *graph.eliminateMultifrontal();
+
+  VectorValues x;
+  boost::timer::cpu_timer timer;
+  for(size_t k = 0; k < reps; ++k)
+    x = bayesTree.optimize();
+  const double mapSolveTime = double(timer.elapsed().wall) / 1e9 / reps;
+  VectorValues g;
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    g = bayesTree.gradientAtZero();
+  const double mapGradientTime = double(timer.elapsed().wall) / 1e9 / reps;
+
+  timer.start();
+  DenseBayesTreeSolver solver(bayesTree, nThreads);
+  const double setupTime = double(timer.elapsed().wall) / 1e9;
+
+  DenseVectorValues xDense = solver.zero();
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    solver.optimize(xDense);
+  const double denseSolveTime = double(timer.elapsed().wall) / 1e9 / reps;
+  DenseVectorValues gDense = solver.zero();
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    solver.gradientAtZero(gDense);
+  const double denseGradientTime = double(timer.elapsed().wall) / 1e9 / reps;
+
+  cout << boost::format("%d variables, %d cliques, %d threads, setup %.4f s, same solution: %s, same gradient: %s\n")
+    % x.size() % solver.nrCliques() % solver.nThreads() % setupTime
+    % (x.equals(xDense.toVectorValues(), 1e-9) ? "yes" : "no")
+    % (g.equals(gDense.toVectorValues(), 1e-9) ? "yes" : "no");
+  cout << boost::format("%-22s %14s %14s\n") % "" % "solve (s)" % "gradient (s)";
+  cout << boost::format("%-22s %14.5f %14.5f\n") % "GaussianBayesTree" % mapSolveTime % mapGradientTime;
+  cout << boost::format("%-22s %14.5f %14.5f\n") % "DenseBayesTreeSolver" % denseSolveTime % denseGradientTime;
+  return 0;
+}
@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeDenseKeyMode.cpp
+ * @brief   Hessian-vector products and gradients with VectorValues and in dense key mode
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/DenseVectorValues.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// Usage: timeDenseKeyMode [grid side, default 200] [repetitions, default 20]
+int main(int argc, char* argv[]) {
+  const size_t side = argc > 1 ? size_t(atoi(argv[1])) : 200;
+  const size_t reps = argc > 2 ? size_t(atoi(argv[2])) : 20;
+
+  // A grid of 3-dimensional variables with Symbol keys and a factor on every edge
+  GaussianFactorGraph graph;
+  const Matrix I = eye(3);
+  graph += JacobianFactor(X(0), I, zero(3));
+  VectorValues x;
+  for(size_t r = 0; r < side; ++r) {
+    for(size_t c = 0; c < side; ++c) {
+      const size_t j = r * side + c;
+      x.insert(X(j), (Vector(3) << double(r), double(c), 1.0).finished());
+      if(c + 1 < side) graph += JacobianFactor(X(j), I, X(j + 1), -I, ones(3));
+      if(r + 1 < side) graph += JacobianFactor(X(j), I, X(j + side), -I, ones(3));
+    }
+  }
+
+  boost::timer::cpu_timer timer;
+  const DenseVectorValues::sharedIndexer indexer = boost::make_shared<KeyIndexer>(graph);
+  const KeyIndexer::FactorIndices factorIndices = indexer->indexFactors(graph);
+  const double indexTime = double(timer.elapsed().wall) / 1e9;
+
+  VectorValues y = VectorValues::Zero(x);
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    graph.multiplyHessianAdd(1.0, x, y);
+  const double mapProductTime = double(timer.elapsed().wall) / 1e9 / reps;
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    graph.gradientAtZero();
+  const double mapGradientTime = double(timer.elapsed().wall) / 1e9 / reps;
+
+  const DenseVectorValues xDense(indexer, x);
+  DenseVectorValues yDense = DenseVectorValues::Zero(xDense);
+  timer.start();
+  for(size_t k = 0; k < reps; ++k)
+    graph.multiplyHessianAdd(1.0, xDense, yDense, factorIndices);
+  const double denseProductTime = double(timer.elapsed().wall) / 1e9 / reps;
+  DenseVectorValues g = DenseVectorValues::Zero(xDense);
+  timer.start();
+  for(size_t k = 0; k < reps; ++k) {
+    g.setZero();
+    graph.gradientAtZero(g, factorIndices);
+  }
+  const double denseGradientTime = double(timer.elapsed().wall) / 1e9 / reps;
+
+  cout << boost::format("%d variables, %d factors, indexing %.3f s, same product: %s\n")
+    % x.size() % graph.size() % indexTime % (y.equals(yDense.toVectorValues()) ? "yes" : "no");
+  cout << boost::format("%-18s %14s %14s\n") % "" % "A'Ax (s)" % "gradient (s)";
+  cout << boost::format("%-18s %14.5f %14.5f\n") % "VectorValues" % mapProductTime % mapGradientTime;
+  cout << boost::format("%-18s %14.5f %14.5f\n") % "DenseVectorValues" % denseProductTime % denseGradientTime;
+  return 0;
+}
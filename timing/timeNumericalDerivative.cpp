@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeNumericalDerivative.cpp
+ * @brief   Numerical Jacobians of a projection through boost::function and with fixed sizes
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/batchedNumericalDerivative.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Cal3_S2.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const Cal3_S2 K(500.0, 480.0, 0.1, 320.0, 240.0);
+
+/* ************************************************************************* */
+static Point2 project(const Pose3& pose, const Point3& point) {
+  return PinholeCamera<Cal3_S2>(pose, K).project(point);
+}
+
+/* ************************************************************************* */
+// Projects all perturbed points in one call, sharing the camera between them
+struct ProjectPoints {
+  const PinholeCamera<Cal3_S2> camera;
+  ProjectPoints(const Pose3& pose) : camera(pose, K) {}
+  void operator()(const Point3* points, Point2* projections, size_t count) const {
+    for (size_t i = 0; i < count; ++i)
+      projections[i] = camera.project(points[i]);
+  }
+};
+
+/* ************************************************************************* */
+// Usage: timeNumericalDerivative [calls, default 100000]
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? size_t(atoi(argv[1])) : 100000;
+
+  const Pose3 pose(Rot3::ypr(0.3, -0.2, 1.1), Point3(0.5, -1.0, -12.0));
+  const Point3 point(1.0, 2.0, 4.0);
+  double sum = 0.0;
+
+  Matrix N1, N2;
+  boost::timer::cpu_timer timer;
+  for (size_t i = 0; i < n; ++i) {
+    N1 = numericalDerivative21(project, pose, point);
+    N2 = numericalDerivative22(project, pose, point);
+    sum += N1(0, 0) + N2(0, 0);
+  }
+  const double dynamicTime = double(timer.elapsed().wall) / n;
+
+  Eigen::Matrix<double, 2, 6> F1;
+  Eigen::Matrix<double, 2, 3> F2;
+  timer.start();
+  for (size_t i = 0; i < n; ++i) {
+    F1 = numericalDerivativeFixed21<Point2, Pose3, Point3>(project, pose, point);
+    F2 = numericalDerivativeFixed22<Point2, Pose3, Point3>(project, pose, point);
+    sum += F1(0, 0) + F2(0, 0);
+  }
+  const double fixedTime = double(timer.elapsed().wall) / n;
+
+  timer.start();
+  for (size_t i = 0; i < n; ++i) {
+    F1 = numericalDerivativeParallel21<Point2, Pose3, Point3>(project, pose, point);
+    F2 = numericalDerivativeParallel22<Point2, Pose3, Point3>(project, pose, point);
+    sum += F1(0, 0) + F2(0, 0);
+  }
+  const double parallelTime = double(timer.elapsed().wall) / n;
+
+  timer.start();
+  for (size_t i = 0; i < n; ++i) {
+    F1 = numericalDerivativeFixed21<Point2, Pose3, Point3>(project, pose, point);
+    F2 = numericalDerivativeBatch<Point2, Point3>(ProjectPoints(pose), point);
+    sum += F1(0, 0) + F2(0, 0);
+  }
+  const double batchTime = double(timer.elapsed().wall) / n;
+
+  cout << boost::format("max difference fixed vs boost::function: %g (%g)\n")
+    % std::max((Matrix(F1) - N1).cwiseAbs().maxCoeff(), (Matrix(F2) - N2).cwiseAbs().maxCoeff()) % sum;
+  cout << boost::format("%-16s %10.1f ns/call\n") % "boost::function" % dynamicTime;
+  cout << boost::format("%-16s %10.1f ns/call\n") % "fixed" % fixedTime;
+  cout << boost::format("%-16s %10.1f ns/call\n") % "parallel" % parallelTime;
+  cout << boost::format("%-16s %10.1f ns/call\n") % "batched point" % batchTime;
+  return 0;
+}
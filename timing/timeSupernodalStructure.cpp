@@ -0,0 +1,71 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeSupernodalStructure.cpp
+ * @brief   Symbolic setup of a junction tree, from an elimination tree and from a SupernodalStructure
+ * @date    October 19, 2026
+ */
+
+#include <gtsam/inference/SupernodalStructure.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicEliminationTree.h>
+#include <gtsam/symbolic/SymbolicJunctionTree.h>
+
+#include <boost/timer/timer.hpp>
+#include <boost/format.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Usage: timeSupernodalStructure [grid side, default 300]
+int main(int argc, char* argv[]) {
+  const size_t side = argc > 1 ? size_t(atoi(argv[1])) : 300;
+
+  // A grid with a factor on every edge, as in a large batch SLAM problem
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for(size_t r = 0; r < side; ++r) {
+    for(size_t c = 0; c < side; ++c) {
+      const Key j = r * side + c;
+      if(c + 1 < side) graph.push_factor(j, j + 1);
+      if(r + 1 < side) graph.push_factor(j, j + side);
+    }
+  }
+  const VariableIndex variableIndex(graph);
+  const Ordering ordering = Ordering::COLAMD(variableIndex);
+
+  boost::timer::cpu_timer timer;
+  SymbolicJunctionTree fromEliminationTree(SymbolicEliminationTree(graph, variableIndex, ordering));
+  const double eliminationTreeTime = double(timer.elapsed().wall) / 1e9;
+
+  timer.start();
+  SupernodalStructure exact(variableIndex, ordering, SupernodeParams::Exact());
+  SymbolicJunctionTree fromExact(graph, exact);
+  const double exactTime = double(timer.elapsed().wall) / 1e9;
+
+  timer.start();
+  SupernodalStructure relaxed(variableIndex, ordering);
+  SymbolicJunctionTree fromRelaxed(graph, relaxed);
+  const double relaxedTime = double(timer.elapsed().wall) / 1e9;
+
+  cout << boost::format("%d variables, %d factors\n") % ordering.size() % graph.size();
+  cout << boost::format("%-28s %10s %10s\n") % "junction tree from" % "time (s)" % "cliques";
+  cout << boost::format("%-28s %10.3f %10s\n") % "elimination tree" % eliminationTreeTime % "-";
+  cout << boost::format("%-28s %10.3f %10d\n") % "exact supernodes" % exactTime % exact.nrSupernodes();
+  cout << boost::format("%-28s %10.3f %10d\n") % "relaxed supernodes" % relaxedTime % relaxed.nrSupernodes();
+  return 0;
+}